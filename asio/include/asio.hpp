@@ -62,6 +62,7 @@
 #include "asio/cancellation_signal.hpp"
 #include "asio/cancellation_state.hpp"
 #include "asio/cancellation_type.hpp"
+#include "asio/coalescing_write_stream.hpp"
 #include "asio/co_spawn.hpp"
 #include "asio/completion_condition.hpp"
 #include "asio/compose.hpp"
@@ -101,6 +102,7 @@
 #include "asio/handler_continuation_hook.hpp"
 #include "asio/high_resolution_timer.hpp"
 #include "asio/io_context.hpp"
+#include "asio/io_context_metrics.hpp"
 #include "asio/io_context_strand.hpp"
 #include "asio/io_service.hpp"
 #include "asio/io_service_strand.hpp"
@@ -133,6 +135,8 @@
 #include "asio/is_executor.hpp"
 #include "asio/is_read_buffered.hpp"
 #include "asio/is_write_buffered.hpp"
+#include "asio/latency_histogram.hpp"
+#include "asio/local/ancillary_data.hpp"
 #include "asio/local/basic_endpoint.hpp"
 #include "asio/local/connect_pair.hpp"
 #include "asio/local/datagram_protocol.hpp"
@@ -149,6 +153,7 @@
 #include "asio/post.hpp"
 #include "asio/prefer.hpp"
 #include "asio/prepend.hpp"
+#include "asio/proxy.hpp"
 #include "asio/query.hpp"
 #include "asio/random_access_file.hpp"
 #include "asio/read.hpp"
@@ -158,6 +163,7 @@
 #include "asio/recycling_allocator.hpp"
 #include "asio/redirect_error.hpp"
 #include "asio/registered_buffer.hpp"
+#include "asio/ring_buffer.hpp"
 #include "asio/require.hpp"
 #include "asio/require_concept.hpp"
 #include "asio/serial_port.hpp"
@@ -176,6 +182,7 @@
 #include "asio/system_timer.hpp"
 #include "asio/this_coro.hpp"
 #include "asio/thread.hpp"
+#include "asio/thread_policy.hpp"
 #include "asio/thread_pool.hpp"
 #include "asio/time_traits.hpp"
 #include "asio/use_awaitable.hpp"
@@ -185,7 +192,10 @@
 #include <asio/vm/basic_endpoint.hpp>
 #include <asio/vm/cid.hpp>
 #include <asio/vm/datagram_protocol.hpp>
+#include <asio/vm/message_batch.hpp>
+#include <asio/vm/seqpacket_protocol.hpp>
 #include <asio/vm/stream_protocol.hpp>
+#include <asio/vm/zerocopy_sender.hpp>
 #include "asio/wait_traits.hpp"
 #include "asio/windows/basic_object_handle.hpp"
 #include "asio/windows/basic_overlapped_handle.hpp"
@@ -196,6 +206,7 @@
 #include "asio/windows/overlapped_ptr.hpp"
 #include "asio/windows/random_access_handle.hpp"
 #include "asio/windows/stream_handle.hpp"
+#include "asio/work_stealing_pool.hpp"
 #include "asio/writable_pipe.hpp"
 #include "asio/write.hpp"
 #include "asio/write_at.hpp"
@@ -27,9 +27,22 @@
 
 #include "asio/detail/push_options.hpp"
 
+#if !defined(ASIO_ANY_COMPLETION_HANDLER_INLINE_SIZE)
+# define ASIO_ANY_COMPLETION_HANDLER_INLINE_SIZE (6 * sizeof(void*))
+#endif // !defined(ASIO_ANY_COMPLETION_HANDLER_INLINE_SIZE)
+
 namespace asio {
 namespace detail {
 
+// Storage used to hold small handlers inside the any_completion_handler
+// object itself, avoiding an allocation through the associated allocator.
+struct any_completion_handler_storage
+{
+  enum { size = ASIO_ANY_COMPLETION_HANDLER_INLINE_SIZE };
+
+  aligned_storage_t<(size > 0 ? size : 1), ASIO_DEFAULT_ALIGN> data_;
+};
+
 class any_completion_handler_impl_base
 {
 public:
@@ -48,6 +61,28 @@ private:
   cancellation_state cancel_state_;
 };
 
+template <typename Handler>
+class any_completion_handler_impl;
+
+// A handler is stored inline when its implementation object fits within the
+// inline storage and it can be relocated without throwing. The handler must
+// also have no associated allocator of its own, as allocators obtained from
+// the any_completion_handler would otherwise refer to the handler's old
+// location after a move.
+template <typename Handler>
+struct any_completion_handler_is_inline :
+  integral_constant<bool,
+    (any_completion_handler_storage::size > 0)
+      && (sizeof(any_completion_handler_impl<Handler>)
+        <= any_completion_handler_storage::size)
+      && (alignof(any_completion_handler_impl<Handler>) <= ASIO_DEFAULT_ALIGN)
+      && is_nothrow_move_constructible<Handler>::value
+      && is_same<
+        associated_allocator_t<Handler, asio::recycling_allocator<void>>,
+        asio::recycling_allocator<void>>::value>
+{
+};
+
 template <typename Handler>
 class any_completion_handler_impl :
   public any_completion_handler_impl_base
@@ -88,7 +123,24 @@ public:
   };
 
   template <typename S, typename H>
-  static any_completion_handler_impl* create(S&& slot, H&& h)
+  static any_completion_handler_impl* create(
+      S&& slot, H&& h, any_completion_handler_storage* storage)
+  {
+    return create(static_cast<S&&>(slot), static_cast<H&&>(h),
+        storage, any_completion_handler_is_inline<Handler>());
+  }
+
+  template <typename S, typename H>
+  static any_completion_handler_impl* create(S&& slot, H&& h,
+      any_completion_handler_storage* storage, true_type)
+  {
+    return new (&storage->data_) any_completion_handler_impl(
+        static_cast<S&&>(slot), static_cast<H&&>(h));
+  }
+
+  template <typename S, typename H>
+  static any_completion_handler_impl* create(S&& slot, H&& h,
+      any_completion_handler_storage*, false_type)
   {
     uninit_deleter d{
         (get_associated_allocator)(h,
@@ -106,6 +158,16 @@ public:
   }
 
   void destroy()
+  {
+    destroy(any_completion_handler_is_inline<Handler>());
+  }
+
+  void destroy(true_type)
+  {
+    this->~any_completion_handler_impl();
+  }
+
+  void destroy(false_type)
   {
     deleter d{
         (get_associated_allocator)(handler_,
@@ -114,6 +176,16 @@ public:
     d(this);
   }
 
+  any_completion_handler_impl* move(
+      any_completion_handler_storage* storage) noexcept
+  {
+    any_completion_handler_impl* ptr =
+      new (&storage->data_) any_completion_handler_impl(
+        static_cast<any_completion_handler_impl&&>(*this));
+    this->~any_completion_handler_impl();
+    return ptr;
+  }
+
   any_completion_executor executor(
       const any_completion_executor& candidate) const noexcept
   {
@@ -130,12 +202,16 @@ public:
 
   void* allocate(std::size_t size, std::size_t align) const
   {
-    typename std::allocator_traits<
-      associated_allocator_t<Handler,
-        asio::recycling_allocator<void>>>::template
-          rebind_alloc<unsigned char> alloc(
-            (get_associated_allocator)(handler_,
-              asio::recycling_allocator<void>()));
+    return allocate((get_associated_allocator)(handler_,
+          asio::recycling_allocator<void>()), size, align);
+  }
+
+  template <typename Allocator>
+  static void* allocate(const Allocator& a,
+      std::size_t size, std::size_t align)
+  {
+    typename std::allocator_traits<Allocator>::template
+      rebind_alloc<unsigned char> alloc(a);
 
     std::size_t space = size + align - 1;
     unsigned char* base =
@@ -156,15 +232,19 @@ public:
   }
 
   void deallocate(void* p, std::size_t size, std::size_t align) const
+  {
+    deallocate((get_associated_allocator)(handler_,
+          asio::recycling_allocator<void>()), p, size, align);
+  }
+
+  template <typename Allocator>
+  static void deallocate(const Allocator& a,
+      void* p, std::size_t size, std::size_t align)
   {
     if (p)
     {
-      typename std::allocator_traits<
-        associated_allocator_t<Handler,
-          asio::recycling_allocator<void>>>::template
-            rebind_alloc<unsigned char> alloc(
-              (get_associated_allocator)(handler_,
-                asio::recycling_allocator<void>()));
+      typename std::allocator_traits<Allocator>::template
+        rebind_alloc<unsigned char> alloc(a);
 
       std::ptrdiff_t off;
       std::memcpy(&off, static_cast<unsigned char*>(p) + size, sizeof(off));
@@ -177,6 +257,23 @@ public:
 
   template <typename... Args>
   void call(Args&&... args)
+  {
+    do_call(any_completion_handler_is_inline<Handler>(),
+        static_cast<Args&&>(args)...);
+  }
+
+  template <typename... Args>
+  void do_call(true_type, Args&&... args)
+  {
+    Handler handler(static_cast<Handler&&>(handler_));
+    this->~any_completion_handler_impl();
+
+    static_cast<Handler&&>(handler)(
+        static_cast<Args&&>(args)...);
+  }
+
+  template <typename... Args>
+  void do_call(false_type, Args&&... args)
   {
     deleter d{
         (get_associated_allocator)(handler_,
@@ -279,6 +376,55 @@ private:
   type destroy_fn_;
 };
 
+class any_completion_handler_move_fn
+{
+public:
+  using type = any_completion_handler_impl_base*(*)(
+      any_completion_handler_impl_base*, any_completion_handler_storage*);
+
+  constexpr any_completion_handler_move_fn(type fn)
+    : move_fn_(fn)
+  {
+  }
+
+  any_completion_handler_impl_base* move(
+      any_completion_handler_impl_base* impl,
+      any_completion_handler_storage* storage) const
+  {
+    return move_fn_ ? move_fn_(impl, storage) : impl;
+  }
+
+  template <typename Handler>
+  static constexpr type select()
+  {
+    return select<Handler>(any_completion_handler_is_inline<Handler>());
+  }
+
+  template <typename Handler>
+  static constexpr type select(true_type)
+  {
+    return &any_completion_handler_move_fn::impl<Handler>;
+  }
+
+  template <typename Handler>
+  static constexpr type select(false_type)
+  {
+    return nullptr;
+  }
+
+  template <typename Handler>
+  static any_completion_handler_impl_base* impl(
+      any_completion_handler_impl_base* impl,
+      any_completion_handler_storage* storage)
+  {
+    return static_cast<any_completion_handler_impl<Handler>*>(impl)->move(
+        storage);
+  }
+
+private:
+  type move_fn_;
+};
+
 class any_completion_handler_executor_fn
 {
 public:
@@ -358,6 +504,24 @@ public:
   template <typename Handler>
   static void* impl(any_completion_handler_impl_base* impl,
       std::size_t size, std::size_t align)
+  {
+    return impl_allocate<Handler>(impl, size, align,
+        any_completion_handler_is_inline<Handler>());
+  }
+
+  // Inline handlers move with the any_completion_handler, so the allocation
+  // must not depend on the handler object.
+  template <typename Handler>
+  static void* impl_allocate(any_completion_handler_impl_base*,
+      std::size_t size, std::size_t align, true_type)
+  {
+    return any_completion_handler_impl<Handler>::allocate(
+        asio::recycling_allocator<void>(), size, align);
+  }
+
+  template <typename Handler>
+  static void* impl_allocate(any_completion_handler_impl_base* impl,
+      std::size_t size, std::size_t align, false_type)
   {
     return static_cast<any_completion_handler_impl<Handler>*>(impl)->allocate(
         size, align);
@@ -387,6 +551,22 @@ public:
   template <typename Handler>
   static void impl(any_completion_handler_impl_base* impl,
       void* p, std::size_t size, std::size_t align)
+  {
+    impl_deallocate<Handler>(impl, p, size, align,
+        any_completion_handler_is_inline<Handler>());
+  }
+
+  template <typename Handler>
+  static void impl_deallocate(any_completion_handler_impl_base*,
+      void* p, std::size_t size, std::size_t align, true_type)
+  {
+    any_completion_handler_impl<Handler>::deallocate(
+        asio::recycling_allocator<void>(), p, size, align);
+  }
+
+  template <typename Handler>
+  static void impl_deallocate(any_completion_handler_impl_base* impl,
+      void* p, std::size_t size, std::size_t align, false_type)
   {
     static_cast<any_completion_handler_impl<Handler>*>(impl)->deallocate(
         p, size, align);
@@ -399,6 +579,7 @@ private:
 template <typename... Signatures>
 class any_completion_handler_fn_table
   : private any_completion_handler_destroy_fn,
+    private any_completion_handler_move_fn,
     private any_completion_handler_executor_fn,
     private any_completion_handler_immediate_executor_fn,
     private any_completion_handler_allocate_fn,
@@ -409,12 +590,14 @@ public:
   template <typename... CallFns>
   constexpr any_completion_handler_fn_table(
       any_completion_handler_destroy_fn::type destroy_fn,
+      any_completion_handler_move_fn::type move_fn,
       any_completion_handler_executor_fn::type executor_fn,
       any_completion_handler_immediate_executor_fn::type immediate_executor_fn,
       any_completion_handler_allocate_fn::type allocate_fn,
       any_completion_handler_deallocate_fn::type deallocate_fn,
       CallFns... call_fns)
     : any_completion_handler_destroy_fn(destroy_fn),
+      any_completion_handler_move_fn(move_fn),
       any_completion_handler_executor_fn(executor_fn),
       any_completion_handler_immediate_executor_fn(immediate_executor_fn),
       any_completion_handler_allocate_fn(allocate_fn),
@@ -424,6 +607,7 @@ public:
   }
 
   using any_completion_handler_destroy_fn::destroy;
+  using any_completion_handler_move_fn::move;
   using any_completion_handler_executor_fn::executor;
   using any_completion_handler_immediate_executor_fn::immediate_executor;
   using any_completion_handler_allocate_fn::allocate;
@@ -437,6 +621,7 @@ struct any_completion_handler_fn_table_instance
   static constexpr any_completion_handler_fn_table<Signatures...>
     value = any_completion_handler_fn_table<Signatures...>(
         &any_completion_handler_destroy_fn::impl<Handler>,
+        any_completion_handler_move_fn::select<Handler>(),
         &any_completion_handler_executor_fn::impl<Handler>,
         &any_completion_handler_immediate_executor_fn::impl<Handler>,
         &any_completion_handler_allocate_fn::impl<Handler>,
@@ -608,6 +793,13 @@ public:
  *
  * @li Enabling interoperability between asynchronous operations and virtual
  *     functions.
+ *
+ * Small target handlers that are nothrow move constructible are stored within
+ * the @c any_completion_handler object itself, and no memory is allocated for
+ * them. The capacity of this inline storage is set at compile time by the
+ * @c ASIO_ANY_COMPLETION_HANDLER_INLINE_SIZE macro, which defaults to six
+ * pointers. Larger target handlers, and target handlers that have an
+ * associated allocator, are allocated using their associated allocator.
  */
 template <typename... Signatures>
 class any_completion_handler
@@ -625,6 +817,7 @@ private:
 
   const detail::any_completion_handler_fn_table<Signatures...>* fn_table_;
   detail::any_completion_handler_impl_base* impl_;
+  detail::any_completion_handler_storage storage_;
 #endif // !defined(GENERATING_DOCUMENTATION)
 
 public:
@@ -660,7 +853,8 @@ public:
         &detail::any_completion_handler_fn_table_instance<
           Handler, Signatures...>::value),
       impl_(detail::any_completion_handler_impl<Handler>::create(
-            (get_associated_cancellation_slot)(h), static_cast<H&&>(h)))
+            (get_associated_cancellation_slot)(h),
+            static_cast<H&&>(h), &storage_))
   {
   }
 
@@ -670,7 +864,7 @@ public:
    */
   any_completion_handler(any_completion_handler&& other) noexcept
     : fn_table_(other.fn_table_),
-      impl_(other.impl_)
+      impl_(other.impl_ ? fn_table_->move(other.impl_, &storage_) : nullptr)
   {
     other.fn_table_ = nullptr;
     other.impl_ = nullptr;
@@ -717,8 +911,13 @@ public:
   /// Swap the content of an @c any_completion_handler with another.
   void swap(any_completion_handler& other) noexcept
   {
-    std::swap(fn_table_, other.fn_table_);
-    std::swap(impl_, other.impl_);
+    any_completion_handler tmp(static_cast<any_completion_handler&&>(other));
+    other.fn_table_ = fn_table_;
+    other.impl_ = impl_ ? fn_table_->move(impl_, &other.storage_) : nullptr;
+    fn_table_ = tmp.fn_table_;
+    impl_ = tmp.impl_ ? fn_table_->move(tmp.impl_, &storage_) : nullptr;
+    tmp.fn_table_ = nullptr;
+    tmp.impl_ = nullptr;
   }
 
   /// Get the associated allocator.
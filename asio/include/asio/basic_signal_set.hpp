@@ -92,6 +92,17 @@ namespace asio {
  * and @c pthread_sigmask(). For signals to be delivered, programs must ensure
  * that any signals registered using signal_set objects are unblocked in at
  * least one thread.
+ *
+ * @par Signal delivery using signalfd on Linux
+ *
+ * If @c ASIO_HAS_SIGNALFD is defined, signals are instead received through a
+ * @c signalfd owned by each execution context, and no signal handler is
+ * installed. A signal is only queued for the @c signalfd while it is blocked,
+ * so the masking rules above are reversed: adding a signal blocks it in the
+ * calling thread, and programs must ensure that it is also blocked in every
+ * other thread. This is most easily achieved by adding signals before any
+ * other threads are created, as new threads inherit the creator's signal mask.
+ * Flags other than flags::dont_care are not supported in this mode.
  */
 template <typename Executor = any_io_executor>
 class basic_signal_set : public signal_set_base
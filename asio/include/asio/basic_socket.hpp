@@ -19,6 +19,7 @@
 #include "asio/any_io_executor.hpp"
 #include "asio/detail/config.hpp"
 #include "asio/async_result.hpp"
+#include "asio/detail/accepted_socket_access.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/io_object_impl.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
@@ -325,6 +326,9 @@ public:
   template <typename Protocol1, typename Executor1>
   friend class basic_socket;
 
+  // Accept operations adopt new connections directly into the implementation.
+  friend class detail::accepted_socket_access;
+
   /// Move-construct a basic_socket from a socket of another protocol type.
   /**
    * This constructor moves a socket from one object to another.
@@ -695,6 +695,106 @@ public:
   }
 #endif // !defined(ASIO_NO_DEPRECATED)
 
+  /// Change the timer's expiry time as an absolute time, without cancelling
+  /// pending waits.
+  /**
+   * This function sets the expiry time. Unlike expires_at(), any pending
+   * asynchronous wait operations are not cancelled, and will complete when the
+   * new expiry time is reached. This suits idle timeouts that are pushed back
+   * whenever activity occurs.
+   *
+   * Moving the expiry time later does not acquire the scheduler's lock. The
+   * timer keeps its position in the scheduler's queue until its previous
+   * expiry time is reached, at which point it is moved to its new position
+   * rather than completed. Moving the expiry time earlier reschedules the
+   * timer immediately.
+   *
+   * @param expiry_time The expiry time to be used for the timer.
+   *
+   * @note If the timer has already expired when refresh_expires_at() is
+   * called, then the handlers for asynchronous wait operations will:
+   *
+   * @li have already been invoked; or
+   *
+   * @li have been queued for invocation in the near future.
+   *
+   * These handlers are passed an error code that indicates the successful
+   * completion of the wait operation, and may compare expiry() against the
+   * clock to detect that the timer was refreshed.
+   */
+  void refresh_expires_at(const time_point& expiry_time)
+  {
+    impl_.get_service().refresh(impl_.get_implementation(), expiry_time);
+  }
+
+  /// Change the timer's expiry time relative to now, without cancelling
+  /// pending waits.
+  /**
+   * This function sets the expiry time. Any pending asynchronous wait
+   * operations are not cancelled, and will complete when the new expiry time
+   * is reached. See refresh_expires_at() for details.
+   *
+   * @param expiry_time The expiry time to be used for the timer.
+   *
+   * @par Example
+   * Pushing back an idle timeout whenever data is received:
+   * @code
+   * void on_read(const asio::error_code& error, std::size_t n)
+   * {
+   *   if (!error)
+   *   {
+   *     idle_timer.refresh_expires_after(std::chrono::seconds(30));
+   *     ...
+   *   }
+   * }
+   * @endcode
+   */
+  void refresh_expires_after(const duration& expiry_time)
+  {
+    impl_.get_service().refresh_after(
+        impl_.get_implementation(), expiry_time);
+  }
+
+  /// Get the timer's slack.
+  /**
+   * This function may be used to obtain the amount by which asynchronous wait
+   * operations on the timer are permitted to complete after the expiry time.
+   */
+  duration slack() const
+  {
+    return impl_.get_service().slack(impl_.get_implementation());
+  }
+
+  /// Set the timer's slack.
+  /**
+   * This function sets the amount by which asynchronous wait operations on
+   * the timer are permitted to complete after the expiry time. Waits started
+   * after the call are scheduled at the expiry time rounded up to the next
+   * multiple of the slack, measured from the clock's epoch. Timers that share
+   * a slack value and expire close together are then dispatched by a single
+   * wakeup, and adding such a timer rarely requires the reactor's timeout to
+   * be reprogrammed.
+   *
+   * The default slack is zero, meaning that waits complete as soon as
+   * possible after the expiry time. The slack has no effect on blocking
+   * waits, or on clocks whose duration is not an integral type.
+   *
+   * @param slack_time The slack to be used for the timer.
+   *
+   * @par Example
+   * Idle timeouts that tolerate up to 10 milliseconds of lateness:
+   * @code
+   * asio::steady_timer timer(my_context);
+   * timer.slack(std::chrono::milliseconds(10));
+   * timer.expires_after(std::chrono::seconds(30));
+   * timer.async_wait(handler);
+   * @endcode
+   */
+  void slack(const duration& slack_time)
+  {
+    impl_.get_service().slack(impl_.get_implementation(), slack_time);
+  }
+
   /// Perform a blocking wait on the timer.
   /**
    * This function is used to wait for the timer to expire. This function
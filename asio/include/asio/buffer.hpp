@@ -2181,7 +2181,8 @@ private:
 /** @defgroup dynamic_buffer asio::dynamic_buffer
  *
  * @brief The asio::dynamic_buffer function is used to create a
- * dynamically resized buffer from a @c std::basic_string or @c std::vector.
+ * dynamically resized buffer from a @c std::basic_string, a @c std::vector,
+ * or an asio::ring_buffer.
  */
 /*@{*/
 
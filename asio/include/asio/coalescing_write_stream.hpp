@@ -0,0 +1,400 @@
+//
+// coalescing_write_stream.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_COALESCING_WRITE_STREAM_HPP
+#define ASIO_COALESCING_WRITE_STREAM_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/buffer.hpp"
+#include "asio/detail/coalescing_write_op.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error.hpp"
+#include "asio/post.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Adds write coalescing to the asynchronous write operations of a stream.
+/**
+ * The coalescing_write_stream class template can be used to combine many small
+ * asynchronous write operations into a few writes on the next layer. Any
+ * number of async_write_some operations may be outstanding at once. They are
+ * queued in the order they are started and their data is written to the next
+ * layer in that order.
+ *
+ * The data is not copied. Each queued operation holds a copy of its buffer
+ * sequence, and the buffers of consecutive operations are gathered into a
+ * single scatter/gather write of up to
+ * detail::buffer_sequence_adapter_base::max_buffers buffers.
+ *
+ * Writes are corked automatically. When a write is started on an idle stream,
+ * the flush is posted to the stream's executor, so that all writes started
+ * before the current handler returns are sent together. While a write to the
+ * next layer is in progress, further writes are queued and are sent as soon as
+ * it completes.
+ *
+ * An async_write_some operation completes only when all of its data has been
+ * written, or when an error occurs. Should a write to the next layer fail,
+ * all queued operations complete with the error and the number of bytes of
+ * their data that had already been written.
+ *
+ * The synchronous write_some functions write directly to the next layer and
+ * must not be used while asynchronous write operations are outstanding.
+ * Queued operations cannot be cancelled individually; closing the next layer
+ * causes them to complete with an error.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe. The application must also ensure that the
+ * stream's handlers are not run concurrently, for example by using a strand
+ * or a single-threaded io_context.
+ *
+ * @par Concepts:
+ * AsyncReadStream, AsyncWriteStream, Stream, SyncReadStream, SyncWriteStream.
+ */
+template <typename Stream>
+class coalescing_write_stream
+  : private noncopyable
+{
+private:
+  class initiate_async_write_some;
+
+public:
+  /// The type of the next layer.
+  typedef remove_reference_t<Stream> next_layer_type;
+
+  /// The type of the lowest layer.
+  typedef typename next_layer_type::lowest_layer_type lowest_layer_type;
+
+  /// The type of the executor associated with the object.
+  typedef typename lowest_layer_type::executor_type executor_type;
+
+  /// Construct, passing the specified argument to initialise the next layer.
+  template <typename Arg>
+  explicit coalescing_write_stream(Arg&& a)
+    : next_layer_(static_cast<Arg&&>(a)),
+      buffer_count_(0),
+      flushing_(false)
+  {
+  }
+
+  /// Destructor.
+  /**
+   * Destroys any queued write operations without invoking their handlers. The
+   * stream must not be destroyed while a flush or a write to the next layer is
+   * in progress.
+   */
+  ~coalescing_write_stream()
+  {
+  }
+
+  /// Get a reference to the next layer.
+  next_layer_type& next_layer()
+  {
+    return next_layer_;
+  }
+
+  /// Get a reference to the lowest layer.
+  lowest_layer_type& lowest_layer()
+  {
+    return next_layer_.lowest_layer();
+  }
+
+  /// Get a const reference to the lowest layer.
+  const lowest_layer_type& lowest_layer() const
+  {
+    return next_layer_.lowest_layer();
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() noexcept
+  {
+    return next_layer_.lowest_layer().get_executor();
+  }
+
+  /// Close the stream.
+  void close()
+  {
+    next_layer_.close();
+  }
+
+  /// Close the stream.
+  ASIO_SYNC_OP_VOID close(asio::error_code& ec)
+  {
+    next_layer_.close(ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Write the given data directly to the next layer. Returns the number of
+  /// bytes written. Throws an exception on failure.
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers)
+  {
+    return next_layer_.write_some(buffers);
+  }
+
+  /// Write the given data directly to the next layer. Returns the number of
+  /// bytes written, or 0 if an error occurred.
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    return next_layer_.write_some(buffers, ec);
+  }
+
+  /// Start an asynchronous write. The data being written must be valid for the
+  /// lifetime of the asynchronous operation.
+  /**
+   * The data is queued behind any outstanding writes, and the operation
+   * completes once all of it has been written to the next layer.
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_write_some(const ConstBufferSequence& buffers,
+      WriteToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WriteToken,
+        void (asio::error_code, std::size_t)>(
+          declval<initiate_async_write_some>(), token, buffers))
+  {
+    return async_initiate<WriteToken,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_write_some(this), token, buffers);
+  }
+
+  /// Read some data from the stream. Returns the number of bytes read. Throws
+  /// an exception on failure.
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers)
+  {
+    return next_layer_.read_some(buffers);
+  }
+
+  /// Read some data from the stream. Returns the number of bytes read or 0 if
+  /// an error occurred.
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    return next_layer_.read_some(buffers, ec);
+  }
+
+  /// Start an asynchronous read. The buffer into which the data will be read
+  /// must be valid for the lifetime of the asynchronous operation.
+  /**
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler = default_completion_token_t<executor_type>>
+  auto async_read_some(const MutableBufferSequence& buffers,
+      ReadHandler&& handler = default_completion_token_t<executor_type>())
+    -> decltype(
+      declval<conditional_t<true, Stream&, ReadHandler>>().async_read_some(
+        buffers, static_cast<ReadHandler&&>(handler)))
+  {
+    return next_layer_.async_read_some(buffers,
+        static_cast<ReadHandler&&>(handler));
+  }
+
+private:
+  typedef detail::coalescing_write_op_base op_base;
+
+  class initiate_async_write_some
+  {
+  public:
+    typedef typename coalescing_write_stream::executor_type executor_type;
+
+    explicit initiate_async_write_some(coalescing_write_stream* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(WriteHandler&& handler,
+        const ConstBufferSequence& buffers) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->start_write_op(buffers, handler2.value);
+    }
+
+  private:
+    coalescing_write_stream* self_;
+  };
+
+  class flush_handler
+  {
+  public:
+    explicit flush_handler(coalescing_write_stream* self)
+      : self_(self)
+    {
+    }
+
+    void operator()()
+    {
+      self_->start_flush();
+    }
+
+  private:
+    coalescing_write_stream* self_;
+  };
+
+  class write_handler
+  {
+  public:
+    explicit write_handler(coalescing_write_stream* self)
+      : self_(self)
+    {
+    }
+
+    void operator()(const asio::error_code& ec, std::size_t bytes_transferred)
+    {
+      self_->handle_write(ec, bytes_transferred);
+    }
+
+  private:
+    coalescing_write_stream* self_;
+  };
+
+  // Queue a write operation, posting a flush if the stream is idle.
+  template <typename ConstBufferSequence, typename Handler>
+  void start_write_op(const ConstBufferSequence& buffers, Handler& handler)
+  {
+    // Allocate and construct an operation to wrap the handler.
+    typedef detail::coalescing_write_op<
+      ConstBufferSequence, Handler, executor_type> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(buffers, handler, get_executor());
+
+    queue_.push(p.p);
+    p.v = p.p = 0;
+
+    if (!flushing_)
+    {
+      flushing_ = true;
+      asio::post(get_executor(), flush_handler(this));
+    }
+  }
+
+  // Gather the buffers of the queued operations and write them to the next
+  // layer.
+  void start_flush()
+  {
+    buffer_count_ = 0;
+    for (op_base* op = queue_.front(); op;
+        op = detail::op_queue_access::next(op))
+    {
+      if (!op->gather(buffers_, buffer_count_))
+        break;
+    }
+
+    if (buffer_count_ == 0)
+    {
+      // The queued operations have no data left to write.
+      handle_write(asio::error_code(), 0);
+    }
+    else
+    {
+      next_layer_.async_write_some(
+          detail::coalesced_buffers(buffers_, buffer_count_),
+          write_handler(this));
+    }
+  }
+
+  // Consume the bytes written from the queued operations, start the next
+  // write, and then complete the operations that have finished. No member is
+  // accessed once the first handler has been invoked.
+  void handle_write(const asio::error_code& ec, std::size_t bytes_transferred)
+  {
+    detail::op_queue<op_base> completed;
+    while (op_base* op = queue_.front())
+    {
+      std::size_t remaining = op->remaining();
+      if (remaining > bytes_transferred)
+      {
+        op->consume(bytes_transferred);
+        break;
+      }
+      op->consume(remaining);
+      bytes_transferred -= remaining;
+      queue_.pop();
+      completed.push(op);
+    }
+
+    detail::op_queue<op_base> failed;
+    if (ec)
+      failed.push(queue_);
+
+    if (queue_.empty())
+      flushing_ = false;
+    else
+      start_flush();
+
+    while (op_base* op = completed.front())
+    {
+      completed.pop();
+      op->complete(asio::error_code());
+    }
+
+    while (op_base* op = failed.front())
+    {
+      failed.pop();
+      op->complete(ec);
+    }
+  }
+
+  // The next layer.
+  Stream next_layer_;
+
+  // The write operations that have not yet completed, in the order in which
+  // they were started.
+  detail::op_queue<op_base> queue_;
+
+  // The buffers being written to the next layer.
+  const_buffer buffers_[detail::coalesced_buffers::max_buffers];
+  std::size_t buffer_count_;
+
+  // Whether a flush has been posted or a write to the next layer is in
+  // progress.
+  bool flushing_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_COALESCING_WRITE_STREAM_HPP
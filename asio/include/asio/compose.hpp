@@ -21,6 +21,7 @@
 #include "asio/detail/base_from_cancellation_state.hpp"
 #include "asio/detail/composed_work.hpp"
 #include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/reusable_op_memory.hpp"
 #include "asio/detail/type_traits.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -46,7 +47,9 @@ public:
       impl_(static_cast<I&&>(impl)),
       work_(static_cast<W&&>(work)),
       handler_(static_cast<H&&>(handler)),
-      invocations_(0)
+      invocations_(0),
+      memory_((get_associated_allocator)(handler_, std::allocator<void>()),
+          sizeof(*this))
   {
   }
 
@@ -56,7 +59,8 @@ public:
       impl_(static_cast<Impl&&>(other.impl_)),
       work_(static_cast<Work&&>(other.work_)),
       handler_(static_cast<Handler&&>(other.handler_)),
-      invocations_(other.invocations_)
+      invocations_(other.invocations_),
+      memory_(static_cast<reusable_op_memory&&>(other.memory_))
   {
   }
 
@@ -75,11 +79,13 @@ public:
     return (get_associated_executor)(handler_, work_.head_.get_executor());
   }
 
-  typedef associated_allocator_t<Handler, std::allocator<void>> allocator_type;
+  typedef reusable_op_allocator<void,
+      associated_allocator_t<Handler, std::allocator<void>>> allocator_type;
 
   allocator_type get_allocator() const noexcept
   {
-    return (get_associated_allocator)(handler_, std::allocator<void>());
+    return allocator_type(memory_,
+        (get_associated_allocator)(handler_, std::allocator<void>()));
   }
 
   template<typename... T>
@@ -94,6 +100,7 @@ public:
   void complete(Args... args)
   {
     this->work_.reset();
+    this->memory_.reset();
     static_cast<Handler&&>(this->handler_)(static_cast<Args&&>(args)...);
   }
 
@@ -128,6 +135,7 @@ public:
   Work work_;
   Handler handler_;
   unsigned invocations_;
+  reusable_op_memory memory_;
 };
 
 template <typename Impl, typename Work, typename Handler, typename Signature>
@@ -225,6 +233,13 @@ struct associator<Associator,
  * @param io_objects_or_executors Zero or more I/O objects or I/O executors for
  * which outstanding work must be maintained.
  *
+ * @par Allocation
+ * The composed operation allocates a single block of memory, using the
+ * completion handler's associated allocator, when it is launched. The
+ * intermediate asynchronous operations started by the implementation reuse
+ * this block in turn, provided only one is outstanding at a time. The block is
+ * deallocated before the completion handler is invoked.
+ *
  * @par Per-Operation Cancellation
  * By default, terminal per-operation cancellation is enabled for
  * composed operations that are implemented using @c async_compose. To
@@ -17,8 +17,10 @@
 
 #include "asio/detail/config.hpp"
 #include <tuple>
+#include "asio/associated_allocator.hpp"
 #include "asio/associator.hpp"
 #include "asio/async_result.hpp"
+#include "asio/detail/reusable_op_memory.hpp"
 #include "asio/detail/type_traits.hpp"
 #include "asio/detail/utility.hpp"
 
@@ -80,6 +82,40 @@ public:
   Tail tail_;
 };
 
+// Completion handler for an entire deferred sequence. The handler owns a block
+// of memory that is reused by the asynchronous operation of each stage in turn,
+// so that running the sequence performs a single allocation.
+template <typename Handler>
+class deferred_sequence_state_handler
+{
+public:
+  template <typename H>
+  explicit deferred_sequence_state_handler(H&& handler, std::size_t size)
+    : handler_(static_cast<H&&>(handler)),
+      memory_((get_associated_allocator)(handler_), size)
+  {
+  }
+
+  typedef reusable_op_allocator<void,
+      associated_allocator_t<Handler>> allocator_type;
+
+  allocator_type get_allocator() const noexcept
+  {
+    return allocator_type(memory_, (get_associated_allocator)(handler_));
+  }
+
+  template <typename... Args>
+  void operator()(Args&&... args)
+  {
+    memory_.reset();
+    static_cast<Handler&&>(handler_)(static_cast<Args&&>(args)...);
+  }
+
+//private:
+  Handler handler_;
+  reusable_op_memory memory_;
+};
+
 template <typename Head, typename Tail, typename... Signatures>
 class deferred_sequence_base
 {
@@ -88,11 +124,32 @@ private:
   {
     template <typename Handler>
     void operator()(Handler&& handler, Head head, Tail&& tail)
+    {
+      this->start(static_cast<Handler&&>(handler), head, tail,
+          is_reusable_op_allocator<
+            associated_allocator_t<decay_t<Handler>>>());
+    }
+
+    // The handler already provides memory for reuse, as happens when this
+    // sequence is a stage of an enclosing sequence or composed operation.
+    template <typename Handler>
+    void start(Handler&& handler, Head& head, Tail& tail, true_type)
     {
       static_cast<Head&&>(head)(
           deferred_sequence_handler<decay_t<Handler>, decay_t<Tail>>(
             static_cast<Handler&&>(handler), static_cast<Tail&&>(tail)));
     }
+
+    template <typename Handler>
+    void start(Handler&& handler, Head& head, Tail& tail, false_type)
+    {
+      typedef deferred_sequence_state_handler<decay_t<Handler>> state_handler;
+      static_cast<Head&&>(head)(
+          deferred_sequence_handler<state_handler, decay_t<Tail>>(
+            state_handler(static_cast<Handler&&>(handler),
+              sizeof(deferred_sequence_handler<state_handler, decay_t<Tail>>)),
+            static_cast<Tail&&>(tail)));
+    }
   };
 
   Head head_;
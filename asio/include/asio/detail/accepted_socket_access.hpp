@@ -0,0 +1,48 @@
+//
+// detail/accepted_socket_access.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_ACCEPTED_SOCKET_ACCESS_HPP
+#define ASIO_DETAIL_ACCEPTED_SOCKET_ACCESS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/socket_types.hpp"
+#include "asio/error_code.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Gives the accept operations access to a peer socket's implementation, so
+// that a descriptor already created non-blocking and close-on-exec can be
+// adopted without repeating that work.
+class accepted_socket_access
+{
+public:
+  template <typename Socket>
+  static asio::error_code assign(Socket& peer,
+      const typename Socket::protocol_type& protocol,
+      socket_type new_socket, asio::error_code& ec)
+  {
+    return peer.impl_.get_service().assign_accepted(
+        peer.impl_.get_implementation(), protocol, new_socket, ec);
+  }
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_ACCEPTED_SOCKET_ACCESS_HPP
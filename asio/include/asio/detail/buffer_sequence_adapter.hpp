@@ -33,9 +33,13 @@ public:
   // The maximum number of buffers to support in a single operation.
   enum { max_buffers = 1 };
 
-protected:
+  // The maximum number of buffers held within the adapter itself.
+  enum { max_inline_buffers = max_buffers };
+
   typedef Windows::Storage::Streams::IBuffer^ native_buffer_type;
 
+protected:
+
   ASIO_DECL static void init_native_buffer(
       native_buffer_type& buf,
       const asio::mutable_buffer& buffer);
@@ -48,9 +52,13 @@ public:
   // The maximum number of buffers to support in a single operation.
   enum { max_buffers = 64 < max_iov_len ? 64 : max_iov_len };
 
-protected:
+  // The maximum number of buffers held within the adapter itself.
+  enum { max_inline_buffers = max_buffers };
+
   typedef WSABUF native_buffer_type;
 
+protected:
+
   static void init_native_buffer(WSABUF& buf,
       const asio::mutable_buffer& buffer)
   {
@@ -67,11 +75,20 @@ protected:
 #else // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
 public:
   // The maximum number of buffers to support in a single operation.
+# if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+  enum { max_buffers = 1024 < max_iov_len ? 1024 : max_iov_len };
+# else // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
   enum { max_buffers = 64 < max_iov_len ? 64 : max_iov_len };
+# endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+
+  // The maximum number of buffers held within the adapter itself. Up to
+  // max_buffers may be used when the operation supplies the storage.
+  enum { max_inline_buffers = 64 < max_buffers ? 64 : max_buffers };
 
-protected:
   typedef iovec native_buffer_type;
 
+protected:
+
   static void init_iov_base(void*& base, void* addr)
   {
     base = addr;
@@ -110,15 +127,36 @@ public:
 
   explicit buffer_sequence_adapter(const Buffers& buffer_sequence)
     : count_(0), total_buffer_size_(0)
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+      , storage_(0)
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
   {
     buffer_sequence_adapter::init(
         asio::buffer_sequence_begin(buffer_sequence),
-        asio::buffer_sequence_end(buffer_sequence));
+        asio::buffer_sequence_end(buffer_sequence), max_inline_buffers);
   }
 
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+  // Construct using storage, owned by the operation, for up to the specified
+  // number of buffers. The adapter's own storage is used if none is supplied.
+  buffer_sequence_adapter(const Buffers& buffer_sequence,
+      native_buffer_type* storage, std::size_t storage_size)
+    : count_(0), total_buffer_size_(0), storage_(storage)
+  {
+    buffer_sequence_adapter::init(
+        asio::buffer_sequence_begin(buffer_sequence),
+        asio::buffer_sequence_end(buffer_sequence),
+        storage ? storage_size : std::size_t(max_inline_buffers));
+  }
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+
   native_buffer_type* buffers()
   {
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+    return storage_ ? storage_ : buffers_;
+#else // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
     return buffers_;
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
   }
 
   std::size_t count() const
@@ -174,13 +212,14 @@ public:
 
 private:
   template <typename Iterator>
-  void init(Iterator begin, Iterator end)
+  void init(Iterator begin, Iterator end, std::size_t max_count)
   {
+    native_buffer_type* bufs = buffers();
     Iterator iter = begin;
-    for (; iter != end && count_ < max_buffers; ++iter, ++count_)
+    for (; iter != end && count_ < max_count; ++iter, ++count_)
     {
       Buffer buffer(*iter);
-      init_native_buffer(buffers_[count_], buffer);
+      init_native_buffer(bufs[count_], buffer);
       total_buffer_size_ += buffer.size();
     }
   }
@@ -244,9 +283,12 @@ private:
     return Buffer(storage.data(), storage.size() - unused_storage.size());
   }
 
-  native_buffer_type buffers_[max_buffers];
+  native_buffer_type buffers_[max_inline_buffers];
   std::size_t count_;
   std::size_t total_buffer_size_;
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+  native_buffer_type* storage_;
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
 };
 
 template <typename Buffer>
@@ -264,6 +306,14 @@ public:
     total_buffer_size_ = buffer_sequence.size();
   }
 
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+  buffer_sequence_adapter(const asio::mutable_buffer& buffer_sequence,
+      native_buffer_type*, std::size_t)
+    : buffer_sequence_adapter(buffer_sequence)
+  {
+  }
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+
   native_buffer_type* buffers()
   {
     return &buffer_;
@@ -332,6 +382,14 @@ public:
     total_buffer_size_ = buffer_sequence.size();
   }
 
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+  buffer_sequence_adapter(const asio::const_buffer& buffer_sequence,
+      native_buffer_type*, std::size_t)
+    : buffer_sequence_adapter(buffer_sequence)
+  {
+  }
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+
   native_buffer_type* buffers()
   {
     return &buffer_;
@@ -402,6 +460,15 @@ public:
     total_buffer_size_ = buffer_sequence.size();
   }
 
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+  buffer_sequence_adapter(
+      const asio::mutable_buffers_1& buffer_sequence,
+      native_buffer_type*, std::size_t)
+    : buffer_sequence_adapter(buffer_sequence)
+  {
+  }
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+
   native_buffer_type* buffers()
   {
     return &buffer_;
@@ -470,6 +537,15 @@ public:
     total_buffer_size_ = buffer_sequence.size();
   }
 
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+  buffer_sequence_adapter(
+      const asio::const_buffers_1& buffer_sequence,
+      native_buffer_type*, std::size_t)
+    : buffer_sequence_adapter(buffer_sequence)
+  {
+  }
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+
   native_buffer_type* buffers()
   {
     return &buffer_;
@@ -541,6 +617,15 @@ public:
     registered_id_ = buffer_sequence.id();
   }
 
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+  buffer_sequence_adapter(
+      const asio::mutable_registered_buffer& buffer_sequence,
+      native_buffer_type*, std::size_t)
+    : buffer_sequence_adapter(buffer_sequence)
+  {
+  }
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+
   native_buffer_type* buffers()
   {
     return &buffer_;
@@ -615,6 +700,15 @@ public:
     registered_id_ = buffer_sequence.id();
   }
 
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+  buffer_sequence_adapter(
+      const asio::const_registered_buffer& buffer_sequence,
+      native_buffer_type*, std::size_t)
+    : buffer_sequence_adapter(buffer_sequence)
+  {
+  }
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+
   native_buffer_type* buffers()
   {
     return &buffer_;
@@ -689,6 +783,14 @@ public:
     total_buffer_size_ = buffer_sequence[0].size() + buffer_sequence[1].size();
   }
 
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+  buffer_sequence_adapter(const boost::array<Elem, 2>& buffer_sequence,
+      native_buffer_type*, std::size_t)
+    : buffer_sequence_adapter(buffer_sequence)
+  {
+  }
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+
   native_buffer_type* buffers()
   {
     return buffers_;
@@ -765,6 +867,14 @@ public:
     total_buffer_size_ = buffer_sequence[0].size() + buffer_sequence[1].size();
   }
 
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+  buffer_sequence_adapter(const std::array<Elem, 2>& buffer_sequence,
+      native_buffer_type*, std::size_t)
+    : buffer_sequence_adapter(buffer_sequence)
+  {
+  }
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+
   native_buffer_type* buffers()
   {
     return buffers_;
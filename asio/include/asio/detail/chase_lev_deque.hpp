@@ -0,0 +1,192 @@
+//
+// detail/chase_lev_deque.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_CHASE_LEV_DEQUE_HPP
+#define ASIO_DETAIL_CHASE_LEV_DEQUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A lock-free work stealing deque of pointers, as described by Chase and Lev
+// in "Dynamic Circular Work-Stealing Deque", using the memory orderings given
+// by Le et al. in "Correct and Efficient Work-Stealing for Weak Memory Models".
+//
+// Only the owning thread may call push() and pop(), which operate on the
+// bottom of the deque in LIFO order. Any thread may call steal(), which takes
+// from the top of the deque in FIFO order. The deque grows as required. Arrays
+// that are replaced when growing may still be read by concurrent thieves, and
+// so are kept until the deque is destroyed.
+template <typename T>
+class chase_lev_deque
+  : private noncopyable
+{
+public:
+  // Construct an empty deque. The initial capacity must be a power of two.
+  explicit chase_lev_deque(std::size_t capacity = 256)
+    : top_(0),
+      bottom_(0),
+      array_(new array(capacity, 0))
+  {
+  }
+
+  // Destructor. Pointers that remain in the deque are not destroyed.
+  ~chase_lev_deque()
+  {
+    array* a = array_.load(std::memory_order_relaxed);
+    while (a)
+    {
+      array* previous = a->previous_;
+      delete a;
+      a = previous;
+    }
+  }
+
+  // Add a value to the bottom of the deque. Owner only.
+  void push(T* value)
+  {
+    std::int64_t b = bottom_.load(std::memory_order_relaxed);
+    std::int64_t t = top_.load(std::memory_order_acquire);
+    array* a = array_.load(std::memory_order_relaxed);
+    if (b - t >= static_cast<std::int64_t>(a->capacity_))
+      a = grow(a, t, b);
+    a->put(b, value);
+    bottom_.store(b + 1, std::memory_order_release);
+  }
+
+  // Remove the most recently pushed value. Owner only. Returns null if the
+  // deque is empty.
+  T* pop()
+  {
+    std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    array* a = array_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_seq_cst);
+    std::int64_t t = top_.load(std::memory_order_seq_cst);
+
+    if (t > b)
+    {
+      // The deque was empty.
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return 0;
+    }
+
+    T* value = a->get(b);
+    if (t == b)
+    {
+      // This is the last value, so race with any thieves to take it.
+      if (!top_.compare_exchange_strong(t, t + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed))
+        value = 0;
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return value;
+  }
+
+  // Remove the least recently pushed value. May be called by any thread.
+  // Returns null if the deque is empty or if another thread took the value
+  // first.
+  T* steal()
+  {
+    std::int64_t t = top_.load(std::memory_order_seq_cst);
+    std::int64_t b = bottom_.load(std::memory_order_seq_cst);
+    if (t >= b)
+      return 0;
+
+    array* a = array_.load(std::memory_order_acquire);
+    T* value = a->get(t);
+    if (!top_.compare_exchange_strong(t, t + 1,
+          std::memory_order_seq_cst, std::memory_order_relaxed))
+      return 0;
+    return value;
+  }
+
+  // Determine whether the deque appears to be empty. The result is only a
+  // hint when other threads are accessing the deque.
+  bool empty() const
+  {
+    std::int64_t t = top_.load(std::memory_order_relaxed);
+    std::int64_t b = bottom_.load(std::memory_order_relaxed);
+    return t >= b;
+  }
+
+private:
+  // A circular array of values.
+  struct array
+  {
+    array(std::size_t capacity, array* previous)
+      : capacity_(capacity),
+        mask_(capacity - 1),
+        values_(new std::atomic<T*>[capacity]),
+        previous_(previous)
+    {
+    }
+
+    ~array()
+    {
+      delete[] values_;
+    }
+
+    T* get(std::int64_t i) const
+    {
+      return values_[static_cast<std::size_t>(i) & mask_].load(
+          std::memory_order_relaxed);
+    }
+
+    void put(std::int64_t i, T* value)
+    {
+      values_[static_cast<std::size_t>(i) & mask_].store(
+          value, std::memory_order_relaxed);
+    }
+
+    std::size_t capacity_;
+    std::size_t mask_;
+    std::atomic<T*>* values_;
+    array* previous_;
+  };
+
+  // Replace the array with one of twice the size. Owner only.
+  array* grow(array* a, std::int64_t t, std::int64_t b)
+  {
+    array* new_array = new array(a->capacity_ * 2, a);
+    for (std::int64_t i = t; i < b; ++i)
+      new_array->put(i, a->get(i));
+    array_.store(new_array, std::memory_order_release);
+    return new_array;
+  }
+
+  // The index of the next value to be stolen. The top and bottom indexes are
+  // kept apart so that thieves do not contend with the owner's cache line.
+  std::atomic<std::int64_t> top_;
+  char top_padding_[64 - sizeof(std::atomic<std::int64_t>)];
+
+  // The index at which the owner will push the next value.
+  std::atomic<std::int64_t> bottom_;
+
+  // The current array.
+  std::atomic<array*> array_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_CHASE_LEV_DEQUE_HPP
@@ -0,0 +1,224 @@
+//
+// detail/coalescing_write_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_COALESCING_WRITE_OP_HPP
+#define ASIO_DETAIL_COALESCING_WRITE_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/buffer.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/error_code.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// The buffers gathered from queued write operations for a single write to the
+// next layer. The buffers themselves are owned by the coalescing stream, so
+// that copying the sequence into the next layer's operation is cheap.
+class coalesced_buffers
+{
+public:
+  typedef const_buffer value_type;
+  typedef const const_buffer* const_iterator;
+
+  enum { max_buffers = buffer_sequence_adapter_base::max_buffers };
+
+  coalesced_buffers(const const_buffer* buffers, std::size_t count)
+    : begin_(buffers),
+      end_(buffers + count)
+  {
+  }
+
+  const_iterator begin() const
+  {
+    return begin_;
+  }
+
+  const_iterator end() const
+  {
+    return end_;
+  }
+
+private:
+  const const_buffer* begin_;
+  const const_buffer* end_;
+};
+
+// Base class for write operations queued on a coalescing stream. The caller's
+// buffer sequence is held by the operation and is never copied into an
+// intermediate buffer.
+class coalescing_write_op_base
+{
+public:
+  // Append the operation's unwritten buffers to the array. Returns false if
+  // the array was filled before all of the buffers could be added.
+  bool gather(const_buffer* buffers, std::size_t& count)
+  {
+    return gather_func_(this, buffers, count);
+  }
+
+  // Get the number of bytes that have been written.
+  std::size_t written() const
+  {
+    return written_;
+  }
+
+  // Get the number of bytes that have not yet been written.
+  std::size_t remaining() const
+  {
+    return size_ - written_;
+  }
+
+  // Record that the given number of bytes has been written.
+  void consume(std::size_t n)
+  {
+    written_ += n;
+  }
+
+  // Complete the operation with the number of bytes written so far.
+  void complete(const asio::error_code& ec)
+  {
+    complete_func_(this, &ec);
+  }
+
+  // Destroy the operation without invoking the handler.
+  void destroy()
+  {
+    complete_func_(this, 0);
+  }
+
+protected:
+  typedef bool (*gather_func_type)(
+      coalescing_write_op_base*, const_buffer*, std::size_t&);
+  typedef void (*complete_func_type)(
+      coalescing_write_op_base*, const asio::error_code*);
+
+  coalescing_write_op_base(gather_func_type gather_func,
+      complete_func_type complete_func, std::size_t size)
+    : next_(0),
+      gather_func_(gather_func),
+      complete_func_(complete_func),
+      size_(size),
+      written_(0)
+  {
+  }
+
+  // Prevents deletion through this type.
+  ~coalescing_write_op_base()
+  {
+  }
+
+private:
+  friend class op_queue_access;
+  coalescing_write_op_base* next_;
+  gather_func_type gather_func_;
+  complete_func_type complete_func_;
+  std::size_t size_;
+  std::size_t written_;
+};
+
+template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+class coalescing_write_op : public coalescing_write_op_base
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(coalescing_write_op);
+
+  coalescing_write_op(const ConstBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+    : coalescing_write_op_base(&coalescing_write_op::do_gather,
+        &coalescing_write_op::do_complete, asio::buffer_size(buffers)),
+      buffers_(buffers),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static bool do_gather(coalescing_write_op_base* base,
+      const_buffer* buffers, std::size_t& count)
+  {
+    coalescing_write_op* o(static_cast<coalescing_write_op*>(base));
+    return gather_range(asio::buffer_sequence_begin(o->buffers_),
+        asio::buffer_sequence_end(o->buffers_), o->written(), buffers, count);
+  }
+
+  static void do_complete(coalescing_write_op_base* base,
+      const asio::error_code* ec)
+  {
+    // Take ownership of the operation object.
+    coalescing_write_op* o(static_cast<coalescing_write_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    if (ec)
+    {
+      // Take ownership of the operation's outstanding work.
+      handler_work<Handler, IoExecutor> w(
+          static_cast<handler_work<Handler, IoExecutor>&&>(
+            o->work_));
+
+      // Make a copy of the handler so that the memory can be deallocated
+      // before the upcall is made. Even if we're not about to make an upcall,
+      // a sub-object of the handler may be the true owner of the memory
+      // associated with the handler. Consequently, a local copy of the handler
+      // is required to ensure that any owning sub-object remains valid until
+      // after we have deallocated the memory here.
+      detail::binder2<Handler, asio::error_code, std::size_t>
+        handler(o->handler_, *ec, o->written());
+      p.h = asio::detail::addressof(handler.handler_);
+      p.reset();
+
+      w.complete(handler, handler.handler_);
+    }
+  }
+
+private:
+  template <typename Iterator>
+  static bool gather_range(Iterator begin, Iterator end,
+      std::size_t skip, const_buffer* buffers, std::size_t& count)
+  {
+    for (Iterator iter = begin; iter != end; ++iter)
+    {
+      const_buffer b(*iter);
+      if (skip >= b.size())
+      {
+        skip -= b.size();
+        continue;
+      }
+      b += skip;
+      skip = 0;
+      if (count == coalesced_buffers::max_buffers)
+        return false;
+      buffers[count++] = b;
+    }
+    return true;
+  }
+
+  ConstBufferSequence buffers_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_COALESCING_WRITE_OP_HPP
@@ -856,6 +856,25 @@
 #   define ASIO_HAS_VM_SOCKETS 1
 #  endif // LINUX_VERSION_CODE >= KERNEL_VERSION(5,6,0)
 # endif // !defined(ASIO_HAS_VM_SOCKETS)
+# if !defined(ASIO_HAS_SPLICE)
+#  if !defined(ASIO_DISABLE_SPLICE)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,17)
+#    define ASIO_HAS_SPLICE 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,17)
+#  endif // !defined(ASIO_DISABLE_SPLICE)
+# endif // !defined(ASIO_HAS_SPLICE)
+# if !defined(ASIO_HAS_ACCEPT4)
+#  if !defined(ASIO_DISABLE_ACCEPT4)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,28)
+#    define ASIO_HAS_ACCEPT4 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,28)
+#  endif // !defined(ASIO_DISABLE_ACCEPT4)
+# endif // !defined(ASIO_HAS_ACCEPT4)
+# if defined(ASIO_HAS_SIGNALFD)
+#  if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
+#   error Linux kernel 2.6.27 or later is required to support signalfd
+#  endif // LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
+# endif // defined(ASIO_HAS_SIGNALFD)
 #endif // defined(__linux__)
 
 // Linux: io_uring is used instead of epoll.
@@ -966,6 +985,19 @@
 # endif // !defined(ASIO_DISABLE_LOCAL_SOCKETS)
 #endif // !defined(ASIO_HAS_LOCAL_SOCKETS)
 
+// Ring buffers using memory that is mapped twice, back-to-back.
+#if !defined(ASIO_HAS_RING_BUFFER)
+# if !defined(ASIO_DISABLE_RING_BUFFER)
+#  if !defined(ASIO_WINDOWS) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(__CYGWIN__)
+#   define ASIO_HAS_RING_BUFFER 1
+#  endif // !defined(ASIO_WINDOWS)
+         //   && !defined(ASIO_WINDOWS_RUNTIME)
+         //   && !defined(__CYGWIN__)
+# endif // !defined(ASIO_DISABLE_RING_BUFFER)
+#endif // !defined(ASIO_HAS_RING_BUFFER)
+
 // Files.
 #if !defined(ASIO_HAS_FILE)
 # if !defined(ASIO_DISABLE_FILE)
@@ -1424,4 +1456,39 @@
 # endif // !defined(ASIO_DISABLE_SNPRINTF)
 #endif // !defined(ASIO_HAS_SNPRINTF)
 
+// Compiler support for SSE2 intrinsics.
+#if !defined(ASIO_HAS_SSE2)
+# if !defined(ASIO_DISABLE_SSE2)
+#  if defined(__SSE2__)
+#   define ASIO_HAS_SSE2 1
+#  elif defined(ASIO_MSVC)
+#   if defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#    define ASIO_HAS_SSE2 1
+#   endif // defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#  endif // defined(ASIO_MSVC)
+# endif // !defined(ASIO_DISABLE_SSE2)
+#endif // !defined(ASIO_HAS_SSE2)
+
+// Compiler support for AVX2 code paths that are selected at runtime, without
+// requiring the whole program to be compiled for AVX2.
+#if !defined(ASIO_HAS_AVX2)
+# if !defined(ASIO_DISABLE_AVX2)
+#  if defined(ASIO_HAS_SSE2)
+#   if defined(__clang__)
+#    if (__clang_major__ >= 4)
+#     define ASIO_HAS_AVX2 1
+#    endif // (__clang_major__ >= 4)
+#   elif defined(__GNUC__)
+#    if (__GNUC__ >= 5)
+#     define ASIO_HAS_AVX2 1
+#    endif // (__GNUC__ >= 5)
+#   elif defined(ASIO_MSVC)
+#    if (_MSC_VER >= 1800)
+#     define ASIO_HAS_AVX2 1
+#    endif // (_MSC_VER >= 1800)
+#   endif // defined(ASIO_MSVC)
+#  endif // defined(ASIO_HAS_SSE2)
+# endif // !defined(ASIO_DISABLE_AVX2)
+#endif // !defined(ASIO_HAS_AVX2)
+
 #endif // ASIO_DETAIL_CONFIG_HPP
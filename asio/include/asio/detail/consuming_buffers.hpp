@@ -53,7 +53,12 @@ struct prepared_buffers
   typedef Buffer value_type;
   typedef const Buffer* const_iterator;
 
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+  enum { max_buffers = MaxBuffers < buffer_sequence_adapter_base::max_buffers
+    ? MaxBuffers : std::size_t(buffer_sequence_adapter_base::max_buffers) };
+#else // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
   enum { max_buffers = MaxBuffers < 16 ? MaxBuffers : 16 };
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
 
   prepared_buffers() : count(0) {}
   const_iterator begin() const { return elems; }
@@ -22,6 +22,7 @@
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
 #include "asio/detail/bind_handler.hpp"
+#include "asio/detail/chrono_time_traits.hpp"
 #include "asio/detail/fenced_block.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/noncopyable.hpp"
@@ -30,6 +31,7 @@
 #include "asio/detail/timer_queue.hpp"
 #include "asio/detail/timer_queue_ptime.hpp"
 #include "asio/detail/timer_scheduler.hpp"
+#include "asio/detail/type_traits.hpp"
 #include "asio/detail/wait_handler.hpp"
 #include "asio/detail/wait_op.hpp"
 
@@ -60,6 +62,8 @@ public:
     : private asio::detail::noncopyable
   {
     time_type expiry;
+    time_type scheduled_expiry;
+    duration_type slack;
     bool might_have_pending_waits;
     typename timer_queue<Time_Traits>::per_timer_data timer_data;
   };
@@ -89,6 +93,8 @@ public:
   void construct(implementation_type& impl)
   {
     impl.expiry = time_type();
+    impl.scheduled_expiry = time_type();
+    impl.slack = duration_type();
     impl.might_have_pending_waits = false;
   }
 
@@ -108,6 +114,12 @@ public:
     impl.expiry = other_impl.expiry;
     other_impl.expiry = time_type();
 
+    impl.scheduled_expiry = other_impl.scheduled_expiry;
+    other_impl.scheduled_expiry = time_type();
+
+    impl.slack = other_impl.slack;
+    other_impl.slack = duration_type();
+
     impl.might_have_pending_waits = other_impl.might_have_pending_waits;
     other_impl.might_have_pending_waits = false;
   }
@@ -127,6 +139,12 @@ public:
     impl.expiry = other_impl.expiry;
     other_impl.expiry = time_type();
 
+    impl.scheduled_expiry = other_impl.scheduled_expiry;
+    other_impl.scheduled_expiry = time_type();
+
+    impl.slack = other_impl.slack;
+    other_impl.slack = duration_type();
+
     impl.might_have_pending_waits = other_impl.might_have_pending_waits;
     other_impl.might_have_pending_waits = false;
   }
@@ -229,6 +247,52 @@ public:
         Time_Traits::add(Time_Traits::now(), expiry_time), ec);
   }
 
+  // Change the expiry time for the timer without cancelling pending waits.
+  void refresh(implementation_type& impl, const time_type& expiry_time)
+  {
+    impl.expiry = expiry_time;
+    if (!impl.might_have_pending_waits)
+      return;
+
+    ASIO_HANDLER_OPERATION((scheduler_.context(),
+          "deadline_timer", &impl, 0, "refresh"));
+
+    time_type target = coalesce_expiry(impl.expiry,
+        impl.slack, static_cast<Time_Traits*>(0));
+
+    // A later deadline is published to the queue without taking the
+    // scheduler's lock, and the queue re-sorts the timer when the deadline it
+    // is currently queued at is reached. Earlier deadlines must be applied
+    // immediately.
+    if (Time_Traits::less_than(target, impl.scheduled_expiry)
+        || !timer_queue<Time_Traits>::refresh_timer(impl.timer_data, target))
+    {
+      scheduler_.reschedule_timer(timer_queue_, impl.timer_data, target);
+    }
+
+    impl.scheduled_expiry = target;
+  }
+
+  // Change the expiry time for the timer relative to now without cancelling
+  // pending waits.
+  void refresh_after(implementation_type& impl,
+      const duration_type& expiry_time)
+  {
+    refresh(impl, Time_Traits::add(Time_Traits::now(), expiry_time));
+  }
+
+  // Get the amount by which asynchronous waits may complete late.
+  duration_type slack(const implementation_type& impl) const
+  {
+    return impl.slack;
+  }
+
+  // Set the amount by which asynchronous waits may complete late.
+  void slack(implementation_type& impl, const duration_type& slack_time)
+  {
+    impl.slack = slack_time;
+  }
+
   // Perform a blocking wait on the timer.
   void wait(implementation_type& impl, asio::error_code& ec)
   {
@@ -263,16 +327,72 @@ public:
         &slot.template emplace<op_cancellation>(this, &impl.timer_data);
     }
 
+    // An already queued timer keeps its position in the queue, so track the
+    // latest deadline it may be queued at.
+    time_type target = coalesce_expiry(impl.expiry,
+        impl.slack, static_cast<Time_Traits*>(0));
+    if (!impl.might_have_pending_waits
+        || Time_Traits::less_than(impl.scheduled_expiry, target))
+      impl.scheduled_expiry = target;
+
     impl.might_have_pending_waits = true;
 
     ASIO_HANDLER_CREATION((scheduler_.context(),
           *p.p, "deadline_timer", &impl, 0, "async_wait"));
 
-    scheduler_.schedule_timer(timer_queue_, impl.expiry, impl.timer_data, p.p);
+    scheduler_.schedule_timer(timer_queue_, target, impl.timer_data, p.p);
     p.v = p.p = 0;
   }
 
 private:
+  // Time traits other than those for std::chrono clocks do not support slack.
+  template <typename Traits>
+  static typename Traits::time_type coalesce_expiry(
+      const typename Traits::time_type& expiry,
+      const typename Traits::duration_type&, Traits*)
+  {
+    return expiry;
+  }
+
+  // Round the expiry up to the next multiple of the slack, measured from the
+  // clock's epoch. Timers with the same slack then share a deadline and can
+  // be dispatched by a single wakeup of the reactor.
+  template <typename Clock, typename WaitTraits>
+  static typename Clock::time_point coalesce_expiry(
+      const typename Clock::time_point& expiry,
+      const typename Clock::duration& slack,
+      chrono_time_traits<Clock, WaitTraits>*)
+  {
+    return coalesce_chrono_expiry<chrono_time_traits<Clock, WaitTraits>>(
+        expiry, slack, is_integral<typename Clock::duration::rep>());
+  }
+
+  template <typename Traits>
+  static typename Traits::time_type coalesce_chrono_expiry(
+      const typename Traits::time_type& expiry,
+      const typename Traits::duration_type& slack, true_type)
+  {
+    typedef typename Traits::duration_type::rep rep;
+    rep step = slack.count();
+    if (step <= 0)
+      return expiry;
+    rep remainder = expiry.time_since_epoch().count() % step;
+    if (remainder < 0)
+      remainder += step;
+    if (remainder == 0)
+      return expiry;
+    return Traits::add(expiry,
+        typename Traits::duration_type(step - remainder));
+  }
+
+  template <typename Traits>
+  static typename Traits::time_type coalesce_chrono_expiry(
+      const typename Traits::time_type& expiry,
+      const typename Traits::duration_type&, false_type)
+  {
+    return expiry;
+  }
+
   // Helper function to wait given a duration type. The duration type should
   // either be of type boost::posix_time::time_duration, or implement the
   // required subset of its interface.
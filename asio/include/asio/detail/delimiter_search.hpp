@@ -0,0 +1,282 @@
+//
+// detail/delimiter_search.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_DELIMITER_SEARCH_HPP
+#define ASIO_DETAIL_DELIMITER_SEARCH_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include "asio/buffer.hpp"
+
+#if defined(ASIO_HAS_SSE2)
+# include <emmintrin.h>
+#endif // defined(ASIO_HAS_SSE2)
+
+#if defined(ASIO_HAS_AVX2)
+# include <immintrin.h>
+# if defined(ASIO_MSVC)
+#  include <intrin.h>
+# endif // defined(ASIO_MSVC)
+#endif // defined(ASIO_HAS_AVX2)
+
+#include "asio/detail/push_options.hpp"
+
+#if defined(ASIO_HAS_AVX2) && !defined(ASIO_MSVC)
+# define ASIO_AVX2_TARGET __attribute__((target("avx2")))
+#else // defined(ASIO_HAS_AVX2) && !defined(ASIO_MSVC)
+# define ASIO_AVX2_TARGET
+#endif // defined(ASIO_HAS_AVX2) && !defined(ASIO_MSVC)
+
+namespace asio {
+namespace detail {
+namespace delimiter_search {
+
+// Find the first full match of a delimiter that lies wholly within a
+// contiguous range. Returns last if there is no such match.
+inline const char* find_portable(const char* first,
+    const char* last, const char* delim, std::size_t length)
+{
+  if (length == 1)
+  {
+    const void* p = std::memchr(first, delim[0], last - first);
+    return p ? static_cast<const char*>(p) : last;
+  }
+
+  const char* limit = last - (length - 1);
+  while (first < limit)
+  {
+    const void* p = std::memchr(first, delim[0], limit - first);
+    if (!p)
+      break;
+    first = static_cast<const char*>(p);
+    if (std::memcmp(first + 1, delim + 1, length - 1) == 0)
+      return first;
+    ++first;
+  }
+  return last;
+}
+
+#if defined(ASIO_HAS_SSE2)
+
+// The vectorised searches compare the first and last characters of the
+// delimiter at each candidate position in a block, and compare the remaining
+// characters only where both are equal.
+
+inline unsigned int lowest_bit(unsigned int mask)
+{
+#if defined(ASIO_MSVC)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<unsigned int>(index);
+#else // defined(ASIO_MSVC)
+  return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif // defined(ASIO_MSVC)
+}
+
+inline const char* find_sse2(const char* first,
+    const char* last, const char* delim, std::size_t length)
+{
+  const char* limit = last - (length - 1);
+  const __m128i head = _mm_set1_epi8(delim[0]);
+  const __m128i tail = _mm_set1_epi8(delim[length - 1]);
+  while (limit - first >= 16)
+  {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+    __m128i b = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(first + length - 1));
+    unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(
+          _mm_and_si128(_mm_cmpeq_epi8(a, head), _mm_cmpeq_epi8(b, tail))));
+    while (mask)
+    {
+      const char* p = first + lowest_bit(mask);
+      if (length <= 2 || std::memcmp(p + 1, delim + 1, length - 2) == 0)
+        return p;
+      mask &= mask - 1;
+    }
+    first += 16;
+  }
+  return find_portable(first, last, delim, length);
+}
+
+#endif // defined(ASIO_HAS_SSE2)
+
+#if defined(ASIO_HAS_AVX2)
+
+ASIO_AVX2_TARGET inline const char* find_avx2(const char* first,
+    const char* last, const char* delim, std::size_t length)
+{
+  const char* limit = last - (length - 1);
+  const __m256i head = _mm256_set1_epi8(delim[0]);
+  const __m256i tail = _mm256_set1_epi8(delim[length - 1]);
+  while (limit - first >= 32)
+  {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+    __m256i b = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(first + length - 1));
+    unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(
+          _mm256_and_si256(_mm256_cmpeq_epi8(a, head),
+            _mm256_cmpeq_epi8(b, tail))));
+    while (mask)
+    {
+      const char* p = first + lowest_bit(mask);
+      if (length <= 2 || std::memcmp(p + 1, delim + 1, length - 2) == 0)
+        return p;
+      mask &= mask - 1;
+    }
+    first += 32;
+  }
+  return find_sse2(first, last, delim, length);
+}
+
+inline bool cpu_has_avx2()
+{
+#if defined(ASIO_MSVC)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+    return false;
+  __cpuid(info, 1);
+  const int osxsave_and_avx = (1 << 27) | (1 << 28);
+  if ((info[2] & osxsave_and_avx) != osxsave_and_avx)
+    return false;
+  if ((_xgetbv(0) & 0x6) != 0x6)
+    return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else // defined(ASIO_MSVC)
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+#endif // defined(ASIO_MSVC)
+}
+
+#endif // defined(ASIO_HAS_AVX2)
+
+// Find the first full match of a delimiter that lies wholly within a
+// contiguous range, using the widest instruction set supported by the CPU.
+inline const char* find(const char* first,
+    const char* last, const char* delim, std::size_t length)
+{
+  if (static_cast<std::size_t>(last - first) < length)
+    return last;
+
+#if defined(ASIO_HAS_AVX2)
+  static const bool use_avx2 = cpu_has_avx2();
+  if (use_avx2)
+    return find_avx2(first, last, delim, length);
+#endif // defined(ASIO_HAS_AVX2)
+
+#if defined(ASIO_HAS_SSE2)
+  return find_sse2(first, last, delim, length);
+#else // defined(ASIO_HAS_SSE2)
+  return find_portable(first, last, delim, length);
+#endif // defined(ASIO_HAS_SSE2)
+}
+
+// Compare the delimiter against the data that follows a buffer, which starts
+// at the given buffer in the sequence. Returns 1 if the delimiter matches, 0
+// if it does not, or -1 if the data ends before the comparison is complete.
+template <typename Iterator>
+int match_following(Iterator iter, Iterator end,
+    const char* delim, std::size_t length)
+{
+  for (; iter != end && length > 0; ++iter)
+  {
+    const_buffer b(*iter);
+    std::size_t n = b.size() < length ? b.size() : length;
+    if (n == 0)
+      continue;
+    if (std::memcmp(b.data(), delim, n) != 0)
+      return 0;
+    delim += n;
+    length -= n;
+  }
+  return length == 0 ? 1 : -1;
+}
+
+// Search a range of buffers for a delimiter, starting at the given offset. The
+// buffers are searched one at a time, with matches that straddle adjacent
+// buffers checked separately. Returns (offset,true) if a full match was found,
+// in which case the offset is that of the beginning of the match. Returns
+// (offset,false) if a partial match was found at the end of the data, in which
+// case the offset is that of the beginning of the partial match. Returns
+// (size,false) if no full or partial match was found.
+template <typename Iterator>
+std::pair<std::size_t, bool> search(Iterator iter, Iterator end,
+    std::size_t start, const char* delim, std::size_t length)
+{
+  std::size_t offset = 0;
+  while (iter != end)
+  {
+    const_buffer b(*iter);
+    const char* data = static_cast<const char*>(b.data());
+    std::size_t size = b.size();
+    ++iter;
+
+    if (offset + size <= start)
+    {
+      offset += size;
+      continue;
+    }
+
+    std::size_t skip = start > offset ? start - offset : 0;
+    if (length == 0)
+      return std::make_pair(offset + skip, true);
+
+    // Look for a match that lies wholly within this buffer.
+    const char* first = data + skip;
+    const char* last = data + size;
+    const char* p = delimiter_search::find(first, last, delim, length);
+    if (p != last)
+      return std::make_pair(offset + (p - data), true);
+
+    // Look for a match that begins in this buffer and continues into the
+    // buffers that follow it.
+    std::size_t tail = size - skip < length - 1 ? size - skip : length - 1;
+    for (p = last - tail; p != last; ++p)
+    {
+      std::size_t n = last - p;
+      if (std::memcmp(p, delim, n) == 0)
+      {
+        int result = delimiter_search::match_following(
+            iter, end, delim + n, length - n);
+        if (result != 0)
+          return std::make_pair(offset + (p - data), result > 0);
+      }
+    }
+
+    offset += size;
+  }
+
+  return std::make_pair(offset, false);
+}
+
+template <typename ConstBufferSequence>
+inline std::pair<std::size_t, bool> search(const ConstBufferSequence& buffers,
+    std::size_t start, const char* delim, std::size_t length)
+{
+  return delimiter_search::search(asio::buffer_sequence_begin(buffers),
+      asio::buffer_sequence_end(buffers), start, delim, length);
+}
+
+} // namespace delimiter_search
+} // namespace detail
+} // namespace asio
+
+#undef ASIO_AVX2_TARGET
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_DELIMITER_SEARCH_HPP
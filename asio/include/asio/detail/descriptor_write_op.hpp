@@ -27,6 +27,10 @@
 #include "asio/detail/memory.hpp"
 #include "asio/detail/reactor_op.hpp"
 
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+# include "asio/detail/native_buffer_storage.hpp"
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -43,6 +47,10 @@ public:
         &descriptor_write_op_base::do_perform, complete_func),
       descriptor_(descriptor),
       buffers_(buffers)
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+      , buffer_storage_(0),
+      buffer_storage_size_(0)
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
   {
   }
 
@@ -64,7 +72,12 @@ public:
     }
     else
     {
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+      bufs_type bufs(o->buffers_,
+          o->buffer_storage_, o->buffer_storage_size_);
+#else // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
       bufs_type bufs(o->buffers_);
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
       result = descriptor_ops::non_blocking_write(o->descriptor_,
           bufs.buffers(), bufs.count(), o->ec_, o->bytes_transferred_)
         ? done : not_done;
@@ -76,9 +89,25 @@ public:
     return result;
   }
 
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+protected:
+  // Use storage owned by the derived operation for long buffer sequences.
+  void set_buffer_storage(
+      buffer_sequence_adapter_base::native_buffer_type* storage,
+      std::size_t size)
+  {
+    buffer_storage_ = storage;
+    buffer_storage_size_ = size;
+  }
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+
 private:
   int descriptor_;
   ConstBufferSequence buffers_;
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+  buffer_sequence_adapter_base::native_buffer_type* buffer_storage_;
+  std::size_t buffer_storage_size_;
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
 };
 
 template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
@@ -98,7 +127,13 @@ public:
         descriptor, buffers, &descriptor_write_op::do_complete),
       handler_(static_cast<Handler&&>(handler)),
       work_(handler_, io_ex)
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+      , storage_(buffers, handler_)
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
   {
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+    this->set_buffer_storage(storage_.data(), storage_.size());
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
   }
 
   static void do_complete(void* owner, operation* base,
@@ -175,6 +210,10 @@ public:
 private:
   Handler handler_;
   handler_work<Handler, IoExecutor> work_;
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+  native_buffer_storage<asio::const_buffer,
+      ConstBufferSequence, Handler> storage_;
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
 };
 
 } // namespace detail
@@ -19,6 +19,7 @@
 
 #if defined(ASIO_HAS_EPOLL)
 
+#include <atomic>
 #include "asio/detail/atomic_count.hpp"
 #include "asio/detail/conditionally_enabled_mutex.hpp"
 #include "asio/detail/limits.hpp"
@@ -71,6 +72,12 @@ public:
     bool try_speculative_[max_ops];
     bool shutdown_;
 
+    // The following members are protected by the reactor's mutex.
+    uint32_t epoll_events_;
+    uint32_t pending_events_;
+    descriptor_state* next_pending_;
+    int registration_error_;
+
     ASIO_DECL descriptor_state(bool locking);
     void set_ready_events(uint32_t events) { task_result_ = events; }
     void add_ready_events(uint32_t events) { task_result_ |= events; }
@@ -100,7 +107,8 @@ public:
   ASIO_DECL void init_task();
 
   // Register a socket with the reactor. Returns 0 on success, system error
-  // code on failure.
+  // code on failure. The descriptor is not added to the epoll set until an
+  // operation first needs to wait for readiness.
   ASIO_DECL int register_descriptor(socket_type descriptor,
       per_descriptor_data& descriptor_data);
 
@@ -205,12 +213,25 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& target,
       typename timer_queue<Time_Traits>::per_timer_data& source);
 
+  // Change the expiry time of the given timer without cancelling its
+  // operations.
+  template <typename Time_Traits>
+  void reschedule_timer(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& timer,
+      const typename Time_Traits::time_type& time);
+
   // Run epoll once until interrupted or events are ready to be dispatched.
   ASIO_DECL void run(long usec, op_queue<operation>& ops);
 
   // Interrupt the select loop.
   ASIO_DECL void interrupt();
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  // Add the number of registered descriptors and pending timers to the
+  // snapshot.
+  ASIO_DECL void get_metrics(io_context_metrics& m);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 private:
   // The hint to pass to epoll_create to size its data structures.
   enum { epoll_size = 20000 };
@@ -228,6 +249,33 @@ private:
   // Free an existing descriptor state object.
   ASIO_DECL void free_descriptor_state(descriptor_state* s);
 
+  // Request that the descriptor's epoll registration be updated to the given
+  // events. The update is deferred until the next call to run() unless a
+  // thread may already be blocked in epoll_wait. Must be called with the
+  // descriptor's mutex held. Returns 0 on success, system error code on
+  // failure.
+  ASIO_DECL int request_registration(
+      descriptor_state* descriptor_data, uint32_t events);
+
+  // Apply a registration update to the epoll set. Must be called with the
+  // reactor's mutex held.
+  ASIO_DECL int apply_registration(
+      descriptor_state* descriptor_data, uint32_t events);
+
+  // Remove a descriptor from the list of pending registration updates. Must
+  // be called with the reactor's mutex held.
+  ASIO_DECL void remove_pending_registration(descriptor_state* descriptor_data);
+
+  // Remove a descriptor from the epoll set and from the list of pending
+  // registration updates. Must be called with the descriptor's mutex held.
+  ASIO_DECL void cancel_registration(socket_type descriptor,
+      descriptor_state* descriptor_data, bool closing);
+
+  // Apply all pending registration updates. Descriptors that could not be
+  // added are queued so that their operations can be failed. Must be called
+  // with the reactor's mutex held.
+  ASIO_DECL void flush_registrations(op_queue<operation>& ops);
+
   // Helper function to add a new timer queue.
   ASIO_DECL void do_add_timer_queue(timer_queue_base& queue);
 
@@ -269,12 +317,28 @@ private:
   // Whether the service has been shut down.
   bool shutdown_;
 
+  // Whether a thread is in run() and may be blocked in epoll_wait. Together
+  // with registrations_pending_, this lets run() skip the mutex when there
+  // are no registration updates to apply.
+  std::atomic<bool> epoll_waiting_;
+
+  // Whether pending_registrations_ is non-empty.
+  std::atomic<bool> registrations_pending_;
+
+  // Descriptors with registration updates waiting for the next call to run().
+  descriptor_state* pending_registrations_;
+
   // Mutex to protect access to the registered descriptors.
   mutex registered_descriptors_mutex_;
 
   // Keep track of all registered descriptors.
   object_pool<descriptor_state> registered_descriptors_;
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  // The number of registered descriptors.
+  std::size_t registered_descriptor_count_;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
   // Helper class to do post-perform_io cleanup.
   struct perform_io_cleanup_on_block_exit;
   friend struct perform_io_cleanup_on_block_exit;
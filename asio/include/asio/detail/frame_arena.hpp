@@ -0,0 +1,317 @@
+//
+// detail/frame_arena.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_FRAME_ARENA_HPP
+#define ASIO_DETAIL_FRAME_ARENA_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/call_stack.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/thread_context.hpp"
+#include "asio/detail/thread_info_base.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+#ifndef ASIO_FRAME_ARENA_CHUNK_SIZE
+# define ASIO_FRAME_ARENA_CHUNK_SIZE 16384
+#endif // ASIO_FRAME_ARENA_CHUNK_SIZE
+
+namespace asio {
+namespace detail {
+
+// A stack-like arena for coroutine frames belonging to a single logical thread
+// of execution, such as the coroutines launched by one co_spawn. Frames are
+// bump-allocated contiguously from a chunk, and the space is reclaimed when
+// they are released in LIFO order. Chunks are reference counted by the frames
+// they contain, so a frame may safely outlive its arena or be released on
+// another thread, in which case its space is reclaimed with the chunk.
+class frame_arena
+  : private noncopyable
+{
+public:
+  class context;
+
+  enum
+  {
+    chunk_size = ASIO_FRAME_ARENA_CHUNK_SIZE,
+    max_frame_size = chunk_size / 4
+  };
+
+  // Create a new arena, owned by a single reference.
+  static frame_arena* create()
+  {
+    void* p = thread_info_base::allocate(
+        thread_info_base::awaitable_frame_tag(),
+        thread_context::top_of_thread_call_stack(),
+        sizeof(frame_arena));
+    return new (p) frame_arena;
+  }
+
+  // Obtain a new reference to the arena that is active on the current thread,
+  // or null if there is none.
+  static frame_arena* share_current()
+  {
+    frame_arena* a = current();
+    if (a)
+      a->add_ref();
+    return a;
+  }
+
+  void add_ref()
+  {
+    ref_count_up(ref_count_);
+  }
+
+  void release()
+  {
+    if (ref_count_down(ref_count_))
+    {
+      if (current_)
+        release_chunk(current_);
+      this->~frame_arena();
+      thread_info_base::deallocate(
+          thread_info_base::awaitable_frame_tag(),
+          thread_context::top_of_thread_call_stack(),
+          this, sizeof(frame_arena));
+    }
+  }
+
+  // Allocate a frame from the arena that is active on the current thread. If
+  // there is no such arena, or the frame is too large, the frame is allocated
+  // from the thread's recycling cache.
+  static void* allocate(std::size_t size)
+  {
+    if (frame_arena* a = current())
+      if (void* pointer = a->bump(size))
+        return pointer;
+
+    unsigned char* const base = static_cast<unsigned char*>(
+        thread_info_base::allocate(
+          thread_info_base::awaitable_frame_tag(),
+          thread_context::top_of_thread_call_stack(),
+          header_size + size));
+    frame_header* h = new (base) frame_header;
+    h->owner = 0;
+    h->size = size;
+    return base + header_size;
+  }
+
+  // Deallocate a frame. The space is returned to the arena immediately if the
+  // frame is the most recent allocation in the active arena's current chunk.
+  static void deallocate(void* pointer)
+  {
+    unsigned char* const base =
+      static_cast<unsigned char*>(pointer) - header_size;
+    frame_header* h = reinterpret_cast<frame_header*>(base);
+    chunk* c = h->owner;
+    if (c == 0)
+    {
+      thread_info_base::deallocate(
+          thread_info_base::awaitable_frame_tag(),
+          thread_context::top_of_thread_call_stack(),
+          base, header_size + h->size);
+      return;
+    }
+
+    frame_arena* a = current();
+    if (a && a->current_ == c)
+    {
+      // The arena holds its own reference to the current chunk, so the count
+      // cannot reach zero here. When only that reference remains, every frame
+      // has gone and the whole chunk can be reused.
+      if (c->top == base + header_size + round_up(h->size))
+        c->top = base;
+      decrement(c->refs, 1);
+      if (c->refs == 1)
+        c->top = c->data();
+      return;
+    }
+
+    release_chunk(c);
+  }
+
+private:
+  struct chunk
+  {
+    explicit chunk(std::size_t size)
+      : refs(1),
+        top(data()),
+        end(reinterpret_cast<unsigned char*>(this) + size)
+    {
+    }
+
+    unsigned char* data()
+    {
+      return reinterpret_cast<unsigned char*>(this) + chunk_header_size;
+    }
+
+    atomic_count refs;
+    unsigned char* top;
+    unsigned char* end;
+  };
+
+  struct frame_header
+  {
+    // The chunk containing the frame, or null if not allocated in an arena.
+    chunk* owner;
+
+    // The size requested for the frame.
+    std::size_t size;
+  };
+
+  enum
+  {
+    header_size = ((sizeof(frame_header) + ASIO_DEFAULT_ALIGN - 1)
+        / ASIO_DEFAULT_ALIGN) * ASIO_DEFAULT_ALIGN,
+    chunk_header_size = ((sizeof(chunk) + ASIO_DEFAULT_ALIGN - 1)
+        / ASIO_DEFAULT_ALIGN) * ASIO_DEFAULT_ALIGN
+  };
+
+  typedef call_stack<frame_arena, frame_arena*> arena_call_stack;
+
+  frame_arena()
+    : ref_count_(1),
+      in_use_(false),
+      current_(0)
+  {
+  }
+
+  static frame_arena* current()
+  {
+    frame_arena** a = arena_call_stack::top();
+    return a ? *a : 0;
+  }
+
+  static std::size_t round_up(std::size_t size)
+  {
+    return ((size + ASIO_DEFAULT_ALIGN - 1)
+        / ASIO_DEFAULT_ALIGN) * ASIO_DEFAULT_ALIGN;
+  }
+
+  static void release_chunk(chunk* c)
+  {
+    if (ref_count_down(c->refs))
+    {
+      c->~chunk();
+      aligned_delete(c);
+    }
+  }
+
+  void* bump(std::size_t size)
+  {
+    std::size_t space = header_size + round_up(size);
+    if (space > max_frame_size)
+      return 0;
+
+    if (current_ == 0 || static_cast<std::size_t>(
+          current_->end - current_->top) < space)
+    {
+      if (current_ && current_->refs == 1)
+      {
+        current_->top = current_->data();
+      }
+      else
+      {
+        void* p = aligned_new(ASIO_DEFAULT_ALIGN, chunk_size);
+        chunk* c = new (p) chunk(chunk_size);
+        if (current_)
+          release_chunk(current_);
+        current_ = c;
+      }
+    }
+
+    unsigned char* const base = current_->top;
+    current_->top += space;
+    ref_count_up(current_->refs);
+    frame_header* h = new (base) frame_header;
+    h->owner = current_;
+    h->size = size;
+    return base + header_size;
+  }
+
+  // The number of references to the arena.
+  atomic_count ref_count_;
+
+  // Whether the arena is active on some thread.
+  std::atomic<bool> in_use_;
+
+  // The chunk from which frames are currently allocated.
+  chunk* current_;
+};
+
+// Makes an arena the active arena for the current thread. An arena may only be
+// active on one thread at a time. If it is already active elsewhere, no arena
+// is active for the lifetime of the context and frames are allocated from the
+// thread's recycling cache instead.
+class frame_arena::context
+  : private noncopyable
+{
+public:
+  explicit context(frame_arena* a)
+    : owned_(false),
+      arena_(acquire(a, owned_)),
+      context_(arena_, arena_)
+  {
+  }
+
+  ~context()
+  {
+    if (owned_)
+    {
+      arena_->in_use_.store(false, std::memory_order_release);
+      arena_->release();
+    }
+  }
+
+private:
+  static frame_arena* acquire(frame_arena* a, bool& owned)
+  {
+#if defined(ASIO_DISABLE_FRAME_ARENA)
+    (void)a;
+    (void)owned;
+    return 0;
+#else // defined(ASIO_DISABLE_FRAME_ARENA)
+    if (a == 0)
+      return 0;
+
+    if (arena_call_stack::contains(a))
+      return a;
+
+    if (a->in_use_.exchange(true, std::memory_order_acquire))
+      return 0;
+
+    // The arena must outlive the context, even if the frame that owns it is
+    // destroyed while the context is active.
+    a->add_ref();
+    owned = true;
+    return a;
+#endif // defined(ASIO_DISABLE_FRAME_ARENA)
+  }
+
+  bool owned_;
+  frame_arena* arena_;
+  arena_call_stack::context context_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_FRAME_ARENA_HPP
@@ -0,0 +1,80 @@
+//
+// detail/handler_location.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_HANDLER_LOCATION_HPP
+#define ASIO_DETAIL_HANDLER_LOCATION_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
+#include "asio/detail/call_stack.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A source location recorded by ASIO_HANDLER_LOCATION. The locations form a
+// per-thread stack, and operations created while a location is on the stack
+// remember the innermost one so that it can be reported for slow handlers.
+class handler_location
+  : private noncopyable
+{
+public:
+  handler_location(const char* file, int line, const char* func)
+    : file_(file),
+      line_(line),
+      func_(func),
+      context_(this, *this)
+  {
+  }
+
+  // Get the innermost location for the current thread, if any.
+  static const handler_location* current()
+  {
+    return call_stack<handler_location, handler_location>::top();
+  }
+
+  const char* file_name() const
+  {
+    return file_;
+  }
+
+  int line() const
+  {
+    return line_;
+  }
+
+  const char* function_name() const
+  {
+    return func_;
+  }
+
+private:
+  const char* file_;
+  int line_;
+  const char* func_;
+  call_stack<handler_location, handler_location>::context context_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
+#endif // ASIO_DETAIL_HANDLER_LOCATION_HPP
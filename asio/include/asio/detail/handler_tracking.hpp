@@ -32,6 +32,10 @@ class execution_context;
 # include "asio/detail/tss_ptr.hpp"
 #endif // defined(ASIO_ENABLE_HANDLER_TRACKING)
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+# include "asio/detail/handler_location.hpp"
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -107,6 +111,9 @@ public:
     int line_;
     const char* func_;
     location* next_;
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+    handler_location metrics_location_;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
   };
 
   // Record the creation of a tracked handler.
@@ -236,7 +243,12 @@ private:
 # define ASIO_INHERIT_TRACKED_HANDLER
 # define ASIO_ALSO_INHERIT_TRACKED_HANDLER
 # define ASIO_HANDLER_TRACKING_INIT (void)0
-# define ASIO_HANDLER_LOCATION(loc) (void)0
+# if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+#  define ASIO_HANDLER_LOCATION(args) \
+  asio::detail::handler_location tracked_location args
+# else // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+#  define ASIO_HANDLER_LOCATION(loc) (void)0
+# endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
 # define ASIO_HANDLER_CREATION(args) (void)0
 # define ASIO_HANDLER_COMPLETION(args) (void)0
 # define ASIO_HANDLER_INVOCATION_BEGIN(args) (void)0
@@ -101,6 +101,16 @@ void dev_poll_reactor::move_timer(timer_queue<Time_Traits>& queue,
   scheduler_.post_deferred_completions(ops);
 }
 
+template <typename Time_Traits>
+void dev_poll_reactor::reschedule_timer(timer_queue<Time_Traits>& queue,
+    typename timer_queue<Time_Traits>::per_timer_data& timer,
+    const typename Time_Traits::time_type& time)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  if (queue.reschedule_timer(timer, time))
+    interrupter_.interrupt();
+}
+
 } // namespace detail
 } // namespace asio
 
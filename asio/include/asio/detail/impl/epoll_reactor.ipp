@@ -23,6 +23,7 @@
 #include <sys/epoll.h>
 #include "asio/detail/epoll_reactor.hpp"
 #include "asio/detail/scheduler.hpp"
+#include "asio/detail/thread_info_base.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
 
@@ -44,7 +45,13 @@ epoll_reactor::epoll_reactor(asio::execution_context& ctx)
     epoll_fd_(do_epoll_create()),
     timer_fd_(do_timerfd_create()),
     shutdown_(false),
+    epoll_waiting_(false),
+    registrations_pending_(false),
+    pending_registrations_(0),
     registered_descriptors_mutex_(mutex_.enabled())
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+    , registered_descriptor_count_(0)
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
 {
   // Add the interrupter's descriptor to epoll.
   epoll_event ev = { 0, { 0 } };
@@ -74,6 +81,8 @@ void epoll_reactor::shutdown()
 {
   mutex::scoped_lock lock(mutex_);
   shutdown_ = true;
+  pending_registrations_ = 0;
+  registrations_pending_ = false;
   lock.unlock();
 
   op_queue<operation> ops;
@@ -84,6 +93,9 @@ void epoll_reactor::shutdown()
       ops.push(state->op_queue_[i]);
     state->shutdown_ = true;
     registered_descriptors_.free(state);
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+    --registered_descriptor_count_;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
   }
 
   timer_queues_.get_all_timers(ops);
@@ -125,12 +137,16 @@ void epoll_reactor::notify_fork(
 
     update_timeout();
 
-    // Re-register all descriptors with epoll.
+    // Re-register all descriptors with epoll. Descriptors that have not yet
+    // been added will be added when their pending registrations are flushed.
     mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
     for (descriptor_state* state = registered_descriptors_.first();
         state != 0; state = state->next_)
     {
-      ev.events = state->registered_events_;
+      if (state->epoll_events_ == 0)
+        continue;
+
+      ev.events = state->epoll_events_;
       ev.data.ptr = state;
       int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, state->descriptor_, &ev);
       if (result != 0)
@@ -165,25 +181,11 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
     descriptor_data->shutdown_ = false;
     for (int i = 0; i < max_ops; ++i)
       descriptor_data->try_speculative_[i] = true;
-  }
 
-  epoll_event ev = { 0, { 0 } };
-  ev.events = EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
-  descriptor_data->registered_events_ = ev.events;
-  ev.data.ptr = descriptor_data;
-  int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, descriptor, &ev);
-  if (result != 0)
-  {
-    if (errno == EPERM)
-    {
-      // This file descriptor type is not supported by epoll. However, if it is
-      // a regular file then operations on it will not block. We will allow
-      // this descriptor to be used and fail later if an operation on it would
-      // otherwise require a trip through the reactor.
-      descriptor_data->registered_events_ = 0;
-      return 0;
-    }
-    return errno;
+    // The descriptor is added to the epoll set only when an operation first
+    // needs to wait for it, so that short-lived descriptors whose operations
+    // all complete speculatively never cost an epoll_ctl call.
+    descriptor_data->registered_events_ = 0;
   }
 
   return 0;
@@ -210,15 +212,10 @@ int epoll_reactor::register_internal_descriptor(
       descriptor_data->try_speculative_[i] = true;
   }
 
-  epoll_event ev = { 0, { 0 } };
-  ev.events = EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
-  descriptor_data->registered_events_ = ev.events;
-  ev.data.ptr = descriptor_data;
-  int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, descriptor, &ev);
-  if (result != 0)
-    return errno;
-
-  return 0;
+  mutex::scoped_lock lock(mutex_);
+  uint32_t events = EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
+  descriptor_data->registered_events_ = events;
+  return apply_registration(descriptor_data, events);
 }
 
 void epoll_reactor::move_descriptor(socket_type,
@@ -236,7 +233,7 @@ void epoll_reactor::call_post_immediate_completion(
       op, is_continuation);
 }
 
-void epoll_reactor::start_op(int op_type, socket_type descriptor,
+void epoll_reactor::start_op(int op_type, socket_type,
     epoll_reactor::per_descriptor_data& descriptor_data, reactor_op* op,
     bool is_continuation, bool allow_speculative,
     void (*on_immediate)(operation*, bool, const void*),
@@ -259,6 +256,10 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
 
   if (descriptor_data->op_queue_[op_type].empty())
   {
+    // A non-speculative operation always updates the registration, as that
+    // causes epoll to re-check the descriptor's current readiness.
+    bool force_update = true;
+
     if (allow_speculative
         && (op_type != read_op
           || descriptor_data->op_queue_[except_op].empty()))
@@ -276,51 +277,36 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
         }
       }
 
-      if (descriptor_data->registered_events_ == 0)
-      {
-        op->ec_ = asio::error::operation_not_supported;
-        on_immediate(op, is_continuation, immediate_arg);
-        return;
-      }
+      force_update = false;
+    }
 
-      if (op_type == write_op)
+    uint32_t events = descriptor_data->registered_events_
+      | EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
+    if (op_type == write_op)
+      events |= EPOLLOUT;
+
+    if (force_update || events != descriptor_data->registered_events_)
+    {
+      if (int error = request_registration(descriptor_data, events))
       {
-        if ((descriptor_data->registered_events_ & EPOLLOUT) == 0)
+        if (error == EPERM)
         {
-          epoll_event ev = { 0, { 0 } };
-          ev.events = descriptor_data->registered_events_ | EPOLLOUT;
-          ev.data.ptr = descriptor_data;
-          if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, descriptor, &ev) == 0)
-          {
-            descriptor_data->registered_events_ |= ev.events;
-          }
-          else
-          {
-            op->ec_ = asio::error_code(errno,
-                asio::error::get_system_category());
-            on_immediate(op, is_continuation, immediate_arg);
-            return;
-          }
+          // This file descriptor type is not supported by epoll. However, if
+          // it is a regular file then operations on it will not block, so we
+          // only fail those operations that require a trip through the
+          // reactor.
+          op->ec_ = asio::error::operation_not_supported;
         }
-      }
-    }
-    else if (descriptor_data->registered_events_ == 0)
-    {
-      op->ec_ = asio::error::operation_not_supported;
-      on_immediate(op, is_continuation, immediate_arg);
-      return;
-    }
-    else
-    {
-      if (op_type == write_op)
-      {
-        descriptor_data->registered_events_ |= EPOLLOUT;
+        else
+        {
+          op->ec_ = asio::error_code(error,
+              asio::error::get_system_category());
+        }
+        on_immediate(op, is_continuation, immediate_arg);
+        return;
       }
 
-      epoll_event ev = { 0, { 0 } };
-      ev.events = descriptor_data->registered_events_;
-      ev.data.ptr = descriptor_data;
-      epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, descriptor, &ev);
+      descriptor_data->registered_events_ = events;
     }
   }
 
@@ -391,16 +377,9 @@ void epoll_reactor::deregister_descriptor(socket_type descriptor,
 
   if (!descriptor_data->shutdown_)
   {
-    if (closing)
-    {
-      // The descriptor will be automatically removed from the epoll set when
-      // it is closed.
-    }
-    else if (descriptor_data->registered_events_ != 0)
-    {
-      epoll_event ev = { 0, { 0 } };
-      epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, descriptor, &ev);
-    }
+    // Descriptors that have never waited for readiness are not known to epoll.
+    if (descriptor_data->registered_events_ != 0)
+      cancel_registration(descriptor, descriptor_data, closing);
 
     op_queue<operation> ops;
     for (int i = 0; i < max_ops; ++i)
@@ -445,8 +424,7 @@ void epoll_reactor::deregister_internal_descriptor(socket_type descriptor,
 
   if (!descriptor_data->shutdown_)
   {
-    epoll_event ev = { 0, { 0 } };
-    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, descriptor, &ev);
+    cancel_registration(descriptor, descriptor_data, false);
 
     op_queue<operation> ops;
     for (int i = 0; i < max_ops; ++i)
@@ -490,9 +468,21 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
   // operations have already been dequeued. Therefore it is now safe for us to
   // reuse and return them for the scheduler to queue again.
 
+  // From here on, registration updates are applied directly by the thread
+  // that requests them. Setting this flag before checking for pending updates
+  // ensures that an update is either seen here or applied by the requester.
+  epoll_waiting_ = true;
+
+  // Apply the registration updates that have accumulated since the last call.
+  if (registrations_pending_)
+  {
+    mutex::scoped_lock lock(mutex_);
+    flush_registrations(ops);
+  }
+
   // Calculate timeout. Check the timer queues only if timerfd is not in use.
   int timeout;
-  if (usec == 0)
+  if (usec == 0 || !ops.empty())
     timeout = 0;
   else
   {
@@ -508,6 +498,19 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
   epoll_event events[128];
   int num_events = epoll_wait(epoll_fd_, events, 128, timeout);
 
+  epoll_waiting_ = false;
+
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  // Count the wakeup against the thread that is running the scheduler.
+  if (thread_info_base* this_thread =
+      thread_context::top_of_thread_call_stack())
+  {
+    this_thread->metrics().add(thread_metrics::reactor_wakeups, 1);
+    if (num_events > 0)
+      this_thread->metrics().add(thread_metrics::reactor_events, num_events);
+  }
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 #if defined(ASIO_ENABLE_HANDLER_TRACKING)
   // Trace the waiting events.
   for (int i = 0; i < num_events; ++i)
@@ -663,6 +666,9 @@ int epoll_reactor::do_timerfd_create()
 epoll_reactor::descriptor_state* epoll_reactor::allocate_descriptor_state()
 {
   mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  ++registered_descriptor_count_;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
   return registered_descriptors_.alloc(ASIO_CONCURRENCY_HINT_IS_LOCKING(
         REACTOR_IO, scheduler_.concurrency_hint()));
 }
@@ -670,9 +676,125 @@ epoll_reactor::descriptor_state* epoll_reactor::allocate_descriptor_state()
 void epoll_reactor::free_descriptor_state(epoll_reactor::descriptor_state* s)
 {
   mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  --registered_descriptor_count_;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
   registered_descriptors_.free(s);
 }
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+void epoll_reactor::get_metrics(io_context_metrics& m)
+{
+  mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+  m.registered_descriptors = registered_descriptor_count_;
+  descriptors_lock.unlock();
+
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.get_pending_timers(m.pending_timers);
+}
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
+int epoll_reactor::request_registration(
+    epoll_reactor::descriptor_state* descriptor_data, uint32_t events)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  if (descriptor_data->pending_events_ == 0)
+  {
+    descriptor_data->next_pending_ = pending_registrations_;
+    pending_registrations_ = descriptor_data;
+  }
+  descriptor_data->pending_events_ = events;
+  registrations_pending_ = true;
+
+  // A thread in run() may have missed the update, so apply it now.
+  if (epoll_waiting_)
+  {
+    remove_pending_registration(descriptor_data);
+    return apply_registration(descriptor_data, events);
+  }
+
+  return 0;
+}
+
+int epoll_reactor::apply_registration(
+    epoll_reactor::descriptor_state* descriptor_data, uint32_t events)
+{
+  epoll_event ev = { 0, { 0 } };
+  ev.events = events;
+  ev.data.ptr = descriptor_data;
+  int op = descriptor_data->epoll_events_ ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+  if (epoll_ctl(epoll_fd_, op, descriptor_data->descriptor_, &ev) != 0)
+    return errno;
+  descriptor_data->epoll_events_ = events;
+  return 0;
+}
+
+void epoll_reactor::remove_pending_registration(
+    epoll_reactor::descriptor_state* descriptor_data)
+{
+  descriptor_state** p = &pending_registrations_;
+  while (*p != descriptor_data)
+    p = &(*p)->next_pending_;
+  *p = descriptor_data->next_pending_;
+  descriptor_data->next_pending_ = 0;
+  descriptor_data->pending_events_ = 0;
+  if (pending_registrations_ == 0)
+    registrations_pending_ = false;
+}
+
+void epoll_reactor::cancel_registration(socket_type descriptor,
+    epoll_reactor::descriptor_state* descriptor_data, bool closing)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  if (descriptor_data->pending_events_ != 0)
+    remove_pending_registration(descriptor_data);
+
+  if (closing)
+  {
+    // The descriptor will be automatically removed from the epoll set when
+    // it is closed.
+  }
+  else if (descriptor_data->epoll_events_ != 0)
+  {
+    epoll_event ev = { 0, { 0 } };
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, descriptor, &ev);
+  }
+
+  descriptor_data->epoll_events_ = 0;
+  descriptor_data->registration_error_ = 0;
+}
+
+void epoll_reactor::flush_registrations(op_queue<operation>& ops)
+{
+  registrations_pending_ = false;
+
+  while (descriptor_state* descriptor_data = pending_registrations_)
+  {
+    pending_registrations_ = descriptor_data->next_pending_;
+    uint32_t events = descriptor_data->pending_events_;
+    descriptor_data->next_pending_ = 0;
+    descriptor_data->pending_events_ = 0;
+
+    if (int error = apply_registration(descriptor_data, events))
+    {
+      // Hand the descriptor to the scheduler so that its waiting operations
+      // can be failed with the registration error.
+      descriptor_data->registration_error_ = error;
+      if (!ops.is_enqueued(descriptor_data))
+      {
+        descriptor_data->set_ready_events(EPOLLERR);
+        ops.push(descriptor_data);
+      }
+      else
+      {
+        descriptor_data->add_ready_events(EPOLLERR);
+      }
+    }
+  }
+}
+
 void epoll_reactor::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
@@ -758,7 +880,11 @@ struct epoll_reactor::perform_io_cleanup_on_block_exit
 
 epoll_reactor::descriptor_state::descriptor_state(bool locking)
   : operation(&epoll_reactor::descriptor_state::do_complete),
-    mutex_(locking)
+    mutex_(locking),
+    epoll_events_(0),
+    pending_events_(0),
+    next_pending_(0),
+    registration_error_(0)
 {
 }
 
@@ -768,6 +894,36 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
   perform_io_cleanup_on_block_exit io_cleanup(reactor_);
   mutex::scoped_lock descriptor_lock(mutex_, mutex::scoped_lock::adopt_lock);
 
+  // Fail all operations if the descriptor could not be added to epoll.
+  if (events & EPOLLERR)
+  {
+    mutex::scoped_lock reactor_lock(reactor_->mutex_);
+    int error = registration_error_;
+    registration_error_ = 0;
+    uint32_t epoll_events = epoll_events_;
+    reactor_lock.unlock();
+
+    if (error)
+    {
+      asio::error_code ec = (error == EPERM)
+        ? asio::error_code(asio::error::operation_not_supported)
+        : asio::error_code(error, asio::error::get_system_category());
+      registered_events_ = epoll_events;
+      for (int j = 0; j < max_ops; ++j)
+      {
+        while (reactor_op* op = op_queue_[j].front())
+        {
+          op->ec_ = ec;
+          op_queue_[j].pop();
+          io_cleanup.ops_.push(op);
+        }
+      }
+      io_cleanup.first_op_ = io_cleanup.ops_.front();
+      io_cleanup.ops_.pop();
+      return io_cleanup.first_op_;
+    }
+  }
+
   // Exception operations must be processed first to ensure that any
   // out-of-band data is read before normal data.
   static const int flag[max_ops] = { EPOLLIN, EPOLLOUT, EPOLLPRI };
@@ -101,6 +101,9 @@ handler_tracking::location::location(
     line_(line),
     func_(func),
     next_(*get_state()->current_location_)
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+    , metrics_location_(file, line, func)
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
 {
   if (file_)
     *get_state()->current_location_ = this;
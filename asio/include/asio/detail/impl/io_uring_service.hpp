@@ -102,6 +102,19 @@ void io_uring_service::move_timer(timer_queue<Time_Traits>& queue,
   scheduler_.post_deferred_completions(ops);
 }
 
+template <typename Time_Traits>
+void io_uring_service::reschedule_timer(timer_queue<Time_Traits>& queue,
+    typename timer_queue<Time_Traits>::per_timer_data& timer,
+    const typename Time_Traits::time_type& time)
+{
+  mutex::scoped_lock lock(mutex_);
+  if (queue.reschedule_timer(timer, time))
+  {
+    update_timeout();
+    post_submit_sqes_op(lock);
+  }
+}
+
 } // namespace detail
 } // namespace asio
 
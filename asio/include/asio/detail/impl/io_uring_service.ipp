@@ -24,6 +24,7 @@
 #include "asio/detail/io_uring_service.hpp"
 #include "asio/detail/reactor_op.hpp"
 #include "asio/detail/scheduler.hpp"
+#include "asio/detail/thread_info_base.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
 
@@ -44,6 +45,9 @@ io_uring_service::io_uring_service(asio::execution_context& ctx)
     shutdown_(false),
     timeout_(),
     registration_mutex_(mutex_.enabled()),
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+    registered_io_object_count_(0),
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
     reactor_(use_service<reactor>(ctx)),
     reactor_data_(),
     event_fd_(-1)
@@ -83,6 +87,9 @@ void io_uring_service::shutdown()
     }
     io_obj->shutdown_ = true;
     registered_io_objects_.free(io_obj);
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+    --registered_io_object_count_;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
   }
 
   // Cancel the timeout operation.
@@ -492,6 +499,18 @@ void io_uring_service::run(long usec, op_queue<operation>& ops)
 
   decrement(outstanding_work_, count);
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS) \
+  && defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  // Count the wakeup against the thread that is running the scheduler.
+  if (thread_info_base* this_thread =
+      thread_context::top_of_thread_call_stack())
+  {
+    this_thread->metrics().add(thread_metrics::reactor_wakeups, 1);
+    this_thread->metrics().add(thread_metrics::reactor_events, count);
+  }
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+       //   && defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
   if (check_timers)
   {
     mutex::scoped_lock lock(mutex_);
@@ -612,6 +631,9 @@ void io_uring_service::register_with_reactor()
 io_uring_service::io_object* io_uring_service::allocate_io_object()
 {
   mutex::scoped_lock registration_lock(registration_mutex_);
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  ++registered_io_object_count_;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
   return registered_io_objects_.alloc(
       ASIO_CONCURRENCY_HINT_IS_LOCKING(
         REACTOR_IO, scheduler_.concurrency_hint()));
@@ -620,9 +642,24 @@ io_uring_service::io_object* io_uring_service::allocate_io_object()
 void io_uring_service::free_io_object(io_uring_service::io_object* io_obj)
 {
   mutex::scoped_lock registration_lock(registration_mutex_);
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  --registered_io_object_count_;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
   registered_io_objects_.free(io_obj);
 }
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+void io_uring_service::get_metrics(io_context_metrics& m)
+{
+  mutex::scoped_lock registration_lock(registration_mutex_);
+  m.registered_descriptors = registered_io_object_count_;
+  registration_lock.unlock();
+
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.get_pending_timers(m.pending_timers);
+}
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 bool io_uring_service::do_cancel_ops(
     per_io_object_data& io_obj, op_queue<operation>& ops)
 {
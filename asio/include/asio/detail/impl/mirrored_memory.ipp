@@ -0,0 +1,140 @@
+//
+// detail/impl/mirrored_memory.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_MIRRORED_MEMORY_IPP
+#define ASIO_DETAIL_IMPL_MIRRORED_MEMORY_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_RING_BUFFER)
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <limits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(__linux__)
+# include <sys/syscall.h>
+#endif // defined(__linux__)
+#include "asio/detail/mirrored_memory.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+namespace mirrored_memory_ops {
+
+// Create an anonymous file to hold the memory, returning -1 on failure.
+inline int open_file()
+{
+#if defined(__linux__) && defined(SYS_memfd_create)
+  const unsigned int memfd_cloexec = 1;
+  int fd = static_cast<int>(::syscall(SYS_memfd_create,
+        "asio.ring_buffer", memfd_cloexec));
+  if (fd != -1 || errno != ENOSYS)
+    return fd;
+#endif // defined(__linux__) && defined(SYS_memfd_create)
+
+  // Fall back to a shared memory object whose name is removed immediately.
+  static std::atomic<unsigned int> counter(0);
+  for (int attempt = 0; attempt < 16; ++attempt)
+  {
+    char name[32];
+    std::snprintf(name, sizeof(name), "/asio.rb.%x.%x",
+        static_cast<unsigned int>(::getpid()), counter++);
+    int fd = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd != -1)
+    {
+      ::shm_unlink(name);
+      ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+      return fd;
+    }
+    if (errno != EEXIST)
+      return -1;
+  }
+  return -1;
+}
+
+} // namespace mirrored_memory_ops
+
+mirrored_memory::mirrored_memory(std::size_t size)
+  : data_(0),
+    size_(0)
+{
+  long page_size = ::sysconf(_SC_PAGESIZE);
+  std::size_t page = page_size > 0 ? static_cast<std::size_t>(page_size) : 4096;
+  if (size > (std::numeric_limits<std::size_t>::max)() / 2 - page)
+  {
+    asio::error_code ec(asio::error::no_memory);
+    asio::detail::throw_error(ec, "mirrored_memory");
+  }
+  std::size_t length = size == 0 ? page : (size + page - 1) / page * page;
+
+  int fd = mirrored_memory_ops::open_file();
+  if (fd == -1 || ::ftruncate(fd, static_cast<off_t>(length)) != 0)
+  {
+    asio::error_code ec(errno, asio::error::get_system_category());
+    if (fd != -1)
+      ::close(fd);
+    asio::detail::throw_error(ec, "mirrored_memory");
+  }
+
+  // Reserve address space for both mappings, then map the file over each half
+  // of the reservation.
+  void* base = ::mmap(0, 2 * length, PROT_NONE, MAP_PRIVATE | MAP_ANON, -1, 0);
+  if (base == MAP_FAILED)
+  {
+    asio::error_code ec(errno, asio::error::get_system_category());
+    ::close(fd);
+    asio::detail::throw_error(ec, "mirrored_memory");
+  }
+
+  unsigned char* p = static_cast<unsigned char*>(base);
+  if (::mmap(p, length, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+      || ::mmap(p + length, length, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+  {
+    asio::error_code ec(errno, asio::error::get_system_category());
+    ::munmap(base, 2 * length);
+    ::close(fd);
+    asio::detail::throw_error(ec, "mirrored_memory");
+  }
+
+  // The mappings keep the file alive.
+  ::close(fd);
+
+  data_ = p;
+  size_ = length;
+}
+
+mirrored_memory::~mirrored_memory()
+{
+  if (data_)
+    ::munmap(data_, 2 * size_);
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_RING_BUFFER)
+
+#endif // ASIO_DETAIL_IMPL_MIRRORED_MEMORY_IPP
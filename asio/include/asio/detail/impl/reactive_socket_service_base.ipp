@@ -233,6 +233,19 @@ asio::error_code reactive_socket_service_base::do_assign(
   return ec;
 }
 
+asio::error_code reactive_socket_service_base::do_assign_accepted(
+    reactive_socket_service_base::base_implementation_type& impl, int type,
+    const reactive_socket_service_base::native_handle_type& native_socket,
+    asio::error_code& ec)
+{
+  if (!do_assign(impl, type, native_socket, ec))
+  {
+    impl.state_ &= ~socket_ops::possible_dup;
+    impl.state_ |= socket_ops::internal_non_blocking;
+  }
+  return ec;
+}
+
 void reactive_socket_service_base::do_start_op(
     reactive_socket_service_base::base_implementation_type& impl, int op_type,
     reactor_op* op, bool is_continuation, bool is_non_blocking, bool noop,
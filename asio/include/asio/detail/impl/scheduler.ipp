@@ -65,6 +65,10 @@ struct scheduler::task_cleanup
     }
     this_thread_->private_outstanding_work = 0;
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+    scheduler::mark_ready(this_thread_->private_op_queue);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
     // Enqueue the completed operations and reinsert the task at the end of
     // the operation queue.
     lock_->lock();
@@ -108,6 +112,74 @@ struct scheduler::work_cleanup
   thread_info* this_thread_;
 };
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+struct scheduler::handler_timer
+{
+  handler_timer(scheduler* s, thread_info& this_thread, operation* o)
+    : scheduler_(s),
+      metrics_(this_thread.metrics()),
+      start_(chrono::steady_clock::now()),
+      queue_wait_(0),
+      completed_(false),
+      file_name_(o->file_name_),
+      line_(o->line_),
+      function_name_(o->function_name_)
+  {
+    if (o->ready_time_ != chrono::steady_clock::time_point())
+    {
+      queue_wait_ = chrono::duration_cast<chrono::nanoseconds>(
+          start_ - o->ready_time_);
+      metrics_.record(thread_metrics::queue_wait_histogram, queue_wait_);
+
+      // Some operations, such as the reactor's descriptor state, are reused.
+      o->ready_time_ = chrono::steady_clock::time_point();
+    }
+  }
+
+  ~handler_timer()
+  {
+    // The handler exited with an exception. The slow handler callback is not
+    // invoked here, as it may itself throw during stack unwinding.
+    if (!completed_)
+      record();
+  }
+
+  // Record the execution of a handler that returned normally.
+  void complete()
+  {
+    completed_ = true;
+    chrono::nanoseconds d = record();
+    if (d.count() >= scheduler_->slow_handler_threshold_.load(
+          std::memory_order_relaxed))
+    {
+      slow_handler_info info = { queue_wait_, d,
+        file_name_, line_, function_name_ };
+      scheduler_->report_slow_handler(info);
+    }
+  }
+
+  chrono::nanoseconds record()
+  {
+    chrono::nanoseconds d = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now() - start_);
+    metrics_.add(thread_metrics::handlers_executed, 1);
+    metrics_.add(thread_metrics::handler_execution_ns,
+        static_cast<std::uint64_t>(d.count()));
+    metrics_.record(thread_metrics::execution_histogram, d);
+    return d;
+  }
+
+  scheduler* scheduler_;
+  thread_metrics& metrics_;
+  chrono::steady_clock::time_point start_;
+  chrono::nanoseconds queue_wait_;
+  bool completed_;
+  const char* file_name_;
+  int line_;
+  const char* function_name_;
+};
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 scheduler::scheduler(asio::execution_context& ctx,
     int concurrency_hint, bool own_thread, get_task_func_type get_task)
   : asio::detail::execution_context_service_base<scheduler>(ctx),
@@ -126,6 +198,10 @@ scheduler::scheduler(asio::execution_context& ctx,
     shutdown_(false),
     concurrency_hint_(concurrency_hint),
     thread_(0)
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+    , slow_handler_mutex_(true),
+      slow_handler_threshold_((std::numeric_limits<std::int64_t>::max)())
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
 {
   ASIO_HANDLER_TRACKING_INIT;
 
@@ -202,6 +278,10 @@ std::size_t scheduler::run(asio::error_code& ec)
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  thread_metrics_list::scoped_registration metrics_registration(
+      thread_metrics_, this_thread.metrics());
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
 
   mutex::scoped_lock lock(mutex_);
 
@@ -224,6 +304,10 @@ std::size_t scheduler::run_one(asio::error_code& ec)
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  thread_metrics_list::scoped_registration metrics_registration(
+      thread_metrics_, this_thread.metrics());
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
 
   mutex::scoped_lock lock(mutex_);
 
@@ -242,6 +326,10 @@ std::size_t scheduler::wait_one(long usec, asio::error_code& ec)
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  thread_metrics_list::scoped_registration metrics_registration(
+      thread_metrics_, this_thread.metrics());
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
 
   mutex::scoped_lock lock(mutex_);
 
@@ -260,6 +348,10 @@ std::size_t scheduler::poll(asio::error_code& ec)
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  thread_metrics_list::scoped_registration metrics_registration(
+      thread_metrics_, this_thread.metrics());
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
 
   mutex::scoped_lock lock(mutex_);
 
@@ -291,6 +383,10 @@ std::size_t scheduler::poll_one(asio::error_code& ec)
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  thread_metrics_list::scoped_registration metrics_registration(
+      thread_metrics_, this_thread.metrics());
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
 
   mutex::scoped_lock lock(mutex_);
 
@@ -345,6 +441,10 @@ void scheduler::capture_current_exception()
 void scheduler::post_immediate_completion(
     scheduler::operation* op, bool is_continuation)
 {
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  mark_ready(op);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 #if defined(ASIO_HAS_THREADS)
   if (one_thread_ || is_continuation)
   {
@@ -368,6 +468,10 @@ void scheduler::post_immediate_completion(
 void scheduler::post_immediate_completions(std::size_t n,
     op_queue<scheduler::operation>& ops, bool is_continuation)
 {
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  mark_ready(ops);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 #if defined(ASIO_HAS_THREADS)
   if (one_thread_ || is_continuation)
   {
@@ -391,6 +495,10 @@ void scheduler::post_immediate_completions(std::size_t n,
 
 void scheduler::post_deferred_completion(scheduler::operation* op)
 {
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  mark_ready(op);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 #if defined(ASIO_HAS_THREADS)
   if (one_thread_)
   {
@@ -412,6 +520,10 @@ void scheduler::post_deferred_completions(
 {
   if (!ops.empty())
   {
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+    mark_ready(ops);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 #if defined(ASIO_HAS_THREADS)
     if (one_thread_)
     {
@@ -432,6 +544,10 @@ void scheduler::post_deferred_completions(
 void scheduler::do_dispatch(
     scheduler::operation* op)
 {
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  mark_ready(op);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
   work_started();
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
@@ -488,8 +604,15 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
         work_cleanup on_exit = { this, &lock, &this_thread };
         (void)on_exit;
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+        handler_timer timer(this, this_thread, o);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
         // Complete the operation. May throw an exception. Deletes the object.
         o->complete(this, ec, task_result);
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+        timer.complete();
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
         this_thread.rethrow_pending_exception();
 
         return 1;
@@ -569,8 +692,15 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
   work_cleanup on_exit = { this, &lock, &this_thread };
   (void)on_exit;
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  handler_timer timer(this, this_thread, o);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
   // Complete the operation. May throw an exception. Deletes the object.
   o->complete(this, ec, task_result);
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  timer.complete();
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
   this_thread.rethrow_pending_exception();
 
   return 1;
@@ -624,13 +754,95 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   work_cleanup on_exit = { this, &lock, &this_thread };
   (void)on_exit;
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  handler_timer timer(this, this_thread, o);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
   // Complete the operation. May throw an exception. Deletes the object.
   o->complete(this, ec, task_result);
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  timer.complete();
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
   this_thread.rethrow_pending_exception();
 
   return 1;
 }
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+void scheduler::get_metrics(io_context_metrics& m)
+{
+  mutex::scoped_lock lock(mutex_);
+  m.queue_depth = op_queue_.size();
+  if (op_queue_.is_enqueued(&task_operation_))
+    --m.queue_depth;
+  scheduler_task* task = task_;
+  lock.unlock();
+
+  m.outstanding_work = static_cast<std::size_t>(outstanding_work_);
+  m.threads = thread_metrics_.size();
+  m.handlers_executed =
+    thread_metrics_.total(thread_metrics::handlers_executed);
+  m.handler_execution_time = chrono::nanoseconds(
+      thread_metrics_.total(thread_metrics::handler_execution_ns));
+  m.reactor_wakeups = thread_metrics_.total(thread_metrics::reactor_wakeups);
+  m.reactor_events = thread_metrics_.total(thread_metrics::reactor_events);
+  m.queue_wait_histogram =
+    thread_metrics_.total(thread_metrics::queue_wait_histogram);
+  m.execution_histogram =
+    thread_metrics_.total(thread_metrics::execution_histogram);
+
+  if (task)
+    task->get_metrics(m);
+}
+
+void scheduler::set_slow_handler_callback(
+    chrono::nanoseconds threshold, slow_handler_callback callback)
+{
+  std::shared_ptr<slow_handler_callback> new_callback;
+  if (callback)
+  {
+    new_callback = std::make_shared<slow_handler_callback>(
+        static_cast<slow_handler_callback&&>(callback));
+  }
+
+  mutex::scoped_lock lock(slow_handler_mutex_);
+  slow_handler_threshold_.store(new_callback
+      ? static_cast<std::int64_t>(threshold.count())
+      : (std::numeric_limits<std::int64_t>::max)(),
+      std::memory_order_relaxed);
+  slow_handler_callback_.swap(new_callback);
+}
+
+void scheduler::mark_ready(scheduler::operation* op)
+{
+  op->ready_time_ = chrono::steady_clock::now();
+}
+
+void scheduler::mark_ready(op_queue<scheduler::operation>& ops)
+{
+  chrono::steady_clock::time_point now = chrono::steady_clock::time_point();
+  for (operation* op = ops.front(); op; op = op_queue_access::next(op))
+  {
+    if (op->ready_time_ == chrono::steady_clock::time_point())
+    {
+      if (now == chrono::steady_clock::time_point())
+        now = chrono::steady_clock::now();
+      op->ready_time_ = now;
+    }
+  }
+}
+
+void scheduler::report_slow_handler(const slow_handler_info& info)
+{
+  mutex::scoped_lock lock(slow_handler_mutex_);
+  std::shared_ptr<slow_handler_callback> callback = slow_handler_callback_;
+  lock.unlock();
+
+  if (callback)
+    (*callback)(info);
+}
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 void scheduler::stop_all_threads(
     mutex::scoped_lock& lock)
 {
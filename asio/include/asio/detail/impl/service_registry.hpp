@@ -23,19 +23,27 @@ namespace detail {
 template <typename Service>
 Service& service_registry::use_service()
 {
+  std::size_t index = service_index<Service>();
+  if (execution_context::service* service = find_cached_service(index))
+    return *static_cast<Service*>(service);
+
   execution_context::service::key key;
   init_key<Service>(key, 0);
   factory_type factory = &service_registry::create<Service, execution_context>;
-  return *static_cast<Service*>(do_use_service(key, factory, &owner_));
+  return *static_cast<Service*>(do_use_service(key, factory, &owner_, index));
 }
 
 template <typename Service>
 Service& service_registry::use_service(io_context& owner)
 {
+  std::size_t index = service_index<Service>();
+  if (execution_context::service* service = find_cached_service(index))
+    return *static_cast<Service*>(service);
+
   execution_context::service::key key;
   init_key<Service>(key, 0);
   factory_type factory = &service_registry::create<Service, io_context>;
-  return *static_cast<Service*>(do_use_service(key, factory, &owner));
+  return *static_cast<Service*>(do_use_service(key, factory, &owner, index));
 }
 
 template <typename Service>
@@ -49,11 +57,33 @@ void service_registry::add_service(Service* new_service)
 template <typename Service>
 bool service_registry::has_service() const
 {
+  if (find_cached_service(service_index<Service>()))
+    return true;
+
   execution_context::service::key key;
   init_key<Service>(key, 0);
   return do_has_service(key);
 }
 
+template <typename Service>
+std::size_t service_registry::service_index()
+{
+  // The index only identifies a slot in the lookup table. Keys remain the
+  // authority on service identity, so it does not matter if a type is given
+  // more than one index, for example when used from several shared libraries.
+  static const std::size_t index = next_service_index();
+  return index;
+}
+
+inline execution_context::service* service_registry::find_cached_service(
+    std::size_t index) const
+{
+  lookup_table* table = lookup_table_.load(std::memory_order_acquire);
+  if (table && index < table->size_)
+    return table->slots_[index].load(std::memory_order_acquire);
+  return 0;
+}
+
 template <typename Service>
 inline void service_registry::init_key(
     execution_context::service::key& key, ...)
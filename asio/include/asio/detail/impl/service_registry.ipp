@@ -25,14 +25,37 @@
 namespace asio {
 namespace detail {
 
+service_registry::lookup_table::lookup_table(std::size_t size)
+  : size_(size),
+    slots_(new std::atomic<execution_context::service*>[size]),
+    next_retired_(0)
+{
+  for (std::size_t i = 0; i < size_; ++i)
+    slots_[i].store(0, std::memory_order_relaxed);
+}
+
+service_registry::lookup_table::~lookup_table()
+{
+  delete[] slots_;
+}
+
 service_registry::service_registry(execution_context& owner)
   : owner_(owner),
-    first_service_(0)
+    first_service_(0),
+    lookup_table_(0),
+    retired_tables_(0)
 {
 }
 
 service_registry::~service_registry()
 {
+  delete lookup_table_.load(std::memory_order_relaxed);
+  while (retired_tables_)
+  {
+    lookup_table* next_table = retired_tables_->next_retired_;
+    delete retired_tables_;
+    retired_tables_ = next_table;
+  }
 }
 
 void service_registry::shutdown_services()
@@ -47,6 +70,14 @@ void service_registry::shutdown_services()
 
 void service_registry::destroy_services()
 {
+  // Services created after this point must be found via the list.
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    if (lookup_table* table = lookup_table_.load(std::memory_order_relaxed))
+      for (std::size_t i = 0; i < table->size_; ++i)
+        table->slots_[i].store(0, std::memory_order_release);
+  }
+
   while (first_service_)
   {
     execution_context::service* next_service = first_service_->next_;
@@ -84,6 +115,12 @@ void service_registry::notify_fork(execution_context::fork_event fork_ev)
       services[i - 1]->notify_fork(fork_ev);
 }
 
+std::size_t service_registry::next_service_index()
+{
+  static std::atomic<std::size_t> next_index(0);
+  return next_index.fetch_add(1, std::memory_order_relaxed);
+}
+
 void service_registry::init_key_from_id(execution_context::service::key& key,
     const execution_context::id& id)
 {
@@ -111,7 +148,7 @@ void service_registry::destroy(execution_context::service* service)
 
 execution_context::service* service_registry::do_use_service(
     const execution_context::service::key& key,
-    factory_type factory, void* owner)
+    factory_type factory, void* owner, std::size_t index)
 {
   asio::detail::mutex::scoped_lock lock(mutex_);
 
@@ -120,7 +157,10 @@ execution_context::service* service_registry::do_use_service(
   while (service)
   {
     if (keys_match(service->key_, key))
+    {
+      cache_service(index, service);
       return service;
+    }
     service = service->next_;
   }
 
@@ -138,7 +178,10 @@ execution_context::service* service_registry::do_use_service(
   while (service)
   {
     if (keys_match(service->key_, key))
+    {
+      cache_service(index, service);
       return service;
+    }
     service = service->next_;
   }
 
@@ -146,6 +189,7 @@ execution_context::service* service_registry::do_use_service(
   new_service.ptr_->next_ = first_service_;
   first_service_ = new_service.ptr_;
   new_service.ptr_ = 0;
+  cache_service(index, first_service_);
   return first_service_;
 }
 
@@ -189,6 +233,36 @@ bool service_registry::do_has_service(
   return false;
 }
 
+void service_registry::cache_service(std::size_t index,
+    execution_context::service* service)
+{
+  lookup_table* table = lookup_table_.load(std::memory_order_relaxed);
+  if (table && index < table->size_)
+  {
+    table->slots_[index].store(service, std::memory_order_release);
+    return;
+  }
+
+  // Replace the table with one that is large enough to hold the index.
+  std::size_t new_size = table ? table->size_ * 2 : 16;
+  while (new_size <= index)
+    new_size *= 2;
+  lookup_table* new_table = new lookup_table(new_size);
+  if (table)
+  {
+    for (std::size_t i = 0; i < table->size_; ++i)
+    {
+      new_table->slots_[i].store(
+          table->slots_[i].load(std::memory_order_relaxed),
+          std::memory_order_relaxed);
+    }
+    table->next_retired_ = retired_tables_;
+    retired_tables_ = table;
+  }
+  new_table->slots_[index].store(service, std::memory_order_relaxed);
+  lookup_table_.store(new_table, std::memory_order_release);
+}
+
 } // namespace detail
 } // namespace asio
 
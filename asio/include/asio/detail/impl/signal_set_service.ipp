@@ -30,6 +30,10 @@
 # include "asio/detail/reactor.hpp"
 #endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
 
+#if defined(ASIO_HAS_SIGNALFD)
+# include <sys/signalfd.h>
+#endif // defined(ASIO_HAS_SIGNALFD)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -103,52 +107,70 @@ class signal_set_service::pipe_read_op :
 {
 public:
 # if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
-  pipe_read_op()
+  explicit pipe_read_op(int descriptor)
     : io_uring_operation(asio::error_code(), &pipe_read_op::do_prepare,
-        &pipe_read_op::do_perform, pipe_read_op::do_complete)
+        &pipe_read_op::do_perform, pipe_read_op::do_complete),
+      descriptor_(descriptor)
   {
   }
 
-  static void do_prepare(io_uring_operation*, ::io_uring_sqe* sqe)
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
   {
-    signal_state* state = get_signal_state();
+    pipe_read_op* o(static_cast<pipe_read_op*>(base));
 
-    int fd = state->read_descriptor_;
-    ::io_uring_prep_poll_add(sqe, fd, POLLIN);
+    ::io_uring_prep_poll_add(sqe, o->descriptor_, POLLIN);
   }
 
-  static bool do_perform(io_uring_operation*, bool)
+  static bool do_perform(io_uring_operation* base, bool)
   {
-    signal_state* state = get_signal_state();
-
-    int fd = state->read_descriptor_;
-    int signal_number = 0;
-    while (::read(fd, &signal_number, sizeof(int)) == sizeof(int))
-      if (signal_number >= 0 && signal_number < max_signal_number)
-        signal_set_service::deliver_signal(signal_number);
+    pipe_read_op* o(static_cast<pipe_read_op*>(base));
 
+    read_signals(o->descriptor_);
     return false;
   }
 # else // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
-  pipe_read_op()
+  explicit pipe_read_op(int descriptor)
     : reactor_op(asio::error_code(),
-        &pipe_read_op::do_perform, pipe_read_op::do_complete)
+        &pipe_read_op::do_perform, pipe_read_op::do_complete),
+      descriptor_(descriptor)
   {
   }
 
-  static status do_perform(reactor_op*)
+  static status do_perform(reactor_op* base)
   {
-    signal_state* state = get_signal_state();
+    pipe_read_op* o(static_cast<pipe_read_op*>(base));
+
+    read_signals(o->descriptor_);
+    return not_done;
+  }
+# endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+  static void read_signals(int fd)
+  {
+# if defined(ASIO_HAS_SIGNALFD)
+    // Drain the signalfd, which returns as many queued signals as will fit.
+    signalfd_siginfo info[16];
+    for (;;)
+    {
+      signed_size_type bytes = ::read(fd, info, sizeof(info));
+      if (bytes < static_cast<signed_size_type>(sizeof(signalfd_siginfo)))
+        break;
 
-    int fd = state->read_descriptor_;
+      std::size_t count = static_cast<std::size_t>(bytes) / sizeof(info[0]);
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        int signal_number = static_cast<int>(info[i].ssi_signo);
+        if (signal_number >= 0 && signal_number < max_signal_number)
+          signal_set_service::deliver_signal(signal_number);
+      }
+    }
+# else // defined(ASIO_HAS_SIGNALFD)
     int signal_number = 0;
     while (::read(fd, &signal_number, sizeof(int)) == sizeof(int))
       if (signal_number >= 0 && signal_number < max_signal_number)
         signal_set_service::deliver_signal(signal_number);
-
-    return not_done;
+# endif // defined(ASIO_HAS_SIGNALFD)
   }
-# endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
 
   static void do_complete(void* /*owner*/, operation* base,
       const asio::error_code& /*ec*/,
@@ -157,6 +179,10 @@ public:
     pipe_read_op* o(static_cast<pipe_read_op*>(base));
     delete o;
   }
+
+private:
+  // The pipe or signalfd descriptor to be read.
+  int descriptor_;
 };
 #endif // !defined(ASIO_WINDOWS)
        //   && !defined(ASIO_WINDOWS_RUNTIME)
@@ -176,11 +202,28 @@ signal_set_service::signal_set_service(execution_context& context)
 #endif // !defined(ASIO_WINDOWS)
        //   && !defined(ASIO_WINDOWS_RUNTIME)
        //   && !defined(__CYGWIN__)
+#if defined(ASIO_HAS_SIGNALFD)
+    signal_descriptor_(-1),
+#endif // defined(ASIO_HAS_SIGNALFD)
     next_(0),
     prev_(0)
 {
   get_signal_state()->mutex_.init();
 
+#if defined(ASIO_HAS_SIGNALFD)
+  // Start with an empty mask. Signals are added as they are registered with
+  // this service's signal sets.
+  sigemptyset(&signal_mask_);
+  signal_descriptor_ = ::signalfd(-1, &signal_mask_,
+      SFD_NONBLOCK | SFD_CLOEXEC);
+  if (signal_descriptor_ == -1)
+  {
+    asio::error_code ec(errno,
+        asio::error::get_system_category());
+    asio::detail::throw_error(ec, "signalfd");
+  }
+#endif // defined(ASIO_HAS_SIGNALFD)
+
 #if !defined(ASIO_WINDOWS) \
   && !defined(ASIO_WINDOWS_RUNTIME) \
   && !defined(__CYGWIN__)
@@ -202,6 +245,10 @@ signal_set_service::signal_set_service(execution_context& context)
 signal_set_service::~signal_set_service()
 {
   remove_service(this);
+
+#if defined(ASIO_HAS_SIGNALFD)
+  ::close(signal_descriptor_);
+#endif // defined(ASIO_HAS_SIGNALFD)
 }
 
 void signal_set_service::shutdown()
@@ -235,7 +282,7 @@ void signal_set_service::notify_fork(execution_context::fork_event fork_ev)
   {
   case execution_context::fork_prepare:
     {
-      int read_descriptor = state->read_descriptor_;
+      int read_descriptor = notification_descriptor();
       state->fork_prepared_ = true;
       lock.unlock();
 # if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
@@ -251,35 +298,38 @@ void signal_set_service::notify_fork(execution_context::fork_event fork_ev)
   case execution_context::fork_parent:
     if (state->fork_prepared_)
     {
-      int read_descriptor = state->read_descriptor_;
+      int read_descriptor = notification_descriptor();
       state->fork_prepared_ = false;
       lock.unlock();
 # if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
-      (void)read_descriptor;
       io_uring_service_.register_internal_io_object(io_object_data_,
-          io_uring_service::read_op, new pipe_read_op);
+          io_uring_service::read_op, new pipe_read_op(read_descriptor));
 # else // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
       reactor_.register_internal_descriptor(reactor::read_op,
-          read_descriptor, reactor_data_, new pipe_read_op);
+          read_descriptor, reactor_data_, new pipe_read_op(read_descriptor));
 # endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
     }
     break;
   case execution_context::fork_child:
     if (state->fork_prepared_)
     {
+# if defined(ASIO_HAS_SIGNALFD)
+      // An inherited signalfd reads the signals queued for the child process,
+      // so unlike the pipe it need not be recreated.
+# else // defined(ASIO_HAS_SIGNALFD)
       asio::detail::signal_blocker blocker;
       close_descriptors();
       open_descriptors();
-      int read_descriptor = state->read_descriptor_;
+# endif // defined(ASIO_HAS_SIGNALFD)
+      int read_descriptor = notification_descriptor();
       state->fork_prepared_ = false;
       lock.unlock();
 # if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
-      (void)read_descriptor;
       io_uring_service_.register_internal_io_object(io_object_data_,
-          io_uring_service::read_op, new pipe_read_op);
+          io_uring_service::read_op, new pipe_read_op(read_descriptor));
 # else // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
       reactor_.register_internal_descriptor(reactor::read_op,
-          read_descriptor, reactor_data_, new pipe_read_op);
+          read_descriptor, reactor_data_, new pipe_read_op(read_descriptor));
 # endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
     }
     break;
@@ -320,14 +370,15 @@ asio::error_code signal_set_service::add(
     return ec;
   }
 
-  // Check that the specified flags are supported.
-#if !defined(ASIO_HAS_SIGACTION)
+  // Check that the specified flags are supported. No handler is installed
+  // when signals are received through a signalfd.
+#if !defined(ASIO_HAS_SIGACTION) || defined(ASIO_HAS_SIGNALFD)
   if (f != signal_set_base::flags::dont_care)
   {
     ec = asio::error::operation_not_supported;
     return ec;
   }
-#endif // !defined(ASIO_HAS_SIGACTION)
+#endif // !defined(ASIO_HAS_SIGACTION) || defined(ASIO_HAS_SIGNALFD)
 
   signal_state* state = get_signal_state();
   static_mutex::scoped_lock lock(state->mutex_);
@@ -346,7 +397,14 @@ asio::error_code signal_set_service::add(
   {
     registration* new_registration = new registration;
 
-#if defined(ASIO_HAS_SIGNAL) || defined(ASIO_HAS_SIGACTION)
+#if defined(ASIO_HAS_SIGNALFD)
+    // Accept the signal through this service's signalfd.
+    if (update_signal_mask(signal_number, true, ec))
+    {
+      delete new_registration;
+      return ec;
+    }
+#elif defined(ASIO_HAS_SIGNAL) || defined(ASIO_HAS_SIGACTION)
     // Register for the signal if we're the first.
     if (state->registration_count_[signal_number] == 0)
     {
@@ -405,7 +463,7 @@ asio::error_code signal_set_service::add(
       }
     }
 # endif // defined(ASIO_HAS_SIGACTION)
-#endif // defined(ASIO_HAS_SIGNAL) || defined(ASIO_HAS_SIGACTION)
+#endif // defined(ASIO_HAS_SIGNALFD)
 
     // Record the new registration in the set.
     new_registration->signal_number_ = signal_number;
@@ -451,7 +509,11 @@ asio::error_code signal_set_service::remove(
 
   if (reg != 0 && reg->signal_number_ == signal_number)
   {
-#if defined(ASIO_HAS_SIGNAL) || defined(ASIO_HAS_SIGACTION)
+#if defined(ASIO_HAS_SIGNALFD)
+    // Stop accepting the signal through this service's signalfd.
+    if (update_signal_mask(signal_number, false, ec))
+      return ec;
+#elif defined(ASIO_HAS_SIGNAL) || defined(ASIO_HAS_SIGACTION)
     // Set signal handler back to the default if we're the last.
     if (state->registration_count_[signal_number] == 1)
     {
@@ -477,7 +539,7 @@ asio::error_code signal_set_service::remove(
       state->flags_[signal_number] = signal_set_base::flags_t();
 # endif // defined(ASIO_HAS_SIGACTION)
     }
-#endif // defined(ASIO_HAS_SIGNAL) || defined(ASIO_HAS_SIGACTION)
+#endif // defined(ASIO_HAS_SIGNALFD)
 
     // Remove the registration from the set.
     *deletion_point = reg->next_in_set_;
@@ -508,7 +570,11 @@ asio::error_code signal_set_service::clear(
 
   while (registration* reg = impl.signals_)
   {
-#if defined(ASIO_HAS_SIGNAL) || defined(ASIO_HAS_SIGACTION)
+#if defined(ASIO_HAS_SIGNALFD)
+    // Stop accepting the signal through this service's signalfd.
+    if (update_signal_mask(reg->signal_number_, false, ec))
+      return ec;
+#elif defined(ASIO_HAS_SIGNAL) || defined(ASIO_HAS_SIGACTION)
     // Set signal handler back to the default if we're the last.
     if (state->registration_count_[reg->signal_number_] == 1)
     {
@@ -534,7 +600,7 @@ asio::error_code signal_set_service::clear(
       state->flags_[reg->signal_number_] = signal_set_base::flags_t();
 # endif // defined(ASIO_HAS_SIGACTION)
     }
-#endif // defined(ASIO_HAS_SIGNAL) || defined(ASIO_HAS_SIGACTION)
+#endif // defined(ASIO_HAS_SIGNALFD)
 
     // Remove the registration from the registration table.
     if (registrations_[reg->signal_number_] == reg)
@@ -648,11 +714,15 @@ void signal_set_service::add_service(signal_set_service* service)
   signal_state* state = get_signal_state();
   static_mutex::scoped_lock lock(state->mutex_);
 
-#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+#if !defined(ASIO_WINDOWS) \
+  && !defined(__CYGWIN__) \
+  && !defined(ASIO_HAS_SIGNALFD)
   // If this is the first service to be created, open a new pipe.
   if (state->service_list_ == 0)
     open_descriptors();
-#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+#endif // !defined(ASIO_WINDOWS)
+       //   && !defined(__CYGWIN__)
+       //   && !defined(ASIO_HAS_SIGNALFD)
 
   // If a scheduler_ object is thread-unsafe then it must be the only
   // scheduler used to create signal_set objects.
@@ -680,16 +750,17 @@ void signal_set_service::add_service(signal_set_service* service)
 #if !defined(ASIO_WINDOWS) \
   && !defined(ASIO_WINDOWS_RUNTIME) \
   && !defined(__CYGWIN__)
-  // Register for pipe readiness notifications.
-  int read_descriptor = state->read_descriptor_;
+  // Register for pipe or signalfd readiness notifications.
+  int read_descriptor = service->notification_descriptor();
   lock.unlock();
 # if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
-  (void)read_descriptor;
   service->io_uring_service_.register_internal_io_object(
-      service->io_object_data_, io_uring_service::read_op, new pipe_read_op);
+      service->io_object_data_, io_uring_service::read_op,
+      new pipe_read_op(read_descriptor));
 # else // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
   service->reactor_.register_internal_descriptor(reactor::read_op,
-      read_descriptor, service->reactor_data_, new pipe_read_op);
+      read_descriptor, service->reactor_data_,
+      new pipe_read_op(read_descriptor));
 # endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
 #endif // !defined(ASIO_WINDOWS)
        //   && !defined(ASIO_WINDOWS_RUNTIME)
@@ -706,8 +777,8 @@ void signal_set_service::remove_service(signal_set_service* service)
 #if !defined(ASIO_WINDOWS) \
   && !defined(ASIO_WINDOWS_RUNTIME) \
   && !defined(__CYGWIN__)
-    // Disable the pipe readiness notifications.
-    int read_descriptor = state->read_descriptor_;
+    // Disable the pipe or signalfd readiness notifications.
+    int read_descriptor = service->notification_descriptor();
     lock.unlock();
 # if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
     (void)read_descriptor;
@@ -734,11 +805,15 @@ void signal_set_service::remove_service(signal_set_service* service)
     service->next_ = 0;
     service->prev_ = 0;
 
-#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+#if !defined(ASIO_WINDOWS) \
+  && !defined(__CYGWIN__) \
+  && !defined(ASIO_HAS_SIGNALFD)
     // If this is the last service to be removed, close the pipe.
     if (state->service_list_ == 0)
       close_descriptors();
-#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+#endif // !defined(ASIO_WINDOWS)
+       //   && !defined(__CYGWIN__)
+       //   && !defined(ASIO_HAS_SIGNALFD)
   }
 }
 
@@ -793,6 +868,70 @@ void signal_set_service::close_descriptors()
        //   && !defined(__CYGWIN__)
 }
 
+int signal_set_service::notification_descriptor() const
+{
+#if defined(ASIO_HAS_SIGNALFD)
+  return signal_descriptor_;
+#elif !defined(ASIO_WINDOWS) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(__CYGWIN__)
+  return get_signal_state()->read_descriptor_;
+#else // !defined(ASIO_WINDOWS)
+      //   && !defined(ASIO_WINDOWS_RUNTIME)
+      //   && !defined(__CYGWIN__)
+  return -1;
+#endif // !defined(ASIO_WINDOWS)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(__CYGWIN__)
+}
+
+#if defined(ASIO_HAS_SIGNALFD)
+asio::error_code signal_set_service::update_signal_mask(
+    int signal_number, bool enable, asio::error_code& ec)
+{
+  sigset_t signals;
+  sigemptyset(&signals);
+  if (signal_number == SIGKILL || signal_number == SIGSTOP
+      || sigaddset(&signals, signal_number) == -1)
+  {
+    ec = asio::error::invalid_argument;
+    return ec;
+  }
+
+  // Only the first and last registrations in this service change the set of
+  // signals accepted by the signalfd.
+  registration* reg = registrations_[signal_number];
+  if (enable ? reg == 0 : (reg != 0 && reg->next_in_table_ == 0))
+  {
+    sigset_t new_mask = signal_mask_;
+    if (enable)
+      sigaddset(&new_mask, signal_number);
+    else
+      sigdelset(&new_mask, signal_number);
+
+    if (::signalfd(signal_descriptor_, &new_mask, 0) == -1)
+    {
+      ec = asio::error_code(errno,
+          asio::error::get_system_category());
+      return ec;
+    }
+
+    signal_mask_ = new_mask;
+  }
+
+  // A signal is only queued for the signalfd while it is blocked. Otherwise
+  // its default action is taken. The calling thread's mask is updated here,
+  // and is inherited by any threads it subsequently creates.
+  if (enable)
+    ::pthread_sigmask(SIG_BLOCK, &signals, 0);
+  else if (get_signal_state()->registration_count_[signal_number] == 1)
+    ::pthread_sigmask(SIG_UNBLOCK, &signals, 0);
+
+  ec = asio::error_code();
+  return ec;
+}
+#endif // defined(ASIO_HAS_SIGNALFD)
+
 void signal_set_service::start_wait_op(
     signal_set_service::implementation_type& impl, signal_op* op)
 {
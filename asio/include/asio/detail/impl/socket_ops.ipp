@@ -105,8 +105,29 @@ inline socket_type call_accept(SockLenType msghdr::*,
   return result;
 }
 
+#if defined(ASIO_HAS_ACCEPT4)
+template <typename SockLenType>
+inline socket_type call_accept4(SockLenType msghdr::*,
+    socket_type s, void* addr, std::size_t* addrlen, int flags)
+{
+  SockLenType tmp_addrlen = addrlen ? (SockLenType)*addrlen : 0;
+  socket_type result = ::accept4(s,
+      static_cast<socket_addr_type*>(addr),
+      addrlen ? &tmp_addrlen : 0, flags);
+  if (addrlen)
+    *addrlen = (std::size_t)tmp_addrlen;
+  return result;
+}
+#endif // defined(ASIO_HAS_ACCEPT4)
+
 socket_type accept(socket_type s, void* addr,
     std::size_t* addrlen, asio::error_code& ec)
+{
+  return socket_ops::accept(s, 0, addr, addrlen, ec);
+}
+
+socket_type accept(socket_type s, int flags,
+    void* addr, std::size_t* addrlen, asio::error_code& ec)
 {
   if (s == invalid_socket)
   {
@@ -114,11 +135,40 @@ socket_type accept(socket_type s, void* addr,
     return invalid_socket;
   }
 
+#if defined(ASIO_HAS_ACCEPT4)
+  if (flags != 0)
+  {
+    socket_type new_s = call_accept4(&msghdr::msg_namelen, s, addr, addrlen,
+        ((flags & accept_non_blocking) ? SOCK_NONBLOCK : 0)
+        | ((flags & accept_close_on_exec) ? SOCK_CLOEXEC : 0));
+    get_last_error(ec, new_s == invalid_socket);
+    if (new_s != invalid_socket || ec.value() != ENOSYS)
+      return new_s;
+    // Fall through to use accept() if accept4() is unavailable at runtime.
+  }
+#endif // defined(ASIO_HAS_ACCEPT4)
+
   socket_type new_s = call_accept(&msghdr::msg_namelen, s, addr, addrlen);
   get_last_error(ec, new_s == invalid_socket);
   if (new_s == invalid_socket)
     return new_s;
 
+  // Apply the requested flags, as accept4() would.
+  if (flags & accept_non_blocking)
+  {
+    state_type new_state = 0;
+    if (!set_internal_non_blocking(new_s, new_state, true, ec))
+    {
+      asio::error_code ignored_ec;
+      socket_ops::close(new_s, new_state, true, ignored_ec);
+      return invalid_socket;
+    }
+  }
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__) && defined(FD_CLOEXEC)
+  if (flags & accept_close_on_exec)
+    ::fcntl(new_s, F_SETFD, FD_CLOEXEC);
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__) && defined(FD_CLOEXEC)
+
 #if defined(__MACH__) && defined(__APPLE__) || defined(__FreeBSD__)
   int optval = 1;
   int result = ::setsockopt(new_s, SOL_SOCKET,
@@ -136,13 +186,13 @@ socket_type accept(socket_type s, void* addr,
 }
 
 socket_type sync_accept(socket_type s, state_type state,
-    void* addr, std::size_t* addrlen, asio::error_code& ec)
+    int flags, void* addr, std::size_t* addrlen, asio::error_code& ec)
 {
   // Accept a socket.
   for (;;)
   {
     // Try to complete the operation without blocking.
-    socket_type new_socket = socket_ops::accept(s, addr, addrlen, ec);
+    socket_type new_socket = socket_ops::accept(s, flags, addr, addrlen, ec);
 
     // Check if operation succeeded.
     if (new_socket != invalid_socket)
@@ -226,13 +276,13 @@ void complete_iocp_accept(socket_type s, void* output_buffer,
 #else // defined(ASIO_HAS_IOCP)
 
 bool non_blocking_accept(socket_type s,
-    state_type state, void* addr, std::size_t* addrlen,
+    state_type state, int flags, void* addr, std::size_t* addrlen,
     asio::error_code& ec, socket_type& new_socket)
 {
   for (;;)
   {
     // Accept the waiting connection.
-    new_socket = socket_ops::accept(s, addr, addrlen, ec);
+    new_socket = socket_ops::accept(s, flags, addr, addrlen, ec);
 
     // Check if operation succeeded.
     if (new_socket != invalid_socket)
@@ -1948,6 +1998,23 @@ int setsockopt(socket_type s, state_type& state, int level, int optname,
     return 0;
   }
 
+  if (level == custom_socket_option_level
+      && optname == fast_accept_option)
+  {
+    if (optlen != sizeof(int))
+    {
+      ec = asio::error::invalid_argument;
+      return socket_error_retval;
+    }
+
+    if (*static_cast<const int*>(optval))
+      state |= fast_accept;
+    else
+      state &= ~fast_accept;
+    asio::error::clear(ec);
+    return 0;
+  }
+
   if (level == SOL_SOCKET && optname == SO_LINGER)
     state |= user_set_linger;
 
@@ -2033,6 +2100,20 @@ int getsockopt(socket_type s, state_type state, int level, int optname,
     return 0;
   }
 
+  if (level == custom_socket_option_level
+      && optname == fast_accept_option)
+  {
+    if (*optlen != sizeof(int))
+    {
+      ec = asio::error::invalid_argument;
+      return socket_error_retval;
+    }
+
+    *static_cast<int*>(optval) = (state & fast_accept) ? 1 : 0;
+    asio::error::clear(ec);
+    return 0;
+  }
+
 #if defined(__BORLANDC__)
   // Mysteriously, using the getsockopt and setsockopt functions directly with
   // Borland C++ results in incorrect values being set and read. The bug can be
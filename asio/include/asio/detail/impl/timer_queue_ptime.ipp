@@ -69,6 +69,14 @@ void timer_queue<time_traits<boost::posix_time::ptime>>::get_all_timers(
   impl_.get_all_timers(ops);
 }
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+std::size_t
+timer_queue<time_traits<boost::posix_time::ptime>>::pending_timers() const
+{
+  return impl_.pending_timers();
+}
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 std::size_t timer_queue<time_traits<boost::posix_time::ptime>>::cancel_timer(
     per_timer_data& timer, op_queue<operation>& ops, std::size_t max_cancelled)
 {
@@ -93,6 +93,15 @@ void timer_queue_set::get_all_timers(op_queue<operation>& ops)
     p->get_all_timers(ops);
 }
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+void timer_queue_set::get_pending_timers(
+    std::vector<std::size_t>& counts) const
+{
+  for (timer_queue_base* p = first_; p; p = p->next_)
+    counts.push_back(p->pending_timers());
+}
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 } // namespace detail
 } // namespace asio
 
@@ -109,6 +109,20 @@ void win_iocp_io_context::move_timer(timer_queue<Time_Traits>& queue,
   post_deferred_completions(ops);
 }
 
+template <typename Time_Traits>
+void win_iocp_io_context::reschedule_timer(timer_queue<Time_Traits>& queue,
+    typename timer_queue<Time_Traits>::per_timer_data& timer,
+    const typename Time_Traits::time_type& time)
+{
+  // If the service has been shut down we silently ignore the change.
+  if (::InterlockedExchangeAdd(&shutdown_, 0) != 0)
+    return;
+
+  mutex::scoped_lock lock(dispatch_mutex_);
+  if (queue.reschedule_timer(timer, time))
+    update_timeout();
+}
+
 } // namespace detail
 } // namespace asio
 
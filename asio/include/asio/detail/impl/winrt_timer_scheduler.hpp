@@ -82,6 +82,16 @@ void winrt_timer_scheduler::move_timer(timer_queue<Time_Traits>& queue,
   scheduler_.post_deferred_completions(ops);
 }
 
+template <typename Time_Traits>
+void winrt_timer_scheduler::reschedule_timer(timer_queue<Time_Traits>& queue,
+    typename timer_queue<Time_Traits>::per_timer_data& timer,
+    const typename Time_Traits::time_type& time)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  if (queue.reschedule_timer(timer, time))
+    event_.signal(lock);
+}
+
 } // namespace detail
 } // namespace asio
 
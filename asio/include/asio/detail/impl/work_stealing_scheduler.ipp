@@ -0,0 +1,228 @@
+//
+// detail/impl/work_stealing_scheduler.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_WORK_STEALING_SCHEDULER_IPP
+#define ASIO_DETAIL_IMPL_WORK_STEALING_SCHEDULER_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstdint>
+#include "asio/detail/chase_lev_deque.hpp"
+#include "asio/detail/thread_info_base.hpp"
+#include "asio/detail/work_stealing_scheduler.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+struct work_stealing_scheduler::worker : thread_info_base
+{
+  worker()
+    : random_state_(0)
+  {
+  }
+
+  // Choose the worker from which to start looking for work to steal.
+  std::size_t next_victim(std::size_t num_workers)
+  {
+    // Use an xorshift generator, seeded from the worker's address.
+    if (random_state_ == 0)
+      random_state_ = static_cast<std::uint32_t>(
+          reinterpret_cast<std::size_t>(this) >> 4) | 1;
+    random_state_ ^= random_state_ << 13;
+    random_state_ ^= random_state_ >> 17;
+    random_state_ ^= random_state_ << 5;
+    return random_state_ % num_workers;
+  }
+
+  // The operations posted by this worker.
+  chase_lev_deque<operation> queue_;
+
+  // State used to randomise the choice of victim.
+  std::uint32_t random_state_;
+};
+
+work_stealing_scheduler::work_stealing_scheduler(
+    asio::execution_context& ctx, std::size_t num_workers)
+  : asio::detail::execution_context_service_base<work_stealing_scheduler>(ctx),
+    injected_count_(0),
+    idle_workers_(0),
+    stopped_(false),
+    outstanding_work_(0),
+    num_workers_(num_workers == 0 ? 1 : num_workers),
+    workers_(new worker[num_workers_])
+{
+}
+
+work_stealing_scheduler::~work_stealing_scheduler()
+{
+  delete[] workers_;
+}
+
+void work_stealing_scheduler::shutdown()
+{
+  // No workers are running, so the deques may be emptied from this thread.
+  for (std::size_t i = 0; i < num_workers_; ++i)
+    while (operation* o = workers_[i].queue_.pop())
+      o->destroy();
+
+  mutex::scoped_lock lock(mutex_);
+  while (operation* o = injected_.front())
+  {
+    injected_.pop();
+    o->destroy();
+  }
+  injected_count_.store(0, std::memory_order_relaxed);
+}
+
+void work_stealing_scheduler::run(std::size_t index)
+{
+  worker& this_worker = workers_[index];
+  thread_call_stack::context ctx(this, this_worker);
+
+  while (!stopped_.load(std::memory_order_acquire))
+  {
+    if (operation* o = find_work(this_worker))
+    {
+      o->complete(this, asio::error_code(), 0);
+      work_finished();
+      this_worker.rethrow_pending_exception();
+    }
+    else if (!wait_for_work())
+    {
+      break;
+    }
+  }
+}
+
+void work_stealing_scheduler::stop()
+{
+  mutex::scoped_lock lock(mutex_);
+  stopped_.store(true, std::memory_order_release);
+  wakeup_event_.signal_all(lock);
+}
+
+bool work_stealing_scheduler::stopped() const
+{
+  return stopped_.load(std::memory_order_acquire);
+}
+
+void work_stealing_scheduler::capture_current_exception()
+{
+  if (thread_info_base* this_thread = thread_call_stack::contains(this))
+    this_thread->capture_current_exception();
+}
+
+void work_stealing_scheduler::post_immediate_completion(
+    work_stealing_scheduler::operation* op, bool is_continuation)
+{
+  work_started();
+
+  if (thread_info_base* this_thread = thread_call_stack::contains(this))
+  {
+    static_cast<worker*>(this_thread)->queue_.push(op);
+    if (is_continuation)
+      return;
+
+    // Either an idle worker will see the new operation when it checks for
+    // work, or we will see that the worker is idle and wake it.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (idle_workers_.load(std::memory_order_relaxed) > 0)
+      wake_one_worker();
+  }
+  else
+  {
+    mutex::scoped_lock lock(mutex_);
+    injected_.push(op);
+    injected_count_.store(injected_count_.load(
+          std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (idle_workers_.load(std::memory_order_relaxed) > 0)
+      wakeup_event_.unlock_and_signal_one(lock);
+  }
+}
+
+work_stealing_scheduler::operation* work_stealing_scheduler::find_work(
+    work_stealing_scheduler::worker& this_worker)
+{
+  if (operation* o = this_worker.queue_.pop())
+    return o;
+
+  if (injected_count_.load(std::memory_order_relaxed) > 0)
+  {
+    mutex::scoped_lock lock(mutex_);
+    if (operation* o = injected_.front())
+    {
+      injected_.pop();
+      injected_count_.store(injected_count_.load(
+            std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+      return o;
+    }
+  }
+
+  if (num_workers_ > 1)
+  {
+    std::size_t start = this_worker.next_victim(num_workers_);
+    for (std::size_t i = 0; i < num_workers_; ++i)
+    {
+      worker& victim = workers_[(start + i) % num_workers_];
+      if (&victim != &this_worker)
+        if (operation* o = victim.queue_.steal())
+          return o;
+    }
+  }
+
+  return 0;
+}
+
+bool work_stealing_scheduler::work_available() const
+{
+  if (injected_count_.load(std::memory_order_relaxed) > 0)
+    return true;
+  for (std::size_t i = 0; i < num_workers_; ++i)
+    if (!workers_[i].queue_.empty())
+      return true;
+  return false;
+}
+
+bool work_stealing_scheduler::wait_for_work()
+{
+  mutex::scoped_lock lock(mutex_);
+
+  // Pairs with the fence in post_immediate_completion().
+  idle_workers_.fetch_add(1, std::memory_order_seq_cst);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  while (!stopped_.load(std::memory_order_relaxed) && !work_available())
+  {
+    wakeup_event_.clear(lock);
+    wakeup_event_.wait(lock);
+  }
+
+  idle_workers_.fetch_sub(1, std::memory_order_relaxed);
+  return !stopped_.load(std::memory_order_relaxed);
+}
+
+void work_stealing_scheduler::wake_one_worker()
+{
+  mutex::scoped_lock lock(mutex_);
+  if (idle_workers_.load(std::memory_order_relaxed) > 0)
+    wakeup_event_.unlock_and_signal_one(lock);
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_IMPL_WORK_STEALING_SCHEDULER_IPP
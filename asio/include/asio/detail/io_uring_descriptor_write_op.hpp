@@ -27,6 +27,10 @@
 #include "asio/detail/io_uring_operation.hpp"
 #include "asio/detail/memory.hpp"
 
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+# include "asio/detail/native_buffer_storage.hpp"
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -104,12 +108,26 @@ public:
     return after_completion;
   }
 
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+protected:
+  // Use storage owned by the derived operation for long buffer sequences.
+  void set_buffer_storage(
+      buffer_sequence_adapter_base::native_buffer_type* storage,
+      std::size_t size)
+  {
+    if (storage)
+      bufs_ = bufs_type(buffers_, storage, size);
+  }
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+
 private:
+  typedef buffer_sequence_adapter<asio::const_buffer,
+      ConstBufferSequence> bufs_type;
+
   int descriptor_;
   descriptor_ops::state_type state_;
   ConstBufferSequence buffers_;
-  buffer_sequence_adapter<asio::const_buffer,
-      ConstBufferSequence> bufs_;
+  bufs_type bufs_;
 };
 
 template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
@@ -127,7 +145,13 @@ public:
         descriptor, state, buffers, &io_uring_descriptor_write_op::do_complete),
       handler_(static_cast<Handler&&>(handler)),
       work_(handler_, io_ex)
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+      , storage_(buffers, handler_)
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
   {
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+    this->set_buffer_storage(storage_.data(), storage_.size());
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
   }
 
   static void do_complete(void* owner, operation* base,
@@ -173,6 +197,10 @@ public:
 private:
   Handler handler_;
   handler_work<Handler, IoExecutor> work_;
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+  native_buffer_storage<asio::const_buffer,
+      ConstBufferSequence, Handler> storage_;
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
 };
 
 } // namespace detail
@@ -179,6 +179,13 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& target,
       typename timer_queue<Time_Traits>::per_timer_data& source);
 
+  // Change the expiry time of the given timer without cancelling its
+  // operations.
+  template <typename Time_Traits>
+  void reschedule_timer(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& timer,
+      const typename Time_Traits::time_type& time);
+
   // Wait on io_uring once until interrupted or events are ready to be
   // dispatched.
   ASIO_DECL void run(long usec, op_queue<operation>& ops);
@@ -186,6 +193,12 @@ public:
   // Interrupt the io_uring wait.
   ASIO_DECL void interrupt();
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  // Add the number of registered I/O objects and pending timers to the
+  // snapshot.
+  ASIO_DECL void get_metrics(io_context_metrics& m);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 private:
   // The hint to pass to io_uring_queue_init to size its data structures.
   enum { ring_size = 16384 };
@@ -290,6 +303,11 @@ private:
   // Keep track of all registered I/O objects.
   object_pool<io_object> registered_io_objects_;
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  // The number of registered I/O objects.
+  std::size_t registered_io_object_count_;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
   // Helper class to do post-perform_io cleanup.
   struct perform_io_cleanup_on_block_exit;
   friend struct perform_io_cleanup_on_block_exit;
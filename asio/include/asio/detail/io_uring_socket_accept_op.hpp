@@ -65,9 +65,12 @@ public:
     }
     else
     {
+      // Requests for fast accept get a close-on-exec descriptor atomically.
+      // The descriptor is left blocking, as io_uring does not require it.
       ::io_uring_prep_accept(sqe, o->socket_,
           o->peer_endpoint_ ? o->peer_endpoint_->data() : 0,
-          o->peer_endpoint_ ? &o->addrlen_ : 0, 0);
+          o->peer_endpoint_ ? &o->addrlen_ : 0,
+          (o->state_ & socket_ops::fast_accept) != 0 ? SOCK_CLOEXEC : 0);
     }
   }
 
@@ -81,8 +84,10 @@ public:
     {
       socket_type new_socket = invalid_socket;
       std::size_t addrlen = static_cast<std::size_t>(o->addrlen_);
-      bool result = socket_ops::non_blocking_accept(o->socket_,
-          o->state_, o->peer_endpoint_ ? o->peer_endpoint_->data() : 0,
+      bool result = socket_ops::non_blocking_accept(o->socket_, o->state_,
+          (o->state_ & socket_ops::fast_accept) != 0
+            ? socket_ops::accept_close_on_exec : 0,
+          o->peer_endpoint_ ? o->peer_endpoint_->data() : 0,
           o->peer_endpoint_ ? &addrlen : 0, o->ec_, new_socket);
       o->new_socket_.reset(new_socket);
       o->addrlen_ = static_cast<socklen_t>(addrlen);
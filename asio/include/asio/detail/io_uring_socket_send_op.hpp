@@ -27,6 +27,10 @@
 #include "asio/detail/io_uring_operation.hpp"
 #include "asio/detail/memory.hpp"
 
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+# include "asio/detail/native_buffer_storage.hpp"
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -109,12 +113,31 @@ public:
     return after_completion;
   }
 
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+protected:
+  // Use storage owned by the derived operation for long buffer sequences.
+  void set_buffer_storage(
+      buffer_sequence_adapter_base::native_buffer_type* storage,
+      std::size_t size)
+  {
+    if (storage)
+    {
+      bufs_ = bufs_type(buffers_, storage, size);
+      msghdr_.msg_iov = bufs_.buffers();
+      msghdr_.msg_iovlen = static_cast<int>(bufs_.count());
+    }
+  }
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+
 private:
+  typedef buffer_sequence_adapter<asio::const_buffer,
+      ConstBufferSequence> bufs_type;
+
   socket_type socket_;
   socket_ops::state_type state_;
   ConstBufferSequence buffers_;
   socket_base::message_flags flags_;
-  buffer_sequence_adapter<asio::const_buffer, ConstBufferSequence> bufs_;
+  bufs_type bufs_;
   msghdr msghdr_;
 };
 
@@ -133,7 +156,13 @@ public:
         socket, state, buffers, flags, &io_uring_socket_send_op::do_complete),
       handler_(static_cast<Handler&&>(handler)),
       work_(handler_, io_ex)
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+      , storage_(buffers, handler_)
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
   {
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+    this->set_buffer_storage(storage_.data(), storage_.size());
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
   }
 
   static void do_complete(void* owner, operation* base,
@@ -179,6 +208,10 @@ public:
 private:
   Handler handler_;
   handler_work<Handler, IoExecutor> work_;
+#if defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
+  native_buffer_storage<asio::const_buffer,
+      ConstBufferSequence, Handler> storage_;
+#endif // defined(ASIO_ENABLE_LARGE_BUFFER_SEQUENCES)
 };
 
 } // namespace detail
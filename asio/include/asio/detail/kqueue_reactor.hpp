@@ -205,6 +205,13 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& target,
       typename timer_queue<Time_Traits>::per_timer_data& source);
 
+  // Change the expiry time of the given timer without cancelling its
+  // operations.
+  template <typename Time_Traits>
+  void reschedule_timer(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& timer,
+      const typename Time_Traits::time_type& time);
+
   // Run the kqueue loop.
   ASIO_DECL void run(long usec, op_queue<operation>& ops);
 
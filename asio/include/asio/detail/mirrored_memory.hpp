@@ -0,0 +1,82 @@
+//
+// detail/mirrored_memory.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_MIRRORED_MEMORY_HPP
+#define ASIO_DETAIL_MIRRORED_MEMORY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_RING_BUFFER)
+
+#include <cstddef>
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A region of memory that is mapped twice, back-to-back, so that the byte at
+// data()[i] is also visible at data()[i + size()]. A range of up to size()
+// bytes that starts anywhere in the first mapping is therefore contiguous,
+// even if it wraps around the end of the underlying memory.
+class mirrored_memory
+  : private noncopyable
+{
+public:
+  // Map at least the given number of bytes. The size is rounded up to a
+  // multiple of the page size.
+  ASIO_DECL explicit mirrored_memory(std::size_t size);
+
+  // Move constructor.
+  mirrored_memory(mirrored_memory&& other) noexcept
+    : data_(other.data_),
+      size_(other.size_)
+  {
+    other.data_ = 0;
+    other.size_ = 0;
+  }
+
+  // Destructor.
+  ASIO_DECL ~mirrored_memory();
+
+  // Get the start of the first mapping.
+  unsigned char* data() const noexcept
+  {
+    return data_;
+  }
+
+  // Get the size of each mapping.
+  std::size_t size() const noexcept
+  {
+    return size_;
+  }
+
+private:
+  unsigned char* data_;
+  std::size_t size_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/mirrored_memory.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_RING_BUFFER)
+
+#endif // ASIO_DETAIL_MIRRORED_MEMORY_HPP
@@ -0,0 +1,110 @@
+//
+// detail/native_buffer_storage.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_NATIVE_BUFFER_STORAGE_HPP
+#define ASIO_DETAIL_NATIVE_BUFFER_STORAGE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <iterator>
+#include "asio/associated_allocator.hpp"
+#include "asio/buffer.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Storage for the native representation of a buffer sequence that is longer
+// than a buffer_sequence_adapter can hold by itself. The storage is owned by
+// an operation and is obtained from the handler's associated allocator, so
+// that it is recycled along with the operation. No storage is allocated for
+// sequences that fit within the adapter.
+template <typename Buffer, typename Buffers, typename Handler>
+class native_buffer_storage
+  : private noncopyable
+{
+public:
+  typedef buffer_sequence_adapter_base::native_buffer_type native_buffer_type;
+
+  native_buffer_storage(const Buffers& buffers, Handler& handler)
+    : allocator_(get_default_allocator<associated_allocator_type>::get(
+          asio::get_associated_allocator(handler))),
+      data_(0),
+      size_(0)
+  {
+    if (static_cast<std::size_t>(buffer_sequence_adapter_base::max_buffers)
+        > static_cast<std::size_t>(
+          buffer_sequence_adapter_base::max_inline_buffers)
+        && !buffer_sequence_adapter<Buffer, Buffers>::is_single_buffer)
+    {
+      std::size_t count = native_buffer_storage::count(
+          asio::buffer_sequence_begin(buffers),
+          asio::buffer_sequence_end(buffers));
+      if (count > buffer_sequence_adapter_base::max_inline_buffers)
+      {
+        size_ = count < buffer_sequence_adapter_base::max_buffers
+          ? count : std::size_t(buffer_sequence_adapter_base::max_buffers);
+        data_ = allocator_.allocate(size_);
+      }
+    }
+  }
+
+  ~native_buffer_storage()
+  {
+    if (data_)
+      allocator_.deallocate(data_, size_);
+  }
+
+  // Get the storage, or null if the adapter's own storage is sufficient.
+  native_buffer_type* data() const
+  {
+    return data_;
+  }
+
+  // Get the number of buffers that the storage can hold.
+  std::size_t size() const
+  {
+    return size_;
+  }
+
+private:
+  template <typename Iterator>
+  static std::size_t count(Iterator begin, Iterator end)
+  {
+    return static_cast<std::size_t>(std::distance(begin, end));
+  }
+
+  typedef typename associated_allocator<Handler>::type
+    associated_allocator_type;
+  typedef typename get_default_allocator<
+    associated_allocator_type>::type default_allocator_type;
+  typedef ASIO_REBIND_ALLOC(default_allocator_type,
+      native_buffer_type) allocator_type;
+
+  allocator_type allocator_;
+  native_buffer_type* data_;
+  std::size_t size_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_NATIVE_BUFFER_STORAGE_HPP
@@ -0,0 +1,100 @@
+//
+// detail/non_blocking_io_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_NON_BLOCKING_IO_OP_HPP
+#define ASIO_DETAIL_NON_BLOCKING_IO_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/error_code.hpp"
+#include "asio/post.hpp"
+#include "asio/socket_base.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A composed operation, for use with async_compose, that performs a system
+// call on a socket without blocking and waits for readiness only when the
+// call cannot make progress.
+//
+// The Operation type must provide:
+//
+//   // Attempt the operation without blocking. Returns true if the operation
+//   // has finished, with ec set to its result. Otherwise, sets wait to the
+//   // readiness that is required before the next attempt.
+//   bool perform(asio::error_code& ec, socket_base::wait_type& wait);
+//
+//   // Returns the number of bytes to pass to the completion handler.
+//   std::size_t bytes_transferred() const;
+template <typename Socket, typename Operation>
+class non_blocking_io_op
+{
+public:
+  non_blocking_io_op(Socket& socket, const Operation& op)
+    : socket_(socket),
+      op_(op),
+      started_(false),
+      completing_(false)
+  {
+  }
+
+  template <typename Self>
+  void operator()(Self& self, asio::error_code ec = asio::error_code())
+  {
+    if (completing_)
+    {
+      ec = ec_;
+    }
+    else if (!ec)
+    {
+      socket_base::wait_type wait = socket_base::wait_read;
+      bool finished = op_.perform(ec, wait);
+      if (!finished || !started_)
+      {
+        started_ = true;
+        if (!finished)
+        {
+          socket_.async_wait(wait, static_cast<Self&&>(self));
+        }
+        else
+        {
+          // The first attempt finished the operation. Defer the handler so
+          // that it is not invoked from within the initiating function.
+          completing_ = true;
+          ec_ = ec;
+          asio::post(self.get_io_executor(), static_cast<Self&&>(self));
+        }
+        return;
+      }
+    }
+
+    self.complete(ec, op_.bytes_transferred());
+  }
+
+private:
+  Socket& socket_;
+  Operation op_;
+  bool started_;
+  bool completing_;
+  asio::error_code ec_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_NON_BLOCKING_IO_OP_HPP
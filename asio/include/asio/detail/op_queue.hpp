@@ -15,6 +15,7 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <cstddef>
 #include "asio/detail/noncopyable.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -57,6 +58,14 @@ public:
   {
     return q.back_;
   }
+
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  template <typename Operation>
+  static std::size_t& size(op_queue<Operation>& q)
+  {
+    return q.size_;
+  }
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
 };
 
 template <typename Operation>
@@ -68,6 +77,9 @@ public:
   op_queue()
     : front_(0),
       back_(0)
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+      , size_(0)
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
   {
   }
 
@@ -97,6 +109,9 @@ public:
       if (front_ == 0)
         back_ = 0;
       op_queue_access::next(tmp, static_cast<Operation*>(0));
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+      --size_;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
     }
   }
 
@@ -113,6 +128,9 @@ public:
     {
       front_ = back_ = h;
     }
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+    ++size_;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
   }
 
   // Push all operations from another queue on to the back of the queue. The
@@ -129,6 +147,10 @@ public:
       back_ = op_queue_access::back(q);
       op_queue_access::front(q) = 0;
       op_queue_access::back(q) = 0;
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+      size_ += op_queue_access::size(q);
+      op_queue_access::size(q) = 0;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
     }
   }
 
@@ -138,6 +160,14 @@ public:
     return front_ == 0;
   }
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  // Get the number of operations in the queue.
+  std::size_t size() const
+  {
+    return size_;
+  }
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
   // Test whether an operation is already enqueued.
   bool is_enqueued(Operation* o) const
   {
@@ -152,6 +182,11 @@ private:
 
   // The back of the queue.
   Operation* back_;
+
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  // The number of operations in the queue.
+  std::size_t size_;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
 };
 
 } // namespace detail
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/detail/accepted_socket_access.hpp"
 #include "asio/detail/bind_handler.hpp"
 #include "asio/detail/fenced_block.hpp"
 #include "asio/detail/handler_alloc_helpers.hpp"
@@ -56,8 +57,11 @@ public:
         static_cast<reactive_socket_accept_op_base*>(base));
 
     socket_type new_socket = invalid_socket;
-    status result = socket_ops::non_blocking_accept(o->socket_,
-        o->state_, o->peer_endpoint_ ? o->peer_endpoint_->data() : 0,
+    status result = socket_ops::non_blocking_accept(o->socket_, o->state_,
+        (o->state_ & socket_ops::fast_accept) != 0
+          ? socket_ops::accept_non_blocking | socket_ops::accept_close_on_exec
+          : 0,
+        o->peer_endpoint_ ? o->peer_endpoint_->data() : 0,
         o->peer_endpoint_ ? &o->addrlen_ : 0, o->ec_, new_socket)
     ? done : not_done;
     o->new_socket_.reset(new_socket);
@@ -73,7 +77,15 @@ public:
     {
       if (peer_endpoint_)
         peer_endpoint_->resize(addrlen_);
-      peer_.assign(protocol_, new_socket_.get(), ec_);
+      if (state_ & socket_ops::fast_accept)
+      {
+        accepted_socket_access::assign(peer_,
+            protocol_, new_socket_.get(), ec_);
+      }
+      else
+      {
+        peer_.assign(protocol_, new_socket_.get(), ec_);
+      }
       if (!ec_)
         new_socket_.release();
     }
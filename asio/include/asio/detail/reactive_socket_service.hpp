@@ -24,6 +24,7 @@
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
 #include "asio/socket_base.hpp"
+#include "asio/detail/accepted_socket_access.hpp"
 #include "asio/detail/buffer_sequence_adapter.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/noncopyable.hpp"
@@ -145,6 +146,19 @@ public:
     return ec;
   }
 
+  // Assign a native socket, created by a fast accept, to a socket
+  // implementation.
+  asio::error_code assign_accepted(implementation_type& impl,
+      const protocol_type& protocol, const native_handle_type& native_socket,
+      asio::error_code& ec)
+  {
+    if (!do_assign_accepted(impl, protocol.type(), native_socket, ec))
+      impl.protocol_ = protocol;
+
+    ASIO_ERROR_LOCATION(ec);
+    return ec;
+  }
+
   // Get the native socket representation.
   native_handle_type native_handle(implementation_type& impl)
   {
@@ -490,7 +504,10 @@ public:
 
     std::size_t addr_len = peer_endpoint ? peer_endpoint->capacity() : 0;
     socket_holder new_socket(socket_ops::sync_accept(impl.socket_,
-          impl.state_, peer_endpoint ? peer_endpoint->data() : 0,
+          impl.state_, (impl.state_ & socket_ops::fast_accept) != 0
+            ? socket_ops::accept_non_blocking | socket_ops::accept_close_on_exec
+            : 0,
+          peer_endpoint ? peer_endpoint->data() : 0,
           peer_endpoint ? &addr_len : 0, ec));
 
     // On success, assign new connection to peer socket object.
@@ -498,7 +515,11 @@ public:
     {
       if (peer_endpoint)
         peer_endpoint->resize(addr_len);
-      peer.assign(impl.protocol_, new_socket.get(), ec);
+      if (impl.state_ & socket_ops::fast_accept)
+        accepted_socket_access::assign(peer, impl.protocol_,
+            new_socket.get(), ec);
+      else
+        peer.assign(impl.protocol_, new_socket.get(), ec);
       if (!ec)
         new_socket.release();
     }
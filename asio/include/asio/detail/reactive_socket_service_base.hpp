@@ -588,6 +588,12 @@ protected:
       base_implementation_type& impl, int type,
       const native_handle_type& native_socket, asio::error_code& ec);
 
+  // Assign a native socket that was created by a fast accept, and so is known
+  // to be non-blocking and not shared with any other descriptor.
+  ASIO_DECL asio::error_code do_assign_accepted(
+      base_implementation_type& impl, int type,
+      const native_handle_type& native_socket, asio::error_code& ec);
+
   // Start the asynchronous read or write operation.
   ASIO_DECL void do_start_op(base_implementation_type& impl, int op_type,
       reactor_op* op, bool is_continuation, bool is_non_blocking, bool noop,
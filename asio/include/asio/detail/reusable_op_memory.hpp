@@ -0,0 +1,430 @@
+//
+// detail/reusable_op_memory.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REUSABLE_OP_MEMORY_HPP
+#define ASIO_DETAIL_REUSABLE_OP_MEMORY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <new>
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+#ifndef ASIO_REUSABLE_OP_MEMORY_RESERVE
+# define ASIO_REUSABLE_OP_MEMORY_RESERVE 256
+#endif // ASIO_REUSABLE_OP_MEMORY_RESERVE
+
+namespace asio {
+namespace detail {
+
+template <typename T, typename Allocator>
+class reusable_op_allocator;
+
+// A block of memory owned by the intermediate completion handler of a composed
+// operation. The block is allocated when the composed operation is started and
+// is then reused for each of its intermediate operations in turn, so that the
+// composed operation performs a single allocation over its lifetime.
+//
+// The block is sized for an intermediate operation that contains a copy of the
+// handler, plus a reserve for the operation's own state. If an intermediate
+// operation needs more space, the block's memory is grown in place, so that
+// allocators that refer to the block remain valid.
+//
+// Ownership of the block moves with the handler. The block is freed once the
+// handler has relinquished it and no intermediate operation is using it.
+class reusable_op_memory
+{
+public:
+  class block
+  {
+  public:
+    // Frees the block using the allocator that created it.
+    void (*destroy)(block*);
+
+    // Replaces the block's memory with memory of at least the given size.
+    void (*grow)(block*, std::size_t);
+
+    // The memory available to intermediate operations.
+    unsigned char* data;
+    std::size_t capacity;
+
+    // Whether the memory is occupied by an intermediate operation.
+    bool in_use;
+
+    // Whether the block is still owned by a handler.
+    bool owned;
+  };
+
+  reusable_op_memory() noexcept
+    : block_(0)
+  {
+  }
+
+  template <typename Allocator>
+  reusable_op_memory(const Allocator& a, std::size_t handler_size)
+    : block_(create_block(
+          get_default_allocator<Allocator>::get(a), handler_size))
+  {
+  }
+
+  // Copies of a handler do not share its memory.
+  reusable_op_memory(const reusable_op_memory&) noexcept
+    : block_(0)
+  {
+  }
+
+  reusable_op_memory(reusable_op_memory&& other) noexcept
+    : block_(other.block_)
+  {
+    other.block_ = 0;
+  }
+
+  ~reusable_op_memory()
+  {
+    reset();
+  }
+
+  // Get the block, or null if there is none.
+  block* get() const noexcept
+  {
+    return block_;
+  }
+
+  // Relinquish the block. It is freed immediately if no intermediate operation
+  // is using it, otherwise when that operation's memory is deallocated. Must
+  // be called before a composed operation invokes its final handler.
+  void reset() noexcept
+  {
+    if (block_)
+    {
+      block_->owned = false;
+      if (!block_->in_use)
+        block_->destroy(block_);
+      block_ = 0;
+    }
+  }
+
+private:
+  template <typename, typename> friend class reusable_op_allocator;
+
+  reusable_op_memory& operator=(const reusable_op_memory&) = delete;
+
+  // Stored immediately before every allocation made by the allocator.
+  struct allocation_header
+  {
+    // The block containing the allocation, or null if the allocation was
+    // obtained directly from the underlying allocator.
+    block* owner;
+  };
+
+  typedef aligned_storage_t<ASIO_DEFAULT_ALIGN, ASIO_DEFAULT_ALIGN> unit;
+
+  enum
+  {
+    header_size = ((sizeof(allocation_header) + sizeof(unit) - 1)
+        / sizeof(unit)) * sizeof(unit)
+  };
+
+  static std::size_t units(std::size_t size)
+  {
+    return (size + sizeof(unit) - 1) / sizeof(unit);
+  }
+
+  template <typename Allocator>
+  class block_impl;
+
+  template <typename Allocator>
+  static block* create_block(const Allocator& a, std::size_t handler_size);
+
+  template <typename Allocator>
+  static void* allocate(block* b, const Allocator& a, std::size_t size);
+
+  template <typename Allocator>
+  static void deallocate(const Allocator& a, void* pointer, std::size_t size);
+
+  block* block_;
+};
+
+template <typename Allocator>
+class reusable_op_memory::block_impl : public block
+{
+public:
+  typedef ASIO_REBIND_ALLOC(Allocator, unit) allocator_type;
+
+  block_impl(const Allocator& a, std::size_t n)
+    : allocator_(a),
+      size_(n),
+      external_(0),
+      external_size_(0)
+  {
+  }
+
+  static void do_destroy(block* base)
+  {
+    block_impl* b = static_cast<block_impl*>(base);
+    allocator_type a(b->allocator_);
+    std::size_t n = b->size_;
+    b->free_external();
+    b->~block_impl();
+    a.deallocate(reinterpret_cast<unit*>(b), n);
+  }
+
+  static void do_grow(block* base, std::size_t size)
+  {
+    block_impl* b = static_cast<block_impl*>(base);
+    std::size_t n = units(header_size + size);
+    unit* external = b->allocator_.allocate(n);
+    b->free_external();
+    b->external_ = external;
+    b->external_size_ = n;
+    unsigned char* memory = reinterpret_cast<unsigned char*>(external);
+    b->data = memory + header_size;
+    b->capacity = n * sizeof(unit) - header_size;
+    allocation_header* h = new (memory) allocation_header;
+    h->owner = b;
+  }
+
+private:
+  void free_external()
+  {
+    if (external_)
+      allocator_.deallocate(external_, external_size_);
+  }
+
+  allocator_type allocator_;
+  std::size_t size_;
+  unit* external_;
+  std::size_t external_size_;
+};
+
+template <typename Allocator>
+reusable_op_memory::block* reusable_op_memory::create_block(
+    const Allocator& a, std::size_t handler_size)
+{
+#if !defined(ASIO_DISABLE_REUSABLE_OP_MEMORY)
+  typedef block_impl<Allocator> impl_type;
+  std::size_t offset = units(sizeof(impl_type)) * sizeof(unit);
+  std::size_t n = units(offset + header_size
+      + handler_size + ASIO_REUSABLE_OP_MEMORY_RESERVE);
+
+  typename impl_type::allocator_type unit_allocator(a);
+  unsigned char* memory = reinterpret_cast<unsigned char*>(
+      unit_allocator.allocate(n));
+  impl_type* b = new (memory) impl_type(a, n);
+  b->destroy = &impl_type::do_destroy;
+  b->grow = &impl_type::do_grow;
+  b->data = memory + offset + header_size;
+  b->capacity = n * sizeof(unit) - offset - header_size;
+  b->in_use = false;
+  b->owned = true;
+  allocation_header* h = new (memory + offset) allocation_header;
+  h->owner = b;
+  return b;
+#else // !defined(ASIO_DISABLE_REUSABLE_OP_MEMORY)
+  (void)a;
+  (void)handler_size;
+  return 0;
+#endif // !defined(ASIO_DISABLE_REUSABLE_OP_MEMORY)
+}
+
+template <typename Allocator>
+void* reusable_op_memory::allocate(block* b,
+    const Allocator& a, std::size_t size)
+{
+  if (b && !b->in_use)
+  {
+    if (size > b->capacity)
+      b->grow(b, size);
+    b->in_use = true;
+    return b->data;
+  }
+
+  ASIO_REBIND_ALLOC(Allocator, unit) unit_allocator(a);
+  unsigned char* memory = reinterpret_cast<unsigned char*>(
+      unit_allocator.allocate(units(header_size + size)));
+  allocation_header* h = new (memory) allocation_header;
+  h->owner = 0;
+  return memory + header_size;
+}
+
+template <typename Allocator>
+void reusable_op_memory::deallocate(const Allocator& a,
+    void* pointer, std::size_t size)
+{
+  unsigned char* memory = static_cast<unsigned char*>(pointer) - header_size;
+  if (block* b = reinterpret_cast<allocation_header*>(memory)->owner)
+  {
+    b->in_use = false;
+    if (!b->owned)
+      b->destroy(b);
+  }
+  else
+  {
+    ASIO_REBIND_ALLOC(Allocator, unit) unit_allocator(a);
+    unit_allocator.deallocate(reinterpret_cast<unit*>(memory),
+        units(header_size + size));
+  }
+}
+
+// The allocator associated with a composed operation's intermediate completion
+// handler. Allocations are placed in the handler's block when it is free, and
+// are otherwise obtained from the underlying allocator.
+template <typename T, typename Allocator>
+class reusable_op_allocator
+{
+public:
+  typedef T value_type;
+
+  template <typename U>
+  struct rebind
+  {
+    typedef reusable_op_allocator<U, Allocator> other;
+  };
+
+  reusable_op_allocator(const reusable_op_memory& memory,
+      const Allocator& a) noexcept
+    : block_(memory.get()),
+      allocator_(a)
+  {
+  }
+
+  template <typename U>
+  reusable_op_allocator(
+      const reusable_op_allocator<U, Allocator>& other) noexcept
+    : block_(other.block_),
+      allocator_(other.allocator_)
+  {
+  }
+
+  bool operator==(const reusable_op_allocator& other) const noexcept
+  {
+    return allocator_ == other.allocator_;
+  }
+
+  bool operator!=(const reusable_op_allocator& other) const noexcept
+  {
+    return allocator_ != other.allocator_;
+  }
+
+  T* allocate(std::size_t n)
+  {
+    return allocate(n, integral_constant<bool,
+        (alignof(T) <= ASIO_DEFAULT_ALIGN)>());
+  }
+
+  void deallocate(T* p, std::size_t n)
+  {
+    deallocate(p, n, integral_constant<bool,
+        (alignof(T) <= ASIO_DEFAULT_ALIGN)>());
+  }
+
+private:
+  template <typename, typename> friend class reusable_op_allocator;
+
+  typedef typename get_default_allocator<Allocator>::type default_type;
+
+  T* allocate(std::size_t n, true_type)
+  {
+    return static_cast<T*>(reusable_op_memory::allocate(block_,
+          get_default_allocator<Allocator>::get(allocator_), sizeof(T) * n));
+  }
+
+  T* allocate(std::size_t n, false_type)
+  {
+    ASIO_REBIND_ALLOC(default_type, T) a(
+        get_default_allocator<Allocator>::get(allocator_));
+    return a.allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n, true_type)
+  {
+    reusable_op_memory::deallocate(
+        get_default_allocator<Allocator>::get(allocator_), p, sizeof(T) * n);
+  }
+
+  void deallocate(T* p, std::size_t n, false_type)
+  {
+    ASIO_REBIND_ALLOC(default_type, T) a(
+        get_default_allocator<Allocator>::get(allocator_));
+    a.deallocate(p, n);
+  }
+
+  reusable_op_memory::block* block_;
+  Allocator allocator_;
+};
+
+template <typename Allocator>
+class reusable_op_allocator<void, Allocator>
+{
+public:
+  typedef void value_type;
+
+  template <typename U>
+  struct rebind
+  {
+    typedef reusable_op_allocator<U, Allocator> other;
+  };
+
+  reusable_op_allocator(const reusable_op_memory& memory,
+      const Allocator& a) noexcept
+    : block_(memory.get()),
+      allocator_(a)
+  {
+  }
+
+  template <typename U>
+  reusable_op_allocator(
+      const reusable_op_allocator<U, Allocator>& other) noexcept
+    : block_(other.block_),
+      allocator_(other.allocator_)
+  {
+  }
+
+  bool operator==(const reusable_op_allocator& other) const noexcept
+  {
+    return allocator_ == other.allocator_;
+  }
+
+  bool operator!=(const reusable_op_allocator& other) const noexcept
+  {
+    return allocator_ != other.allocator_;
+  }
+
+private:
+  template <typename, typename> friend class reusable_op_allocator;
+
+  reusable_op_memory::block* block_;
+  Allocator allocator_;
+};
+
+template <typename T>
+struct is_reusable_op_allocator : false_type
+{
+};
+
+template <typename T, typename Allocator>
+struct is_reusable_op_allocator<reusable_op_allocator<T, Allocator>>
+  : true_type
+{
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_REUSABLE_OP_MEMORY_HPP
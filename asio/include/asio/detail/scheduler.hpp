@@ -27,6 +27,12 @@
 #include "asio/detail/scheduler_task.hpp"
 #include "asio/detail/thread.hpp"
 #include "asio/detail/thread_context.hpp"
+#include "asio/detail/thread_metrics.hpp"
+
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+# include <atomic>
+# include <memory>
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
 
 #include "asio/detail/push_options.hpp"
 
@@ -135,6 +141,16 @@ public:
   // work_started() was previously called for the operations.
   ASIO_DECL void abandon_operations(op_queue<operation>& ops);
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  // Fill in a snapshot of the scheduler's metrics and those of its task.
+  ASIO_DECL void get_metrics(io_context_metrics& m);
+
+  // Set the callback to be invoked for handlers that take at least the given
+  // time to execute. An empty callback disables the check.
+  ASIO_DECL void set_slow_handler_callback(
+      chrono::nanoseconds threshold, slow_handler_callback callback);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
   // Get the concurrency hint that was used to initialise the scheduler.
   int concurrency_hint() const
   {
@@ -186,6 +202,22 @@ private:
   struct work_cleanup;
   friend struct work_cleanup;
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  // Helper class to measure the execution of a handler on block exit.
+  struct handler_timer;
+  friend struct handler_timer;
+
+  // Record the time at which an operation became ready to run.
+  static void mark_ready(operation* op);
+
+  // Record the time at which operations became ready to run, for those that
+  // have not already been marked.
+  static void mark_ready(op_queue<operation>& ops);
+
+  // Invoke the slow handler callback, if one is set.
+  ASIO_DECL void report_slow_handler(const slow_handler_info& info);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
   // Whether to optimise for single-threaded use cases.
   const bool one_thread_;
 
@@ -227,6 +259,20 @@ private:
 
   // The thread that is running the scheduler.
   asio::detail::thread* thread_;
+
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  // The counters of the threads that are running the scheduler.
+  thread_metrics_list thread_metrics_;
+
+  // Protects the slow handler callback.
+  mutex slow_handler_mutex_;
+
+  // The callback invoked for slow handlers.
+  std::shared_ptr<slow_handler_callback> slow_handler_callback_;
+
+  // The slow handler threshold in nanoseconds.
+  std::atomic<std::int64_t> slow_handler_threshold_;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
 };
 
 } // namespace detail
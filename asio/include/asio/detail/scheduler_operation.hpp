@@ -19,6 +19,11 @@
 #include "asio/detail/handler_tracking.hpp"
 #include "asio/detail/op_queue.hpp"
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+# include "asio/detail/chrono.hpp"
+# include "asio/detail/handler_location.hpp"
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -53,7 +58,23 @@ protected:
     : next_(0),
       func_(func),
       task_result_(0)
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+    , ready_time_(),
+      file_name_(0),
+      line_(0),
+      function_name_(0)
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
   {
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+    // Remember where the operation was initiated, so that the location can be
+    // reported if its handler is slow.
+    if (const handler_location* location = handler_location::current())
+    {
+      file_name_ = location->file_name();
+      line_ = location->line();
+      function_name_ = location->function_name();
+    }
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
   }
 
   // Prevents deletion through this type.
@@ -68,6 +89,13 @@ private:
 protected:
   friend class scheduler;
   unsigned int task_result_; // Passed into bytes transferred.
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+private:
+  chrono::steady_clock::time_point ready_time_; // When queued for execution.
+  const char* file_name_;
+  int line_;
+  const char* function_name_;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
 };
 
 } // namespace detail
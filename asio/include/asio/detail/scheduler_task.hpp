@@ -17,6 +17,10 @@
 
 #include "asio/detail/op_queue.hpp"
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+# include "asio/io_context_metrics.hpp"
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -34,6 +38,13 @@ public:
   // Interrupt the task.
   virtual void interrupt() = 0;
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  // Add the task's own metrics to the snapshot.
+  virtual void get_metrics(io_context_metrics&)
+  {
+  }
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 protected:
   // Prevent deletion through this type.
   ~scheduler_task()
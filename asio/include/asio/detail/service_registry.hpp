@@ -16,6 +16,8 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
 #include <typeinfo>
 #include "asio/detail/mutex.hpp"
 #include "asio/detail/noncopyable.hpp"
@@ -87,6 +89,13 @@ private:
       enable_if_t<is_base_of<typename Service::key_type, Service>::value>*);
 #endif // !defined(ASIO_NO_TYPEID)
 
+  // Get the dense index used to cache the service of the specified type.
+  template <typename Service>
+  static std::size_t service_index();
+
+  // Allocate a new dense index for a service type.
+  ASIO_DECL static std::size_t next_service_index();
+
   // Initialise a service's key based on its id.
   ASIO_DECL static void init_key_from_id(
       execution_context::service::key& key,
@@ -128,7 +137,7 @@ private:
   // exists. Ownership of the service object is not transferred to the caller.
   ASIO_DECL execution_context::service* do_use_service(
       const execution_context::service::key& key,
-      factory_type factory, void* owner);
+      factory_type factory, void* owner, std::size_t index);
 
   // Add a service object. Throws on error, in which case ownership of the
   // object is retained by the caller.
@@ -140,6 +149,25 @@ private:
   ASIO_DECL bool do_has_service(
       const execution_context::service::key& key) const;
 
+  // Find a service in the lookup table without locking the mutex. Returns 0 if
+  // the service has not yet been recorded.
+  execution_context::service* find_cached_service(std::size_t index) const;
+
+  // Record a service in the lookup table. The mutex must be held.
+  ASIO_DECL void cache_service(std::size_t index,
+      execution_context::service* service);
+
+  // A table of services indexed by service_index().
+  struct lookup_table
+  {
+    explicit lookup_table(std::size_t size);
+    ~lookup_table();
+
+    std::size_t size_;
+    std::atomic<execution_context::service*>* slots_;
+    lookup_table* next_retired_;
+  };
+
   // Mutex to protect access to internal data.
   mutable asio::detail::mutex mutex_;
 
@@ -148,6 +176,15 @@ private:
 
   // The first service in the list of contained services.
   execution_context::service* first_service_;
+
+  // The lookup table for existing services. It is replaced by a larger table
+  // as needed, and is published atomically so that services that already
+  // exist may be found without locking the mutex.
+  std::atomic<lookup_table*> lookup_table_;
+
+  // Tables that have been replaced. A concurrent lookup may still be reading
+  // from them, so they are kept until the registry is destroyed.
+  lookup_table* retired_tables_;
 };
 
 } // namespace detail
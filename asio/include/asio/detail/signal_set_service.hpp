@@ -212,6 +212,15 @@ private:
   // Helper function to close the pipe descriptors.
   ASIO_DECL static void close_descriptors();
 
+  // Helper function to get the descriptor that is registered for readiness.
+  ASIO_DECL int notification_descriptor() const;
+
+#if defined(ASIO_HAS_SIGNALFD)
+  // Helper function to add or remove a signal from the signalfd's mask.
+  ASIO_DECL asio::error_code update_signal_mask(int signal_number,
+      bool enable, asio::error_code& ec);
+#endif // defined(ASIO_HAS_SIGNALFD)
+
   // Helper function to start a wait operation.
   ASIO_DECL void start_wait_op(implementation_type& impl, signal_op* op);
 
@@ -272,6 +281,14 @@ private:
        //   && !defined(ASIO_WINDOWS_RUNTIME)
        //   && !defined(__CYGWIN__)
 
+#if defined(ASIO_HAS_SIGNALFD)
+  // The signalfd used to receive the signals registered with this service.
+  int signal_descriptor_;
+
+  // The signals currently accepted by the signalfd.
+  sigset_t signal_mask_;
+#endif // defined(ASIO_HAS_SIGNALFD)
+
   // A mapping from signal number to the registered signal sets.
   registration* registrations_[max_signal_number];
 
@@ -0,0 +1,350 @@
+//
+// detail/size_class_cache.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_SIZE_CLASS_CACHE_HPP
+#define ASIO_DETAIL_SIZE_CLASS_CACHE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include "asio/detail/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+#ifndef ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE
+# define ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE 8
+#endif // ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE
+
+#ifndef ASIO_RECYCLING_ALLOCATOR_MIN_BLOCK_SIZE
+# define ASIO_RECYCLING_ALLOCATOR_MIN_BLOCK_SIZE 64
+#endif // ASIO_RECYCLING_ALLOCATOR_MIN_BLOCK_SIZE
+
+#ifndef ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES
+# define ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES 8
+#endif // ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES
+
+namespace asio {
+namespace detail {
+
+// A per-thread cache of memory blocks, segregated into power-of-two size
+// classes. Blocks remember the cache that allocated them. A block deallocated
+// on another thread is pushed onto its owner's lock-free remote list, from
+// which the owner reclaims it the next time its local free list is empty.
+class size_class_cache
+  : private noncopyable
+{
+public:
+  enum
+  {
+    cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
+    min_block_size = ASIO_RECYCLING_ALLOCATOR_MIN_BLOCK_SIZE,
+    num_classes = ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES,
+    max_block_size = min_block_size << (num_classes - 1)
+  };
+
+  // Identifiers for the statistics counters.
+  enum counter
+  {
+    hit_counter,
+    miss_counter,
+    uncached_counter,
+    remote_counter,
+    max_counter
+  };
+
+  size_class_cache()
+    : owner_(0),
+      outstanding_(0)
+  {
+    for (int i = 0; i < num_classes; ++i)
+    {
+      free_[i] = 0;
+      free_count_[i] = 0;
+    }
+  }
+
+  ~size_class_cache()
+  {
+    for (int i = 0; i < num_classes; ++i)
+    {
+      while (free_[i])
+      {
+        free_block* b = free_[i];
+        free_[i] = b->next;
+        aligned_delete(base_of(b));
+      }
+    }
+
+    if (owner_)
+    {
+      // Blocks still in use elsewhere keep the owner state alive. The extra
+      // count is the reference held by this cache while it closes the list.
+      owner_->orphans.store(outstanding_ + 1, std::memory_order_relaxed);
+      free_block* b = owner_->remote_head.exchange(
+          closed_list(), std::memory_order_acq_rel);
+      std::size_t released = 1;
+      while (b)
+      {
+        free_block* next = b->next;
+        aligned_delete(base_of(b));
+        ++released;
+        b = next;
+      }
+      if (owner_->orphans.fetch_sub(released,
+            std::memory_order_acq_rel) == released)
+        delete owner_;
+    }
+  }
+
+  static void* allocate(size_class_cache* cache,
+      std::size_t size, std::size_t align)
+  {
+    if (cache && align <= ASIO_DEFAULT_ALIGN && size <= max_block_size)
+    {
+      std::size_t size_class = size_class_of(size);
+      if (void* pointer = cache->pop(size_class))
+      {
+        count(hit_counter);
+        return pointer;
+      }
+
+      if (cache->reclaim())
+      {
+        if (void* pointer = cache->pop(size_class))
+        {
+          count(hit_counter);
+          return pointer;
+        }
+      }
+
+      count(miss_counter);
+      return cache->new_block(size_class);
+    }
+
+    count(uncached_counter);
+    std::size_t offset = (align > header_size)
+      ? align : static_cast<std::size_t>(header_size);
+    unsigned char* const base = static_cast<unsigned char*>(
+        aligned_new(align, offset + size));
+    block_header* h = new (base + offset - header_size) block_header;
+    h->owner = 0;
+    h->value = offset;
+    return base + offset;
+  }
+
+  static void deallocate(size_class_cache* cache, void* pointer)
+  {
+    if (!pointer)
+      return;
+
+    block_header* h = header_of(pointer);
+    if (h->owner == 0)
+    {
+      aligned_delete(static_cast<unsigned char*>(pointer) - h->value);
+    }
+    else if (cache && cache->owner_ == h->owner)
+    {
+      --cache->outstanding_;
+      cache->push(static_cast<free_block*>(pointer), h->value);
+    }
+    else
+    {
+      count(remote_counter);
+      push_remote(h->owner, static_cast<free_block*>(pointer));
+    }
+  }
+
+  static std::size_t counter_value(counter c)
+  {
+#if defined(ASIO_ENABLE_RECYCLING_ALLOCATOR_STATS)
+    return counters()[c].load(std::memory_order_relaxed);
+#else // defined(ASIO_ENABLE_RECYCLING_ALLOCATOR_STATS)
+    (void)c;
+    return 0;
+#endif // defined(ASIO_ENABLE_RECYCLING_ALLOCATOR_STATS)
+  }
+
+private:
+  struct free_block
+  {
+    free_block* next;
+  };
+
+  // State shared between the owning thread and threads returning blocks.
+  struct owner_state
+  {
+    owner_state()
+      : remote_head(0),
+        orphans(0)
+    {
+    }
+
+    std::atomic<free_block*> remote_head;
+    std::atomic<std::size_t> orphans;
+  };
+
+  // Stored immediately before every block handed out by the cache.
+  struct block_header
+  {
+    // The state of the owning cache, or null if the block is not cached.
+    owner_state* owner;
+
+    // The size class if cached, otherwise the offset from the allocation.
+    std::size_t value;
+  };
+
+  enum
+  {
+    header_size = ((sizeof(block_header) + ASIO_DEFAULT_ALIGN - 1)
+        / ASIO_DEFAULT_ALIGN) * ASIO_DEFAULT_ALIGN
+  };
+
+  static block_header* header_of(void* pointer)
+  {
+    return reinterpret_cast<block_header*>(
+        static_cast<unsigned char*>(pointer) - header_size);
+  }
+
+  static void* base_of(free_block* b)
+  {
+    return reinterpret_cast<unsigned char*>(b) - header_size;
+  }
+
+  static std::size_t size_class_of(std::size_t size)
+  {
+    std::size_t size_class = 0;
+    for (std::size_t s = min_block_size; s < size; s <<= 1)
+      ++size_class;
+    return size_class;
+  }
+
+  // Marks the remote list of a cache that has been destroyed.
+  static free_block* closed_list()
+  {
+    static free_block closed;
+    return &closed;
+  }
+
+  void* pop(std::size_t size_class)
+  {
+    if (free_block* b = free_[size_class])
+    {
+      free_[size_class] = b->next;
+      --free_count_[size_class];
+      ++outstanding_;
+      return b;
+    }
+    return 0;
+  }
+
+  void push(free_block* b, std::size_t size_class)
+  {
+    if (free_count_[size_class] < cache_size)
+    {
+      b->next = free_[size_class];
+      free_[size_class] = b;
+      ++free_count_[size_class];
+    }
+    else
+    {
+      aligned_delete(base_of(b));
+    }
+  }
+
+  // Move blocks returned by other threads onto the local free lists.
+  bool reclaim()
+  {
+    if (!owner_ || !owner_->remote_head.load(std::memory_order_relaxed))
+      return false;
+
+    free_block* b = owner_->remote_head.exchange(
+        0, std::memory_order_acquire);
+    while (b)
+    {
+      free_block* next = b->next;
+      --outstanding_;
+      push(b, header_of(b)->value);
+      b = next;
+    }
+    return true;
+  }
+
+  void* new_block(std::size_t size_class)
+  {
+    if (!owner_)
+      owner_ = new owner_state;
+
+    unsigned char* const base = static_cast<unsigned char*>(
+        aligned_new(ASIO_DEFAULT_ALIGN,
+          header_size + (min_block_size << size_class)));
+    block_header* h = new (base) block_header;
+    h->owner = owner_;
+    h->value = size_class;
+    ++outstanding_;
+    return base + header_size;
+  }
+
+  static void push_remote(owner_state* owner, free_block* b)
+  {
+    free_block* head = owner->remote_head.load(std::memory_order_acquire);
+    do
+    {
+      if (head == closed_list())
+      {
+        // The owning cache no longer exists, so release the block directly.
+        aligned_delete(base_of(b));
+        if (owner->orphans.fetch_sub(1, std::memory_order_acq_rel) == 1)
+          delete owner;
+        return;
+      }
+      b->next = head;
+    } while (!owner->remote_head.compare_exchange_weak(head, b,
+          std::memory_order_release, std::memory_order_acquire));
+  }
+
+  static void count(counter c)
+  {
+#if defined(ASIO_ENABLE_RECYCLING_ALLOCATOR_STATS)
+    counters()[c].fetch_add(1, std::memory_order_relaxed);
+#else // defined(ASIO_ENABLE_RECYCLING_ALLOCATOR_STATS)
+    (void)c;
+#endif // defined(ASIO_ENABLE_RECYCLING_ALLOCATOR_STATS)
+  }
+
+#if defined(ASIO_ENABLE_RECYCLING_ALLOCATOR_STATS)
+  static std::atomic<std::size_t>* counters()
+  {
+    static std::atomic<std::size_t> values[max_counter];
+    return values;
+  }
+#endif // defined(ASIO_ENABLE_RECYCLING_ALLOCATOR_STATS)
+
+  // The state shared with other threads. Created on first use.
+  owner_state* owner_;
+
+  // The number of blocks owned by this cache that are not on a local list.
+  std::size_t outstanding_;
+
+  // The local free lists, one per size class.
+  free_block* free_[num_classes];
+  std::size_t free_count_[num_classes];
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_SIZE_CLASS_CACHE_HPP
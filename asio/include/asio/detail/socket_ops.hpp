@@ -52,11 +52,24 @@ enum
   datagram_oriented = 32,
 
   // The socket may have been dup()-ed.
-  possible_dup = 64
+  possible_dup = 64,
+
+  // User wants accepted sockets created non-blocking and close-on-exec.
+  fast_accept = 128
 };
 
 typedef unsigned char state_type;
 
+// Flags that control how accepted sockets are created.
+enum
+{
+  // Create the accepted socket in non-blocking mode.
+  accept_non_blocking = 1,
+
+  // Create the accepted socket close-on-exec.
+  accept_close_on_exec = 2
+};
+
 struct noop_deleter { void operator()(void*) {} };
 typedef shared_ptr<void> shared_cancel_token_type;
 typedef weak_ptr<void> weak_cancel_token_type;
@@ -66,9 +79,12 @@ typedef weak_ptr<void> weak_cancel_token_type;
 ASIO_DECL socket_type accept(socket_type s, void* addr,
     std::size_t* addrlen, asio::error_code& ec);
 
-ASIO_DECL socket_type sync_accept(socket_type s, state_type state,
+ASIO_DECL socket_type accept(socket_type s, int flags,
     void* addr, std::size_t* addrlen, asio::error_code& ec);
 
+ASIO_DECL socket_type sync_accept(socket_type s, state_type state,
+    int flags, void* addr, std::size_t* addrlen, asio::error_code& ec);
+
 #if defined(ASIO_HAS_IOCP)
 
 ASIO_DECL void complete_iocp_accept(socket_type s, void* output_buffer,
@@ -78,7 +94,7 @@ ASIO_DECL void complete_iocp_accept(socket_type s, void* output_buffer,
 #else // defined(ASIO_HAS_IOCP)
 
 ASIO_DECL bool non_blocking_accept(socket_type s,
-    state_type state, void* addr, std::size_t* addrlen,
+    state_type state, int flags, void* addr, std::size_t* addrlen,
     asio::error_code& ec, socket_type& new_socket);
 
 #endif // defined(ASIO_HAS_IOCP)
@@ -16,10 +16,10 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
-#include <climits>
 #include <cstddef>
-#include "asio/detail/memory.hpp"
 #include "asio/detail/noncopyable.hpp"
+#include "asio/detail/size_class_cache.hpp"
+#include "asio/detail/thread_metrics.hpp"
 
 #if !defined(ASIO_NO_EXCEPTIONS)
 # include <exception>
@@ -31,85 +31,21 @@
 namespace asio {
 namespace detail {
 
-#ifndef ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE
-# define ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE 2
-#endif // ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE
-
 class thread_info_base
   : private noncopyable
 {
 public:
-  struct default_tag
-  {
-    enum
-    {
-      cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = 0,
-      end_mem_index = cache_size
-    };
-  };
-
-  struct awaitable_frame_tag
-  {
-    enum
-    {
-      cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = default_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
-    };
-  };
-
-  struct executor_function_tag
-  {
-    enum
-    {
-      cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = awaitable_frame_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
-    };
-  };
-
-  struct cancellation_signal_tag
-  {
-    enum
-    {
-      cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = executor_function_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
-    };
-  };
-
-  struct parallel_group_tag
-  {
-    enum
-    {
-      cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = cancellation_signal_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
-    };
-  };
-
-  enum { max_mem_index = parallel_group_tag::end_mem_index };
+  struct default_tag {};
+  struct awaitable_frame_tag {};
+  struct executor_function_tag {};
+  struct cancellation_signal_tag {};
+  struct parallel_group_tag {};
 
   thread_info_base()
 #if !defined(ASIO_NO_EXCEPTIONS)
     : has_pending_exception_(0)
 #endif // !defined(ASIO_NO_EXCEPTIONS)
   {
-    for (int i = 0; i < max_mem_index; ++i)
-      reusable_memory_[i] = 0;
-  }
-
-  ~thread_info_base()
-  {
-    for (int i = 0; i < max_mem_index; ++i)
-    {
-      // The following test for non-null pointers is technically redundant, but
-      // it is significantly faster when using a tight io_context::poll() loop
-      // in latency sensitive applications.
-      if (reusable_memory_[i])
-        aligned_delete(reusable_memory_[i]);
-    }
   }
 
   static void* allocate(thread_info_base* this_thread,
@@ -124,74 +60,31 @@ public:
     deallocate(default_tag(), this_thread, pointer, size);
   }
 
+  // Memory for all purposes is drawn from the same size-classed cache, so the
+  // purpose tag is retained only to keep the call sites self-describing.
   template <typename Purpose>
   static void* allocate(Purpose, thread_info_base* this_thread,
       std::size_t size, std::size_t align = ASIO_DEFAULT_ALIGN)
   {
-    std::size_t chunks = (size + chunk_size - 1) / chunk_size;
-
-    if (this_thread)
-    {
-      for (int mem_index = Purpose::begin_mem_index;
-          mem_index < Purpose::end_mem_index; ++mem_index)
-      {
-        if (this_thread->reusable_memory_[mem_index])
-        {
-          void* const pointer = this_thread->reusable_memory_[mem_index];
-          unsigned char* const mem = static_cast<unsigned char*>(pointer);
-          if (static_cast<std::size_t>(mem[0]) >= chunks
-              && reinterpret_cast<std::size_t>(pointer) % align == 0)
-          {
-            this_thread->reusable_memory_[mem_index] = 0;
-            mem[size] = mem[0];
-            return pointer;
-          }
-        }
-      }
-
-      for (int mem_index = Purpose::begin_mem_index;
-          mem_index < Purpose::end_mem_index; ++mem_index)
-      {
-        if (this_thread->reusable_memory_[mem_index])
-        {
-          void* const pointer = this_thread->reusable_memory_[mem_index];
-          this_thread->reusable_memory_[mem_index] = 0;
-          aligned_delete(pointer);
-          break;
-        }
-      }
-    }
-
-    void* const pointer = aligned_new(align, chunks * chunk_size + 1);
-    unsigned char* const mem = static_cast<unsigned char*>(pointer);
-    mem[size] = (chunks <= UCHAR_MAX) ? static_cast<unsigned char>(chunks) : 0;
-    return pointer;
+    return size_class_cache::allocate(
+        this_thread ? &this_thread->cache_ : 0, size, align);
   }
 
   template <typename Purpose>
   static void deallocate(Purpose, thread_info_base* this_thread,
-      void* pointer, std::size_t size)
+      void* pointer, std::size_t)
   {
-    if (size <= chunk_size * UCHAR_MAX)
-    {
-      if (this_thread)
-      {
-        for (int mem_index = Purpose::begin_mem_index;
-            mem_index < Purpose::end_mem_index; ++mem_index)
-        {
-          if (this_thread->reusable_memory_[mem_index] == 0)
-          {
-            unsigned char* const mem = static_cast<unsigned char*>(pointer);
-            mem[0] = mem[size];
-            this_thread->reusable_memory_[mem_index] = pointer;
-            return;
-          }
-        }
-      }
-    }
+    size_class_cache::deallocate(
+        this_thread ? &this_thread->cache_ : 0, pointer);
+  }
 
-    aligned_delete(pointer);
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  // Get the counters kept by the thread while it runs an io_context.
+  thread_metrics& metrics()
+  {
+    return metrics_;
   }
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
 
   void capture_current_exception()
   {
@@ -229,12 +122,11 @@ public:
   }
 
 private:
-#if defined(ASIO_HAS_IO_URING)
-  enum { chunk_size = 8 };
-#else // defined(ASIO_HAS_IO_URING)
-  enum { chunk_size = 4 };
-#endif // defined(ASIO_HAS_IO_URING)
-  void* reusable_memory_[max_mem_index];
+  size_class_cache cache_;
+
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  thread_metrics metrics_;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
 
 #if !defined(ASIO_NO_EXCEPTIONS)
   int has_pending_exception_;
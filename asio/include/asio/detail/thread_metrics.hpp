@@ -0,0 +1,216 @@
+//
+// detail/thread_metrics.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_THREAD_METRICS_HPP
+#define ASIO_DETAIL_THREAD_METRICS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/latency_histogram.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Cumulative counters kept by a thread while it runs an io_context. Only the
+// owning thread updates the counters, so no read-modify-write operations are
+// needed, but any thread may read them.
+class thread_metrics
+  : private noncopyable
+{
+public:
+  enum counter
+  {
+    handlers_executed,
+    handler_execution_ns,
+    reactor_wakeups,
+    reactor_events,
+    max_counter
+  };
+
+  enum histogram
+  {
+    queue_wait_histogram,
+    execution_histogram,
+    max_histogram
+  };
+
+  thread_metrics()
+    : next_(0),
+      prev_(0)
+  {
+    for (int i = 0; i < max_counter; ++i)
+      values_[i].store(0, std::memory_order_relaxed);
+    for (int i = 0; i < max_histogram; ++i)
+      for (std::size_t j = 0; j < latency_histogram::bucket_count; ++j)
+        buckets_[i][j].store(0, std::memory_order_relaxed);
+  }
+
+  // Add to a counter. Must only be called by the owning thread.
+  void add(counter c, std::uint64_t n)
+  {
+    values_[c].store(values_[c].load(std::memory_order_relaxed) + n,
+        std::memory_order_relaxed);
+  }
+
+  // Get the value of a counter.
+  std::uint64_t value(counter c) const
+  {
+    return values_[c].load(std::memory_order_relaxed);
+  }
+
+  // Record a duration in a histogram. Must only be called by the owning
+  // thread.
+  void record(histogram h, chrono::nanoseconds d)
+  {
+    std::atomic<std::uint64_t>& n =
+      buckets_[h][latency_histogram::bucket_index(d)];
+    n.store(n.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+  }
+
+  // Add the contents of a histogram to the given one.
+  void add_to(histogram h, latency_histogram& result) const
+  {
+    for (std::size_t i = 0; i < latency_histogram::bucket_count; ++i)
+      if (std::uint64_t n = buckets_[h][i].load(std::memory_order_relaxed))
+        result.record(latency_histogram::bucket_lower_bound(i), n);
+  }
+
+private:
+  friend class thread_metrics_list;
+  std::atomic<std::uint64_t> values_[max_counter];
+  std::atomic<std::uint64_t>
+    buckets_[max_histogram][latency_histogram::bucket_count];
+  thread_metrics* next_;
+  thread_metrics* prev_;
+};
+
+// The set of threads running an io_context. Counters from threads that have
+// left are retained, so that the totals never go backwards.
+class thread_metrics_list
+  : private noncopyable
+{
+public:
+  thread_metrics_list()
+    : first_(0),
+      size_(0)
+  {
+    for (int i = 0; i < thread_metrics::max_counter; ++i)
+      retired_[i] = 0;
+  }
+
+  // Registers a thread's counters for the lifetime of the object.
+  class scoped_registration
+    : private noncopyable
+  {
+  public:
+    scoped_registration(thread_metrics_list& list, thread_metrics& m)
+      : list_(list),
+        metrics_(m)
+    {
+      list_.add(metrics_);
+    }
+
+    ~scoped_registration()
+    {
+      list_.remove(metrics_);
+    }
+
+  private:
+    thread_metrics_list& list_;
+    thread_metrics& metrics_;
+  };
+
+  // Get the number of registered threads.
+  std::size_t size() const
+  {
+    mutex::scoped_lock lock(mutex_);
+    return size_;
+  }
+
+  // Get the sum of a counter over all threads, past and present.
+  std::uint64_t total(thread_metrics::counter c) const
+  {
+    mutex::scoped_lock lock(mutex_);
+    std::uint64_t n = retired_[c];
+    for (thread_metrics* m = first_; m; m = m->next_)
+      n += m->value(c);
+    return n;
+  }
+
+  // Get the combined histogram over all threads, past and present.
+  latency_histogram total(thread_metrics::histogram h) const
+  {
+    mutex::scoped_lock lock(mutex_);
+    latency_histogram result = retired_histograms_[h];
+    for (thread_metrics* m = first_; m; m = m->next_)
+      m->add_to(h, result);
+    return result;
+  }
+
+private:
+  void add(thread_metrics& m)
+  {
+    mutex::scoped_lock lock(mutex_);
+    m.next_ = first_;
+    m.prev_ = 0;
+    if (first_)
+      first_->prev_ = &m;
+    first_ = &m;
+    ++size_;
+  }
+
+  void remove(thread_metrics& m)
+  {
+    mutex::scoped_lock lock(mutex_);
+    for (int i = 0; i < thread_metrics::max_counter; ++i)
+      retired_[i] += m.value(static_cast<thread_metrics::counter>(i));
+    for (int i = 0; i < thread_metrics::max_histogram; ++i)
+      m.add_to(static_cast<thread_metrics::histogram>(i),
+          retired_histograms_[i]);
+    if (m.prev_)
+      m.prev_->next_ = m.next_;
+    else
+      first_ = m.next_;
+    if (m.next_)
+      m.next_->prev_ = m.prev_;
+    m.next_ = m.prev_ = 0;
+    --size_;
+  }
+
+  mutable mutex mutex_;
+  thread_metrics* first_;
+  std::size_t size_;
+  std::uint64_t retired_[thread_metrics::max_counter];
+  latency_histogram retired_histograms_[thread_metrics::max_histogram];
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
+#endif // ASIO_DETAIL_THREAD_METRICS_HPP
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <atomic>
 #include <cstddef>
 #include <vector>
 #include "asio/detail/cstdint.hpp"
@@ -23,6 +24,7 @@
 #include "asio/detail/limits.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/timer_queue_base.hpp"
+#include "asio/detail/type_traits.hpp"
 #include "asio/detail/wait_op.hpp"
 #include "asio/error.hpp"
 
@@ -31,6 +33,68 @@
 namespace asio {
 namespace detail {
 
+// Holds a later expiry time that has been published for a queued timer without
+// holding the scheduler's lock. The queue picks it up when the timer reaches
+// the front of the heap.
+template <typename Time, bool Supported = is_trivially_copyable<Time>::value>
+class timer_refresh
+{
+public:
+  timer_refresh()
+    : time_(Time()),
+      pending_(false)
+  {
+  }
+
+  // Publish a new expiry time. Returns true if the refresh was recorded.
+  bool set(const Time& time)
+  {
+    time_.store(time, std::memory_order_relaxed);
+    pending_.store(true, std::memory_order_release);
+    return true;
+  }
+
+  // Consume a published expiry time, if any.
+  bool take(Time& time)
+  {
+    if (!pending_.load(std::memory_order_relaxed))
+      return false;
+    if (!pending_.exchange(false, std::memory_order_acquire))
+      return false;
+    time = time_.load(std::memory_order_relaxed);
+    return true;
+  }
+
+  // Discard any published expiry time.
+  void clear()
+  {
+    pending_.store(false, std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<Time> time_;
+  std::atomic<bool> pending_;
+};
+
+template <typename Time>
+class timer_refresh<Time, false>
+{
+public:
+  bool set(const Time&)
+  {
+    return false;
+  }
+
+  bool take(Time&)
+  {
+    return false;
+  }
+
+  void clear()
+  {
+  }
+};
+
 template <typename Time_Traits>
 class timer_queue
   : public timer_queue_base
@@ -64,6 +128,9 @@ public:
     // Pointers to adjacent timers in a linked list.
     per_timer_data* next_;
     per_timer_data* prev_;
+
+    // A later expiry time published without the scheduler's lock.
+    timer_refresh<time_type> refresh_;
   };
 
   // Constructor.
@@ -81,6 +148,8 @@ public:
     // Enqueue the timer object.
     if (timer.prev_ == 0 && &timer != timers_)
     {
+      timer.refresh_.clear();
+
       if (this->is_positive_infinity(time))
       {
         // No heap entry is required for timers that never expire.
@@ -117,6 +186,14 @@ public:
     return timers_ == 0;
   }
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  // Get the number of timers that have pending waits.
+  virtual std::size_t pending_timers() const
+  {
+    return heap_.size();
+  }
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
   // Get the time for the timer that is earliest in the queue.
   virtual long wait_duration_msec(long max_duration) const
   {
@@ -150,6 +227,16 @@ public:
       while (!heap_.empty() && !Time_Traits::less_than(now, heap_[0].time_))
       {
         per_timer_data* timer = heap_[0].timer_;
+        time_type refreshed_time;
+        if (timer->refresh_.take(refreshed_time)
+            && Time_Traits::less_than(now, refreshed_time))
+        {
+          // The expiry was extended while the timer was queued, so move it to
+          // its new position instead of completing its operations.
+          heap_[0].time_ = refreshed_time;
+          down_heap(0);
+          continue;
+        }
         while (wait_op* op = timer->op_queue_.front())
         {
           timer->op_queue_.pop();
@@ -221,11 +308,57 @@ public:
     }
   }
 
+  // Extend the expiry time of a queued timer without locking. Returns false if
+  // the refresh cannot be published, in which case the timer must be
+  // rescheduled instead. The new time must not be earlier than the time at
+  // which the timer is queued.
+  static bool refresh_timer(per_timer_data& timer, const time_type& time)
+  {
+    return timer.refresh_.set(time);
+  }
+
+  // Change the expiry time of a queued timer, keeping its operations. Returns
+  // true if the timer is now the earliest in the queue, in which case the
+  // reactor's event demultiplexing function call may need to be interrupted
+  // and restarted.
+  bool reschedule_timer(per_timer_data& timer, const time_type& time)
+  {
+    if (timer.prev_ == 0 && &timer != timers_)
+      return false;
+
+    timer.refresh_.clear();
+
+    std::size_t index = timer.heap_index_;
+    if (index < heap_.size())
+    {
+      heap_[index].time_ = time;
+      if (index > 0 && Time_Traits::less_than(
+            heap_[index].time_, heap_[(index - 1) / 2].time_))
+        up_heap(index);
+      else
+        down_heap(index);
+    }
+    else if (!this->is_positive_infinity(time))
+    {
+      timer.heap_index_ = heap_.size();
+      heap_entry entry = { time, &timer };
+      heap_.push_back(entry);
+      up_heap(heap_.size() - 1);
+    }
+
+    return timer.heap_index_ == 0;
+  }
+
   // Move operations from one timer to another, empty timer.
   void move_timer(per_timer_data& target, per_timer_data& source)
   {
     target.op_queue_.push(source.op_queue_);
 
+    time_type refreshed_time;
+    target.refresh_.clear();
+    if (source.refresh_.take(refreshed_time))
+      target.refresh_.set(refreshed_time);
+
     target.heap_index_ = source.heap_index_;
     source.heap_index_ = (std::numeric_limits<std::size_t>::max)();
 
@@ -289,6 +422,8 @@ private:
   // Remove a timer from the heap and list of timers.
   void remove_timer(per_timer_data& timer)
   {
+    timer.refresh_.clear();
+
     // Remove the timer from the heap.
     std::size_t index = timer.heap_index_;
     if (!heap_.empty() && index < heap_.size())
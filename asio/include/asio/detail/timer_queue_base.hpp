@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <cstddef>
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/operation.hpp"
@@ -50,6 +51,11 @@ public:
   // Dequeue all timers.
   virtual void get_all_timers(op_queue<operation>& ops) = 0;
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  // Get the number of timers that have pending waits.
+  virtual std::size_t pending_timers() const = 0;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 private:
   friend class timer_queue_set;
 
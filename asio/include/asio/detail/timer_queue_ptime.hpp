@@ -72,6 +72,11 @@ public:
   // Dequeue all timers.
   ASIO_DECL virtual void get_all_timers(op_queue<operation>& ops);
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  // Get the number of timers that have pending waits.
+  ASIO_DECL virtual std::size_t pending_timers() const;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
   // Cancel and dequeue operations for the given timer.
   ASIO_DECL std::size_t cancel_timer(
       per_timer_data& timer, op_queue<operation>& ops,
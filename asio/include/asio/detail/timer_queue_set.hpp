@@ -16,6 +16,8 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <cstddef>
+#include <vector>
 #include "asio/detail/timer_queue_base.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -50,6 +52,11 @@ public:
   // Dequeue all timers.
   ASIO_DECL void get_all_timers(op_queue<operation>& ops);
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  // Get the number of pending timers in each queue.
+  ASIO_DECL void get_pending_timers(std::vector<std::size_t>& counts) const;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 private:
   timer_queue_base* first_;
 };
@@ -81,10 +81,14 @@ using std::is_destructible;
 
 using std::is_function;
 
+using std::is_integral;
+
 using std::is_move_constructible;
 
 using std::is_nothrow_copy_constructible;
 
+using std::is_nothrow_move_constructible;
+
 using std::is_nothrow_destructible;
 
 using std::is_object;
@@ -97,6 +101,8 @@ using std::is_same;
 
 using std::is_scalar;
 
+using std::is_trivially_copyable;
+
 using std::remove_cv;
 
 template <typename T>
@@ -33,6 +33,10 @@
 #include "asio/detail/win_iocp_thread_info.hpp"
 #include "asio/execution_context.hpp"
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+# include "asio/io_context_metrics.hpp"
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -89,6 +93,15 @@ public:
     return ::InterlockedExchangeAdd(&stopped_, 0) != 0;
   }
 
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  // Fill in a snapshot of the metrics. Only the outstanding work is tracked.
+  void get_metrics(io_context_metrics& m)
+  {
+    m.outstanding_work = static_cast<std::size_t>(
+        ::InterlockedExchangeAdd(&outstanding_work_, 0));
+  }
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
   // Restart in preparation for a subsequent run invocation.
   void restart()
   {
@@ -209,6 +222,13 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& to,
       typename timer_queue<Time_Traits>::per_timer_data& from);
 
+  // Change the expiry time of the given timer without cancelling its
+  // operations.
+  template <typename Time_Traits>
+  void reschedule_timer(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data& timer,
+      const typename Time_Traits::time_type& time);
+
   // Get the concurrency hint that was used to initialise the io_context.
   int concurrency_hint() const
   {
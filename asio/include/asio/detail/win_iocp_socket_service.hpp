@@ -524,7 +524,9 @@ public:
 
     std::size_t addr_len = peer_endpoint ? peer_endpoint->capacity() : 0;
     socket_holder new_socket(socket_ops::sync_accept(impl.socket_,
-          impl.state_, peer_endpoint ? peer_endpoint->data() : 0,
+          impl.state_, (impl.state_ & socket_ops::fast_accept) != 0
+            ? socket_ops::accept_close_on_exec : 0,
+          peer_endpoint ? peer_endpoint->data() : 0,
           peer_endpoint ? &addr_len : 0, ec));
 
     // On success, assign new connection to peer socket object.
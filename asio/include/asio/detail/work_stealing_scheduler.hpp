@@ -0,0 +1,155 @@
+//
+// detail/work_stealing_scheduler.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_WORK_STEALING_SCHEDULER_HPP
+#define ASIO_DETAIL_WORK_STEALING_SCHEDULER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <atomic>
+#include <cstddef>
+#include "asio/execution_context.hpp"
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/event.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/detail/scheduler_operation.hpp"
+#include "asio/detail/thread_context.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A scheduler for CPU-bound work, in which each worker thread has its own
+// Chase-Lev deque. Operations posted from a worker are pushed on to that
+// worker's deque, and the worker pops them in LIFO order so that recently
+// forked work is run while its data is still in cache. Idle workers steal
+// from the other end of other workers' deques in FIFO order, taking the
+// oldest, and typically largest, pieces of work. Operations posted from
+// outside the pool go to a shared injection queue.
+class work_stealing_scheduler
+  : public execution_context_service_base<work_stealing_scheduler>,
+    public thread_context
+{
+public:
+  typedef scheduler_operation operation;
+
+  // Constructor. Specifies the number of worker threads that will run the
+  // scheduler.
+  ASIO_DECL work_stealing_scheduler(asio::execution_context& ctx,
+      std::size_t num_workers);
+
+  // Destructor.
+  ASIO_DECL ~work_stealing_scheduler();
+
+  // Destroy all user-defined handler objects owned by the service.
+  ASIO_DECL void shutdown();
+
+  // Run operations as the worker with the given index until the scheduler is
+  // stopped. Each index must be used by exactly one thread.
+  ASIO_DECL void run(std::size_t index);
+
+  // Interrupt the workers.
+  ASIO_DECL void stop();
+
+  // Determine whether the scheduler is stopped.
+  ASIO_DECL bool stopped() const;
+
+  // Notify that some work has started.
+  void work_started()
+  {
+    ++outstanding_work_;
+  }
+
+  // Notify that some work has finished.
+  void work_finished()
+  {
+    if (--outstanding_work_ == 0)
+      stop();
+  }
+
+  // Return whether a handler can be dispatched immediately.
+  bool can_dispatch()
+  {
+    return thread_call_stack::contains(this) != 0;
+  }
+
+  // Capture the current exception so it can be rethrown from a run function.
+  ASIO_DECL void capture_current_exception();
+
+  // Request invocation of the given operation and return immediately. Assumes
+  // that work_started() has not yet been called for the operation. Idle
+  // workers are not woken for continuations, as the posting worker will run
+  // them when it next pops from its deque.
+  ASIO_DECL void post_immediate_completion(
+      operation* op, bool is_continuation);
+
+  // Get the number of worker threads.
+  std::size_t concurrency_hint() const
+  {
+    return num_workers_;
+  }
+
+private:
+  struct worker;
+
+  // Take an operation from the worker's own deque, the injection queue, or
+  // another worker's deque.
+  ASIO_DECL operation* find_work(worker& this_worker);
+
+  // Check, without taking any operation, whether work may be available.
+  ASIO_DECL bool work_available() const;
+
+  // Wait until work may be available. Returns false if stopped.
+  ASIO_DECL bool wait_for_work();
+
+  // Wake a worker that is waiting for work.
+  ASIO_DECL void wake_one_worker();
+
+  // Mutex to protect access to the injection queue and waiting workers.
+  mutable mutex mutex_;
+
+  // Event to wake up waiting workers.
+  event wakeup_event_;
+
+  // Operations posted from outside the pool.
+  op_queue<operation> injected_;
+
+  // The number of operations in the injection queue.
+  std::atomic<std::size_t> injected_count_;
+
+  // The number of workers that are waiting, or about to wait, for work.
+  std::atomic<std::size_t> idle_workers_;
+
+  // Whether the scheduler has been stopped.
+  std::atomic<bool> stopped_;
+
+  // The count of unfinished work.
+  atomic_count outstanding_work_;
+
+  // The workers.
+  std::size_t num_workers_;
+  worker* workers_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/work_stealing_scheduler.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_DETAIL_WORK_STEALING_SCHEDULER_HPP
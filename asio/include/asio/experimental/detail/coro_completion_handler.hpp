@@ -47,6 +47,8 @@ struct coro_completion_handler
   void operator()(Args... args)
   {
     result.emplace(std::move(args)...);
+    asio::detail::frame_arena::context arena_context(
+        self.promise().get_frame_arena());
     self.resume();
   }
 
@@ -13,6 +13,7 @@
 #define ASIO_EXPERIMENTAL_DETAIL_CORO_PROMISE_ALLOCATOR_HPP
 
 #include "asio/detail/config.hpp"
+#include "asio/detail/frame_arena.hpp"
 #include "asio/experimental/coro_traits.hpp"
 
 namespace asio {
@@ -114,24 +115,63 @@ struct coro_promise_allocator
   {
   }
 
+  /// Frames using a user-supplied allocator do not take part in an arena.
+  asio::detail::frame_arena* get_frame_arena() noexcept
+  {
+    return nullptr;
+  }
+
 private:
   allocator_type alloc_;
 };
 
+/// Frames using the default allocator are placed in a frame arena. A coro
+/// created while another coro's arena is active shares that arena, so that
+/// a chain of nested coros is allocated contiguously.
 template <>
 struct coro_promise_allocator<std::allocator<void>>
 {
   using allocator_type = std::allocator<void>;
 
+  void* operator new(const std::size_t size)
+  {
+    return asio::detail::frame_arena::allocate(size);
+  }
+
+  void operator delete(void* raw, const std::size_t)
+  {
+    asio::detail::frame_arena::deallocate(raw);
+  }
+
   template <typename... Args>
   coro_promise_allocator(Args&&...)
+    : arena_(asio::detail::frame_arena::share_current())
   {
   }
 
+  coro_promise_allocator(const coro_promise_allocator&) = delete;
+  coro_promise_allocator& operator=(const coro_promise_allocator&) = delete;
+
+  ~coro_promise_allocator()
+  {
+    if (arena_)
+      arena_->release();
+  }
+
   allocator_type get_allocator() const
   {
     return {};
   }
+
+  asio::detail::frame_arena* get_frame_arena()
+  {
+    if (!arena_)
+      arena_ = asio::detail::frame_arena::create();
+    return arena_;
+  }
+
+private:
+  asio::detail::frame_arena* arena_;
 };
 
 } // namespace detail
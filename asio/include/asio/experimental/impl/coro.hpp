@@ -236,7 +236,12 @@ struct coro_with_arg
           typename coro_t::promise_type>::from_promise(*coro.coro_);
 
         return dispatch_coroutine(
-            coro.coro_->get_executor(), [hh]() mutable { hh.resume(); }).handle;
+            coro.coro_->get_executor(), [hh]() mutable
+            {
+              asio::detail::frame_arena::context arena_context(
+                  hh.promise().get_frame_arena());
+              hh.resume();
+            }).handle;
       }
     }
 
@@ -1028,7 +1033,12 @@ struct coro<Yield, Return, Executor, Allocator>::awaitable_t
 
       return detail::dispatch_coroutine(
           coro_.coro_->get_executor(),
-          [hh]() mutable { hh.resume(); }).handle;
+          [hh]() mutable
+          {
+            asio::detail::frame_arena::context arena_context(
+                hh.promise().get_frame_arena());
+            hh.resume();
+          }).handle;
     }
   }
 
@@ -1080,6 +1090,8 @@ struct coro<Yield, Return, Executor, Allocator>::initiate_async_resume
 
       the_coro->awaited_from = post_coroutine(std::move(exec), std::move(h));
       the_coro->reset_error();
+      asio::detail::frame_arena::context arena_context(
+          the_coro->get_frame_arena());
       ch.resume();
     };
   }
@@ -1102,6 +1114,8 @@ struct coro<Yield, Return, Executor, Allocator>::initiate_async_resume
       the_coro->awaited_from = detail::post_coroutine(
           exec, std::move(h), the_coro->result_).handle;
       the_coro->reset_error();
+      asio::detail::frame_arena::context arena_context(
+          the_coro->get_frame_arena());
       ch.resume();
     };
   }
@@ -1134,6 +1148,8 @@ struct coro<Yield, Return, Executor, Allocator>::initiate_async_resume
         the_coro->awaited_from = detail::post_coroutine(
             exec, std::move(h), the_coro->error_).handle;
         the_coro->reset_error();
+        asio::detail::frame_arena::context arena_context(
+            the_coro->get_frame_arena());
         ch.resume();
       }
     };
@@ -1168,6 +1184,8 @@ struct coro<Yield, Return, Executor, Allocator>::initiate_async_resume
         the_coro->awaited_from = detail::post_coroutine(
             exec, std::move(h), the_coro->error_, the_coro->result_).handle;
         the_coro->reset_error();
+        asio::detail::frame_arena::context arena_context(
+            the_coro->get_frame_arena());
         ch.resume();
       }
     };
@@ -21,8 +21,7 @@
 #include <tuple>
 #include "asio/cancellation_signal.hpp"
 #include "asio/cancellation_state.hpp"
-#include "asio/detail/thread_context.hpp"
-#include "asio/detail/thread_info_base.hpp"
+#include "asio/detail/frame_arena.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/detail/type_traits.hpp"
 #include "asio/error.hpp"
@@ -86,20 +85,16 @@ class awaitable_frame_base
 {
 public:
 #if !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+  // Frames created while an awaitable thread is being pumped are allocated
+  // from that thread's frame arena.
   void* operator new(std::size_t size)
   {
-    return asio::detail::thread_info_base::allocate(
-        asio::detail::thread_info_base::awaitable_frame_tag(),
-        asio::detail::thread_context::top_of_thread_call_stack(),
-        size);
+    return asio::detail::frame_arena::allocate(size);
   }
 
-  void operator delete(void* pointer, std::size_t size)
+  void operator delete(void* pointer, std::size_t)
   {
-    asio::detail::thread_info_base::deallocate(
-        asio::detail::thread_info_base::awaitable_frame_tag(),
-        asio::detail::thread_context::top_of_thread_call_stack(),
-        pointer, size);
+    asio::detail::frame_arena::deallocate(pointer);
   }
 #endif // !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
 
@@ -604,6 +599,7 @@ class awaitable_frame<awaitable_thread_entry_point, Executor>
 public:
   awaitable_frame()
     : top_of_stack_(0),
+      arena_(0),
       has_executor_(false),
       has_context_switched_(false),
       throw_if_cancelled_(true)
@@ -614,6 +610,8 @@ public:
   {
     if (has_executor_)
       u_.executor_.~Executor();
+    if (arena_)
+      arena_->release();
   }
 
   awaitable<awaitable_thread_entry_point, Executor> get_return_object()
@@ -647,6 +645,7 @@ private:
   } u_;
 
   awaitable_frame_base<Executor>* top_of_stack_;
+  asio::detail::frame_arena* arena_;
   asio::cancellation_slot parent_cancellation_slot_;
   asio::cancellation_state cancellation_state_;
   bool has_executor_;
@@ -765,9 +764,19 @@ protected:
   // has been transferred to another resumable_thread object.
   void pump()
   {
-    do
-      bottom_of_stack_.frame_->top_of_stack_->resume();
-    while (bottom_of_stack_.frame_ && bottom_of_stack_.frame_->top_of_stack_);
+    {
+#if !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+      if (!bottom_of_stack_.frame_->arena_)
+        bottom_of_stack_.frame_->arena_ = asio::detail::frame_arena::create();
+      asio::detail::frame_arena::context arena_context(
+          bottom_of_stack_.frame_->arena_);
+#endif // !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+
+      do
+        bottom_of_stack_.frame_->top_of_stack_->resume();
+      while (bottom_of_stack_.frame_
+          && bottom_of_stack_.frame_->top_of_stack_);
+    }
 
     if (bottom_of_stack_.frame_)
     {
@@ -132,6 +132,27 @@ void io_context::restart()
   impl_.restart();
 }
 
+io_context_metrics io_context::metrics() const
+{
+  io_context_metrics m = io_context_metrics();
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  impl_.get_metrics(m);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  return m;
+}
+
+void io_context::set_slow_handler_callback(
+    chrono::nanoseconds threshold, slow_handler_callback callback)
+{
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS) && !defined(ASIO_HAS_IOCP)
+  impl_.set_slow_handler_callback(threshold,
+      static_cast<slow_handler_callback&&>(callback));
+#else // defined(ASIO_ENABLE_IO_CONTEXT_METRICS) && !defined(ASIO_HAS_IOCP)
+  (void)threshold;
+  (void)callback;
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS) && !defined(ASIO_HAS_IOCP)
+}
+
 io_context::service::service(asio::io_context& owner)
   : execution_context::service(owner)
 {
@@ -0,0 +1,557 @@
+//
+// impl/proxy.hpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_PROXY_HPP
+#define ASIO_IMPL_PROXY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <memory>
+#include "asio/bind_cancellation_slot.hpp"
+#include "asio/buffer.hpp"
+#include "asio/cancellation_signal.hpp"
+#include "asio/compose.hpp"
+#include "asio/detail/recycling_allocator.hpp"
+#include "asio/detail/size_class_cache.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/recycling_allocator.hpp"
+#include "asio/write.hpp"
+
+#if defined(ASIO_HAS_SPLICE)
+# include <cerrno>
+# include <fcntl.h>
+# include <unistd.h>
+#endif // defined(ASIO_HAS_SPLICE)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+#if defined(ASIO_HAS_SPLICE)
+
+// A non-blocking pipe through which data is spliced from one socket to
+// another. The pipe is only refilled from the source once it has been fully
+// drained into the destination, so it bounds the data held in transit.
+class proxy_pipe
+{
+public:
+  proxy_pipe()
+    : size_(0)
+  {
+    fds_[0] = -1;
+    fds_[1] = -1;
+  }
+
+  proxy_pipe(proxy_pipe&& other)
+    : size_(other.size_)
+  {
+    fds_[0] = other.fds_[0];
+    fds_[1] = other.fds_[1];
+    other.fds_[0] = -1;
+    other.fds_[1] = -1;
+    other.size_ = 0;
+  }
+
+  ~proxy_pipe()
+  {
+    if (fds_[0] != -1)
+      ::close(fds_[0]);
+    if (fds_[1] != -1)
+      ::close(fds_[1]);
+  }
+
+  void open(asio::error_code& ec)
+  {
+    if (::pipe2(fds_, O_NONBLOCK | O_CLOEXEC) != 0)
+    {
+      ec = asio::error_code(errno, asio::error::get_system_category());
+      fds_[0] = -1;
+      fds_[1] = -1;
+      return;
+    }
+    ec = asio::error_code();
+  }
+
+  // Get the number of bytes held in the pipe.
+  std::size_t size() const
+  {
+    return size_;
+  }
+
+  // Move as much data as the pipe will hold from the descriptor into the pipe.
+  // Returns 0 with no error at end of stream.
+  std::size_t splice_from(int fd, asio::error_code& ec)
+  {
+    ssize_t n = ::splice(fd, 0, fds_[1], 0, max_transfer_size,
+        SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    return consumed(n, ec, +1);
+  }
+
+  // Move data held in the pipe to the descriptor.
+  std::size_t splice_to(int fd, asio::error_code& ec)
+  {
+    ssize_t n = ::splice(fds_[0], 0, fd, 0, size_,
+        SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    return consumed(n, ec, -1);
+  }
+
+  // Copy data held in the pipe out into memory.
+  std::size_t read(void* data, std::size_t length, asio::error_code& ec)
+  {
+    ssize_t n = ::read(fds_[0], data, length < size_ ? length : size_);
+    return consumed(n, ec, -1);
+  }
+
+private:
+  enum { max_transfer_size = 1024 * 1024 };
+
+  std::size_t consumed(ssize_t n, asio::error_code& ec, int direction)
+  {
+    if (n < 0)
+    {
+      // Descriptors that cannot be spliced fail with EINVAL.
+      if (errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP)
+        ec = asio::error::operation_not_supported;
+      else
+        ec = asio::error_code(errno, asio::error::get_system_category());
+      return 0;
+    }
+
+    ec = asio::error_code();
+    if (direction > 0)
+      size_ += static_cast<std::size_t>(n);
+    else
+      size_ -= static_cast<std::size_t>(n);
+    return static_cast<std::size_t>(n);
+  }
+
+  int fds_[2];
+  std::size_t size_;
+};
+
+#endif // defined(ASIO_HAS_SPLICE)
+
+// A buffer for the copy loop. The buffer is the largest block held by the
+// thread's recycling allocator cache, so that proxying many short-lived
+// connections does not go to the heap for each one.
+class proxy_buffer
+{
+public:
+  enum { capacity = size_class_cache::max_block_size };
+
+  proxy_buffer()
+    : data_(0)
+  {
+  }
+
+  proxy_buffer(proxy_buffer&& other)
+    : data_(other.data_)
+  {
+    other.data_ = 0;
+  }
+
+  ~proxy_buffer()
+  {
+    if (data_)
+      recycling_allocator<unsigned char>().deallocate(data_, capacity);
+  }
+
+  unsigned char* data()
+  {
+    if (!data_)
+      data_ = recycling_allocator<unsigned char>().allocate(capacity);
+    return data_;
+  }
+
+private:
+  unsigned char* data_;
+};
+
+// Relays data in one direction, from the source socket to the sink socket,
+// until end of stream or an error.
+template <typename Source, typename Sink>
+class proxy_relay_op
+{
+public:
+  proxy_relay_op(Source& source, Sink& sink)
+    : source_(source),
+      sink_(sink),
+      state_(starting),
+      eof_(false),
+      total_(0)
+  {
+  }
+
+  template <typename Self>
+  void operator()(Self& self, asio::error_code ec = asio::error_code(),
+      std::size_t n = 0)
+  {
+    switch (state_)
+    {
+    case starting:
+#if defined(ASIO_HAS_SPLICE)
+      source_.native_non_blocking(true, ec);
+      if (!ec)
+        sink_.native_non_blocking(true, ec);
+      if (!ec)
+        pipe_.open(ec);
+      if (!ec)
+      {
+        state_ = splicing;
+        source_.async_wait(socket_base::wait_read, static_cast<Self&&>(self));
+        return;
+      }
+#endif // defined(ASIO_HAS_SPLICE)
+      copy(self);
+      return;
+#if defined(ASIO_HAS_SPLICE)
+    case splicing:
+      if (ec)
+        break;
+      splice(self);
+      return;
+#endif // defined(ASIO_HAS_SPLICE)
+    case reading:
+      if (ec == asio::error::eof)
+        ec = asio::error_code();
+      else if (!ec)
+      {
+        state_ = writing;
+        asio::async_write(sink_, asio::buffer(buffer_.data(), n),
+            static_cast<Self&&>(self));
+        return;
+      }
+      break;
+    case writing:
+      total_ += n;
+      if (ec)
+        break;
+      copy(self);
+      return;
+    }
+
+    finish(self, ec);
+  }
+
+private:
+#if defined(ASIO_HAS_SPLICE)
+  // Move data through the pipe until either socket would block. Only one of
+  // the two sockets is waited on at a time: the sink while the pipe holds
+  // data, the source otherwise.
+  template <typename Self>
+  void splice(Self& self)
+  {
+    asio::error_code ec;
+    for (;;)
+    {
+      if (pipe_.size() > 0)
+      {
+        std::size_t n = pipe_.splice_to(sink_.native_handle(), ec);
+        if (ec == asio::error::would_block)
+        {
+          sink_.async_wait(socket_base::wait_write, static_cast<Self&&>(self));
+          return;
+        }
+        total_ += n;
+      }
+      else if (eof_)
+        break;
+      else
+      {
+        std::size_t n = pipe_.splice_from(source_.native_handle(), ec);
+        if (ec == asio::error::would_block)
+        {
+          source_.async_wait(socket_base::wait_read,
+              static_cast<Self&&>(self));
+          return;
+        }
+        eof_ = (n == 0 && !ec);
+      }
+
+      if (ec == asio::error::operation_not_supported)
+      {
+        // One of the sockets cannot be spliced, such as a VSOCK socket as
+        // the source. Copy through memory instead.
+        copy(self);
+        return;
+      }
+      else if (ec && ec != asio::error::interrupted)
+        break;
+    }
+
+    finish(self, ec);
+  }
+#endif // defined(ASIO_HAS_SPLICE)
+
+  // Copy one buffer of data from the source to the sink.
+  template <typename Self>
+  void copy(Self& self)
+  {
+#if defined(ASIO_HAS_SPLICE)
+    // Data already spliced into the pipe is sent before any more is read.
+    if (pipe_.size() > 0)
+    {
+      asio::error_code ec;
+      std::size_t n = pipe_.read(buffer_.data(), proxy_buffer::capacity, ec);
+      if (ec)
+      {
+        finish(self, ec);
+        return;
+      }
+
+      state_ = writing;
+      asio::async_write(sink_, asio::buffer(buffer_.data(), n),
+          static_cast<Self&&>(self));
+      return;
+    }
+#endif // defined(ASIO_HAS_SPLICE)
+
+    state_ = reading;
+    source_.async_read_some(
+        asio::buffer(buffer_.data(), proxy_buffer::capacity),
+        static_cast<Self&&>(self));
+  }
+
+  // Propagate end of stream to the sink's peer and complete.
+  template <typename Self>
+  void finish(Self& self, const asio::error_code& ec)
+  {
+    if (!ec)
+    {
+      asio::error_code ignored;
+      sink_.shutdown(socket_base::shutdown_send, ignored);
+    }
+
+    self.complete(ec, total_);
+  }
+
+  Source& source_;
+  Sink& sink_;
+  enum
+  {
+    starting,
+#if defined(ASIO_HAS_SPLICE)
+    splicing,
+#endif // defined(ASIO_HAS_SPLICE)
+    reading,
+    writing
+  } state_;
+  bool eof_;
+  std::size_t total_;
+#if defined(ASIO_HAS_SPLICE)
+  proxy_pipe pipe_;
+#endif // defined(ASIO_HAS_SPLICE)
+  proxy_buffer buffer_;
+};
+
+// The state shared by the two directions of a proxy operation. The enclosing
+// composed operation is moved in here and completed by whichever direction
+// finishes last.
+template <typename Self>
+class proxy_state
+{
+public:
+  explicit proxy_state(Self&& self)
+    : self_(static_cast<Self&&>(self)),
+      pending_(2)
+  {
+    bytes_[0] = 0;
+    bytes_[1] = 0;
+  }
+
+  template <typename Stream1, typename Stream2>
+  static void start(Self& self, Stream1& a, Stream2& b);
+
+  void direction_complete(int direction,
+      const asio::error_code& ec, std::size_t n)
+  {
+    bytes_[direction] = n;
+    if (ec && !ec_)
+      ec_ = ec;
+
+    if (--pending_ > 0)
+    {
+      // A failure in one direction ends the proxy, so stop the other.
+      if (ec)
+        signals_[1 - direction].emit(cancellation_type::terminal);
+      return;
+    }
+
+    self_.get_cancellation_state().slot().clear();
+    self_.complete(ec_, bytes_[0], bytes_[1]);
+  }
+
+private:
+  Self self_;
+  cancellation_signal signals_[2];
+  asio::error_code ec_;
+  std::size_t bytes_[2];
+  int pending_;
+};
+
+// The completion handler for one direction of a proxy operation. Intermediate
+// handlers run on the proxy operation's executor.
+template <typename Self>
+class proxy_direction_handler
+{
+public:
+  typedef decltype(declval<const Self&>().get_executor()) executor_type;
+
+  typedef asio::recycling_allocator<void> allocator_type;
+
+  proxy_direction_handler(
+      const std::shared_ptr<proxy_state<Self>>& state,
+      const executor_type& ex, int direction)
+    : state_(state),
+      executor_(ex),
+      direction_(direction)
+  {
+  }
+
+  executor_type get_executor() const noexcept
+  {
+    return executor_;
+  }
+
+  allocator_type get_allocator() const noexcept
+  {
+    return allocator_type();
+  }
+
+  void operator()(const asio::error_code& ec, std::size_t n)
+  {
+    state_->direction_complete(direction_, ec, n);
+  }
+
+private:
+  std::shared_ptr<proxy_state<Self>> state_;
+  executor_type executor_;
+  int direction_;
+};
+
+template <typename Self>
+template <typename Stream1, typename Stream2>
+void proxy_state<Self>::start(Self& self, Stream1& a, Stream2& b)
+{
+  typedef proxy_direction_handler<Self> handler_type;
+  typename handler_type::executor_type ex = self.get_executor();
+
+  std::shared_ptr<proxy_state> state = std::allocate_shared<proxy_state>(
+      asio::recycling_allocator<void>(), static_cast<Self&&>(self));
+
+  cancellation_slot slot = state->self_.get_cancellation_state().slot();
+  if (slot.is_connected())
+  {
+    proxy_state* p = state.get();
+    slot.assign(
+        [p](cancellation_type_t type)
+        {
+          p->signals_[0].emit(type);
+          p->signals_[1].emit(type);
+        });
+  }
+
+  cancellation_slot_binder<handler_type, cancellation_slot> handler1(
+      state->signals_[0].slot(), handler_type(state, ex, 0));
+  asio::async_compose<decltype(handler1),
+    void (asio::error_code, std::size_t)>(
+      proxy_relay_op<Stream1, Stream2>(a, b), handler1, a, b);
+
+  cancellation_slot_binder<handler_type, cancellation_slot> handler2(
+      state->signals_[1].slot(), handler_type(state, ex, 1));
+  asio::async_compose<decltype(handler2),
+    void (asio::error_code, std::size_t)>(
+      proxy_relay_op<Stream2, Stream1>(b, a), handler2, a, b);
+}
+
+template <typename Stream1, typename Stream2>
+class proxy_op
+{
+public:
+  proxy_op(Stream1& a, Stream2& b)
+    : a_(a),
+      b_(b)
+  {
+  }
+
+  template <typename Self>
+  void operator()(Self& self)
+  {
+    // The operation, including this object, is moved into the shared state.
+    Stream1& a = a_;
+    Stream2& b = b_;
+    proxy_state<Self>::start(self, a, b);
+  }
+
+private:
+  Stream1& a_;
+  Stream2& b_;
+};
+
+template <typename Stream1, typename Stream2>
+class initiate_async_proxy
+{
+public:
+  typedef typename Stream1::executor_type executor_type;
+
+  initiate_async_proxy(Stream1& a, Stream2& b)
+    : a_(a),
+      b_(b)
+  {
+  }
+
+  executor_type get_executor() const noexcept
+  {
+    return a_.get_executor();
+  }
+
+  template <typename ProxyHandler>
+  void operator()(ProxyHandler&& handler) const
+  {
+    asio::async_compose<ProxyHandler,
+      void (asio::error_code, std::size_t, std::size_t)>(
+        proxy_op<Stream1, Stream2>(a_, b_), handler, a_, b_);
+  }
+
+private:
+  Stream1& a_;
+  Stream2& b_;
+};
+
+} // namespace detail
+
+template <typename Protocol1, typename Executor1,
+    typename Protocol2, typename Executor2,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t, std::size_t)) ProxyToken>
+inline auto async_proxy(basic_stream_socket<Protocol1, Executor1>& a,
+    basic_stream_socket<Protocol2, Executor2>& b, ProxyToken&& token)
+  -> decltype(
+    async_initiate<ProxyToken,
+      void (asio::error_code, std::size_t, std::size_t)>(
+        declval<detail::initiate_async_proxy<
+          basic_stream_socket<Protocol1, Executor1>,
+          basic_stream_socket<Protocol2, Executor2>>>(), token))
+{
+  return async_initiate<ProxyToken,
+    void (asio::error_code, std::size_t, std::size_t)>(
+      detail::initiate_async_proxy<
+        basic_stream_socket<Protocol1, Executor1>,
+        basic_stream_socket<Protocol2, Executor2>>(a, b), token);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_PROXY_HPP
@@ -28,6 +28,7 @@
 #include "asio/detail/handler_tracking.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/reusable_op_memory.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
 
@@ -332,7 +333,8 @@ namespace detail
         stream_(stream),
         buffers_(buffers),
         start_(0),
-        handler_(static_cast<ReadHandler&&>(handler))
+        handler_(static_cast<ReadHandler&&>(handler)),
+        memory_((get_associated_allocator)(handler_), sizeof(*this))
     {
     }
 
@@ -354,7 +356,8 @@ namespace detail
         stream_(other.stream_),
         buffers_(static_cast<buffers_type&&>(other.buffers_)),
         start_(other.start_),
-        handler_(static_cast<ReadHandler&&>(other.handler_))
+        handler_(static_cast<ReadHandler&&>(other.handler_)),
+        memory_(static_cast<reusable_op_memory&&>(other.memory_))
     {
     }
 
@@ -387,12 +390,22 @@ namespace detail
           }
         }
 
+        memory_.reset();
         static_cast<ReadHandler&&>(handler_)(
             static_cast<const asio::error_code&>(ec),
             static_cast<const std::size_t&>(buffers_.total_consumed()));
       }
     }
 
+    typedef reusable_op_allocator<void,
+        associated_allocator_t<ReadHandler>> allocator_type;
+
+    allocator_type get_allocator() const noexcept
+    {
+      return allocator_type(memory_,
+          (get_associated_allocator)(handler_));
+    }
+
   //private:
     typedef asio::detail::consuming_buffers<mutable_buffer,
         MutableBufferSequence, MutableBufferIterator> buffers_type;
@@ -401,6 +414,7 @@ namespace detail
     buffers_type buffers_;
     int start_;
     ReadHandler handler_;
+    reusable_op_memory memory_;
   };
 
   template <typename AsyncReadStream, typename MutableBufferSequence,
@@ -560,7 +574,8 @@ namespace detail
         buffers_(static_cast<BufferSequence&&>(buffers)),
         start_(0),
         total_transferred_(0),
-        handler_(static_cast<ReadHandler&&>(handler))
+        handler_(static_cast<ReadHandler&&>(handler)),
+        memory_((get_associated_allocator)(handler_), sizeof(*this))
     {
     }
 
@@ -584,7 +599,8 @@ namespace detail
         buffers_(static_cast<DynamicBuffer_v1&&>(other.buffers_)),
         start_(other.start_),
         total_transferred_(other.total_transferred_),
-        handler_(static_cast<ReadHandler&&>(other.handler_))
+        handler_(static_cast<ReadHandler&&>(other.handler_)),
+        memory_(static_cast<reusable_op_memory&&>(other.memory_))
     {
     }
 
@@ -626,18 +642,29 @@ namespace detail
           }
         }
 
+        memory_.reset();
         static_cast<ReadHandler&&>(handler_)(
             static_cast<const asio::error_code&>(ec),
             static_cast<const std::size_t&>(total_transferred_));
       }
     }
 
+    typedef reusable_op_allocator<void,
+        associated_allocator_t<ReadHandler>> allocator_type;
+
+    allocator_type get_allocator() const noexcept
+    {
+      return allocator_type(memory_,
+          (get_associated_allocator)(handler_));
+    }
+
   //private:
     AsyncReadStream& stream_;
     DynamicBuffer_v1 buffers_;
     int start_;
     std::size_t total_transferred_;
     ReadHandler handler_;
+    reusable_op_memory memory_;
   };
 
   template <typename AsyncReadStream, typename DynamicBuffer_v1,
@@ -836,7 +863,8 @@ namespace detail
         start_(0),
         total_transferred_(0),
         bytes_available_(0),
-        handler_(static_cast<ReadHandler&&>(handler))
+        handler_(static_cast<ReadHandler&&>(handler)),
+        memory_((get_associated_allocator)(handler_), sizeof(*this))
     {
     }
 
@@ -862,7 +890,8 @@ namespace detail
         start_(other.start_),
         total_transferred_(other.total_transferred_),
         bytes_available_(other.bytes_available_),
-        handler_(static_cast<ReadHandler&&>(other.handler_))
+        handler_(static_cast<ReadHandler&&>(other.handler_)),
+        memory_(static_cast<reusable_op_memory&&>(other.memory_))
     {
     }
 
@@ -906,12 +935,22 @@ namespace detail
           }
         }
 
+        memory_.reset();
         static_cast<ReadHandler&&>(handler_)(
             static_cast<const asio::error_code&>(ec),
             static_cast<const std::size_t&>(total_transferred_));
       }
     }
 
+    typedef reusable_op_allocator<void,
+        associated_allocator_t<ReadHandler>> allocator_type;
+
+    allocator_type get_allocator() const noexcept
+    {
+      return allocator_type(memory_,
+          (get_associated_allocator)(handler_));
+    }
+
   //private:
     AsyncReadStream& stream_;
     DynamicBuffer_v2 buffers_;
@@ -919,6 +958,7 @@ namespace detail
     std::size_t total_transferred_;
     std::size_t bytes_available_;
     ReadHandler handler_;
+    reusable_op_memory memory_;
   };
 
   template <typename AsyncReadStream, typename DynamicBuffer_v2,
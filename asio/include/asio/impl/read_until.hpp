@@ -24,52 +24,19 @@
 #include "asio/buffers_iterator.hpp"
 #include "asio/detail/base_from_cancellation_state.hpp"
 #include "asio/detail/bind_handler.hpp"
+#include "asio/detail/delimiter_search.hpp"
 #include "asio/detail/handler_cont_helpers.hpp"
 #include "asio/detail/handler_tracking.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/limits.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/reusable_op_memory.hpp"
 #include "asio/detail/throw_error.hpp"
 
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
 
-namespace detail
-{
-  // Algorithm that finds a subsequence of equal values in a sequence. Returns
-  // (iterator,true) if a full match was found, in which case the iterator
-  // points to the beginning of the match. Returns (iterator,false) if a
-  // partial match was found at the end of the first sequence, in which case
-  // the iterator points to the beginning of the partial match. Returns
-  // (last1,false) if no full or partial match was found.
-  template <typename Iterator1, typename Iterator2>
-  std::pair<Iterator1, bool> partial_search(
-      Iterator1 first1, Iterator1 last1, Iterator2 first2, Iterator2 last2)
-  {
-    for (Iterator1 iter1 = first1; iter1 != last1; ++iter1)
-    {
-      Iterator1 test_iter1 = iter1;
-      Iterator2 test_iter2 = first2;
-      for (;; ++test_iter1, ++test_iter2)
-      {
-        if (test_iter2 == last2)
-          return std::make_pair(iter1, true);
-        if (test_iter1 == last1)
-        {
-          if (test_iter2 != first2)
-            return std::make_pair(iter1, false);
-          else
-            break;
-        }
-        if (*test_iter1 != *test_iter2)
-          break;
-      }
-    }
-    return std::make_pair(last1, false);
-  }
-} // namespace detail
-
 #if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
 
 template <typename SyncReadStream, typename DynamicBuffer_v1>
@@ -108,24 +75,22 @@ std::size_t read_until(SyncReadStream& s,
   {
     // Determine the range of the data to be searched.
     typedef typename DynamicBuffer_v1::const_buffers_type buffers_type;
-    typedef buffers_iterator<buffers_type> iterator;
     buffers_type data_buffers = b.data();
-    iterator begin = iterator::begin(data_buffers);
-    iterator start_pos = begin + search_position;
-    iterator end = iterator::end(data_buffers);
 
     // Look for a match.
-    iterator iter = std::find(start_pos, end, delim);
-    if (iter != end)
+    std::pair<std::size_t, bool> result =
+      detail::delimiter_search::search(data_buffers,
+          search_position, &delim, 1);
+    if (result.second)
     {
       // Found a match. We're done.
       ec = asio::error_code();
-      return iter - begin + 1;
+      return result.first + 1;
     }
     else
     {
       // No match. Next search can start with the new data.
-      search_position = end - begin;
+      search_position = result.first;
     }
 
     // Check if buffer is full.
@@ -182,33 +147,30 @@ std::size_t read_until(SyncReadStream& s,
   {
     // Determine the range of the data to be searched.
     typedef typename DynamicBuffer_v1::const_buffers_type buffers_type;
-    typedef buffers_iterator<buffers_type> iterator;
     buffers_type data_buffers = b.data();
-    iterator begin = iterator::begin(data_buffers);
-    iterator start_pos = begin + search_position;
-    iterator end = iterator::end(data_buffers);
 
     // Look for a match.
-    std::pair<iterator, bool> result = detail::partial_search(
-        start_pos, end, delim.begin(), delim.end());
-    if (result.first != end)
+    std::pair<std::size_t, bool> result =
+      detail::delimiter_search::search(data_buffers,
+          search_position, delim.data(), delim.length());
+    if (result.first != b.size())
     {
       if (result.second)
       {
         // Full match. We're done.
         ec = asio::error_code();
-        return result.first - begin + delim.length();
+        return result.first + delim.length();
       }
       else
       {
         // Partial match. Next search needs to start from beginning of match.
-        search_position = result.first - begin;
+        search_position = result.first;
       }
     }
     else
     {
       // No match. Next search can start with the new data.
-      search_position = end - begin;
+      search_position = result.first;
     }
 
     // Check if buffer is full.
@@ -520,25 +482,23 @@ std::size_t read_until(SyncReadStream& s, DynamicBuffer_v2 buffers,
   {
     // Determine the range of the data to be searched.
     typedef typename DynamicBuffer_v2::const_buffers_type buffers_type;
-    typedef buffers_iterator<buffers_type> iterator;
     buffers_type data_buffers =
       const_cast<const DynamicBuffer_v2&>(b).data(0, b.size());
-    iterator begin = iterator::begin(data_buffers);
-    iterator start_pos = begin + search_position;
-    iterator end = iterator::end(data_buffers);
 
     // Look for a match.
-    iterator iter = std::find(start_pos, end, delim);
-    if (iter != end)
+    std::pair<std::size_t, bool> result =
+      detail::delimiter_search::search(data_buffers,
+          search_position, &delim, 1);
+    if (result.second)
     {
       // Found a match. We're done.
       ec = asio::error_code();
-      return iter - begin + 1;
+      return result.first + 1;
     }
     else
     {
       // No match. Next search can start with the new data.
-      search_position = end - begin;
+      search_position = result.first;
     }
 
     // Check if buffer is full.
@@ -589,34 +549,31 @@ std::size_t read_until(SyncReadStream& s, DynamicBuffer_v2 buffers,
   {
     // Determine the range of the data to be searched.
     typedef typename DynamicBuffer_v2::const_buffers_type buffers_type;
-    typedef buffers_iterator<buffers_type> iterator;
     buffers_type data_buffers =
       const_cast<const DynamicBuffer_v2&>(b).data(0, b.size());
-    iterator begin = iterator::begin(data_buffers);
-    iterator start_pos = begin + search_position;
-    iterator end = iterator::end(data_buffers);
 
     // Look for a match.
-    std::pair<iterator, bool> result = detail::partial_search(
-        start_pos, end, delim.begin(), delim.end());
-    if (result.first != end)
+    std::pair<std::size_t, bool> result =
+      detail::delimiter_search::search(data_buffers,
+          search_position, delim.data(), delim.length());
+    if (result.first != b.size())
     {
       if (result.second)
       {
         // Full match. We're done.
         ec = asio::error_code();
-        return result.first - begin + delim.length();
+        return result.first + delim.length();
       }
       else
       {
         // Partial match. Next search needs to start from beginning of match.
-        search_position = result.first - begin;
+        search_position = result.first;
       }
     }
     else
     {
       // No match. Next search can start with the new data.
-      search_position = end - begin;
+      search_position = result.first;
     }
 
     // Check if buffer is full.
@@ -830,7 +787,8 @@ namespace detail
         delim_(delim),
         start_(0),
         search_position_(0),
-        handler_(static_cast<ReadHandler&&>(handler))
+        handler_(static_cast<ReadHandler&&>(handler)),
+        memory_((get_associated_allocator)(handler_), sizeof(*this))
     {
     }
 
@@ -853,7 +811,8 @@ namespace detail
         delim_(other.delim_),
         start_(other.start_),
         search_position_(other.search_position_),
-        handler_(static_cast<ReadHandler&&>(other.handler_))
+        handler_(static_cast<ReadHandler&&>(other.handler_)),
+        memory_(static_cast<reusable_op_memory&&>(other.memory_))
     {
     }
 
@@ -871,18 +830,16 @@ namespace detail
             // Determine the range of the data to be searched.
             typedef typename DynamicBuffer_v1::const_buffers_type
               buffers_type;
-            typedef buffers_iterator<buffers_type> iterator;
             buffers_type data_buffers = buffers_.data();
-            iterator begin = iterator::begin(data_buffers);
-            iterator start_pos = begin + search_position_;
-            iterator end = iterator::end(data_buffers);
 
             // Look for a match.
-            iterator iter = std::find(start_pos, end, delim_);
-            if (iter != end)
+            std::pair<std::size_t, bool> result =
+              detail::delimiter_search::search(data_buffers,
+                  search_position_, &delim_, 1);
+            if (result.second)
             {
               // Found a match. We're done.
-              search_position_ = iter - begin + 1;
+              search_position_ = result.first + 1;
               bytes_to_read = 0;
             }
 
@@ -897,7 +854,7 @@ namespace detail
             else
             {
               // Next search can start with the new data.
-              search_position_ = end - begin;
+              search_position_ = result.first;
               bytes_to_read = std::min<std::size_t>(
                     std::max<std::size_t>(512,
                       buffers_.capacity() - buffers_.size()),
@@ -936,10 +893,20 @@ namespace detail
           (ec || search_position_ == not_found)
           ? 0 : search_position_;
 
+        memory_.reset();
         static_cast<ReadHandler&&>(handler_)(result_ec, result_n);
       }
     }
 
+    typedef reusable_op_allocator<void,
+        associated_allocator_t<ReadHandler>> allocator_type;
+
+    allocator_type get_allocator() const noexcept
+    {
+      return allocator_type(memory_,
+          (get_associated_allocator)(handler_));
+    }
+
   //private:
     AsyncReadStream& stream_;
     DynamicBuffer_v1 buffers_;
@@ -947,6 +914,7 @@ namespace detail
     int start_;
     std::size_t search_position_;
     ReadHandler handler_;
+    reusable_op_memory memory_;
   };
 
   template <typename AsyncReadStream,
@@ -1070,7 +1038,8 @@ namespace detail
         delim_(delim),
         start_(0),
         search_position_(0),
-        handler_(static_cast<ReadHandler&&>(handler))
+        handler_(static_cast<ReadHandler&&>(handler)),
+        memory_((get_associated_allocator)(handler_), sizeof(*this))
     {
     }
 
@@ -1093,7 +1062,8 @@ namespace detail
         delim_(static_cast<std::string&&>(other.delim_)),
         start_(other.start_),
         search_position_(other.search_position_),
-        handler_(static_cast<ReadHandler&&>(other.handler_))
+        handler_(static_cast<ReadHandler&&>(other.handler_)),
+        memory_(static_cast<reusable_op_memory&&>(other.memory_))
     {
     }
 
@@ -1111,19 +1081,16 @@ namespace detail
             // Determine the range of the data to be searched.
             typedef typename DynamicBuffer_v1::const_buffers_type
               buffers_type;
-            typedef buffers_iterator<buffers_type> iterator;
             buffers_type data_buffers = buffers_.data();
-            iterator begin = iterator::begin(data_buffers);
-            iterator start_pos = begin + search_position_;
-            iterator end = iterator::end(data_buffers);
 
             // Look for a match.
-            std::pair<iterator, bool> result = detail::partial_search(
-                start_pos, end, delim_.begin(), delim_.end());
-            if (result.first != end && result.second)
+            std::pair<std::size_t, bool> result =
+              detail::delimiter_search::search(data_buffers,
+                  search_position_, delim_.data(), delim_.length());
+            if (result.second)
             {
               // Full match. We're done.
-              search_position_ = result.first - begin + delim_.length();
+              search_position_ = result.first + delim_.length();
               bytes_to_read = 0;
             }
 
@@ -1137,16 +1104,16 @@ namespace detail
             // Need to read some more data.
             else
             {
-              if (result.first != end)
+              if (result.first != buffers_.size())
               {
                 // Partial match. Next search needs to start from beginning of
                 // match.
-                search_position_ = result.first - begin;
+                search_position_ = result.first;
               }
               else
               {
                 // Next search can start with the new data.
-                search_position_ = end - begin;
+                search_position_ = result.first;
               }
 
               bytes_to_read = std::min<std::size_t>(
@@ -1187,10 +1154,20 @@ namespace detail
           (ec || search_position_ == not_found)
           ? 0 : search_position_;
 
+        memory_.reset();
         static_cast<ReadHandler&&>(handler_)(result_ec, result_n);
       }
     }
 
+    typedef reusable_op_allocator<void,
+        associated_allocator_t<ReadHandler>> allocator_type;
+
+    allocator_type get_allocator() const noexcept
+    {
+      return allocator_type(memory_,
+          (get_associated_allocator)(handler_));
+    }
+
   //private:
     AsyncReadStream& stream_;
     DynamicBuffer_v1 buffers_;
@@ -1198,6 +1175,7 @@ namespace detail
     int start_;
     std::size_t search_position_;
     ReadHandler handler_;
+    reusable_op_memory memory_;
   };
 
   template <typename AsyncReadStream,
@@ -1326,7 +1304,8 @@ namespace detail
         expr_(expr),
         start_(0),
         search_position_(0),
-        handler_(static_cast<ReadHandler&&>(handler))
+        handler_(static_cast<ReadHandler&&>(handler)),
+        memory_((get_associated_allocator)(handler_), sizeof(*this))
     {
     }
 
@@ -1349,7 +1328,8 @@ namespace detail
         expr_(other.expr_),
         start_(other.start_),
         search_position_(other.search_position_),
-        handler_(static_cast<ReadHandler&&>(other.handler_))
+        handler_(static_cast<ReadHandler&&>(other.handler_)),
+        memory_(static_cast<reusable_op_memory&&>(other.memory_))
     {
     }
 
@@ -1446,10 +1426,20 @@ namespace detail
           (ec || search_position_ == not_found)
           ? 0 : search_position_;
 
+        memory_.reset();
         static_cast<ReadHandler&&>(handler_)(result_ec, result_n);
       }
     }
 
+    typedef reusable_op_allocator<void,
+        associated_allocator_t<ReadHandler>> allocator_type;
+
+    allocator_type get_allocator() const noexcept
+    {
+      return allocator_type(memory_,
+          (get_associated_allocator)(handler_));
+    }
+
   //private:
     AsyncReadStream& stream_;
     DynamicBuffer_v1 buffers_;
@@ -1457,6 +1447,7 @@ namespace detail
     int start_;
     std::size_t search_position_;
     ReadHandler handler_;
+    reusable_op_memory memory_;
   };
 
   template <typename AsyncReadStream, typename DynamicBuffer_v1,
@@ -1581,7 +1572,8 @@ namespace detail
         match_condition_(match_condition),
         start_(0),
         search_position_(0),
-        handler_(static_cast<ReadHandler&&>(handler))
+        handler_(static_cast<ReadHandler&&>(handler)),
+        memory_((get_associated_allocator)(handler_), sizeof(*this))
     {
     }
 
@@ -1604,7 +1596,8 @@ namespace detail
         match_condition_(other.match_condition_),
         start_(other.start_),
         search_position_(other.search_position_),
-        handler_(static_cast<ReadHandler&&>(other.handler_))
+        handler_(static_cast<ReadHandler&&>(other.handler_)),
+        memory_(static_cast<reusable_op_memory&&>(other.memory_))
     {
     }
 
@@ -1697,10 +1690,20 @@ namespace detail
           (ec || search_position_ == not_found)
           ? 0 : search_position_;
 
+        memory_.reset();
         static_cast<ReadHandler&&>(handler_)(result_ec, result_n);
       }
     }
 
+    typedef reusable_op_allocator<void,
+        associated_allocator_t<ReadHandler>> allocator_type;
+
+    allocator_type get_allocator() const noexcept
+    {
+      return allocator_type(memory_,
+          (get_associated_allocator)(handler_));
+    }
+
   //private:
     AsyncReadStream& stream_;
     DynamicBuffer_v1 buffers_;
@@ -1708,6 +1711,7 @@ namespace detail
     int start_;
     std::size_t search_position_;
     ReadHandler handler_;
+    reusable_op_memory memory_;
   };
 
   template <typename AsyncReadStream, typename DynamicBuffer_v1,
@@ -1924,7 +1928,8 @@ namespace detail
         start_(0),
         search_position_(0),
         bytes_to_read_(0),
-        handler_(static_cast<ReadHandler&&>(handler))
+        handler_(static_cast<ReadHandler&&>(handler)),
+        memory_((get_associated_allocator)(handler_), sizeof(*this))
     {
     }
 
@@ -1949,7 +1954,8 @@ namespace detail
         start_(other.start_),
         search_position_(other.search_position_),
         bytes_to_read_(other.bytes_to_read_),
-        handler_(static_cast<ReadHandler&&>(other.handler_))
+        handler_(static_cast<ReadHandler&&>(other.handler_)),
+        memory_(static_cast<reusable_op_memory&&>(other.memory_))
     {
     }
 
@@ -1967,20 +1973,18 @@ namespace detail
             // Determine the range of the data to be searched.
             typedef typename DynamicBuffer_v2::const_buffers_type
               buffers_type;
-            typedef buffers_iterator<buffers_type> iterator;
             buffers_type data_buffers =
               const_cast<const DynamicBuffer_v2&>(buffers_).data(
                   0, buffers_.size());
-            iterator begin = iterator::begin(data_buffers);
-            iterator start_pos = begin + search_position_;
-            iterator end = iterator::end(data_buffers);
 
             // Look for a match.
-            iterator iter = std::find(start_pos, end, delim_);
-            if (iter != end)
+            std::pair<std::size_t, bool> result =
+              detail::delimiter_search::search(data_buffers,
+                  search_position_, &delim_, 1);
+            if (result.second)
             {
               // Found a match. We're done.
-              search_position_ = iter - begin + 1;
+              search_position_ = result.first + 1;
               bytes_to_read_ = 0;
             }
 
@@ -1995,7 +1999,7 @@ namespace detail
             else
             {
               // Next search can start with the new data.
-              search_position_ = end - begin;
+              search_position_ = result.first;
               bytes_to_read_ = std::min<std::size_t>(
                     std::max<std::size_t>(512,
                       buffers_.capacity() - buffers_.size()),
@@ -2036,10 +2040,20 @@ namespace detail
           (ec || search_position_ == not_found)
           ? 0 : search_position_;
 
+        memory_.reset();
         static_cast<ReadHandler&&>(handler_)(result_ec, result_n);
       }
     }
 
+    typedef reusable_op_allocator<void,
+        associated_allocator_t<ReadHandler>> allocator_type;
+
+    allocator_type get_allocator() const noexcept
+    {
+      return allocator_type(memory_,
+          (get_associated_allocator)(handler_));
+    }
+
   //private:
     AsyncReadStream& stream_;
     DynamicBuffer_v2 buffers_;
@@ -2048,6 +2062,7 @@ namespace detail
     std::size_t search_position_;
     std::size_t bytes_to_read_;
     ReadHandler handler_;
+    reusable_op_memory memory_;
   };
 
   template <typename AsyncReadStream,
@@ -2168,7 +2183,8 @@ namespace detail
         start_(0),
         search_position_(0),
         bytes_to_read_(0),
-        handler_(static_cast<ReadHandler&&>(handler))
+        handler_(static_cast<ReadHandler&&>(handler)),
+        memory_((get_associated_allocator)(handler_), sizeof(*this))
     {
     }
 
@@ -2193,7 +2209,8 @@ namespace detail
         start_(other.start_),
         search_position_(other.search_position_),
         bytes_to_read_(other.bytes_to_read_),
-        handler_(static_cast<ReadHandler&&>(other.handler_))
+        handler_(static_cast<ReadHandler&&>(other.handler_)),
+        memory_(static_cast<reusable_op_memory&&>(other.memory_))
     {
     }
 
@@ -2211,21 +2228,18 @@ namespace detail
             // Determine the range of the data to be searched.
             typedef typename DynamicBuffer_v2::const_buffers_type
               buffers_type;
-            typedef buffers_iterator<buffers_type> iterator;
             buffers_type data_buffers =
               const_cast<const DynamicBuffer_v2&>(buffers_).data(
                   0, buffers_.size());
-            iterator begin = iterator::begin(data_buffers);
-            iterator start_pos = begin + search_position_;
-            iterator end = iterator::end(data_buffers);
 
             // Look for a match.
-            std::pair<iterator, bool> result = detail::partial_search(
-                start_pos, end, delim_.begin(), delim_.end());
-            if (result.first != end && result.second)
+            std::pair<std::size_t, bool> result =
+              detail::delimiter_search::search(data_buffers,
+                  search_position_, delim_.data(), delim_.length());
+            if (result.second)
             {
               // Full match. We're done.
-              search_position_ = result.first - begin + delim_.length();
+              search_position_ = result.first + delim_.length();
               bytes_to_read_ = 0;
             }
 
@@ -2239,16 +2253,16 @@ namespace detail
             // Need to read some more data.
             else
             {
-              if (result.first != end)
+              if (result.first != buffers_.size())
               {
                 // Partial match. Next search needs to start from beginning of
                 // match.
-                search_position_ = result.first - begin;
+                search_position_ = result.first;
               }
               else
               {
                 // Next search can start with the new data.
-                search_position_ = end - begin;
+                search_position_ = result.first;
               }
 
               bytes_to_read_ = std::min<std::size_t>(
@@ -2291,10 +2305,20 @@ namespace detail
           (ec || search_position_ == not_found)
           ? 0 : search_position_;
 
+        memory_.reset();
         static_cast<ReadHandler&&>(handler_)(result_ec, result_n);
       }
     }
 
+    typedef reusable_op_allocator<void,
+        associated_allocator_t<ReadHandler>> allocator_type;
+
+    allocator_type get_allocator() const noexcept
+    {
+      return allocator_type(memory_,
+          (get_associated_allocator)(handler_));
+    }
+
   //private:
     AsyncReadStream& stream_;
     DynamicBuffer_v2 buffers_;
@@ -2303,6 +2327,7 @@ namespace detail
     std::size_t search_position_;
     std::size_t bytes_to_read_;
     ReadHandler handler_;
+    reusable_op_memory memory_;
   };
 
   template <typename AsyncReadStream,
@@ -2430,7 +2455,8 @@ namespace detail
         start_(0),
         search_position_(0),
         bytes_to_read_(0),
-        handler_(static_cast<ReadHandler&&>(handler))
+        handler_(static_cast<ReadHandler&&>(handler)),
+        memory_((get_associated_allocator)(handler_), sizeof(*this))
     {
     }
 
@@ -2455,7 +2481,8 @@ namespace detail
         start_(other.start_),
         search_position_(other.search_position_),
         bytes_to_read_(other.bytes_to_read_),
-        handler_(static_cast<ReadHandler&&>(other.handler_))
+        handler_(static_cast<ReadHandler&&>(other.handler_)),
+        memory_(static_cast<reusable_op_memory&&>(other.memory_))
     {
     }
 
@@ -2556,10 +2583,20 @@ namespace detail
           (ec || search_position_ == not_found)
           ? 0 : search_position_;
 
+        memory_.reset();
         static_cast<ReadHandler&&>(handler_)(result_ec, result_n);
       }
     }
 
+    typedef reusable_op_allocator<void,
+        associated_allocator_t<ReadHandler>> allocator_type;
+
+    allocator_type get_allocator() const noexcept
+    {
+      return allocator_type(memory_,
+          (get_associated_allocator)(handler_));
+    }
+
   //private:
     AsyncReadStream& stream_;
     DynamicBuffer_v2 buffers_;
@@ -2568,6 +2605,7 @@ namespace detail
     std::size_t search_position_;
     std::size_t bytes_to_read_;
     ReadHandler handler_;
+    reusable_op_memory memory_;
   };
 
   template <typename AsyncReadStream, typename DynamicBuffer_v2,
@@ -2691,7 +2729,8 @@ namespace detail
         start_(0),
         search_position_(0),
         bytes_to_read_(0),
-        handler_(static_cast<ReadHandler&&>(handler))
+        handler_(static_cast<ReadHandler&&>(handler)),
+        memory_((get_associated_allocator)(handler_), sizeof(*this))
     {
     }
 
@@ -2716,7 +2755,8 @@ namespace detail
         start_(other.start_),
         search_position_(other.search_position_),
         bytes_to_read_(other.bytes_to_read_),
-        handler_(static_cast<ReadHandler&&>(other.handler_))
+        handler_(static_cast<ReadHandler&&>(other.handler_)),
+        memory_(static_cast<reusable_op_memory&&>(other.memory_))
     {
     }
 
@@ -2813,10 +2853,20 @@ namespace detail
           (ec || search_position_ == not_found)
           ? 0 : search_position_;
 
+        memory_.reset();
         static_cast<ReadHandler&&>(handler_)(result_ec, result_n);
       }
     }
 
+    typedef reusable_op_allocator<void,
+        associated_allocator_t<ReadHandler>> allocator_type;
+
+    allocator_type get_allocator() const noexcept
+    {
+      return allocator_type(memory_,
+          (get_associated_allocator)(handler_));
+    }
+
   //private:
     AsyncReadStream& stream_;
     DynamicBuffer_v2 buffers_;
@@ -2825,6 +2875,7 @@ namespace detail
     std::size_t search_position_;
     std::size_t bytes_to_read_;
     ReadHandler handler_;
+    reusable_op_memory memory_;
   };
 
   template <typename AsyncReadStream, typename DynamicBuffer_v2,
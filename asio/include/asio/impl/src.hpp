@@ -31,7 +31,9 @@
 #include "asio/impl/multiple_exceptions.ipp"
 #include "asio/impl/serial_port_base.ipp"
 #include "asio/impl/system_context.ipp"
+#include "asio/impl/thread_policy.ipp"
 #include "asio/impl/thread_pool.ipp"
+#include "asio/impl/work_stealing_pool.ipp"
 #include "asio/detail/impl/buffer_sequence_adapter.ipp"
 #include "asio/detail/impl/descriptor_ops.ipp"
 #include "asio/detail/impl/dev_poll_reactor.ipp"
@@ -43,6 +45,7 @@
 #include "asio/detail/impl/io_uring_socket_service_base.ipp"
 #include "asio/detail/impl/io_uring_service.ipp"
 #include "asio/detail/impl/kqueue_reactor.ipp"
+#include "asio/detail/impl/mirrored_memory.ipp"
 #include "asio/detail/impl/null_event.ipp"
 #include "asio/detail/impl/pipe_select_interrupter.ipp"
 #include "asio/detail/impl/posix_event.ipp"
@@ -79,6 +82,7 @@
 #include "asio/detail/impl/winrt_ssocket_service_base.ipp"
 #include "asio/detail/impl/winrt_timer_scheduler.ipp"
 #include "asio/detail/impl/winsock_init.ipp"
+#include "asio/detail/impl/work_stealing_scheduler.ipp"
 #include "asio/execution/impl/bad_executor.ipp"
 #include "asio/experimental/impl/channel_error.ipp"
 #include "asio/generic/detail/impl/endpoint.ipp"
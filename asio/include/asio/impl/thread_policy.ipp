@@ -0,0 +1,233 @@
+//
+// impl/thread_policy.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_THREAD_POLICY_IPP
+#define ASIO_IMPL_THREAD_POLICY_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "asio/thread_policy.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/error.hpp"
+
+#if defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+# include "asio/detail/socket_types.hpp"
+#elif defined(__linux__)
+# include <cerrno>
+# include <pthread.h>
+# include <sched.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#elif defined(__APPLE__)
+# include <pthread.h>
+#endif // defined(__APPLE__)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Record the first error that occurs while applying a policy.
+inline void thread_policy_error(asio::error_code& ec,
+    const asio::error_code& e)
+{
+  if (!ec)
+    ec = e;
+}
+
+inline asio::error_code thread_policy_system_error(int value)
+{
+  return asio::error_code(value, asio::error::get_system_category());
+}
+
+// Get the CPUs that belong to a NUMA node.
+inline void get_numa_node_cpus(int node,
+    std::vector<int>& cpus, asio::error_code& ec)
+{
+#if defined(__linux__)
+  char path[64];
+  std::snprintf(path, sizeof(path),
+      "/sys/devices/system/node/node%d/cpulist", node);
+  std::FILE* f = std::fopen(path, "r");
+  if (!f)
+  {
+    thread_policy_error(ec, asio::error::invalid_argument);
+    return;
+  }
+
+  // The list is a comma separated sequence of CPUs and ranges, e.g. "0-3,8".
+  char buf[4096];
+  if (std::fgets(buf, sizeof(buf), f))
+  {
+    char* p = buf;
+    while (*p >= '0' && *p <= '9')
+    {
+      long first = std::strtol(p, &p, 10);
+      long last = first;
+      if (*p == '-')
+        last = std::strtol(p + 1, &p, 10);
+      for (long cpu = first; cpu <= last; ++cpu)
+        cpus.push_back(static_cast<int>(cpu));
+      if (*p == ',')
+        ++p;
+    }
+  }
+  std::fclose(f);
+#else // defined(__linux__)
+  (void)node;
+  (void)cpus;
+  thread_policy_error(ec, asio::error::operation_not_supported);
+#endif // defined(__linux__)
+}
+
+// Restrict the calling thread to a set of CPUs.
+inline void set_thread_cpus(const std::vector<int>& cpus,
+    asio::error_code& ec)
+{
+#if defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+  DWORD_PTR mask = 0;
+  for (std::size_t i = 0; i < cpus.size(); ++i)
+  {
+    if (cpus[i] < 0 || cpus[i] >= static_cast<int>(sizeof(mask) * 8))
+    {
+      thread_policy_error(ec, asio::error::invalid_argument);
+      return;
+    }
+    mask |= static_cast<DWORD_PTR>(1) << cpus[i];
+  }
+  if (!::SetThreadAffinityMask(::GetCurrentThread(), mask))
+  {
+    thread_policy_error(ec, thread_policy_system_error(
+          static_cast<int>(::GetLastError())));
+  }
+#elif defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (std::size_t i = 0; i < cpus.size(); ++i)
+  {
+    if (cpus[i] < 0 || cpus[i] >= CPU_SETSIZE)
+    {
+      thread_policy_error(ec, asio::error::invalid_argument);
+      return;
+    }
+    CPU_SET(cpus[i], &set);
+  }
+  int result = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+  if (result != 0)
+    thread_policy_error(ec, thread_policy_system_error(result));
+#else
+  (void)cpus;
+  thread_policy_error(ec, asio::error::operation_not_supported);
+#endif
+}
+
+// Prefer memory from a NUMA node for the calling thread's allocations.
+inline void set_thread_numa_node(int node, asio::error_code& ec)
+{
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+  const int bits_per_word = static_cast<int>(sizeof(unsigned long) * 8);
+  const int max_nodes = 1024;
+  if (node < 0 || node >= max_nodes)
+  {
+    thread_policy_error(ec, asio::error::invalid_argument);
+    return;
+  }
+
+  unsigned long mask[max_nodes / bits_per_word] = {};
+  mask[node / bits_per_word] |= 1UL << (node % bits_per_word);
+  const int mpol_preferred = 1; // From <linux/mempolicy.h>.
+  if (::syscall(SYS_set_mempolicy, mpol_preferred, mask, max_nodes + 1) != 0)
+    thread_policy_error(ec, thread_policy_system_error(errno));
+#else // defined(__linux__) && defined(SYS_set_mempolicy)
+  (void)node;
+  thread_policy_error(ec, asio::error::operation_not_supported);
+#endif // defined(__linux__) && defined(SYS_set_mempolicy)
+}
+
+// Build a thread name from a prefix and a number, truncating the prefix so
+// that the number is kept when the name exceeds the given limit.
+inline std::string make_thread_name(const std::string& prefix,
+    const char* number, std::size_t max_length)
+{
+  std::size_t number_length = std::strlen(number);
+  std::size_t prefix_length = max_length > number_length
+    ? max_length - number_length : 0;
+  return prefix.substr(0, prefix_length) + number;
+}
+
+// Set the name of the calling thread to a prefix followed by a number.
+inline void set_thread_name(const std::string& prefix,
+    const char* number, asio::error_code& ec)
+{
+#if defined(__linux__)
+  // Names are limited to 16 bytes, including the terminating null.
+  int result = ::pthread_setname_np(::pthread_self(),
+      make_thread_name(prefix, number, 15).c_str());
+  if (result != 0)
+    thread_policy_error(ec, thread_policy_system_error(result));
+#elif defined(__APPLE__)
+  int result = ::pthread_setname_np(
+      make_thread_name(prefix, number, 63).c_str());
+  if (result != 0)
+    thread_policy_error(ec, thread_policy_system_error(result));
+#else
+  (void)prefix;
+  (void)number;
+  thread_policy_error(ec, asio::error::operation_not_supported);
+#endif
+}
+
+} // namespace detail
+
+void thread_policy::apply(std::size_t index) const
+{
+  asio::error_code ec;
+  apply(index, ec);
+  asio::detail::throw_error(ec, "apply");
+}
+
+ASIO_SYNC_OP_VOID thread_policy::apply(std::size_t index,
+    asio::error_code& ec) const
+{
+  ec = asio::error_code();
+
+  std::vector<int> cpus = cpus_;
+  if (cpus.empty() && numa_node_ >= 0)
+    detail::get_numa_node_cpus(numa_node_, cpus, ec);
+  if (!cpus.empty() && assignment_ == one_per_thread)
+    cpus.assign(1, cpus[index % cpus.size()]);
+  if (!cpus.empty())
+    detail::set_thread_cpus(cpus, ec);
+
+  if (numa_node_ >= 0)
+    detail::set_thread_numa_node(numa_node_, ec);
+
+  if (!name_prefix_.empty())
+  {
+    char number[32];
+    std::snprintf(number, sizeof(number), "%lu",
+        static_cast<unsigned long>(index));
+    detail::set_thread_name(name_prefix_, number, ec);
+  }
+
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_THREAD_POLICY_IPP
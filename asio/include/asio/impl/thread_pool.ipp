@@ -27,6 +27,8 @@ namespace asio {
 struct thread_pool::thread_function
 {
   detail::scheduler* scheduler_;
+  const thread_policy* policy_;
+  std::size_t index_;
 
   void operator()()
   {
@@ -35,6 +37,8 @@ struct thread_pool::thread_function
     {
 #endif// !defined(ASIO_NO_EXCEPTIONS)
       asio::error_code ec;
+      if (policy_)
+        policy_->apply(index_, ec);
       scheduler_->run(ec);
 #if !defined(ASIO_NO_EXCEPTIONS)
     }
@@ -64,7 +68,7 @@ thread_pool::thread_pool()
 {
   scheduler_.work_started();
 
-  thread_function f = { &scheduler_ };
+  thread_function f = { &scheduler_, 0, 0 };
   threads_.create_threads(f, static_cast<std::size_t>(num_threads_));
 }
 #endif // !defined(ASIO_NO_TS_EXECUTORS)
@@ -90,10 +94,25 @@ thread_pool::thread_pool(std::size_t num_threads)
 {
   scheduler_.work_started();
 
-  thread_function f = { &scheduler_ };
+  thread_function f = { &scheduler_, 0, 0 };
   threads_.create_threads(f, static_cast<std::size_t>(num_threads_));
 }
 
+thread_pool::thread_pool(std::size_t num_threads, const thread_policy& policy)
+  : scheduler_(add_scheduler(new detail::scheduler(
+          *this, num_threads == 1 ? 1 : 0, false))),
+    num_threads_(detail::clamp_thread_pool_size(num_threads)),
+    policy_(policy)
+{
+  scheduler_.work_started();
+
+  for (std::size_t i = 0; i < num_threads; ++i)
+  {
+    thread_function f = { &scheduler_, &policy_, i };
+    threads_.create_thread(f);
+  }
+}
+
 thread_pool::~thread_pool()
 {
   stop();
@@ -109,7 +128,7 @@ void thread_pool::stop()
 void thread_pool::attach()
 {
   ++num_threads_;
-  thread_function f = { &scheduler_ };
+  thread_function f = { &scheduler_, 0, 0 };
   f();
 }
 
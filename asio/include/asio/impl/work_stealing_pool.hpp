@@ -0,0 +1,40 @@
+//
+// impl/work_stealing_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_WORK_STEALING_POOL_HPP
+#define ASIO_IMPL_WORK_STEALING_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/execution_context.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+inline work_stealing_pool::executor_type
+work_stealing_pool::get_executor() noexcept
+{
+  return executor_type(*this);
+}
+
+inline work_stealing_pool::executor_type
+work_stealing_pool::executor() noexcept
+{
+  return executor_type(*this);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_WORK_STEALING_POOL_HPP
@@ -0,0 +1,138 @@
+//
+// impl/work_stealing_pool.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_WORK_STEALING_POOL_IPP
+#define ASIO_IMPL_WORK_STEALING_POOL_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/work_stealing_pool.hpp"
+#include "asio/detail/scoped_ptr.hpp"
+#include "asio/detail/thread.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+struct work_stealing_pool::thread_function
+{
+  detail::work_stealing_scheduler* scheduler_;
+  const thread_policy* policy_;
+  std::size_t index_;
+
+  void operator()()
+  {
+#if !defined(ASIO_NO_EXCEPTIONS)
+    try
+    {
+#endif// !defined(ASIO_NO_EXCEPTIONS)
+      if (policy_)
+      {
+        asio::error_code ec;
+        policy_->apply(index_, ec);
+      }
+      scheduler_->run(index_);
+#if !defined(ASIO_NO_EXCEPTIONS)
+    }
+    catch (...)
+    {
+      std::terminate();
+    }
+#endif// !defined(ASIO_NO_EXCEPTIONS)
+  }
+};
+
+namespace detail {
+
+inline std::size_t default_work_stealing_pool_size()
+{
+  std::size_t num_threads = thread::hardware_concurrency();
+  return num_threads == 0 ? 1 : num_threads;
+}
+
+} // namespace detail
+
+work_stealing_pool::work_stealing_pool()
+  : scheduler_(add_scheduler(new detail::work_stealing_scheduler(
+          *this, detail::default_work_stealing_pool_size())))
+{
+  create_threads();
+}
+
+work_stealing_pool::work_stealing_pool(std::size_t num_threads)
+  : scheduler_(add_scheduler(
+        new detail::work_stealing_scheduler(*this, num_threads)))
+{
+  create_threads();
+}
+
+work_stealing_pool::work_stealing_pool(std::size_t num_threads,
+    const thread_policy& policy)
+  : scheduler_(add_scheduler(
+        new detail::work_stealing_scheduler(*this, num_threads))),
+    policy_(policy)
+{
+  create_threads();
+}
+
+work_stealing_pool::~work_stealing_pool()
+{
+  stop();
+  join();
+  shutdown();
+}
+
+void work_stealing_pool::stop()
+{
+  scheduler_.stop();
+}
+
+void work_stealing_pool::join()
+{
+  if (!threads_.empty())
+  {
+    scheduler_.work_finished();
+    threads_.join();
+  }
+}
+
+void work_stealing_pool::wait()
+{
+  join();
+}
+
+detail::work_stealing_scheduler& work_stealing_pool::add_scheduler(
+    detail::work_stealing_scheduler* s)
+{
+  detail::scoped_ptr<detail::work_stealing_scheduler> scoped_impl(s);
+  asio::add_service<detail::work_stealing_scheduler>(*this, scoped_impl.get());
+  return *scoped_impl.release();
+}
+
+void work_stealing_pool::create_threads()
+{
+  // The pool has outstanding work until join() is called.
+  scheduler_.work_started();
+
+  for (std::size_t i = 0; i < scheduler_.concurrency_hint(); ++i)
+  {
+    thread_function f = { &scheduler_, &policy_, i };
+    threads_.create_thread(f);
+  }
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_WORK_STEALING_POOL_IPP
@@ -27,6 +27,7 @@
 #include "asio/detail/handler_tracking.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/reusable_op_memory.hpp"
 #include "asio/detail/throw_error.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -297,7 +298,8 @@ namespace detail
         stream_(stream),
         buffers_(buffers),
         start_(0),
-        handler_(static_cast<WriteHandler&&>(handler))
+        handler_(static_cast<WriteHandler&&>(handler)),
+        memory_((get_associated_allocator)(handler_), sizeof(*this))
     {
     }
 
@@ -319,7 +321,8 @@ namespace detail
         stream_(other.stream_),
         buffers_(static_cast<buffers_type&&>(other.buffers_)),
         start_(other.start_),
-        handler_(static_cast<WriteHandler&&>(other.handler_))
+        handler_(static_cast<WriteHandler&&>(other.handler_)),
+        memory_(static_cast<reusable_op_memory&&>(other.memory_))
     {
     }
 
@@ -352,12 +355,22 @@ namespace detail
           }
         }
 
+        memory_.reset();
         static_cast<WriteHandler&&>(handler_)(
             static_cast<const asio::error_code&>(ec),
             static_cast<const std::size_t&>(buffers_.total_consumed()));
       }
     }
 
+    typedef reusable_op_allocator<void,
+        associated_allocator_t<WriteHandler>> allocator_type;
+
+    allocator_type get_allocator() const noexcept
+    {
+      return allocator_type(memory_,
+          (get_associated_allocator)(handler_));
+    }
+
   //private:
     typedef asio::detail::consuming_buffers<const_buffer,
         ConstBufferSequence, ConstBufferIterator> buffers_type;
@@ -366,6 +379,7 @@ namespace detail
     buffers_type buffers_;
     int start_;
     WriteHandler handler_;
+    reusable_op_memory memory_;
   };
 
   template <typename AsyncWriteStream, typename ConstBufferSequence,
@@ -522,7 +536,8 @@ namespace detail
         buffers_(static_cast<BufferSequence&&>(buffers)),
         completion_condition_(
           static_cast<CompletionCondition&&>(completion_condition)),
-        handler_(static_cast<WriteHandler&&>(handler))
+        handler_(static_cast<WriteHandler&&>(handler)),
+        memory_((get_associated_allocator)(handler_), sizeof(*this))
     {
     }
 
@@ -540,7 +555,8 @@ namespace detail
         completion_condition_(
           static_cast<CompletionCondition&&>(
             other.completion_condition_)),
-        handler_(static_cast<WriteHandler&&>(other.handler_))
+        handler_(static_cast<WriteHandler&&>(other.handler_)),
+        memory_(static_cast<reusable_op_memory&&>(other.memory_))
     {
     }
 
@@ -555,16 +571,27 @@ namespace detail
             static_cast<write_dynbuf_v1_op&&>(*this));
         return; default:
         buffers_.consume(bytes_transferred);
+        memory_.reset();
         static_cast<WriteHandler&&>(handler_)(ec,
             static_cast<const std::size_t&>(bytes_transferred));
       }
     }
 
+    typedef reusable_op_allocator<void,
+        associated_allocator_t<WriteHandler>> allocator_type;
+
+    allocator_type get_allocator() const noexcept
+    {
+      return allocator_type(memory_,
+          (get_associated_allocator)(handler_));
+    }
+
   //private:
     AsyncWriteStream& stream_;
     DynamicBuffer_v1 buffers_;
     CompletionCondition completion_condition_;
     WriteHandler handler_;
+    reusable_op_memory memory_;
   };
 
   template <typename AsyncWriteStream, typename DynamicBuffer_v1,
@@ -761,7 +788,8 @@ namespace detail
         buffers_(static_cast<BufferSequence&&>(buffers)),
         completion_condition_(
           static_cast<CompletionCondition&&>(completion_condition)),
-        handler_(static_cast<WriteHandler&&>(handler))
+        handler_(static_cast<WriteHandler&&>(handler)),
+        memory_((get_associated_allocator)(handler_), sizeof(*this))
     {
     }
 
@@ -779,7 +807,8 @@ namespace detail
         completion_condition_(
           static_cast<CompletionCondition&&>(
             other.completion_condition_)),
-        handler_(static_cast<WriteHandler&&>(other.handler_))
+        handler_(static_cast<WriteHandler&&>(other.handler_)),
+        memory_(static_cast<reusable_op_memory&&>(other.memory_))
     {
     }
 
@@ -794,16 +823,27 @@ namespace detail
             static_cast<write_dynbuf_v2_op&&>(*this));
         return; default:
         buffers_.consume(bytes_transferred);
+        memory_.reset();
         static_cast<WriteHandler&&>(handler_)(ec,
             static_cast<const std::size_t&>(bytes_transferred));
       }
     }
 
+    typedef reusable_op_allocator<void,
+        associated_allocator_t<WriteHandler>> allocator_type;
+
+    allocator_type get_allocator() const noexcept
+    {
+      return allocator_type(memory_,
+          (get_associated_allocator)(handler_));
+    }
+
   //private:
     AsyncWriteStream& stream_;
     DynamicBuffer_v2 buffers_;
     CompletionCondition completion_condition_;
     WriteHandler handler_;
+    reusable_op_memory memory_;
   };
 
   template <typename AsyncWriteStream, typename DynamicBuffer_v2,
@@ -27,6 +27,7 @@
 #include "asio/error_code.hpp"
 #include "asio/execution.hpp"
 #include "asio/execution_context.hpp"
+#include "asio/io_context_metrics.hpp"
 
 #if defined(ASIO_WINDOWS) || defined(__CYGWIN__)
 # include "asio/detail/winsock_init.hpp"
@@ -516,6 +517,35 @@ public:
    */
   ASIO_DECL void restart();
 
+  /// Obtain a snapshot of the io_context's runtime metrics.
+  /**
+   * This function may be called from any thread, including while other
+   * threads are running the io_context. The counters are summed over all
+   * threads that have run the io_context, and the gauges reflect the state at
+   * the time of the call.
+   *
+   * Metrics are collected only when @c ASIO_ENABLE_IO_CONTEXT_METRICS is
+   * defined. Otherwise, all counters are zero.
+   */
+  ASIO_DECL io_context_metrics metrics() const;
+
+  /// Set a callback to be invoked for handlers that take too long to execute.
+  /**
+   * After a handler whose execution took at least @c threshold has returned,
+   * the callback is invoked on the same thread with a slow_handler_info
+   * describing the handler. Handlers that exit by throwing an exception are
+   * not reported. An exception thrown by the callback propagates from the
+   * run(), run_one(), poll() or poll_one() call, as if thrown by the handler.
+   * Passing an empty callback disables the check.
+   *
+   * This function may be called from any thread, including while other
+   * threads are running the io_context. It has no effect unless
+   * @c ASIO_ENABLE_IO_CONTEXT_METRICS is defined, and is not supported by the
+   * Windows I/O completion port implementation.
+   */
+  ASIO_DECL void set_slow_handler_callback(
+      chrono::nanoseconds threshold, slow_handler_callback callback);
+
 #if !defined(ASIO_NO_DEPRECATED)
   /// (Deprecated: Use restart().) Reset the io_context in preparation for a
   /// subsequent run() invocation.
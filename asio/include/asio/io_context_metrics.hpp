@@ -0,0 +1,121 @@
+//
+// io_context_metrics.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IO_CONTEXT_METRICS_HPP
+#define ASIO_IO_CONTEXT_METRICS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "asio/detail/chrono.hpp"
+#include "asio/latency_histogram.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Runtime metrics for an io_context and its services.
+/**
+ * A snapshot of these metrics is obtained by calling io_context::metrics().
+ * Metrics are collected only when @c ASIO_ENABLE_IO_CONTEXT_METRICS is
+ * defined. Otherwise, all counters are zero and @c pending_timers is empty.
+ *
+ * The cumulative counters are kept separately by each thread that runs the
+ * io_context, and are summed when the snapshot is taken. The average time per
+ * handler is given by <tt>handler_execution_time / handlers_executed</tt>, and
+ * the average number of events per wakeup by <tt>reactor_events /
+ * reactor_wakeups</tt>.
+ *
+ * The reactor metrics are provided by the epoll and io_uring backends only.
+ * They are zero for other backends, and for the Windows I/O completion port
+ * implementation only @c outstanding_work is available.
+ *
+ * The histograms record, for each handler, the time from when it became ready
+ * to run until its execution started, and the time taken to execute it. A
+ * handler becomes ready when it is posted or dispatched to the io_context, or
+ * when the reactor or io_uring service completes its operation.
+ */
+struct io_context_metrics
+{
+  /// The number of handlers that are ready to run and waiting in the queue.
+  std::size_t queue_depth;
+
+  /// The amount of outstanding work, including handlers that are queued,
+  /// asynchronous operations in progress, and executor work guards.
+  std::size_t outstanding_work;
+
+  /// The number of threads currently executing run(), run_one(), poll() or
+  /// poll_one().
+  std::size_t threads;
+
+  /// The total number of handlers executed.
+  std::uint64_t handlers_executed;
+
+  /// The total time spent executing handlers.
+  chrono::nanoseconds handler_execution_time;
+
+  /// The number of times the reactor has returned from waiting for events.
+  std::uint64_t reactor_wakeups;
+
+  /// The total number of events returned by the reactor.
+  std::uint64_t reactor_events;
+
+  /// The number of descriptors registered with the reactor.
+  std::size_t registered_descriptors;
+
+  /// The number of pending timers in each of the reactor's timer queues.
+  std::vector<std::size_t> pending_timers;
+
+  /// The time handlers spent waiting in the queue before they were executed.
+  latency_histogram queue_wait_histogram;
+
+  /// The time taken to execute handlers.
+  latency_histogram execution_histogram;
+};
+
+/// Information about a handler that took longer than the slow handler
+/// threshold to execute.
+/**
+ * The source location is that of the innermost ASIO_HANDLER_LOCATION in scope
+ * when the handler's operation was initiated. The location members are null
+ * or zero if no location was in scope.
+ */
+struct slow_handler_info
+{
+  /// The time the handler spent waiting in the queue before it was executed.
+  chrono::nanoseconds queue_wait_time;
+
+  /// The time taken to execute the handler.
+  chrono::nanoseconds execution_time;
+
+  /// The name of the source file in which the operation was initiated.
+  const char* file_name;
+
+  /// The line number at which the operation was initiated.
+  int line;
+
+  /// The name of the function in which the operation was initiated.
+  const char* function_name;
+};
+
+/// The type of the callback invoked for slow handlers.
+typedef std::function<void (const slow_handler_info&)> slow_handler_callback;
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IO_CONTEXT_METRICS_HPP
@@ -0,0 +1,181 @@
+//
+// latency_histogram.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_LATENCY_HISTOGRAM_HPP
+#define ASIO_LATENCY_HISTOGRAM_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <cstdint>
+#include "asio/detail/chrono.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A histogram of durations with a bounded relative error.
+/**
+ * Durations are recorded in nanoseconds. Values below 16ns each have their own
+ * bucket. Above that, each power of two is divided into 16 equally sized
+ * buckets, so that the width of a bucket is never more than 1/16th of its
+ * lower bound. Durations of 2^43ns (about 2.4 hours) or more are counted in
+ * the last bucket.
+ *
+ * Recording a duration is a constant time operation that does not allocate
+ * memory.
+ */
+class latency_histogram
+{
+public:
+  /// The number of buckets in the histogram.
+  ASIO_STATIC_CONSTEXPR(std::size_t, bucket_count = 640);
+
+  /// Construct an empty histogram.
+  latency_histogram()
+    : counts_()
+  {
+  }
+
+  /// Record a duration.
+  void record(chrono::nanoseconds d, std::uint64_t n = 1)
+  {
+    counts_[bucket_index(d)] += n;
+  }
+
+  /// Add the counts from another histogram to this one.
+  latency_histogram& operator+=(const latency_histogram& other)
+  {
+    for (std::size_t i = 0; i < bucket_count; ++i)
+      counts_[i] += other.counts_[i];
+    return *this;
+  }
+
+  /// Get the total number of recorded durations.
+  std::uint64_t count() const
+  {
+    std::uint64_t n = 0;
+    for (std::size_t i = 0; i < bucket_count; ++i)
+      n += counts_[i];
+    return n;
+  }
+
+  /// Get the number of recorded durations in a bucket.
+  std::uint64_t bucket(std::size_t i) const
+  {
+    return counts_[i];
+  }
+
+  /// Get the duration at or below which the given percentage of the recorded
+  /// durations fall.
+  /**
+   * @param p A percentage in the range [0, 100].
+   *
+   * @returns The highest duration in the bucket that contains the percentile,
+   * or zero if the histogram is empty.
+   */
+  chrono::nanoseconds percentile(double p) const
+  {
+    std::uint64_t total = count();
+    if (total == 0)
+      return chrono::nanoseconds(0);
+
+    double rank = p / 100.0 * static_cast<double>(total);
+    std::uint64_t target = rank < 1.0 ? 1 : static_cast<std::uint64_t>(rank);
+    if (static_cast<double>(target) < rank)
+      ++target;
+
+    std::uint64_t n = 0;
+    for (std::size_t i = 0; i < bucket_count; ++i)
+    {
+      n += counts_[i];
+      if (n >= target)
+        return bucket_upper_bound(i) - chrono::nanoseconds(1);
+    }
+
+    return bucket_upper_bound(bucket_count - 1) - chrono::nanoseconds(1);
+  }
+
+  /// Get the index of the bucket that counts a duration.
+  static std::size_t bucket_index(chrono::nanoseconds d)
+  {
+    if (d.count() < static_cast<chrono::nanoseconds::rep>(sub_bucket_count))
+      return d.count() < 0 ? 0 : static_cast<std::size_t>(d.count());
+
+    std::uint64_t v = static_cast<std::uint64_t>(d.count());
+    int e = highest_bit(v);
+    if (e > max_exponent)
+      return bucket_count - 1;
+
+    std::uint64_t sub = (v >> (e - sub_bucket_bits)) & sub_bucket_mask;
+    return static_cast<std::size_t>(e - sub_bucket_bits + 1) * sub_bucket_count
+      + static_cast<std::size_t>(sub);
+  }
+
+  /// Get the smallest duration counted by a bucket.
+  static chrono::nanoseconds bucket_lower_bound(std::size_t i)
+  {
+    if (i < sub_bucket_count)
+      return chrono::nanoseconds(static_cast<chrono::nanoseconds::rep>(i));
+
+    int e = static_cast<int>(i / sub_bucket_count) + sub_bucket_bits - 1;
+    std::uint64_t sub = sub_bucket_count + (i & sub_bucket_mask);
+    return chrono::nanoseconds(static_cast<chrono::nanoseconds::rep>(
+          sub << (e - sub_bucket_bits)));
+  }
+
+  /// Get the duration immediately above the range counted by a bucket.
+  static chrono::nanoseconds bucket_upper_bound(std::size_t i)
+  {
+    if (i < sub_bucket_count)
+      return chrono::nanoseconds(static_cast<chrono::nanoseconds::rep>(i + 1));
+
+    int e = static_cast<int>(i / sub_bucket_count) + sub_bucket_bits - 1;
+    return bucket_lower_bound(i) + chrono::nanoseconds(
+        static_cast<chrono::nanoseconds::rep>(
+          std::uint64_t(1) << (e - sub_bucket_bits)));
+  }
+
+private:
+  ASIO_STATIC_CONSTEXPR(int, sub_bucket_bits = 4);
+  ASIO_STATIC_CONSTEXPR(std::size_t, sub_bucket_count = 16);
+  ASIO_STATIC_CONSTEXPR(std::uint64_t, sub_bucket_mask = 15);
+  ASIO_STATIC_CONSTEXPR(int, max_exponent = 42);
+
+  // Get the position of the most significant set bit in a non-zero value.
+  static int highest_bit(std::uint64_t v)
+  {
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(v);
+#else // defined(__GNUC__)
+    int n = 0;
+    for (int shift = 32; shift > 0; shift >>= 1)
+    {
+      if (v >> shift)
+      {
+        v >>= shift;
+        n += shift;
+      }
+    }
+    return n;
+#endif // defined(__GNUC__)
+  }
+
+  std::uint64_t counts_[bucket_count];
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_LATENCY_HISTOGRAM_HPP
@@ -0,0 +1,447 @@
+//
+// local/ancillary_data.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_LOCAL_ANCILLARY_DATA_HPP
+#define ASIO_LOCAL_ANCILLARY_DATA_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if (defined(ASIO_HAS_LOCAL_SOCKETS) \
+    && !defined(ASIO_WINDOWS) \
+    && !defined(__CYGWIN__)) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <vector>
+#include "asio/async_result.hpp"
+#include "asio/basic_socket.hpp"
+#include "asio/basic_stream_socket.hpp"
+#include "asio/detail/socket_types.hpp"
+#include "asio/error.hpp"
+#include "asio/local/stream_protocol.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace local {
+namespace detail {
+
+class ancillary_data_io;
+template <typename Executor> class initiate_async_send_with_ancillary;
+template <typename Executor> class initiate_async_receive_with_ancillary;
+
+} // namespace detail
+
+#if defined(SCM_CREDENTIALS) || defined(GENERATING_DOCUMENTATION)
+
+/// The credentials of a process, as carried in an SCM_CREDENTIALS message.
+struct credentials
+{
+  /// The process ID.
+  pid_t pid;
+
+  /// The user ID.
+  uid_t uid;
+
+  /// The group ID.
+  gid_t gid;
+};
+
+#endif // defined(SCM_CREDENTIALS) || defined(GENERATING_DOCUMENTATION)
+
+/// Ancillary data sent or received with a message on a UNIX domain socket.
+/**
+ * The asio::local::ancillary_data class holds the open descriptors, and
+ * optionally the process credentials, that are passed alongside the data sent
+ * by asio::local::send_with_ancillary or received by
+ * asio::local::receive_with_ancillary. The control buffer used by the kernel
+ * is allocated once, when the object is constructed, and reused by every
+ * operation.
+ *
+ * Descriptors added for sending remain owned by the caller. Descriptors that
+ * are received are owned by the ancillary_data object until they are adopted
+ * into a socket, released, or discarded by the next receive. Received
+ * descriptors have the close-on-exec flag set.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * Handing an accepted connection to a worker process:
+ * @code asio::local::ancillary_data data;
+ * data.add_socket(accepted);
+ * asio::local::send_with_ancillary(channel, asio::buffer("C", 1), data);
+ * accepted.close(); @endcode
+ * Taking ownership of it in the worker:
+ * @code asio::local::ancillary_data data;
+ * char tag;
+ * asio::local::receive_with_ancillary(channel, asio::buffer(&tag, 1), data);
+ * asio::ip::tcp::socket connection(my_context);
+ * data.adopt(0, connection, asio::ip::tcp::v4()); @endcode
+ */
+class ancillary_data
+{
+public:
+  /// The native representation of a descriptor.
+  typedef int native_handle_type;
+
+  /// Construct to send or receive up to @c max_descriptors descriptors with
+  /// each message.
+  explicit ancillary_data(std::size_t max_descriptors = 16);
+
+  /// Destructor closes any received descriptors that have not been adopted or
+  /// released.
+  ~ancillary_data();
+
+  /// Get the maximum number of descriptors carried by a single message.
+  std::size_t max_descriptors() const noexcept
+  {
+    return max_descriptors_;
+  }
+
+  /// Add a descriptor to be sent with the next message.
+  /**
+   * @throws std::length_error Thrown if max_descriptors() descriptors have
+   * already been added.
+   */
+  void add_descriptor(native_handle_type descriptor);
+
+  /// Add a socket's descriptor to be sent with the next message.
+  /**
+   * The socket remains open. The receiving process obtains a duplicate of the
+   * descriptor, so the socket may be closed once the message has been sent.
+   *
+   * @throws std::length_error Thrown if max_descriptors() descriptors have
+   * already been added.
+   */
+  template <typename Protocol, typename Executor>
+  void add_socket(basic_socket<Protocol, Executor>& socket)
+  {
+    add_descriptor(socket.native_handle());
+  }
+
+#if defined(SCM_CREDENTIALS) || defined(GENERATING_DOCUMENTATION)
+  /// Send the calling process's credentials with the next message.
+  /**
+   * The receiving socket must have the
+   * asio::local::stream_protocol::pass_credentials option set. When it does,
+   * the kernel attaches the sender's credentials to every message even if
+   * they were not sent explicitly, so this function is only needed to send
+   * credentials other than the process's own, which requires privilege.
+   */
+  void send_credentials(const credentials& creds);
+#endif // defined(SCM_CREDENTIALS) || defined(GENERATING_DOCUMENTATION)
+
+  /// Clear the descriptors and credentials to be sent.
+  void clear_send() noexcept;
+
+  /// Get the number of descriptors received with the last message.
+  std::size_t descriptor_count() const noexcept
+  {
+    return received_.size();
+  }
+
+  /// Take ownership of a received descriptor.
+  /**
+   * @returns The descriptor, which the caller must close. Returns -1 if the
+   * descriptor has already been adopted or released.
+   */
+  native_handle_type release_descriptor(std::size_t i) noexcept;
+
+  /// Adopt a received descriptor into a socket.
+  /**
+   * The socket is opened on the descriptor without duplicating it, and takes
+   * ownership of it.
+   *
+   * @param i The index of the descriptor in the last message received.
+   *
+   * @param socket The socket to assign the descriptor to. The socket may be
+   * associated with any execution context.
+   *
+   * @param protocol The protocol of the socket that was sent.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename Protocol, typename Executor>
+  void adopt(std::size_t i, basic_socket<Protocol, Executor>& socket,
+      const Protocol& protocol = Protocol());
+
+  /// Adopt a received descriptor into a socket.
+  /**
+   * The socket is opened on the descriptor without duplicating it, and takes
+   * ownership of it.
+   *
+   * @param i The index of the descriptor in the last message received.
+   *
+   * @param socket The socket to assign the descriptor to. The socket may be
+   * associated with any execution context.
+   *
+   * @param protocol The protocol of the socket that was sent.
+   *
+   * @param ec Set to indicate what error occurred, if any. Returns
+   * asio::error::bad_descriptor if the descriptor has already been adopted or
+   * released. The descriptor remains owned by the ancillary_data object on
+   * failure.
+   */
+  template <typename Protocol, typename Executor>
+  ASIO_SYNC_OP_VOID adopt(std::size_t i,
+      basic_socket<Protocol, Executor>& socket,
+      const Protocol& protocol, asio::error_code& ec);
+
+  /// Determine whether the last message carried more control data than could
+  /// be received.
+  /**
+   * Descriptors that did not fit are closed by the kernel.
+   */
+  bool truncated() const noexcept
+  {
+    return truncated_;
+  }
+
+#if defined(SCM_CREDENTIALS) || defined(GENERATING_DOCUMENTATION)
+  /// Determine whether the last message carried the sender's credentials.
+  bool has_credentials() const noexcept
+  {
+    return has_credentials_;
+  }
+
+  /// Get the sender's credentials from the last message.
+  const credentials& peer_credentials() const noexcept
+  {
+    return received_credentials_;
+  }
+#endif // defined(SCM_CREDENTIALS) || defined(GENERATING_DOCUMENTATION)
+
+private:
+  friend class detail::ancillary_data_io;
+
+  ancillary_data(const ancillary_data&) = delete;
+  ancillary_data& operator=(const ancillary_data&) = delete;
+
+  // Close any received descriptors that are still owned.
+  void close_received() noexcept;
+
+  std::size_t max_descriptors_;
+  std::vector<unsigned char> control_;
+  std::vector<native_handle_type> outgoing_;
+  std::vector<native_handle_type> received_;
+  bool truncated_;
+#if defined(SCM_CREDENTIALS)
+  bool send_credentials_;
+  credentials outgoing_credentials_;
+  bool has_credentials_;
+  credentials received_credentials_;
+#endif // defined(SCM_CREDENTIALS)
+};
+
+/// Send data together with ancillary data on a UNIX domain stream socket.
+/**
+ * This function is used to send all of the supplied data, with the
+ * descriptors and credentials held by @c data attached to the first byte. The
+ * call will block until all of the data has been sent or an error occurs.
+ *
+ * @param s The socket on which the data is to be sent.
+ *
+ * @param buffers One or more buffers containing the data to be sent. At least
+ * one byte must be sent to carry the ancillary data.
+ *
+ * @param data The ancillary data to be sent. The descriptors and credentials
+ * to be sent are cleared once they have been sent.
+ *
+ * @returns The number of bytes sent.
+ *
+ * @throws asio::system_error Thrown on failure.
+ */
+template <typename Executor, typename ConstBufferSequence>
+std::size_t send_with_ancillary(
+    basic_stream_socket<stream_protocol, Executor>& s,
+    const ConstBufferSequence& buffers, ancillary_data& data);
+
+/// Send data together with ancillary data on a UNIX domain stream socket.
+/**
+ * This function is used to send all of the supplied data, with the
+ * descriptors and credentials held by @c data attached to the first byte. The
+ * call will block until all of the data has been sent or an error occurs.
+ *
+ * @param s The socket on which the data is to be sent.
+ *
+ * @param buffers One or more buffers containing the data to be sent. At least
+ * one byte must be sent to carry the ancillary data.
+ *
+ * @param data The ancillary data to be sent. The descriptors and credentials
+ * to be sent are cleared once they have been sent.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ *
+ * @returns The number of bytes sent.
+ */
+template <typename Executor, typename ConstBufferSequence>
+std::size_t send_with_ancillary(
+    basic_stream_socket<stream_protocol, Executor>& s,
+    const ConstBufferSequence& buffers, ancillary_data& data,
+    asio::error_code& ec);
+
+/// Start an asynchronous operation to send data together with ancillary data
+/// on a UNIX domain stream socket.
+/**
+ * This function is used to asynchronously send all of the supplied data, with
+ * the descriptors and credentials held by @c data attached to the first byte.
+ *
+ * @param s The socket on which the data is to be sent. The socket and the
+ * ancillary data must remain valid until the completion handler is called.
+ *
+ * @param buffers One or more buffers containing the data to be sent. At least
+ * one byte must be sent to carry the ancillary data. Although the buffers
+ * object may be copied as necessary, ownership of the underlying memory blocks
+ * is retained by the caller, which must guarantee that they remain valid until
+ * the completion handler is called.
+ *
+ * @param data The ancillary data to be sent. The descriptors it refers to must
+ * remain open until the completion handler is called.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the send completes. The
+ * function signature of the completion handler must be:
+ * @code void handler(
+ *   const asio::error_code& error, // Result of operation.
+ *   std::size_t bytes_transferred // Number of bytes sent.
+ * ); @endcode
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::size_t) @endcode
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the same types as the
+ * socket's @c async_wait function.
+ */
+template <typename Executor, typename ConstBufferSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteToken = default_completion_token_t<Executor>>
+auto async_send_with_ancillary(
+    basic_stream_socket<stream_protocol, Executor>& s,
+    const ConstBufferSequence& buffers, ancillary_data& data,
+    WriteToken&& token = default_completion_token_t<Executor>())
+  -> decltype(
+    async_initiate<WriteToken, void (asio::error_code, std::size_t)>(
+      declval<detail::initiate_async_send_with_ancillary<Executor>>(),
+      token, buffers, &data));
+
+/// Receive data together with ancillary data on a UNIX domain stream socket.
+/**
+ * This function is used to receive data, and any descriptors and credentials
+ * sent with it, using a single system call. The call will block until at
+ * least one byte has been received or an error occurs. Descriptors received
+ * with a previous message that are still owned by @c data are closed.
+ *
+ * @param s The socket on which the data is to be received.
+ *
+ * @param buffers One or more buffers into which the data will be received.
+ *
+ * @param data The ancillary data object that receives the descriptors and
+ * credentials.
+ *
+ * @returns The number of bytes received.
+ *
+ * @throws asio::system_error Thrown on failure. An error code of
+ * asio::error::eof indicates that the connection was closed by the peer.
+ */
+template <typename Executor, typename MutableBufferSequence>
+std::size_t receive_with_ancillary(
+    basic_stream_socket<stream_protocol, Executor>& s,
+    const MutableBufferSequence& buffers, ancillary_data& data);
+
+/// Receive data together with ancillary data on a UNIX domain stream socket.
+/**
+ * This function is used to receive data, and any descriptors and credentials
+ * sent with it, using a single system call. The call will block until at
+ * least one byte has been received or an error occurs. Descriptors received
+ * with a previous message that are still owned by @c data are closed.
+ *
+ * @param s The socket on which the data is to be received.
+ *
+ * @param buffers One or more buffers into which the data will be received.
+ *
+ * @param data The ancillary data object that receives the descriptors and
+ * credentials.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ *
+ * @returns The number of bytes received. Returns 0 if an error occurred.
+ */
+template <typename Executor, typename MutableBufferSequence>
+std::size_t receive_with_ancillary(
+    basic_stream_socket<stream_protocol, Executor>& s,
+    const MutableBufferSequence& buffers, ancillary_data& data,
+    asio::error_code& ec);
+
+/// Start an asynchronous operation to receive data together with ancillary
+/// data on a UNIX domain stream socket.
+/**
+ * This function is used to asynchronously receive data, and any descriptors
+ * and credentials sent with it, using a single system call. If no data is
+ * available, the operation first waits for the socket to become readable. Descriptors received with a previous message that are
+ * still owned by @c data are closed.
+ *
+ * @param s The socket on which the data is to be received. The socket and the
+ * ancillary data must remain valid until the completion handler is called.
+ *
+ * @param buffers One or more buffers into which the data will be received.
+ * Although the buffers object may be copied as necessary, ownership of the
+ * underlying memory blocks is retained by the caller, which must guarantee
+ * that they remain valid until the completion handler is called.
+ *
+ * @param data The ancillary data object that receives the descriptors and
+ * credentials.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the receive completes. The
+ * function signature of the completion handler must be:
+ * @code void handler(
+ *   const asio::error_code& error, // Result of operation.
+ *   std::size_t bytes_transferred // Number of bytes received.
+ * ); @endcode
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::size_t) @endcode
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the same types as the
+ * socket's @c async_wait function.
+ */
+template <typename Executor, typename MutableBufferSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) ReadToken = default_completion_token_t<Executor>>
+auto async_receive_with_ancillary(
+    basic_stream_socket<stream_protocol, Executor>& s,
+    const MutableBufferSequence& buffers, ancillary_data& data,
+    ReadToken&& token = default_completion_token_t<Executor>())
+  -> decltype(
+    async_initiate<ReadToken, void (asio::error_code, std::size_t)>(
+      declval<detail::initiate_async_receive_with_ancillary<Executor>>(),
+      token, buffers, &data));
+
+} // namespace local
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/local/impl/ancillary_data.hpp"
+
+#endif // (defined(ASIO_HAS_LOCAL_SOCKETS)
+       //     && !defined(ASIO_WINDOWS)
+       //     && !defined(__CYGWIN__))
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_LOCAL_ANCILLARY_DATA_HPP
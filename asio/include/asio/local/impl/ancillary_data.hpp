@@ -0,0 +1,570 @@
+//
+// local/impl/ancillary_data.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_LOCAL_IMPL_ANCILLARY_DATA_HPP
+#define ASIO_LOCAL_IMPL_ANCILLARY_DATA_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include "asio/compose.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/consuming_buffers.hpp"
+#include "asio/detail/non_blocking_io_op.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/throw_exception.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace local {
+namespace detail {
+
+class ancillary_data_io
+{
+public:
+  // Make a single call to sendmsg(), attaching any ancillary data that has not
+  // yet been sent.
+  template <typename ConstBufferSequence>
+  static std::size_t send(asio::detail::socket_type s,
+      const ConstBufferSequence& buffers, ancillary_data& data,
+      int flags, asio::error_code& ec)
+  {
+    asio::detail::buffer_sequence_adapter<const_buffer,
+      ConstBufferSequence> bufs(buffers);
+
+    msghdr msg = msghdr();
+    msg.msg_iov = bufs.buffers();
+    msg.msg_iovlen = bufs.count();
+    prepare_send(data, msg);
+
+#if defined(ASIO_HAS_MSG_NOSIGNAL)
+    flags |= MSG_NOSIGNAL;
+#endif // defined(ASIO_HAS_MSG_NOSIGNAL)
+    ssize_t result = ::sendmsg(s, &msg, flags);
+    if (result < 0)
+    {
+      ec = asio::error_code(errno, asio::error::get_system_category());
+      return 0;
+    }
+
+    // The ancillary data travels with the first byte sent.
+    if (result > 0)
+      data.clear_send();
+
+    ec = asio::error_code();
+    return static_cast<std::size_t>(result);
+  }
+
+  // Make a single call to recvmsg(), replacing the previously received
+  // ancillary data.
+  template <typename MutableBufferSequence>
+  static std::size_t receive(asio::detail::socket_type s,
+      const MutableBufferSequence& buffers, ancillary_data& data,
+      int flags, asio::error_code& ec)
+  {
+    asio::detail::buffer_sequence_adapter<mutable_buffer,
+      MutableBufferSequence> bufs(buffers);
+
+    data.close_received();
+
+    msghdr msg = msghdr();
+    msg.msg_iov = bufs.buffers();
+    msg.msg_iovlen = bufs.count();
+    msg.msg_control = &data.control_[0];
+    msg.msg_controllen = data.control_.size();
+
+#if defined(MSG_CMSG_CLOEXEC)
+    flags |= MSG_CMSG_CLOEXEC;
+#endif // defined(MSG_CMSG_CLOEXEC)
+    ssize_t result = ::recvmsg(s, &msg, flags);
+    if (result < 0)
+    {
+      ec = asio::error_code(errno, asio::error::get_system_category());
+      return 0;
+    }
+
+    for (cmsghdr* c = CMSG_FIRSTHDR(&msg); c; c = CMSG_NXTHDR(&msg, c))
+    {
+      if (c->cmsg_level != SOL_SOCKET)
+        continue;
+
+      if (c->cmsg_type == SCM_RIGHTS)
+      {
+        const unsigned char* p = CMSG_DATA(c);
+        std::size_t count = (c->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (std::size_t i = 0; i < count; ++i, p += sizeof(int))
+        {
+          int descriptor;
+          std::memcpy(&descriptor, p, sizeof(int));
+#if !defined(MSG_CMSG_CLOEXEC)
+          ::fcntl(descriptor, F_SETFD, FD_CLOEXEC);
+#endif // !defined(MSG_CMSG_CLOEXEC)
+          data.received_.push_back(descriptor);
+        }
+      }
+#if defined(SCM_CREDENTIALS)
+      else if (c->cmsg_type == SCM_CREDENTIALS
+          && c->cmsg_len >= CMSG_LEN(sizeof(ucred)))
+      {
+        ucred creds;
+        std::memcpy(&creds, CMSG_DATA(c), sizeof(ucred));
+        data.received_credentials_.pid = creds.pid;
+        data.received_credentials_.uid = creds.uid;
+        data.received_credentials_.gid = creds.gid;
+        data.has_credentials_ = true;
+      }
+#endif // defined(SCM_CREDENTIALS)
+    }
+
+    data.truncated_ = (msg.msg_flags & MSG_CTRUNC) != 0;
+
+    if (result == 0 && !bufs.all_empty())
+    {
+      ec = asio::error::eof;
+      return 0;
+    }
+
+    ec = asio::error_code();
+    return static_cast<std::size_t>(result);
+  }
+
+private:
+  // Build the control messages for the descriptors and credentials to be sent.
+  static void prepare_send(ancillary_data& data, msghdr& msg)
+  {
+    std::size_t descriptors_length = sizeof(int) * data.outgoing_.size();
+    std::size_t length = 0;
+    if (descriptors_length > 0)
+      length += CMSG_SPACE(descriptors_length);
+#if defined(SCM_CREDENTIALS)
+    if (data.send_credentials_)
+      length += CMSG_SPACE(sizeof(ucred));
+#endif // defined(SCM_CREDENTIALS)
+    if (length == 0)
+      return;
+
+    std::memset(&data.control_[0], 0, length);
+    msg.msg_control = &data.control_[0];
+    msg.msg_controllen = length;
+
+    cmsghdr* c = CMSG_FIRSTHDR(&msg);
+    if (descriptors_length > 0)
+    {
+      c->cmsg_level = SOL_SOCKET;
+      c->cmsg_type = SCM_RIGHTS;
+      c->cmsg_len = CMSG_LEN(descriptors_length);
+      std::memcpy(CMSG_DATA(c), &data.outgoing_[0], descriptors_length);
+      c = CMSG_NXTHDR(&msg, c);
+    }
+
+#if defined(SCM_CREDENTIALS)
+    if (data.send_credentials_)
+    {
+      ucred creds;
+      creds.pid = data.outgoing_credentials_.pid;
+      creds.uid = data.outgoing_credentials_.uid;
+      creds.gid = data.outgoing_credentials_.gid;
+      c->cmsg_level = SOL_SOCKET;
+      c->cmsg_type = SCM_CREDENTIALS;
+      c->cmsg_len = CMSG_LEN(sizeof(ucred));
+      std::memcpy(CMSG_DATA(c), &creds, sizeof(ucred));
+    }
+#endif // defined(SCM_CREDENTIALS)
+  }
+};
+
+template <typename Executor, typename ConstBufferSequence>
+class send_with_ancillary_op
+{
+public:
+  send_with_ancillary_op(basic_stream_socket<stream_protocol, Executor>& s,
+      const ConstBufferSequence& buffers, ancillary_data& data)
+    : socket_(s),
+      buffers_(buffers),
+      data_(data)
+  {
+  }
+
+  bool perform(asio::error_code& ec, socket_base::wait_type& wait)
+  {
+    while (!buffers_.empty())
+    {
+      std::size_t n = ancillary_data_io::send(socket_.native_handle(),
+          buffers_.prepare(default_max_transfer_size),
+          data_, MSG_DONTWAIT, ec);
+      if (ec == asio::error::would_block)
+      {
+        wait = socket_base::wait_write;
+        return false;
+      }
+      else if (ec == asio::error::interrupted)
+        continue;
+      else if (ec)
+        return true;
+
+      buffers_.consume(n);
+    }
+
+    return true;
+  }
+
+  std::size_t bytes_transferred() const
+  {
+    return buffers_.total_consumed();
+  }
+
+private:
+  enum { default_max_transfer_size = 65536 };
+
+  basic_stream_socket<stream_protocol, Executor>& socket_;
+  asio::detail::consuming_buffers<const_buffer, ConstBufferSequence,
+    decltype(asio::buffer_sequence_begin(
+      declval<const ConstBufferSequence&>()))> buffers_;
+  ancillary_data& data_;
+};
+
+template <typename Executor, typename MutableBufferSequence>
+class receive_with_ancillary_op
+{
+public:
+  receive_with_ancillary_op(basic_stream_socket<stream_protocol, Executor>& s,
+      const MutableBufferSequence& buffers, ancillary_data& data)
+    : socket_(s),
+      buffers_(buffers),
+      data_(data),
+      bytes_transferred_(0)
+  {
+  }
+
+  bool perform(asio::error_code& ec, socket_base::wait_type& wait)
+  {
+    for (;;)
+    {
+      bytes_transferred_ = ancillary_data_io::receive(
+          socket_.native_handle(), buffers_, data_, MSG_DONTWAIT, ec);
+      if (ec == asio::error::interrupted)
+        continue;
+      if (ec != asio::error::would_block)
+        return true;
+      wait = socket_base::wait_read;
+      return false;
+    }
+  }
+
+  std::size_t bytes_transferred() const
+  {
+    return bytes_transferred_;
+  }
+
+private:
+  basic_stream_socket<stream_protocol, Executor>& socket_;
+  MutableBufferSequence buffers_;
+  ancillary_data& data_;
+  std::size_t bytes_transferred_;
+};
+
+template <typename Executor>
+class initiate_async_send_with_ancillary
+{
+public:
+  typedef Executor executor_type;
+
+  explicit initiate_async_send_with_ancillary(
+      basic_stream_socket<stream_protocol, Executor>& s)
+    : socket_(s)
+  {
+  }
+
+  executor_type get_executor() const noexcept
+  {
+    return socket_.get_executor();
+  }
+
+  template <typename WriteHandler, typename ConstBufferSequence>
+  void operator()(WriteHandler&& handler,
+      const ConstBufferSequence& buffers, ancillary_data* data) const
+  {
+    typedef send_with_ancillary_op<Executor, ConstBufferSequence> op_type;
+
+    asio::async_compose<WriteHandler, void (asio::error_code, std::size_t)>(
+        asio::detail::non_blocking_io_op<
+          basic_stream_socket<stream_protocol, Executor>, op_type>(
+            socket_, op_type(socket_, buffers, *data)),
+        handler, socket_);
+  }
+
+private:
+  basic_stream_socket<stream_protocol, Executor>& socket_;
+};
+
+template <typename Executor>
+class initiate_async_receive_with_ancillary
+{
+public:
+  typedef Executor executor_type;
+
+  explicit initiate_async_receive_with_ancillary(
+      basic_stream_socket<stream_protocol, Executor>& s)
+    : socket_(s)
+  {
+  }
+
+  executor_type get_executor() const noexcept
+  {
+    return socket_.get_executor();
+  }
+
+  template <typename ReadHandler, typename MutableBufferSequence>
+  void operator()(ReadHandler&& handler,
+      const MutableBufferSequence& buffers, ancillary_data* data) const
+  {
+    typedef receive_with_ancillary_op<Executor, MutableBufferSequence> op_type;
+
+    asio::async_compose<ReadHandler, void (asio::error_code, std::size_t)>(
+        asio::detail::non_blocking_io_op<
+          basic_stream_socket<stream_protocol, Executor>, op_type>(
+            socket_, op_type(socket_, buffers, *data)),
+        handler, socket_);
+  }
+
+private:
+  basic_stream_socket<stream_protocol, Executor>& socket_;
+};
+
+} // namespace detail
+
+inline ancillary_data::ancillary_data(std::size_t max_descriptors)
+  : max_descriptors_(max_descriptors),
+    control_(CMSG_SPACE(sizeof(int) * (max_descriptors ? max_descriptors : 1))
+#if defined(SCM_CREDENTIALS)
+        + CMSG_SPACE(sizeof(ucred))
+#endif // defined(SCM_CREDENTIALS)
+        ),
+    truncated_(false)
+#if defined(SCM_CREDENTIALS)
+    , send_credentials_(false),
+    outgoing_credentials_(),
+    has_credentials_(false),
+    received_credentials_()
+#endif // defined(SCM_CREDENTIALS)
+{
+  outgoing_.reserve(max_descriptors);
+  received_.reserve(max_descriptors);
+}
+
+inline ancillary_data::~ancillary_data()
+{
+  close_received();
+}
+
+inline void ancillary_data::add_descriptor(native_handle_type descriptor)
+{
+  if (outgoing_.size() >= max_descriptors_)
+  {
+    std::length_error ex("ancillary_data too many descriptors");
+    asio::detail::throw_exception(ex);
+  }
+
+  outgoing_.push_back(descriptor);
+}
+
+#if defined(SCM_CREDENTIALS)
+inline void ancillary_data::send_credentials(const credentials& creds)
+{
+  send_credentials_ = true;
+  outgoing_credentials_ = creds;
+}
+#endif // defined(SCM_CREDENTIALS)
+
+inline void ancillary_data::clear_send() noexcept
+{
+  outgoing_.clear();
+#if defined(SCM_CREDENTIALS)
+  send_credentials_ = false;
+#endif // defined(SCM_CREDENTIALS)
+}
+
+inline ancillary_data::native_handle_type
+ancillary_data::release_descriptor(std::size_t i) noexcept
+{
+  if (i >= received_.size())
+    return -1;
+
+  native_handle_type descriptor = received_[i];
+  received_[i] = -1;
+  return descriptor;
+}
+
+template <typename Protocol, typename Executor>
+void ancillary_data::adopt(std::size_t i,
+    basic_socket<Protocol, Executor>& socket, const Protocol& protocol)
+{
+  asio::error_code ec;
+  adopt(i, socket, protocol, ec);
+  asio::detail::throw_error(ec, "adopt");
+}
+
+template <typename Protocol, typename Executor>
+ASIO_SYNC_OP_VOID ancillary_data::adopt(std::size_t i,
+    basic_socket<Protocol, Executor>& socket,
+    const Protocol& protocol, asio::error_code& ec)
+{
+  if (i >= received_.size() || received_[i] == -1)
+  {
+    ec = asio::error::bad_descriptor;
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  socket.assign(protocol, received_[i], ec);
+  if (!ec)
+    received_[i] = -1;
+  ASIO_SYNC_OP_VOID_RETURN(ec);
+}
+
+inline void ancillary_data::close_received() noexcept
+{
+  for (std::size_t i = 0; i < received_.size(); ++i)
+    if (received_[i] != -1)
+      ::close(received_[i]);
+  received_.clear();
+  truncated_ = false;
+#if defined(SCM_CREDENTIALS)
+  has_credentials_ = false;
+#endif // defined(SCM_CREDENTIALS)
+}
+
+template <typename Executor, typename ConstBufferSequence>
+std::size_t send_with_ancillary(
+    basic_stream_socket<stream_protocol, Executor>& s,
+    const ConstBufferSequence& buffers, ancillary_data& data)
+{
+  asio::error_code ec;
+  std::size_t n = send_with_ancillary(s, buffers, data, ec);
+  asio::detail::throw_error(ec, "send_with_ancillary");
+  return n;
+}
+
+template <typename Executor, typename ConstBufferSequence>
+std::size_t send_with_ancillary(
+    basic_stream_socket<stream_protocol, Executor>& s,
+    const ConstBufferSequence& buffers, ancillary_data& data,
+    asio::error_code& ec)
+{
+  asio::detail::consuming_buffers<const_buffer, ConstBufferSequence,
+    decltype(asio::buffer_sequence_begin(buffers))> tmp(buffers);
+
+  ec = asio::error_code();
+  while (!tmp.empty())
+  {
+    std::size_t n = detail::ancillary_data_io::send(
+        s.native_handle(), tmp.prepare(65536), data, 0, ec);
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // The descriptor is made non-blocking internally once an asynchronous
+    // operation has been started on the socket. Unless the user asked for
+    // non-blocking behaviour, wait until the data can be sent.
+    if (ec == asio::error::would_block && !s.non_blocking())
+    {
+      s.wait(socket_base::wait_write, ec);
+      if (!ec)
+        continue;
+    }
+    if (ec)
+      break;
+
+    tmp.consume(n);
+  }
+
+  return tmp.total_consumed();
+}
+
+template <typename Executor, typename ConstBufferSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteToken>
+inline auto async_send_with_ancillary(
+    basic_stream_socket<stream_protocol, Executor>& s,
+    const ConstBufferSequence& buffers, ancillary_data& data,
+    WriteToken&& token)
+  -> decltype(
+    async_initiate<WriteToken, void (asio::error_code, std::size_t)>(
+      declval<detail::initiate_async_send_with_ancillary<Executor>>(),
+      token, buffers, &data))
+{
+  return async_initiate<WriteToken, void (asio::error_code, std::size_t)>(
+      detail::initiate_async_send_with_ancillary<Executor>(s),
+      token, buffers, &data);
+}
+
+template <typename Executor, typename MutableBufferSequence>
+std::size_t receive_with_ancillary(
+    basic_stream_socket<stream_protocol, Executor>& s,
+    const MutableBufferSequence& buffers, ancillary_data& data)
+{
+  asio::error_code ec;
+  std::size_t n = receive_with_ancillary(s, buffers, data, ec);
+  asio::detail::throw_error(ec, "receive_with_ancillary");
+  return n;
+}
+
+template <typename Executor, typename MutableBufferSequence>
+std::size_t receive_with_ancillary(
+    basic_stream_socket<stream_protocol, Executor>& s,
+    const MutableBufferSequence& buffers, ancillary_data& data,
+    asio::error_code& ec)
+{
+  for (;;)
+  {
+    std::size_t n = detail::ancillary_data_io::receive(
+        s.native_handle(), buffers, data, 0, ec);
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // The descriptor is made non-blocking internally once an asynchronous
+    // operation has been started on the socket. Unless the user asked for
+    // non-blocking behaviour, wait for data to arrive.
+    if (ec != asio::error::would_block || s.non_blocking())
+      return n;
+    s.wait(socket_base::wait_read, ec);
+    if (ec)
+      return 0;
+  }
+}
+
+template <typename Executor, typename MutableBufferSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) ReadToken>
+inline auto async_receive_with_ancillary(
+    basic_stream_socket<stream_protocol, Executor>& s,
+    const MutableBufferSequence& buffers, ancillary_data& data,
+    ReadToken&& token)
+  -> decltype(
+    async_initiate<ReadToken, void (asio::error_code, std::size_t)>(
+      declval<detail::initiate_async_receive_with_ancillary<Executor>>(),
+      token, buffers, &data))
+{
+  return async_initiate<ReadToken, void (asio::error_code, std::size_t)>(
+      detail::initiate_async_receive_with_ancillary<Executor>(s),
+      token, buffers, &data);
+}
+
+} // namespace local
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_LOCAL_IMPL_ANCILLARY_DATA_HPP
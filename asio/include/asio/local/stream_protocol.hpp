@@ -23,6 +23,7 @@
 #include "asio/basic_socket_acceptor.hpp"
 #include "asio/basic_socket_iostream.hpp"
 #include "asio/basic_stream_socket.hpp"
+#include "asio/detail/socket_option.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/local/basic_endpoint.hpp"
 
@@ -73,6 +74,34 @@ public:
   /// The UNIX domain acceptor type.
   typedef basic_socket_acceptor<stream_protocol> acceptor;
 
+#if defined(SO_PASSCRED) || defined(GENERATING_DOCUMENTATION)
+  /// Socket option to receive the credentials of the sending process.
+  /**
+   * Implements the SOL_SOCKET/SO_PASSCRED socket option. When the option is
+   * set on the receiving socket, asio::local::receive_with_ancillary and
+   * asio::local::async_receive_with_ancillary report the process ID, user ID
+   * and group ID of the sender.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::local::stream_protocol::socket socket(my_context);
+   * ...
+   * asio::local::stream_protocol::pass_credentials option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined pass_credentials;
+#else
+  typedef asio::detail::socket_option::boolean<SOL_SOCKET, SO_PASSCRED>
+    pass_credentials;
+#endif
+#endif // defined(SO_PASSCRED) || defined(GENERATING_DOCUMENTATION)
+
 #if !defined(ASIO_NO_IOSTREAM)
   /// The UNIX domain iostream type.
   typedef basic_socket_iostream<stream_protocol> iostream;
@@ -0,0 +1,137 @@
+//
+// proxy.hpp
+// ~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_PROXY_HPP
+#define ASIO_PROXY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/basic_stream_socket.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename Stream1, typename Stream2> class initiate_async_proxy;
+
+} // namespace detail
+
+/**
+ * @defgroup async_proxy asio::async_proxy
+ *
+ * @brief The @c async_proxy function is a composed asynchronous operation that
+ * relays data in both directions between two connected stream sockets.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to relay data in both directions between
+/// two stream sockets.
+/**
+ * This function is used to asynchronously copy everything received on @c a to
+ * @c b, and everything received on @c b to @c a, until both directions have
+ * reached end of stream or an error occurs. The sockets may use different
+ * protocols, for example to bridge a asio::vm::stream_protocol connection to
+ * an asio::ip::tcp one.
+ *
+ * Each direction runs independently. Where supported, data is moved between
+ * the sockets with @c splice() through a pipe, without being copied into user
+ * space. Otherwise, or if either socket does not support @c splice(), the
+ * direction falls back to copying through a buffer drawn from the thread's
+ * recycling allocator cache. In both cases at most one pipe or buffer of data
+ * is held in transit, so a slow reader on one side applies backpressure to
+ * the writer on the other without affecting the opposite direction.
+ *
+ * When one direction reaches end of stream, the sending side of its
+ * destination socket is shut down, so that a half-closed connection is
+ * propagated to the peer while the other direction continues. If either
+ * direction fails, the other is cancelled.
+ *
+ * @param a The first socket. The socket must remain valid until the
+ * completion handler is called.
+ *
+ * @param b The second socket. The socket must remain valid until the
+ * completion handler is called.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when both directions have finished.
+ * The function signature of the completion handler must be:
+ * @code void handler(
+ *   // Result of operation. This is the first error encountered by either
+ *   // direction, or success if both reached end of stream.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes relayed from a to b.
+ *   std::size_t a_to_b,
+ *
+ *   // Number of bytes relayed from b to a.
+ *   std::size_t b_to_a
+ * ); @endcode
+ * The completion handler will not be invoked from within this function.
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::size_t, std::size_t) @endcode
+ *
+ * @note The operation switches both sockets to non-blocking mode internally.
+ * Both sockets must share the same implicit or explicit strand, and no other
+ * read, write or wait operations may be performed on them until the operation
+ * completes. Writes performed with @c splice() cannot suppress @c SIGPIPE, so
+ * programs using this operation should ignore that signal.
+ *
+ * @par Example
+ * @code void handle_guest(asio::vm::stream_protocol::socket& guest,
+ *     asio::ip::tcp::socket& backend)
+ * {
+ *   asio::async_proxy(guest, backend,
+ *       [](asio::error_code ec, std::size_t up, std::size_t down)
+ *       {
+ *         ...
+ *       });
+ * } @endcode
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the following
+ * asio::cancellation_type values:
+ *
+ * @li @c cancellation_type::terminal
+ *
+ * if they are also supported by the socket's @c async_wait, @c async_read_some
+ * and @c async_write_some operations.
+ */
+template <typename Protocol1, typename Executor1,
+    typename Protocol2, typename Executor2,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t, std::size_t)) ProxyToken
+        = default_completion_token_t<Executor1>>
+auto async_proxy(basic_stream_socket<Protocol1, Executor1>& a,
+    basic_stream_socket<Protocol2, Executor2>& b,
+    ProxyToken&& token = default_completion_token_t<Executor1>())
+  -> decltype(
+    async_initiate<ProxyToken,
+      void (asio::error_code, std::size_t, std::size_t)>(
+        declval<detail::initiate_async_proxy<
+          basic_stream_socket<Protocol1, Executor1>,
+          basic_stream_socket<Protocol2, Executor2>>>(), token));
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/proxy.hpp"
+
+#endif // ASIO_PROXY_HPP
@@ -24,9 +24,11 @@ namespace asio {
 
 /// An allocator that caches memory blocks in thread-local storage for reuse.
 /**
- * The @recycling_allocator uses a simple strategy where a limited number of
- * small memory blocks are cached in thread-local storage, if the current
- * thread is running an @c io_context or is part of a @c thread_pool.
+ * The @recycling_allocator caches small memory blocks in thread-local storage,
+ * if the current thread is running an @c io_context or is part of a
+ * @c thread_pool. Blocks are grouped into power-of-two size classes, and a
+ * block that is deallocated on a thread other than the one that allocated it
+ * is returned to its owning thread's cache.
  */
 template <typename T>
 class recycling_allocator
@@ -85,9 +87,11 @@ public:
 /// A proto-allocator that caches memory blocks in thread-local storage for
 /// reuse.
 /**
- * The @recycling_allocator uses a simple strategy where a limited number of
- * small memory blocks are cached in thread-local storage, if the current
- * thread is running an @c io_context or is part of a @c thread_pool.
+ * The @recycling_allocator caches small memory blocks in thread-local storage,
+ * if the current thread is running an @c io_context or is part of a
+ * @c thread_pool. Blocks are grouped into power-of-two size classes, and a
+ * block that is deallocated on a thread other than the one that allocated it
+ * is returned to its owning thread's cache.
  */
 template <>
 class recycling_allocator<void>
@@ -131,6 +135,40 @@ public:
   }
 };
 
+/// Counters describing the behaviour of the recycling allocator.
+struct recycling_allocator_statistics
+{
+  /// The number of allocations satisfied from a thread's cache.
+  std::size_t hits;
+
+  /// The number of cacheable allocations that required new memory.
+  std::size_t misses;
+
+  /// The number of allocations that were not eligible for caching.
+  std::size_t uncached;
+
+  /// The number of blocks returned to a cache owned by another thread.
+  std::size_t remote_deallocations;
+};
+
+/// Obtain the process-wide recycling allocator statistics.
+/**
+ * Statistics are collected only when @c ASIO_ENABLE_RECYCLING_ALLOCATOR_STATS
+ * is defined. Otherwise, all counters are zero.
+ */
+inline recycling_allocator_statistics
+get_recycling_allocator_statistics() noexcept
+{
+  typedef detail::size_class_cache cache;
+  recycling_allocator_statistics stats = {
+    cache::counter_value(cache::hit_counter),
+    cache::counter_value(cache::miss_counter),
+    cache::counter_value(cache::uncached_counter),
+    cache::counter_value(cache::remote_counter)
+  };
+  return stats;
+}
+
 } // namespace asio
 
 #include "asio/detail/pop_options.hpp"
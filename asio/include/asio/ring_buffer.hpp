@@ -0,0 +1,440 @@
+//
+// ring_buffer.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_RING_BUFFER_HPP
+#define ASIO_RING_BUFFER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_RING_BUFFER) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include "asio/buffer.hpp"
+#include "asio/detail/mirrored_memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/throw_exception.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+class dynamic_ring_buffer;
+
+/// A fixed-capacity circular buffer of bytes.
+/**
+ * The ring_buffer class holds its bytes in memory that is mapped twice,
+ * back-to-back, so that the bytes in the buffer are always contiguous, even
+ * when they wrap around the end of the underlying memory. Bytes are consumed
+ * from the front of the buffer without moving the bytes that remain, and the
+ * buffer never reallocates its memory.
+ *
+ * A ring_buffer is used as the backing storage for a dynamic_ring_buffer,
+ * which is obtained by calling asio::dynamic_buffer().
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class ring_buffer
+  : private noncopyable
+{
+public:
+  /// Construct a ring buffer with at least the specified capacity.
+  /**
+   * @param capacity The minimum capacity of the buffer, in bytes. The capacity
+   * is rounded up to a multiple of the system's page size.
+   *
+   * @throws asio::system_error Thrown if the memory could not be mapped.
+   */
+  explicit ring_buffer(std::size_t capacity)
+    : memory_(capacity),
+      start_(0),
+      size_(0)
+  {
+  }
+
+  /// Move-construct a ring buffer from another.
+  /**
+   * The moved-from object has a capacity of zero.
+   */
+  ring_buffer(ring_buffer&& other) noexcept
+    : memory_(static_cast<detail::mirrored_memory&&>(other.memory_)),
+      start_(other.start_),
+      size_(other.size_)
+  {
+    other.start_ = 0;
+    other.size_ = 0;
+  }
+
+  /// Get the number of bytes in the buffer.
+  std::size_t size() const noexcept
+  {
+    return size_;
+  }
+
+  /// Get the maximum number of bytes that the buffer can hold.
+  std::size_t capacity() const noexcept
+  {
+    return memory_.size();
+  }
+
+  /// Get a single contiguous buffer that represents the bytes in the buffer.
+  /**
+   * @note The returned object is invalidated by any operation that consumes
+   * bytes from the buffer.
+   */
+  const_buffer data() const noexcept
+  {
+    return const_buffer(memory_.data() + start_, size_);
+  }
+
+  /// Remove all bytes from the buffer.
+  void clear() noexcept
+  {
+    start_ = 0;
+    size_ = 0;
+  }
+
+private:
+  friend class dynamic_ring_buffer;
+
+  // Remove bytes from the front of the buffer.
+  void consume(std::size_t n) noexcept
+  {
+    size_ -= n;
+    start_ = size_ == 0 ? 0 : (start_ + n) % memory_.size();
+  }
+
+  detail::mirrored_memory memory_;
+  std::size_t start_;
+  std::size_t size_;
+};
+
+/// Adapt a ring_buffer to the DynamicBuffer requirements.
+/**
+ * The dynamic_ring_buffer class satisfies both the DynamicBuffer_v1 and
+ * DynamicBuffer_v2 requirements. The buffer sequences returned by data() and
+ * prepare() always consist of a single contiguous buffer, consume() does not
+ * move the bytes that remain, and the underlying memory is never reallocated.
+ * The maximum size of the dynamic buffer is limited by the capacity of the
+ * ring_buffer.
+ */
+class dynamic_ring_buffer
+{
+public:
+  /// The type used to represent a sequence of constant buffers that refers to
+  /// the underlying memory.
+  typedef ASIO_CONST_BUFFER const_buffers_type;
+
+  /// The type used to represent a sequence of mutable buffers that refers to
+  /// the underlying memory.
+  typedef ASIO_MUTABLE_BUFFER mutable_buffers_type;
+
+  /// Construct a dynamic buffer from a ring buffer.
+  /**
+   * @param b The ring buffer to be used as backing storage for the dynamic
+   * buffer. The object stores a reference to the ring buffer and the user is
+   * responsible for ensuring that the ring buffer object remains valid while
+   * the dynamic_ring_buffer object, and copies of the object, are in use.
+   *
+   * @b DynamicBuffer_v1: Any existing data in the ring buffer is treated as
+   * the dynamic buffer's input sequence.
+   *
+   * @param maximum_size Specifies a maximum size for the buffer, in bytes.
+   */
+  explicit dynamic_ring_buffer(ring_buffer& b,
+      std::size_t maximum_size =
+        (std::numeric_limits<std::size_t>::max)()) noexcept
+    : ring_(b),
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+      size_((std::numeric_limits<std::size_t>::max)()),
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+      max_size_(maximum_size)
+  {
+  }
+
+  /// @b DynamicBuffer_v2: Copy construct a dynamic buffer.
+  dynamic_ring_buffer(const dynamic_ring_buffer& other) noexcept
+    : ring_(other.ring_),
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+      size_(other.size_),
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+      max_size_(other.max_size_)
+  {
+  }
+
+  /// Move construct a dynamic buffer.
+  dynamic_ring_buffer(dynamic_ring_buffer&& other) noexcept
+    : ring_(other.ring_),
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+      size_(other.size_),
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+      max_size_(other.max_size_)
+  {
+  }
+
+  /// @b DynamicBuffer_v1: Get the size of the input sequence.
+  /// @b DynamicBuffer_v2: Get the current size of the underlying memory.
+  /**
+   * @returns @b DynamicBuffer_v1 The current size of the input sequence.
+   * @b DynamicBuffer_v2: The number of bytes in the ring buffer if less than
+   * max_size(). Otherwise returns max_size().
+   */
+  std::size_t size() const noexcept
+  {
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+    if (size_ != (std::numeric_limits<std::size_t>::max)())
+      return size_;
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+    return (std::min)(ring_.size(), max_size());
+  }
+
+  /// Get the maximum size of the dynamic buffer.
+  /**
+   * @returns The allowed maximum size of the underlying memory, which is no
+   * greater than the capacity of the ring buffer.
+   */
+  std::size_t max_size() const noexcept
+  {
+    return (std::min)(ring_.capacity(), max_size_);
+  }
+
+  /// Get the maximum size that the buffer may grow to without triggering
+  /// reallocation.
+  /**
+   * @returns The same value as max_size(), as the ring buffer's memory is
+   * never reallocated.
+   */
+  std::size_t capacity() const noexcept
+  {
+    return max_size();
+  }
+
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+  /// @b DynamicBuffer_v1: Get a list of buffers that represents the input
+  /// sequence.
+  /**
+   * @returns An object of type @c const_buffers_type that satisfies
+   * ConstBufferSequence requirements, representing the ring buffer memory in
+   * the input sequence.
+   *
+   * @note The returned object is invalidated by any @c dynamic_ring_buffer
+   * or @c ring_buffer member function that consumes bytes from the buffer.
+   */
+  const_buffers_type data() const noexcept
+  {
+    return const_buffers_type(asio::buffer(ring_.data(), size_));
+  }
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+
+  /// @b DynamicBuffer_v2: Get a sequence of buffers that represents the
+  /// underlying memory.
+  /**
+   * @param pos Position of the first byte to represent in the buffer sequence
+   *
+   * @param n The number of bytes to return in the buffer sequence. If the
+   * underlying memory is shorter, the buffer sequence represents as many bytes
+   * as are available.
+   *
+   * @returns An object of type @c mutable_buffers_type that satisfies
+   * MutableBufferSequence requirements, representing the ring buffer memory.
+   *
+   * @note The returned object is invalidated by any @c dynamic_ring_buffer
+   * or @c ring_buffer member function that consumes bytes from the buffer.
+   */
+  mutable_buffers_type data(std::size_t pos, std::size_t n) noexcept
+  {
+    return mutable_buffers_type(asio::buffer(
+          asio::buffer(ring_.memory_.data() + ring_.start_,
+            (std::min)(ring_.size_, max_size_)) + pos, n));
+  }
+
+  /// @b DynamicBuffer_v2: Get a sequence of buffers that represents the
+  /// underlying memory.
+  /**
+   * @param pos Position of the first byte to represent in the buffer sequence
+   *
+   * @param n The number of bytes to return in the buffer sequence. If the
+   * underlying memory is shorter, the buffer sequence represents as many bytes
+   * as are available.
+   *
+   * @note The returned object is invalidated by any @c dynamic_ring_buffer
+   * or @c ring_buffer member function that consumes bytes from the buffer.
+   */
+  const_buffers_type data(std::size_t pos,
+      std::size_t n) const noexcept
+  {
+    return const_buffers_type(asio::buffer(
+          asio::buffer(ring_.memory_.data() + ring_.start_,
+            (std::min)(ring_.size_, max_size_)) + pos, n));
+  }
+
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+  /// @b DynamicBuffer_v1: Get a list of buffers that represents the output
+  /// sequence, with the given size.
+  /**
+   * Ensures that the output sequence can accommodate @c n bytes.
+   *
+   * @returns An object of type @c mutable_buffers_type that satisfies
+   * MutableBufferSequence requirements, representing ring buffer memory
+   * at the start of the output sequence of size @c n.
+   *
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   *
+   * @note The returned object is invalidated by any @c dynamic_ring_buffer
+   * or @c ring_buffer member function that modifies the input sequence or
+   * output sequence.
+   */
+  mutable_buffers_type prepare(std::size_t n)
+  {
+    if (size() > max_size() || max_size() - size() < n)
+    {
+      std::length_error ex("dynamic_ring_buffer too long");
+      asio::detail::throw_exception(ex);
+    }
+
+    if (size_ == (std::numeric_limits<std::size_t>::max)())
+      size_ = ring_.size_; // Enable v1 behaviour.
+
+    ring_.size_ = size_ + n;
+
+    return asio::buffer(ring_.memory_.data() + ring_.start_ + size_, n);
+  }
+
+  /// @b DynamicBuffer_v1: Move bytes from the output sequence to the input
+  /// sequence.
+  /**
+   * @param n The number of bytes to append from the start of the output
+   * sequence to the end of the input sequence. The remainder of the output
+   * sequence is discarded.
+   *
+   * Requires a preceding call <tt>prepare(x)</tt> where <tt>x >= n</tt>, and
+   * no intervening operations that modify the input or output sequence.
+   *
+   * @note If @c n is greater than the size of the output sequence, the entire
+   * output sequence is moved to the input sequence and no error is issued.
+   */
+  void commit(std::size_t n)
+  {
+    size_ += (std::min)(n, ring_.size_ - size_);
+    ring_.size_ = size_;
+  }
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+
+  /// @b DynamicBuffer_v2: Grow the underlying memory by the specified number of
+  /// bytes.
+  /**
+   * Extends the ring buffer by @c n bytes at the end. The contents of the new
+   * bytes are unspecified.
+   *
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   */
+  void grow(std::size_t n)
+  {
+    if (size() > max_size() || max_size() - size() < n)
+    {
+      std::length_error ex("dynamic_ring_buffer too long");
+      asio::detail::throw_exception(ex);
+    }
+
+    ring_.size_ = size() + n;
+  }
+
+  /// @b DynamicBuffer_v2: Shrink the underlying memory by the specified number
+  /// of bytes.
+  /**
+   * Removes @c n bytes from the end of the ring buffer. If @c n is greater
+   * than the current size of the ring buffer, the ring buffer is emptied.
+   */
+  void shrink(std::size_t n)
+  {
+    ring_.size_ = n > size() ? 0 : size() - n;
+    if (ring_.size_ == 0)
+      ring_.start_ = 0;
+  }
+
+  /// @b DynamicBuffer_v1: Remove characters from the input sequence.
+  /// @b DynamicBuffer_v2: Consume the specified number of bytes from the
+  /// beginning of the underlying memory.
+  /**
+   * @b DynamicBuffer_v1: Removes @c n characters from the beginning of the
+   * input sequence. @note If @c n is greater than the size of the input
+   * sequence, the entire input sequence is consumed and no error is issued.
+   *
+   * @b DynamicBuffer_v2: Removes @c n bytes from the beginning of the ring
+   * buffer. If @c n is greater than the current size of the ring buffer, the
+   * ring buffer is emptied.
+   *
+   * The bytes that remain are not moved.
+   */
+  void consume(std::size_t n)
+  {
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+    if (size_ != (std::numeric_limits<std::size_t>::max)())
+    {
+      std::size_t consume_length = (std::min)(n, size_);
+      ring_.consume(consume_length);
+      size_ -= consume_length;
+      return;
+    }
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+    ring_.consume((std::min)(n, ring_.size_));
+  }
+
+private:
+  ring_buffer& ring_;
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+  std::size_t size_;
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+  const std::size_t max_size_;
+};
+
+/** @addtogroup dynamic_buffer */
+/*@{*/
+
+/// Create a new dynamic buffer that represents the given ring buffer.
+/**
+ * @returns <tt>dynamic_ring_buffer(data)</tt>.
+ */
+ASIO_NODISCARD inline
+dynamic_ring_buffer dynamic_buffer(ring_buffer& data) noexcept
+{
+  return dynamic_ring_buffer(data);
+}
+
+/// Create a new dynamic buffer that represents the given ring buffer.
+/**
+ * @returns <tt>dynamic_ring_buffer(data, max_size)</tt>.
+ */
+ASIO_NODISCARD inline
+dynamic_ring_buffer dynamic_buffer(
+    ring_buffer& data, std::size_t max_size) noexcept
+{
+  return dynamic_ring_buffer(data, max_size);
+}
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_RING_BUFFER)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_RING_BUFFER_HPP
@@ -503,6 +503,53 @@ public:
     enable_connection_aborted;
 #endif
 
+  /// Socket option to create accepted sockets in their final state.
+  /**
+   * Implements a custom socket option that determines whether an acceptor
+   * creates accepted sockets as close-on-exec and, with the reactor-based
+   * backends, non-blocking. Where available, this is done atomically using
+   * @c accept4(). The reactor-based backends also adopt each accepted socket
+   * as one created by Asio, which saves a system call when the socket is first
+   * used for an asynchronous operation and another when it is closed. The
+   * @c io_uring backend leaves accepted sockets blocking, as its operations do
+   * not require non-blocking mode. By default the option is false.
+   *
+   * The option is intended for servers that accept connections at a high rate.
+   * Accepted sockets are not inherited by child processes that call @c exec(),
+   * and a socket's native handle must not be duplicated (for example, using
+   * @c dup()) while the socket remains open.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * asio::socket_base::fast_accept option(true);
+   * acceptor.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * asio::socket_base::fast_accept option;
+   * acceptor.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined fast_accept;
+#else
+  typedef asio::detail::socket_option::boolean<
+    asio::detail::custom_socket_option_level,
+    asio::detail::fast_accept_option>
+    fast_accept;
+#endif
+
   /// IO control command to get the amount of data that can be read without
   /// blocking.
   /**
@@ -0,0 +1,213 @@
+//
+// thread_policy.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_THREAD_POLICY_HPP
+#define ASIO_THREAD_POLICY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "asio/detail/type_traits.hpp"
+#include "asio/error_code.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Describes how to configure the threads that run an execution context.
+/**
+ * A thread policy names threads, pins them to CPUs, and binds their memory
+ * allocations to a NUMA node. It is applied by each thread to itself, before
+ * the thread starts running handlers. Memory that a thread allocates after
+ * the policy is applied, such as the per-thread caches used to recycle
+ * handler memory, is then local to the CPUs on which it runs.
+ *
+ * Threads are numbered from zero, and the number is used both to form the
+ * thread's name and to choose its CPU when each thread is pinned to its own
+ * CPU.
+ *
+ * @par Example
+ * Run a pool of eight threads, each of which may run on any CPU of NUMA
+ * node 1:
+ * @code asio::thread_policy policy;
+ * policy.set_name_prefix("pool-").set_numa_node(1);
+ * asio::thread_pool pool(8, policy); @endcode
+ *
+ * Run an io_context on threads created by the application:
+ * @code asio::thread_policy policy;
+ * policy.set_name_prefix("io-")
+ *   .set_cpus({2, 3}, asio::thread_policy::one_per_thread);
+ * std::thread t0(policy.bind(0, [&]{ io_context.run(); }));
+ * std::thread t1(policy.bind(1, [&]{ io_context.run(); })); @endcode
+ *
+ * @note Naming is supported on Linux and macOS, CPU affinity on Linux and
+ * Windows, and NUMA memory binding on Linux only. Elsewhere, apply() fails
+ * with asio::error::operation_not_supported.
+ */
+class thread_policy
+{
+public:
+  /// How threads are assigned to the CPUs given to set_cpus().
+  enum cpu_assignment
+  {
+    /// Every thread may run on any of the CPUs.
+    shared,
+
+    /// Each thread is pinned to a single CPU, chosen round robin by the
+    /// thread's number.
+    one_per_thread
+  };
+
+  /// Construct a policy that leaves threads unchanged.
+  thread_policy()
+    : assignment_(shared),
+      numa_node_(-1)
+  {
+  }
+
+  /// Set the prefix used to name threads.
+  /**
+   * Each thread is named with the prefix followed by its number. When a name
+   * exceeds the platform's limit, which is 15 characters on Linux, the prefix
+   * is truncated so that the number is kept.
+   */
+  thread_policy& set_name_prefix(const std::string& prefix)
+  {
+    name_prefix_ = prefix;
+    return *this;
+  }
+
+  /// Restrict threads to a set of CPUs.
+  thread_policy& set_cpus(const std::vector<int>& cpus,
+      cpu_assignment assignment = shared)
+  {
+    cpus_ = cpus;
+    assignment_ = assignment;
+    return *this;
+  }
+
+  /// Bind threads to a NUMA node.
+  /**
+   * Memory allocated by the threads is preferentially taken from the node. If
+   * no CPUs have been set using set_cpus(), the threads are also restricted
+   * to the node's CPUs.
+   */
+  thread_policy& set_numa_node(int node)
+  {
+    numa_node_ = node;
+    return *this;
+  }
+
+  /// Get the prefix used to name threads.
+  const std::string& name_prefix() const
+  {
+    return name_prefix_;
+  }
+
+  /// Get the CPUs to which threads are restricted.
+  const std::vector<int>& cpus() const
+  {
+    return cpus_;
+  }
+
+  /// Get how threads are assigned to CPUs.
+  cpu_assignment assignment() const
+  {
+    return assignment_;
+  }
+
+  /// Get the NUMA node to which threads are bound, or -1 if none.
+  int numa_node() const
+  {
+    return numa_node_;
+  }
+
+  /// Apply the policy to the calling thread.
+  /**
+   * @param index The number of the calling thread.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  ASIO_DECL void apply(std::size_t index) const;
+
+  /// Apply the policy to the calling thread.
+  /**
+   * @param index The number of the calling thread.
+   *
+   * @param ec Set to indicate what error occurred, if any. If the policy
+   * could be applied only in part, the remaining settings are still applied.
+   */
+  ASIO_DECL ASIO_SYNC_OP_VOID apply(std::size_t index,
+      asio::error_code& ec) const;
+
+  /// Function object that applies a policy before calling a function.
+  template <typename Function>
+  class bound_function;
+
+  /// Create a function object, suitable as a thread's entry point, that
+  /// applies the policy and then calls the given function.
+  template <typename Function>
+  bound_function<decay_t<Function>> bind(
+      std::size_t index, Function&& f) const
+  {
+    return bound_function<decay_t<Function>>(
+        *this, index, static_cast<Function&&>(f));
+  }
+
+private:
+  std::string name_prefix_;
+  std::vector<int> cpus_;
+  cpu_assignment assignment_;
+  int numa_node_;
+};
+
+/// Function object that applies a policy before calling a function.
+template <typename Function>
+class thread_policy::bound_function
+{
+public:
+  /// Constructor.
+  bound_function(const thread_policy& policy,
+      std::size_t index, Function f)
+    : policy_(policy),
+      index_(index),
+      function_(static_cast<Function&&>(f))
+  {
+  }
+
+  /// Apply the policy to the calling thread, ignoring errors, and then call
+  /// the function.
+  void operator()()
+  {
+    asio::error_code ec;
+    policy_.apply(index_, ec);
+    function_();
+  }
+
+private:
+  thread_policy policy_;
+  std::size_t index_;
+  Function function_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/thread_policy.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_THREAD_POLICY_HPP
@@ -0,0 +1,207 @@
+//
+// vm/detail/socket_option.hpp
+//
+
+#ifndef ASIO_VM_DETAIL_SOCKET_OPTION_HPP
+#define ASIO_VM_DETAIL_SOCKET_OPTION_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <asio/detail/config.hpp>
+
+#if defined(ASIO_HAS_VM_SOCKETS)
+
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <asio/detail/socket_types.hpp>
+#include <asio/detail/throw_exception.hpp>
+
+#include <asio/detail/push_options.hpp>
+
+namespace asio {
+namespace vm {
+namespace detail {
+namespace socket_option {
+
+// Helper template for implementing the VSOCK buffer size options, which take
+// a 64-bit unsigned value rather than an int.
+template <int Level, int Name>
+class buffer_size
+{
+public:
+  // Default constructor.
+  buffer_size()
+    : value_(0)
+  {
+  }
+
+  // Construct with a specific option value.
+  explicit buffer_size(unsigned long long v)
+    : value_(v)
+  {
+  }
+
+  // Set the value of the option.
+  buffer_size& operator=(unsigned long long v)
+  {
+    value_ = v;
+    return *this;
+  }
+
+  // Get the current value of the option.
+  unsigned long long value() const
+  {
+    return value_;
+  }
+
+  // Get the level of the socket option.
+  template <typename Protocol>
+  int level(const Protocol&) const
+  {
+    return Level;
+  }
+
+  // Get the name of the socket option.
+  template <typename Protocol>
+  int name(const Protocol&) const
+  {
+    return Name;
+  }
+
+  // Get the address of the option data.
+  template <typename Protocol>
+  unsigned long long* data(const Protocol&)
+  {
+    return &value_;
+  }
+
+  // Get the address of the option data.
+  template <typename Protocol>
+  const unsigned long long* data(const Protocol&) const
+  {
+    return &value_;
+  }
+
+  // Get the size of the option data.
+  template <typename Protocol>
+  std::size_t size(const Protocol&) const
+  {
+    return sizeof(value_);
+  }
+
+  // Set the size of the option data.
+  template <typename Protocol>
+  void resize(const Protocol&, std::size_t s)
+  {
+    if (s != sizeof(value_))
+    {
+      std::length_error ex("buffer_size socket option resize");
+      asio::detail::throw_exception(ex);
+    }
+  }
+
+private:
+  unsigned long long value_;
+};
+
+// Helper template for implementing timeout options, which are passed to the
+// kernel as a timeval.
+template <int Level, int Name>
+class timeout
+{
+public:
+  // Default constructor.
+  timeout()
+  {
+    value_.tv_sec = 0;
+    value_.tv_usec = 0;
+  }
+
+  // Construct with a specific option value.
+  template <typename Rep, typename Period>
+  explicit timeout(const std::chrono::duration<Rep, Period>& d)
+  {
+    *this = d;
+  }
+
+  // Set the value of the option.
+  template <typename Rep, typename Period>
+  timeout& operator=(const std::chrono::duration<Rep, Period>& d)
+  {
+    std::chrono::microseconds us =
+      std::chrono::duration_cast<std::chrono::microseconds>(d);
+    value_.tv_sec = static_cast<time_t>(us.count() / 1000000);
+    value_.tv_usec = static_cast<suseconds_t>(us.count() % 1000000);
+    return *this;
+  }
+
+  // Get the current value of the option.
+  std::chrono::microseconds value() const
+  {
+    return std::chrono::seconds(value_.tv_sec)
+      + std::chrono::microseconds(value_.tv_usec);
+  }
+
+  // Get the level of the socket option.
+  template <typename Protocol>
+  int level(const Protocol&) const
+  {
+    return Level;
+  }
+
+  // Get the name of the socket option.
+  template <typename Protocol>
+  int name(const Protocol&) const
+  {
+    return Name;
+  }
+
+  // Get the address of the option data.
+  template <typename Protocol>
+  timeval* data(const Protocol&)
+  {
+    return &value_;
+  }
+
+  // Get the address of the option data.
+  template <typename Protocol>
+  const timeval* data(const Protocol&) const
+  {
+    return &value_;
+  }
+
+  // Get the size of the option data.
+  template <typename Protocol>
+  std::size_t size(const Protocol&) const
+  {
+    return sizeof(value_);
+  }
+
+  // Set the size of the option data.
+  template <typename Protocol>
+  void resize(const Protocol&, std::size_t s)
+  {
+    if (s != sizeof(value_))
+    {
+      std::length_error ex("timeout socket option resize");
+      asio::detail::throw_exception(ex);
+    }
+  }
+
+private:
+  timeval value_;
+};
+
+} // namespace socket_option
+} // namespace detail
+} // namespace vm
+} // namespace asio
+
+#include <asio/detail/pop_options.hpp>
+
+#endif // defined(ASIO_HAS_VM_SOCKETS)
+
+#endif // ASIO_VM_DETAIL_SOCKET_OPTION_HPP
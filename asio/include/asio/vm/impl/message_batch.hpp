@@ -0,0 +1,191 @@
+//
+// vm/impl/message_batch.hpp
+//
+
+#ifndef ASIO_VM_IMPL_MESSAGE_BATCH_HPP
+#define ASIO_VM_IMPL_MESSAGE_BATCH_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cerrno>
+#include <asio/compose.hpp>
+#include <asio/detail/non_blocking_io_op.hpp>
+#include <asio/detail/throw_error.hpp>
+
+#include <asio/detail/push_options.hpp>
+
+namespace asio {
+namespace vm {
+namespace detail {
+
+class message_batch_receiver
+{
+public:
+  // Receive into the batch using a single call to recvmmsg().
+  static std::size_t receive(asio::detail::socket_type s,
+      message_batch& batch, int flags, asio::error_code& ec)
+  {
+    batch.size_ = 0;
+    for (std::size_t i = 0; i < batch.headers_.size(); ++i)
+    {
+      iovec& iov = batch.iovecs_[i];
+      iov.iov_base = batch.storage_.data() + i * batch.max_message_size_;
+      iov.iov_len = batch.max_message_size_;
+
+      mmsghdr& header = batch.headers_[i];
+      header = mmsghdr();
+      header.msg_hdr.msg_iov = &iov;
+      header.msg_hdr.msg_iovlen = 1;
+    }
+
+    int result = ::recvmmsg(s, batch.headers_.data(),
+        static_cast<unsigned int>(batch.headers_.size()), flags, 0);
+    if (result < 0)
+    {
+      ec = asio::error_code(errno, asio::error::get_system_category());
+      return 0;
+    }
+
+    // Every complete VSOCK message is marked with MSG_EOR, so an empty read
+    // without it indicates that the peer has shut down the connection. Any
+    // messages received before that point are returned first.
+    std::size_t count = 0;
+    while (count < static_cast<std::size_t>(result)
+        && (batch.headers_[count].msg_len != 0
+          || (batch.headers_[count].msg_hdr.msg_flags & MSG_EOR) != 0))
+      ++count;
+    if (count == 0)
+    {
+      ec = asio::error::eof;
+      return 0;
+    }
+
+    ec = asio::error_code();
+    batch.size_ = count;
+    return batch.size_;
+  }
+};
+
+template <typename Socket>
+class receive_batch_op
+{
+public:
+  receive_batch_op(Socket& socket, message_batch& batch)
+    : socket_(socket),
+      batch_(batch),
+      bytes_transferred_(0)
+  {
+  }
+
+  bool perform(asio::error_code& ec, socket_base::wait_type& wait)
+  {
+    for (;;)
+    {
+      bytes_transferred_ = message_batch_receiver::receive(
+          socket_.native_handle(), batch_, MSG_DONTWAIT, ec);
+      if (ec == asio::error::interrupted)
+        continue;
+      if (ec != asio::error::would_block)
+        return true;
+      wait = socket_base::wait_read;
+      return false;
+    }
+  }
+
+  std::size_t bytes_transferred() const
+  {
+    return bytes_transferred_;
+  }
+
+private:
+  Socket& socket_;
+  message_batch& batch_;
+  std::size_t bytes_transferred_;
+};
+
+template <typename Socket>
+class initiate_async_receive_batch
+{
+public:
+  typedef typename Socket::executor_type executor_type;
+
+  explicit initiate_async_receive_batch(Socket& socket)
+    : socket_(socket)
+  {
+  }
+
+  executor_type get_executor() const ASIO_NOEXCEPT
+  {
+    return socket_.get_executor();
+  }
+
+  template <typename ReadHandler>
+  void operator()(ReadHandler&& handler, message_batch* batch) const
+  {
+    asio::async_compose<ReadHandler, void (asio::error_code, std::size_t)>(
+        asio::detail::non_blocking_io_op<Socket, receive_batch_op<Socket>>(
+          socket_, receive_batch_op<Socket>(socket_, *batch)),
+        handler, socket_);
+  }
+
+private:
+  Socket& socket_;
+};
+
+} // namespace detail
+
+template <typename Protocol, typename Executor>
+std::size_t receive_batch(basic_seq_packet_socket<Protocol, Executor>& s,
+    message_batch& batch)
+{
+  asio::error_code ec;
+  std::size_t n = receive_batch(s, batch, ec);
+  asio::detail::throw_error(ec, "receive_batch");
+  return n;
+}
+
+template <typename Protocol, typename Executor>
+std::size_t receive_batch(basic_seq_packet_socket<Protocol, Executor>& s,
+    message_batch& batch, asio::error_code& ec)
+{
+  for (;;)
+  {
+    std::size_t n = detail::message_batch_receiver::receive(
+        s.native_handle(), batch, MSG_WAITFORONE, ec);
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // The descriptor is made non-blocking internally once an asynchronous
+    // operation has been started on the socket. Unless the user asked for
+    // non-blocking behaviour, wait for a message to arrive.
+    if (ec != asio::error::would_block || s.non_blocking())
+      return n;
+    s.wait(socket_base::wait_read, ec);
+    if (ec)
+      return 0;
+  }
+}
+
+template <typename Protocol, typename Executor,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) ReadToken>
+inline auto async_receive_batch(basic_seq_packet_socket<Protocol, Executor>& s,
+    message_batch& batch, ReadToken&& token)
+  -> decltype(
+    async_initiate<ReadToken, void (asio::error_code, std::size_t)>(
+      declval<detail::initiate_async_receive_batch<
+        basic_seq_packet_socket<Protocol, Executor>>>(), token, &batch))
+{
+  return async_initiate<ReadToken, void (asio::error_code, std::size_t)>(
+      detail::initiate_async_receive_batch<
+        basic_seq_packet_socket<Protocol, Executor>>(s), token, &batch);
+}
+
+} // namespace vm
+} // namespace asio
+
+#include <asio/detail/pop_options.hpp>
+
+#endif // ASIO_VM_IMPL_MESSAGE_BATCH_HPP
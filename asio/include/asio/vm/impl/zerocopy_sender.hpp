@@ -0,0 +1,207 @@
+//
+// vm/impl/zerocopy_sender.hpp
+//
+
+#ifndef ASIO_VM_IMPL_ZEROCOPY_SENDER_HPP
+#define ASIO_VM_IMPL_ZEROCOPY_SENDER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cerrno>
+#include <linux/errqueue.h>
+#include <asio/compose.hpp>
+#include <asio/detail/buffer_sequence_adapter.hpp>
+#include <asio/detail/consuming_buffers.hpp>
+#include <asio/detail/non_blocking_io_op.hpp>
+
+#include <asio/detail/push_options.hpp>
+
+namespace asio {
+namespace vm {
+namespace detail {
+
+template <typename Executor, typename ConstBufferSequence>
+class zerocopy_send_op
+{
+public:
+  zerocopy_send_op(basic_zerocopy_sender<Executor>& sender,
+      const ConstBufferSequence& buffers)
+    : sender_(sender),
+      buffers_(buffers)
+  {
+  }
+
+  bool perform(asio::error_code& ec, socket_base::wait_type& wait)
+  {
+    while (!buffers_.empty())
+    {
+      std::size_t n = sender_.send_some(
+          buffers_.prepare(default_max_transfer_size), ec);
+      if (ec == asio::error::would_block)
+      {
+        wait = socket_base::wait_write;
+        return false;
+      }
+      else if (ec == asio::error::no_buffer_space)
+      {
+        // Too many sends are awaiting completion. Wait for the kernel to
+        // release some of them before trying again.
+        sender_.reap_notifications(ec);
+        if (ec)
+          return true;
+        wait = sender_.outstanding() > 0
+          ? socket_base::wait_error : socket_base::wait_write;
+        return false;
+      }
+      else if (ec == asio::error::interrupted)
+        continue;
+      else if (ec)
+        return true;
+
+      buffers_.consume(n);
+    }
+
+    // Everything has been sent. Wait until the kernel no longer refers to any
+    // of the buffers.
+    sender_.reap_notifications(ec);
+    if (!ec && sender_.outstanding() > 0)
+    {
+      wait = socket_base::wait_error;
+      return false;
+    }
+
+    return true;
+  }
+
+  std::size_t bytes_transferred() const
+  {
+    return buffers_.total_consumed();
+  }
+
+private:
+  enum { default_max_transfer_size = 65536 * 16 };
+
+  basic_zerocopy_sender<Executor>& sender_;
+  asio::detail::consuming_buffers<const_buffer, ConstBufferSequence,
+    decltype(asio::buffer_sequence_begin(
+      declval<const ConstBufferSequence&>()))> buffers_;
+};
+
+template <typename Executor>
+class initiate_async_zerocopy_send
+{
+public:
+  typedef Executor executor_type;
+
+  explicit initiate_async_zerocopy_send(basic_zerocopy_sender<Executor>& sender)
+    : sender_(sender)
+  {
+  }
+
+  executor_type get_executor() const ASIO_NOEXCEPT
+  {
+    return sender_.socket().get_executor();
+  }
+
+  template <typename WriteHandler, typename ConstBufferSequence>
+  void operator()(WriteHandler&& handler,
+      const ConstBufferSequence& buffers) const
+  {
+    typedef typename basic_zerocopy_sender<Executor>::socket_type socket_type;
+    typedef zerocopy_send_op<Executor, ConstBufferSequence> op_type;
+
+    asio::async_compose<WriteHandler, void (asio::error_code, std::size_t)>(
+        asio::detail::non_blocking_io_op<socket_type, op_type>(
+          sender_.socket(), op_type(sender_, buffers)),
+        handler, sender_.socket());
+  }
+
+private:
+  basic_zerocopy_sender<Executor>& sender_;
+};
+
+} // namespace detail
+
+template <typename Executor>
+template <typename ConstBufferSequence>
+std::size_t basic_zerocopy_sender<Executor>::send_some(
+    const ConstBufferSequence& buffers, asio::error_code& ec)
+{
+  asio::detail::buffer_sequence_adapter<const_buffer,
+    ConstBufferSequence> bufs(buffers);
+
+  msghdr msg = msghdr();
+  msg.msg_iov = bufs.buffers();
+  msg.msg_iovlen = bufs.count();
+
+  int flags = MSG_DONTWAIT | MSG_NOSIGNAL | (enabled_ ? MSG_ZEROCOPY : 0);
+  ssize_t result = ::sendmsg(socket_.native_handle(), &msg, flags);
+  if (result < 0)
+  {
+    ec = asio::error_code(errno, asio::error::get_system_category());
+    return 0;
+  }
+
+  // The kernel numbers each successful zero-copy send, starting from zero.
+  if (enabled_ && result > 0)
+    ++next_id_;
+
+  ec = asio::error_code();
+  return static_cast<std::size_t>(result);
+}
+
+template <typename Executor>
+void basic_zerocopy_sender<Executor>::reap_notifications(
+    asio::error_code& ec)
+{
+  ec = asio::error_code();
+  while (outstanding() > 0)
+  {
+    union
+    {
+      cmsghdr header;
+      char buffer[CMSG_SPACE(sizeof(sock_extended_err)) * 4];
+    } control;
+
+    msghdr msg = msghdr();
+    msg.msg_control = control.buffer;
+    msg.msg_controllen = sizeof(control.buffer);
+
+    if (::recvmsg(socket_.native_handle(), &msg,
+          MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      if (errno != EAGAIN && errno != EWOULDBLOCK)
+        ec = asio::error_code(errno, asio::error::get_system_category());
+      return;
+    }
+
+    // Each notification covers the inclusive range of send identifiers
+    // [ee_info, ee_data].
+    for (cmsghdr* c = CMSG_FIRSTHDR(&msg); c; c = CMSG_NXTHDR(&msg, c))
+    {
+      if (c->cmsg_len < CMSG_LEN(sizeof(sock_extended_err)))
+        continue;
+
+      const sock_extended_err* err =
+        reinterpret_cast<const sock_extended_err*>(CMSG_DATA(c));
+      if (err->ee_errno != 0 || err->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+        continue;
+
+      uint32_t count = err->ee_data - err->ee_info + 1;
+      completed_ += count;
+      if (err->ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+        copied_ += count;
+    }
+  }
+}
+
+} // namespace vm
+} // namespace asio
+
+#include <asio/detail/pop_options.hpp>
+
+#endif // ASIO_VM_IMPL_ZEROCOPY_SENDER_HPP
@@ -0,0 +1,204 @@
+//
+// vm/message_batch.hpp
+//
+
+#ifndef ASIO_VM_MESSAGE_BATCH_HPP
+#define ASIO_VM_MESSAGE_BATCH_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <asio/detail/config.hpp>
+
+#if defined(ASIO_HAS_VM_SOCKETS)
+
+#include <cstddef>
+#include <vector>
+#include <asio/async_result.hpp>
+#include <asio/basic_seq_packet_socket.hpp>
+#include <asio/buffer.hpp>
+#include <asio/detail/socket_types.hpp>
+#include <asio/error.hpp>
+
+#include <asio/detail/push_options.hpp>
+
+namespace asio {
+namespace vm {
+namespace detail {
+
+class message_batch_receiver;
+template <typename Socket> class initiate_async_receive_batch;
+
+} // namespace detail
+
+/// Storage for a batch of messages received with a single system call.
+/**
+ * The asio::vm::message_batch class owns the buffers into which
+ * asio::vm::receive_batch and asio::vm::async_receive_batch place messages,
+ * and records the size of each message received. The buffers are allocated
+ * once, when the batch is constructed, and reused by every receive.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code asio::vm::seqpacket_protocol::socket socket(my_io_context);
+ * ...
+ * asio::vm::message_batch batch(64, 4096);
+ * std::size_t n = asio::vm::receive_batch(socket, batch);
+ * for (std::size_t i = 0; i < n; ++i)
+ *   handle_message(batch[i]); @endcode
+ */
+class message_batch
+{
+public:
+  /// Construct a batch that can receive up to @c max_messages messages, each
+  /// of up to @c max_message_size bytes.
+  message_batch(std::size_t max_messages, std::size_t max_message_size)
+    : storage_(max_messages * max_message_size),
+      headers_(max_messages),
+      iovecs_(max_messages),
+      max_message_size_(max_message_size),
+      size_(0)
+  {
+  }
+
+  /// Get the maximum number of messages that may be received in one batch.
+  std::size_t capacity() const ASIO_NOEXCEPT
+  {
+    return headers_.size();
+  }
+
+  /// Get the size of the buffer provided for each message.
+  std::size_t max_message_size() const ASIO_NOEXCEPT
+  {
+    return max_message_size_;
+  }
+
+  /// Get the number of messages received by the last receive operation.
+  std::size_t size() const ASIO_NOEXCEPT
+  {
+    return size_;
+  }
+
+  /// Determine whether the last receive operation received no messages.
+  bool empty() const ASIO_NOEXCEPT
+  {
+    return size_ == 0;
+  }
+
+  /// Get the contents of a received message.
+  const_buffer operator[](std::size_t i) const ASIO_NOEXCEPT
+  {
+    std::size_t length = headers_[i].msg_len;
+    if (length > max_message_size_)
+      length = max_message_size_;
+    return const_buffer(storage_.data() + i * max_message_size_, length);
+  }
+
+  /// Determine whether a received message was larger than the buffer provided
+  /// for it, in which case the excess bytes were discarded.
+  bool truncated(std::size_t i) const ASIO_NOEXCEPT
+  {
+    return (headers_[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+  }
+
+private:
+  friend class detail::message_batch_receiver;
+
+  std::vector<unsigned char> storage_;
+  std::vector<mmsghdr> headers_;
+  std::vector<iovec> iovecs_;
+  std::size_t max_message_size_;
+  std::size_t size_;
+};
+
+/// Receive a batch of messages on a sequenced packet socket.
+/**
+ * This function is used to receive as many messages as are immediately
+ * available, up to the capacity of the batch, using a single system call. The
+ * function call will block until at least one message has been received or
+ * an error occurs.
+ *
+ * @param s The socket on which the messages are to be received.
+ *
+ * @param batch The batch into which the messages will be received.
+ *
+ * @returns The number of messages received.
+ *
+ * @throws asio::system_error Thrown on failure.
+ */
+template <typename Protocol, typename Executor>
+std::size_t receive_batch(basic_seq_packet_socket<Protocol, Executor>& s,
+    message_batch& batch);
+
+/// Receive a batch of messages on a sequenced packet socket.
+/**
+ * This function is used to receive as many messages as are immediately
+ * available, up to the capacity of the batch, using a single system call. The
+ * function call will block until at least one message has been received or
+ * an error occurs.
+ *
+ * @param s The socket on which the messages are to be received.
+ *
+ * @param batch The batch into which the messages will be received.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ *
+ * @returns The number of messages received. Returns 0 if an error occurred.
+ */
+template <typename Protocol, typename Executor>
+std::size_t receive_batch(basic_seq_packet_socket<Protocol, Executor>& s,
+    message_batch& batch, asio::error_code& ec);
+
+/// Start an asynchronous operation to receive a batch of messages on a
+/// sequenced packet socket.
+/**
+ * This function is used to asynchronously receive as many messages as are
+ * available, up to the capacity of the batch, using a single system call.
+ * Messages that are already queued are received immediately. Otherwise, the
+ * operation waits for the socket to become readable.
+ *
+ * @param s The socket on which the messages are to be received. The socket
+ * and the batch must remain valid until the completion handler is called.
+ *
+ * @param batch The batch into which the messages will be received.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the receive completes. The
+ * function signature of the completion handler must be:
+ * @code void handler(
+ *   const asio::error_code& error, // Result of operation.
+ *   std::size_t messages // Number of messages received.
+ * ); @endcode
+ *
+ * @par Completion Signature
+ * @code void(asio::error_code, std::size_t) @endcode
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the same types as the
+ * socket's @c async_wait function.
+ */
+template <typename Protocol, typename Executor,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) ReadToken = default_completion_token_t<Executor>>
+auto async_receive_batch(basic_seq_packet_socket<Protocol, Executor>& s,
+    message_batch& batch,
+    ReadToken&& token = default_completion_token_t<Executor>())
+  -> decltype(
+    async_initiate<ReadToken, void (asio::error_code, std::size_t)>(
+      declval<detail::initiate_async_receive_batch<
+        basic_seq_packet_socket<Protocol, Executor>>>(), token, &batch));
+
+} // namespace vm
+} // namespace asio
+
+#include <asio/detail/pop_options.hpp>
+
+#include <asio/vm/impl/message_batch.hpp>
+
+#endif // defined(ASIO_HAS_VM_SOCKETS)
+
+#endif // ASIO_VM_MESSAGE_BATCH_HPP
@@ -0,0 +1,83 @@
+//
+// vm/seqpacket_protocol.hpp
+//
+
+#ifndef ASIO_VM_SEQPACKET_PROTOCOL_HPP
+#define ASIO_VM_SEQPACKET_PROTOCOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <asio/detail/config.hpp>
+
+#if defined(ASIO_HAS_VM_SOCKETS)
+
+#include <asio/basic_seq_packet_socket.hpp>
+#include <asio/basic_socket_acceptor.hpp>
+#include <asio/detail/socket_types.hpp>
+#include <asio/vm/basic_endpoint.hpp>
+#include <asio/vm/cid.hpp>
+
+#include <asio/detail/push_options.hpp>
+
+namespace asio {
+namespace vm {
+
+/// Encapsulates the flags needed for sequenced packet VSOCK sockets.
+/**
+ * The asio::vm::seqpacket_protocol class contains flags necessary for
+ * connection-oriented VSOCK sockets that preserve message boundaries. Each
+ * call to @c send transmits one message, and each call to @c receive returns
+ * at most one message, so no framing is needed on top of the socket.
+ *
+ * Sequenced packet VSOCK sockets require Linux 5.14 or later. Several
+ * messages may be received with a single system call using
+ * asio::vm::receive_batch.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * @par Concepts:
+ * Protocol.
+ */
+class seqpacket_protocol
+{
+public:
+  /// Obtain an identifier for the type of the protocol.
+  int type() const ASIO_NOEXCEPT
+  {
+    return SOCK_SEQPACKET;
+  }
+
+  /// Obtain an identifier for the protocol.
+  int protocol() const ASIO_NOEXCEPT
+  {
+    return 0;
+  }
+
+  /// Obtain an identifier for the protocol family.
+  int family() const ASIO_NOEXCEPT
+  {
+    return AF_VSOCK;
+  }
+
+  /// The type of a VSOCK endpoint.
+  typedef basic_endpoint<seqpacket_protocol> endpoint;
+
+  /// The VSOCK socket type.
+  typedef basic_seq_packet_socket<seqpacket_protocol> socket;
+
+  /// The VSOCK acceptor type.
+  typedef basic_socket_acceptor<seqpacket_protocol> acceptor;
+};
+
+} // namespace vm
+} // namespace asio
+
+#include <asio/detail/pop_options.hpp>
+
+#endif // defined(ASIO_HAS_VM_SOCKETS)
+
+#endif // ASIO_VM_SEQPACKET_PROTOCOL_HPP
\ No newline at end of file
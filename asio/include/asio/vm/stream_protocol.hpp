@@ -16,9 +16,11 @@
 #include <asio/basic_socket_acceptor.hpp>
 #include <asio/basic_socket_iostream.hpp>
 #include <asio/basic_stream_socket.hpp>
+#include <asio/detail/socket_option.hpp>
 #include <asio/detail/socket_types.hpp>
 #include <asio/vm/basic_endpoint.hpp>
 #include <asio/vm/cid.hpp>
+#include <asio/vm/detail/socket_option.hpp>
 
 #include <asio/detail/push_options.hpp>
 
@@ -71,6 +73,114 @@ public:
   /// The VSOCK iostream type.
   typedef basic_socket_iostream<stream_protocol> iostream;
 #endif // !defined(ASIO_NO_IOSTREAM)
+
+  /// Socket option for the size of the transport buffer.
+  /**
+   * Implements the AF_VSOCK/SO_VM_SOCKETS_BUFFER_SIZE socket option. The
+   * transport buffer limits the amount of data in flight on a connection, and
+   * defaults to 256 KB. Values are clamped by the kernel to the range given
+   * by min_buffer_size and max_buffer_size, so raise max_buffer_size first.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::vm::stream_protocol::socket socket(my_context);
+   * ...
+   * asio::vm::stream_protocol::max_buffer_size max_option(4 * 1024 * 1024);
+   * socket.set_option(max_option);
+   * asio::vm::stream_protocol::buffer_size option(4 * 1024 * 1024);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::vm::stream_protocol::socket socket(my_context);
+   * ...
+   * asio::vm::stream_protocol::buffer_size option;
+   * socket.get_option(option);
+   * unsigned long long size = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined buffer_size;
+#else
+  typedef asio::vm::detail::socket_option::buffer_size<
+    AF_VSOCK, SO_VM_SOCKETS_BUFFER_SIZE> buffer_size;
+#endif
+
+  /// Socket option for the minimum size of the transport buffer.
+  /**
+   * Implements the AF_VSOCK/SO_VM_SOCKETS_BUFFER_MIN_SIZE socket option.
+   *
+   * @par Concepts:
+   * Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined min_buffer_size;
+#else
+  typedef asio::vm::detail::socket_option::buffer_size<
+    AF_VSOCK, SO_VM_SOCKETS_BUFFER_MIN_SIZE> min_buffer_size;
+#endif
+
+  /// Socket option for the maximum size of the transport buffer.
+  /**
+   * Implements the AF_VSOCK/SO_VM_SOCKETS_BUFFER_MAX_SIZE socket option.
+   *
+   * @par Concepts:
+   * Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined max_buffer_size;
+#else
+  typedef asio::vm::detail::socket_option::buffer_size<
+    AF_VSOCK, SO_VM_SOCKETS_BUFFER_MAX_SIZE> max_buffer_size;
+#endif
+
+  /// Socket option for the time allowed for a connection to be established.
+  /**
+   * Implements the AF_VSOCK/SO_VM_SOCKETS_CONNECT_TIMEOUT socket option.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::vm::stream_protocol::socket socket(my_context);
+   * ...
+   * asio::vm::stream_protocol::connect_timeout option(
+   *     std::chrono::seconds(5));
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined connect_timeout;
+#else
+  typedef asio::vm::detail::socket_option::timeout<
+    AF_VSOCK, SO_VM_SOCKETS_CONNECT_TIMEOUT> connect_timeout;
+#endif
+
+#if defined(SO_ZEROCOPY) || defined(GENERATING_DOCUMENTATION)
+  /// Socket option to permit zero-copy sends.
+  /**
+   * Implements the SOL_SOCKET/SO_ZEROCOPY socket option, which must be
+   * enabled before MSG_ZEROCOPY sends are made. See
+   * asio::vm::zerocopy_sender.
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined zerocopy;
+#else
+  typedef asio::detail::socket_option::boolean<
+    SOL_SOCKET, SO_ZEROCOPY> zerocopy;
+#endif
+#endif // defined(SO_ZEROCOPY) || defined(GENERATING_DOCUMENTATION)
 };
 
 } // namespace vm
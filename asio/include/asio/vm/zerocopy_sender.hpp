@@ -0,0 +1,206 @@
+//
+// vm/zerocopy_sender.hpp
+//
+
+#ifndef ASIO_VM_ZEROCOPY_SENDER_HPP
+#define ASIO_VM_ZEROCOPY_SENDER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <asio/detail/config.hpp>
+
+#if defined(ASIO_HAS_VM_SOCKETS)
+
+#include <asio/detail/socket_types.hpp>
+
+#if defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+
+#include <cstddef>
+#include <asio/any_io_executor.hpp>
+#include <asio/async_result.hpp>
+#include <asio/basic_stream_socket.hpp>
+#include <asio/detail/cstdint.hpp>
+#include <asio/error.hpp>
+#include <asio/vm/stream_protocol.hpp>
+
+#include <asio/detail/push_options.hpp>
+
+namespace asio {
+namespace vm {
+namespace detail {
+
+template <typename Executor, typename ConstBufferSequence>
+class zerocopy_send_op;
+
+template <typename Executor>
+class initiate_async_zerocopy_send;
+
+} // namespace detail
+
+/// Sends data on a VSOCK stream socket without copying it into the kernel.
+/**
+ * The asio::vm::basic_zerocopy_sender class template sends data using
+ * MSG_ZEROCOPY, so that the kernel transmits directly from the caller's
+ * buffers. Because the kernel continues to reference the buffers after the
+ * send call returns, an asynchronous send does not complete until the kernel
+ * has notified, through the socket's error queue, that it has finished with
+ * them. The buffers may then be reused or freed.
+ *
+ * Zero-copy transmission on VSOCK sockets requires a Linux 6.7 or later
+ * virtio transport. If the SO_ZEROCOPY socket option cannot be enabled, the
+ * sender falls back to ordinary sends with the same completion semantics.
+ * Zero-copy pays off for large sends; for small writes the cost of pinning
+ * pages and reaping notifications outweighs the saved copy.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * The program must ensure that no other send or write operation is performed
+ * on the socket, and that only one async_send() is outstanding on the sender,
+ * until the operation completes.
+ *
+ * @par Example
+ * @code asio::vm::stream_protocol::socket socket(my_io_context);
+ * socket.connect(endpoint);
+ * asio::vm::zerocopy_sender sender(socket);
+ * sender.async_send(asio::buffer(image_chunk),
+ *     [](asio::error_code ec, std::size_t n)
+ *     {
+ *       // The chunk may now be reused.
+ *     }); @endcode
+ */
+template <typename Executor = any_io_executor>
+class basic_zerocopy_sender
+{
+public:
+  /// The type of the socket used by the sender.
+  typedef basic_stream_socket<stream_protocol, Executor> socket_type;
+
+  /// Construct a sender for an open socket, enabling SO_ZEROCOPY on it.
+  explicit basic_zerocopy_sender(socket_type& socket)
+    : socket_(socket),
+      enabled_(false),
+      next_id_(0),
+      completed_(0),
+      copied_(0)
+  {
+    asio::error_code ec;
+    socket_.set_option(stream_protocol::zerocopy(true), ec);
+    enabled_ = !ec;
+  }
+
+  /// Get the socket used by the sender.
+  socket_type& socket() ASIO_NOEXCEPT
+  {
+    return socket_;
+  }
+
+  /// Determine whether zero-copy sends are enabled on the socket.
+  bool zerocopy_enabled() const ASIO_NOEXCEPT
+  {
+    return enabled_;
+  }
+
+  /// Get the number of zero-copy sends whose completions are still pending.
+  std::size_t outstanding() const ASIO_NOEXCEPT
+  {
+    return static_cast<std::size_t>(next_id_ - completed_);
+  }
+
+  /// Get the number of sends for which the kernel copied the data after all.
+  /**
+   * The kernel may fall back to copying, for example when the transport does
+   * not support zero-copy transmission. A count close to the number of sends
+   * suggests that zero-copy should be disabled for the connection.
+   */
+  std::size_t copied_sends() const ASIO_NOEXCEPT
+  {
+    return copied_;
+  }
+
+  /// Start an asynchronous operation to send all of the supplied data.
+  /**
+   * This function is used to asynchronously send all of the data in the
+   * supplied buffers. The operation completes once all of the data has been
+   * sent and the kernel no longer refers to the buffers.
+   *
+   * @param buffers One or more buffers containing the data to be sent.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid, and unmodified, until the completion handler is
+   * called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the send completes. The
+   * function signature of the completion handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes sent.
+   * ); @endcode
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::size_t) @endcode
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<Executor>>
+  auto async_send(const ConstBufferSequence& buffers,
+      WriteToken&& token = default_completion_token_t<Executor>())
+    -> decltype(
+      async_initiate<WriteToken, void (asio::error_code, std::size_t)>(
+        declval<detail::initiate_async_zerocopy_send<Executor>>(),
+        token, buffers))
+  {
+    return async_initiate<WriteToken, void (asio::error_code, std::size_t)>(
+        detail::initiate_async_zerocopy_send<Executor>(*this),
+        token, buffers);
+  }
+
+private:
+  template <typename, typename> friend class detail::zerocopy_send_op;
+
+  basic_zerocopy_sender(const basic_zerocopy_sender&) = delete;
+  basic_zerocopy_sender& operator=(const basic_zerocopy_sender&) = delete;
+
+  // Make a single non-blocking send call.
+  template <typename ConstBufferSequence>
+  std::size_t send_some(const ConstBufferSequence& buffers,
+      asio::error_code& ec);
+
+  // Consume all pending completion notifications from the error queue.
+  void reap_notifications(asio::error_code& ec);
+
+  // The socket used to send the data.
+  socket_type& socket_;
+
+  // Whether SO_ZEROCOPY was enabled on the socket.
+  bool enabled_;
+
+  // The identifier that the kernel will assign to the next zero-copy send.
+  uint32_t next_id_;
+
+  // The number of zero-copy sends that the kernel has finished with.
+  uint32_t completed_;
+
+  // The number of sends for which the kernel fell back to copying.
+  std::size_t copied_;
+};
+
+/// A zero-copy sender for a VSOCK stream socket using the default executor.
+typedef basic_zerocopy_sender<> zerocopy_sender;
+
+} // namespace vm
+} // namespace asio
+
+#include <asio/detail/pop_options.hpp>
+
+#include <asio/vm/impl/zerocopy_sender.hpp>
+
+#endif // defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+
+#endif // defined(ASIO_HAS_VM_SOCKETS)
+
+#endif // ASIO_VM_ZEROCOPY_SENDER_HPP
@@ -0,0 +1,205 @@
+//
+// work_stealing_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_WORK_STEALING_POOL_HPP
+#define ASIO_WORK_STEALING_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/thread_group.hpp"
+#include "asio/detail/thread_pool_executor.hpp"
+#include "asio/detail/work_stealing_scheduler.hpp"
+#include "asio/execution.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/thread_policy.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A fixed-size thread pool that balances work between its threads by work
+/// stealing.
+/**
+ * The work stealing pool class is an execution context intended for CPU-bound
+ * work, such as compression or parsing, that is forked from I/O handlers or
+ * from other work in the pool. Unlike @ref thread_pool, which shares a single
+ * queue between its threads, each thread in the pool has its own deque:
+ *
+ * @li Functions submitted from a thread in the pool are pushed on to that
+ * thread's deque, and the thread runs them in last-in, first-out order.
+ *
+ * @li A thread that has run out of work steals from the other end of another
+ * thread's deque, taking the oldest function first.
+ *
+ * @li Functions submitted from outside the pool are placed on a shared queue.
+ *
+ * A function submitted with the @c relationship.continuation property (for
+ * example, using @ref asio::defer) does not wake idle threads, as the
+ * submitting thread is expected to run it once the current function returns.
+ *
+ * The pool's executor satisfies the standard executor requirements and may be
+ * used with @ref asio::post, @ref asio::co_spawn and
+ * @ref experimental::make_parallel_group.
+ *
+ * @par Example
+ * A recursive fork-join computation:
+ * @code void sum(asio::work_stealing_pool& pool, const int* first,
+ *     const int* last, std::atomic<long>& total)
+ * {
+ *   while (last - first > 1000)
+ *   {
+ *     // Fork the second half, and continue with the first.
+ *     const int* middle = first + (last - first) / 2;
+ *     asio::post(pool,
+ *         [&pool, middle, last, &total]
+ *         {
+ *           sum(pool, middle, last, total);
+ *         });
+ *     last = middle;
+ *   }
+ *
+ *   total += std::accumulate(first, last, 0L);
+ * }
+ *
+ * ...
+ *
+ * asio::work_stealing_pool pool;
+ * std::atomic<long> total(0);
+ * asio::post(pool, [&]{ sum(pool, data, data + size, total); });
+ * pool.join(); @endcode
+ */
+class work_stealing_pool
+  : public execution_context
+{
+public:
+  /// Executor implementation type used to submit functions to a pool.
+  template <typename Allocator, unsigned int Bits>
+  using basic_executor_type =
+    detail::thread_pool_executor<work_stealing_pool, Allocator, Bits>;
+
+  /// Executor used to submit functions to a work stealing pool.
+  typedef basic_executor_type<std::allocator<void>, 0> executor_type;
+
+  /// Constructs a pool with one thread per processor.
+  ASIO_DECL work_stealing_pool();
+
+  /// Constructs a pool with a specified number of threads.
+  ASIO_DECL explicit work_stealing_pool(std::size_t num_threads);
+
+  /// Constructs a pool with a specified number of threads, each of which is
+  /// configured using a thread policy.
+  /**
+   * Each thread applies the policy to itself, using its position in the pool
+   * as its number, before it runs any submitted function objects. Errors in
+   * applying the policy are ignored.
+   */
+  ASIO_DECL work_stealing_pool(std::size_t num_threads,
+      const thread_policy& policy);
+
+  /// Destructor.
+  /**
+   * Automatically stops and joins the pool, if not explicitly done beforehand.
+   */
+  ASIO_DECL ~work_stealing_pool();
+
+  /// Obtains the executor associated with the pool.
+  executor_type get_executor() noexcept;
+
+  /// Obtains the executor associated with the pool.
+  executor_type executor() noexcept;
+
+  /// Stops the threads.
+  /**
+   * This function stops the threads as soon as possible. As a result of calling
+   * @c stop(), pending function objects may be never be invoked.
+   */
+  ASIO_DECL void stop();
+
+  /// Joins the threads.
+  /**
+   * This function blocks until the threads in the pool have completed. If @c
+   * stop() is not called prior to @c join(), the @c join() call will wait
+   * until the pool has no more outstanding work.
+   */
+  ASIO_DECL void join();
+
+  /// Waits for threads to complete.
+  /**
+   * This function blocks until the threads in the pool have completed. If @c
+   * stop() is not called prior to @c wait(), the @c wait() call will wait
+   * until the pool has no more outstanding work.
+   */
+  ASIO_DECL void wait();
+
+private:
+  work_stealing_pool(const work_stealing_pool&) = delete;
+  work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+  template <typename, typename, unsigned int>
+  friend class detail::thread_pool_executor;
+
+  struct thread_function;
+
+  // Helper function to create the underlying scheduler.
+  ASIO_DECL detail::work_stealing_scheduler& add_scheduler(
+      detail::work_stealing_scheduler* s);
+
+  // Helper function to create the threads.
+  ASIO_DECL void create_threads();
+
+  // The recommended number of work items for the pool.
+  std::size_t occupancy() const noexcept
+  {
+    return scheduler_.concurrency_hint();
+  }
+
+  // The object type name used in handler tracking output.
+  static const char* tracking_name() noexcept
+  {
+    return "work_stealing_pool";
+  }
+
+  // The underlying scheduler.
+  detail::work_stealing_scheduler& scheduler_;
+
+  // The threads in the pool.
+  detail::thread_group threads_;
+
+  // The policy applied by the threads in the pool.
+  thread_policy policy_;
+};
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+namespace execution {
+
+template <>
+struct is_executor<work_stealing_pool> : false_type
+{
+};
+
+} // namespace execution
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/work_stealing_pool.hpp"
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/work_stealing_pool.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_WORK_STEALING_POOL_HPP
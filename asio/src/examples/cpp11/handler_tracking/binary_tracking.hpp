@@ -0,0 +1,738 @@
+//
+// binary_tracking.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BINARY_TRACKING_HPP
+#define BINARY_TRACKING_HPP
+
+// A handler tracking backend that is cheap enough to leave enabled in
+// production. Select it by compiling with:
+//
+//   -DASIO_CUSTOM_HANDLER_TRACKING=\"binary_tracking.hpp\"
+//
+// Each thread appends fixed-size records to its own ring buffer, without
+// locking and without formatting. A background thread drains the rings to a
+// file named by the ASIO_BINARY_TRACKING_FILE environment variable, or to
+// handler_tracking.bin if it is not set. On Linux, the value "memfd" writes to
+// an anonymous memory file instead, which may be read through the descriptor
+// returned by binary_tracking::descriptor(). When a ring is full, records are
+// dropped and the number lost is recorded. The size of the rings may be set
+// by defining BINARY_TRACKING_RING_SIZE.
+//
+// The output is converted to the text format of the built-in tracking, for use
+// with handlerviz.pl, handlertree.pl and handlerlive.pl, by:
+//
+//   perl handlerbin.pl handler_tracking.bin
+//
+// and a latency histogram report is produced by:
+//
+//   perl handlerbin.pl -l handler_tracking.bin
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "asio/error_code.hpp"
+
+// The number of records in each thread's ring buffer.
+#if !defined(BINARY_TRACKING_RING_SIZE)
+# define BINARY_TRACKING_RING_SIZE 8192
+#endif // !defined(BINARY_TRACKING_RING_SIZE)
+
+# define ASIO_INHERIT_TRACKED_HANDLER \
+  : public ::binary_tracking::tracked_handler
+
+# define ASIO_ALSO_INHERIT_TRACKED_HANDLER \
+  , public ::binary_tracking::tracked_handler
+
+# define ASIO_HANDLER_TRACKING_INIT \
+  ::binary_tracking::init()
+
+# define ASIO_HANDLER_LOCATION(args) \
+  ::binary_tracking::location tracked_location args
+
+# define ASIO_HANDLER_CREATION(args) \
+  ::binary_tracking::creation args
+
+# define ASIO_HANDLER_COMPLETION(args) \
+  ::binary_tracking::completion tracked_completion args
+
+# define ASIO_HANDLER_INVOCATION_BEGIN(args) \
+  tracked_completion.invocation_begin args
+
+# define ASIO_HANDLER_INVOCATION_END \
+  tracked_completion.invocation_end()
+
+# define ASIO_HANDLER_OPERATION(args) \
+  ::binary_tracking::operation args
+
+# define ASIO_HANDLER_REACTOR_REGISTRATION(args) \
+  ::binary_tracking::reactor_registration args
+
+# define ASIO_HANDLER_REACTOR_DEREGISTRATION(args) \
+  ::binary_tracking::reactor_deregistration args
+
+# define ASIO_HANDLER_REACTOR_READ_EVENT 1
+# define ASIO_HANDLER_REACTOR_WRITE_EVENT 2
+# define ASIO_HANDLER_REACTOR_ERROR_EVENT 4
+
+# define ASIO_HANDLER_REACTOR_EVENTS(args) \
+  ::binary_tracking::reactor_events args
+
+# define ASIO_HANDLER_REACTOR_OPERATION(args) \
+  ::binary_tracking::reactor_operation args
+
+struct binary_tracking
+{
+  // The record types. These values are part of the file format.
+  enum record_type
+  {
+    header_record = 0,
+    string_record = 1,
+    location_record = 2,
+    creation_record = 3,
+    completion_record = 4,
+    invocation_begin_record = 5,
+    invocation_end_record = 6,
+    operation_record = 7,
+    reactor_registration_record = 8,
+    reactor_deregistration_record = 9,
+    reactor_events_record = 10,
+    reactor_operation_record = 11,
+    lost_records_record = 12
+  };
+
+  // The record flags. These values are part of the file format.
+  enum record_flags
+  {
+    invoked_flag = 1, // The completed handler was invoked.
+    error_code_flag = 2, // The record contains an error code.
+    bytes_transferred_flag = 4, // The arg field holds bytes transferred.
+    signal_number_flag = 8, // The value2 field holds a signal number.
+    string_arg_flag = 16, // The str3 field holds an argument string.
+    innermost_flag = 32 // The location is the innermost one.
+  };
+
+  // A fixed-size event record. Strings are written once to the file as
+  // string records, and are then referred to by id.
+  struct record
+  {
+    std::uint16_t type;
+    std::uint16_t flags;
+    std::int32_t value; // Error value, line number or reactor events.
+    std::uint64_t time; // Nanoseconds since the epoch.
+    std::uint64_t id; // The handler id.
+    std::uint64_t parent; // The id of the handler that was running.
+    std::uint64_t object; // Object address or native handle.
+    std::uint64_t arg; // Bytes transferred or registration key.
+    std::uint32_t str1; // Object type, file name or error category.
+    std::uint32_t str2; // Operation name or function name.
+    std::uint32_t str3; // Argument string.
+    std::int32_t value2; // Signal number.
+  };
+
+  // A string record holds the first 48 bytes of a string. The remainder of a
+  // longer string follows in as many record-sized blocks as are needed.
+  struct string_data
+  {
+    std::uint16_t type;
+    std::uint16_t flags;
+    std::int32_t length;
+    std::uint64_t id;
+    char text[48];
+  };
+
+  static_assert(sizeof(record) == 64, "unexpected record size");
+  static_assert(sizeof(string_data) == 64, "unexpected record size");
+
+  // Base class for objects containing tracked handlers.
+  struct tracked_handler
+  {
+    std::uint64_t id_ = 0; // To uniquely identify a handler.
+  };
+
+  // Initialise the tracking system.
+  static void init()
+  {
+    get_state();
+  }
+
+  // Get the descriptor to which the records are written.
+  static int descriptor()
+  {
+    return get_state().fd_;
+  }
+
+  // Write all buffered records to the output.
+  static void flush()
+  {
+    get_state().drain();
+  }
+
+  // A source location, held on a per-thread stack while it is in scope.
+  class location
+  {
+  public:
+    location(const char* file, int line, const char* func)
+      : file_(file),
+        line_(line),
+        func_(func),
+        next_(current_location())
+    {
+      current_location() = this;
+    }
+
+    location(const location&) = delete;
+    location& operator=(const location&) = delete;
+
+    ~location()
+    {
+      current_location() = next_;
+    }
+
+  private:
+    friend struct binary_tracking;
+    const char* file_;
+    int line_;
+    const char* func_;
+    location* next_;
+  };
+
+  class completion;
+
+  // Record the creation of a tracked handler.
+  static void creation(asio::execution_context& /*ctx*/,
+      tracked_handler& h, const char* object_type, void* object,
+      std::uintmax_t /*native_handle*/, const char* op_name)
+  {
+    thread_state& t = this_thread();
+    h.id_ = t.next_id();
+    std::uint64_t parent = current_id();
+    std::uint64_t time = now();
+
+    for (location* l = current_location(); l; l = l->next_)
+    {
+      record r = make_record(location_record, time);
+      r.flags = (l == current_location()) ? innermost_flag : 0;
+      r.value = l->line_;
+      r.id = h.id_;
+      r.parent = parent;
+      r.str1 = intern(t, l->file_);
+      r.str2 = intern(t, l->func_);
+      t.write(r);
+    }
+
+    record r = make_record(creation_record, time);
+    r.id = h.id_;
+    r.parent = parent;
+    r.object = reinterpret_cast<std::uintptr_t>(object);
+    r.str1 = intern(t, object_type);
+    r.str2 = intern(t, op_name);
+    t.write(r);
+  }
+
+  // Records the completion, and optionally the invocation, of a handler.
+  class completion
+  {
+  public:
+    explicit completion(const tracked_handler& h)
+      : id_(h.id_),
+        invoked_(false),
+        next_(current_completion())
+    {
+      current_completion() = this;
+    }
+
+    completion(const completion&) = delete;
+    completion& operator=(const completion&) = delete;
+
+    // Records only when an exception is thrown from the handler, or if the
+    // memory is being freed without the handler having been invoked.
+    ~completion()
+    {
+      if (id_)
+      {
+        record r = make_record(completion_record, now());
+        r.flags = invoked_ ? invoked_flag : 0;
+        r.id = id_;
+        this_thread().write(r);
+      }
+
+      current_completion() = next_;
+    }
+
+    // Record that the handler is to be invoked with no arguments.
+    void invocation_begin()
+    {
+      begin(make_record(invocation_begin_record, now()));
+    }
+
+    // Record that the handler is to be invoked with the specified arguments.
+    void invocation_begin(const asio::error_code& ec)
+    {
+      begin(with_error(ec));
+    }
+
+    // Record that the handler is to be invoked with the specified arguments.
+    void invocation_begin(const asio::error_code& ec,
+        std::size_t bytes_transferred)
+    {
+      record r = with_error(ec);
+      r.flags |= bytes_transferred_flag;
+      r.arg = bytes_transferred;
+      begin(r);
+    }
+
+    // Record that the handler is to be invoked with the specified arguments.
+    void invocation_begin(const asio::error_code& ec, int signal_number)
+    {
+      record r = with_error(ec);
+      r.flags |= signal_number_flag;
+      r.value2 = signal_number;
+      begin(r);
+    }
+
+    // Record that the handler is to be invoked with the specified arguments.
+    void invocation_begin(const asio::error_code& ec, const char* arg)
+    {
+      record r = with_error(ec);
+      r.flags |= string_arg_flag;
+      r.str3 = intern(this_thread(), arg);
+      begin(r);
+    }
+
+    // Record that handler invocation has ended.
+    void invocation_end()
+    {
+      if (id_)
+      {
+        record r = make_record(invocation_end_record, now());
+        r.id = id_;
+        this_thread().write(r);
+        id_ = 0;
+      }
+    }
+
+  private:
+    friend struct binary_tracking;
+
+    record with_error(const asio::error_code& ec)
+    {
+      record r = make_record(invocation_begin_record, now());
+      r.flags = error_code_flag;
+      r.value = ec.value();
+      r.str1 = intern(this_thread(), ec.category().name());
+      return r;
+    }
+
+    void begin(record r)
+    {
+      r.id = id_;
+      this_thread().write(r);
+      invoked_ = true;
+    }
+
+    std::uint64_t id_;
+    bool invoked_;
+    completion* next_;
+  };
+
+  // Record an operation that is not directly associated with a handler.
+  static void operation(asio::execution_context& /*ctx*/,
+      const char* object_type, void* object,
+      std::uintmax_t /*native_handle*/, const char* op_name)
+  {
+    thread_state& t = this_thread();
+    record r = make_record(operation_record, now());
+    r.parent = current_id();
+    r.object = reinterpret_cast<std::uintptr_t>(object);
+    r.str1 = intern(t, object_type);
+    r.str2 = intern(t, op_name);
+    t.write(r);
+  }
+
+  // Record that a descriptor has been registered with the reactor.
+  static void reactor_registration(asio::execution_context& /*context*/,
+      std::uintmax_t native_handle, std::uintmax_t registration)
+  {
+    record r = make_record(reactor_registration_record, now());
+    r.object = native_handle;
+    r.arg = registration;
+    this_thread().write(r);
+  }
+
+  // Record that a descriptor has been deregistered from the reactor.
+  static void reactor_deregistration(asio::execution_context& /*context*/,
+      std::uintmax_t native_handle, std::uintmax_t registration)
+  {
+    record r = make_record(reactor_deregistration_record, now());
+    r.object = native_handle;
+    r.arg = registration;
+    this_thread().write(r);
+  }
+
+  // Record reactor-based readiness events associated with a descriptor.
+  static void reactor_events(asio::execution_context& /*context*/,
+      std::uintmax_t registration, unsigned events)
+  {
+    record r = make_record(reactor_events_record, now());
+    r.value = static_cast<std::int32_t>(events);
+    r.arg = registration;
+    this_thread().write(r);
+  }
+
+  // Record a reactor-based operation that is associated with a handler.
+  static void reactor_operation(const tracked_handler& h,
+      const char* op_name, const asio::error_code& ec)
+  {
+    thread_state& t = this_thread();
+    record r = make_record(reactor_operation_record, now());
+    r.flags = error_code_flag;
+    r.value = ec.value();
+    r.id = h.id_;
+    r.str1 = intern(t, ec.category().name());
+    r.str2 = intern(t, op_name);
+    t.write(r);
+  }
+
+  // Record a reactor-based operation that is associated with a handler.
+  static void reactor_operation(const tracked_handler& h,
+      const char* op_name, const asio::error_code& ec,
+      std::size_t bytes_transferred)
+  {
+    thread_state& t = this_thread();
+    record r = make_record(reactor_operation_record, now());
+    r.flags = error_code_flag | bytes_transferred_flag;
+    r.value = ec.value();
+    r.id = h.id_;
+    r.arg = bytes_transferred;
+    r.str1 = intern(t, ec.category().name());
+    r.str2 = intern(t, op_name);
+    t.write(r);
+  }
+
+private:
+  // A single-producer, single-consumer ring of records. The owning thread
+  // writes records and the flusher reads them.
+  struct ring
+  {
+    enum { capacity = BINARY_TRACKING_RING_SIZE };
+
+    record records_[capacity];
+    std::atomic<std::uint64_t> head_{0};
+    std::atomic<std::uint64_t> tail_{0};
+    std::atomic<bool> retired_{false};
+    ring* next_ = nullptr;
+  };
+
+  // The per-thread tracking state.
+  struct thread_state
+  {
+    enum { id_block_size = 1024 };
+    enum { string_cache_size = 256 };
+
+    thread_state()
+      : ring_(new ring),
+        lost_(0),
+        next_id_(0),
+        last_id_(0)
+    {
+      std::memset(string_cache_, 0, sizeof(string_cache_));
+      get_state().add_ring(ring_);
+    }
+
+    thread_state(const thread_state&) = delete;
+    thread_state& operator=(const thread_state&) = delete;
+
+    ~thread_state()
+    {
+      if (lost_ && !write_lost())
+      {
+        get_state().drain();
+        write_lost();
+      }
+      ring_->retired_.store(true, std::memory_order_release);
+    }
+
+    // Handler ids are taken from the global sequence in blocks.
+    std::uint64_t next_id()
+    {
+      if (next_id_ == last_id_)
+      {
+        next_id_ = get_state().next_id_.fetch_add(
+            id_block_size, std::memory_order_relaxed);
+        last_id_ = next_id_ + id_block_size;
+      }
+      return next_id_++;
+    }
+
+    void write(const record& r)
+    {
+      if (lost_ && !write_lost())
+        ++lost_;
+      else if (!try_write(r))
+        ++lost_;
+    }
+
+    bool try_write(const record& r)
+    {
+      std::uint64_t head = ring_->head_.load(std::memory_order_relaxed);
+      std::uint64_t tail = ring_->tail_.load(std::memory_order_acquire);
+      if (head - tail == ring::capacity)
+        return false;
+      ring_->records_[head % ring::capacity] = r;
+      ring_->head_.store(head + 1, std::memory_order_release);
+
+      // Wake the flusher early if the ring is filling up.
+      if (head - tail == ring::capacity / 2)
+        get_state().flusher_cv_.notify_one();
+
+      return true;
+    }
+
+    bool write_lost()
+    {
+      record r = make_record(lost_records_record, now());
+      r.arg = lost_;
+      if (!try_write(r))
+        return false;
+      lost_ = 0;
+      return true;
+    }
+
+    ring* ring_;
+    std::uint64_t lost_;
+    std::uint64_t next_id_;
+    std::uint64_t last_id_;
+    struct { const char* str; std::uint32_t id; } string_cache_[
+      string_cache_size];
+  };
+
+  // The process-wide tracking state.
+  struct state
+  {
+    state()
+      : fd_(-1),
+        next_id_(1),
+        next_string_id_(1),
+        first_ring_(nullptr),
+        stopped_(false)
+    {
+      const char* name = std::getenv("ASIO_BINARY_TRACKING_FILE");
+      if (!name)
+        name = "handler_tracking.bin";
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+      if (std::strcmp(name, "memfd") == 0)
+      {
+        fd_ = ::memfd_create("asio_handler_tracking", MFD_CLOEXEC);
+        if (fd_ != -1)
+          ::fcntl(fd_, F_SETFL, O_APPEND);
+      }
+      else
+#endif // defined(__linux__) && defined(MFD_CLOEXEC)
+      fd_ = ::open(name, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC,
+          0644);
+
+      string_data header = string_data();
+      header.type = header_record;
+      header.length = sizeof(record);
+      header.id = 1; // Version.
+      std::memcpy(header.text, "asio binary handler tracking", 28);
+      write_all(&header, sizeof(header));
+
+      flusher_ = std::thread([this]{ run_flusher(); });
+    }
+
+    ~state()
+    {
+      {
+        std::lock_guard<std::mutex> lock(flusher_mutex_);
+        stopped_ = true;
+      }
+      flusher_cv_.notify_one();
+      flusher_.join();
+      drain();
+    }
+
+    void add_ring(ring* r)
+    {
+      std::lock_guard<std::mutex> lock(rings_mutex_);
+      r->next_ = first_ring_;
+      first_ring_ = r;
+    }
+
+    // Copy the records in each ring to the output, and free the rings of
+    // threads that have exited.
+    void drain()
+    {
+      std::lock_guard<std::mutex> lock(rings_mutex_);
+      ring** r = &first_ring_;
+      while (*r)
+      {
+        bool retired = (*r)->retired_.load(std::memory_order_acquire);
+        std::uint64_t head = (*r)->head_.load(std::memory_order_acquire);
+        std::uint64_t tail = (*r)->tail_.load(std::memory_order_relaxed);
+        while (tail != head)
+        {
+          std::size_t begin = tail % ring::capacity;
+          std::size_t end = (head - tail < ring::capacity - begin)
+            ? begin + (head - tail) : std::size_t(ring::capacity);
+          write_all((*r)->records_ + begin, (end - begin) * sizeof(record));
+          tail += end - begin;
+        }
+        (*r)->tail_.store(tail, std::memory_order_release);
+
+        if (retired)
+        {
+          ring* tmp = *r;
+          *r = tmp->next_;
+          delete tmp;
+        }
+        else
+          r = &(*r)->next_;
+      }
+    }
+
+    void run_flusher()
+    {
+      std::unique_lock<std::mutex> lock(flusher_mutex_);
+      while (!stopped_)
+      {
+        flusher_cv_.wait_for(lock, std::chrono::milliseconds(10));
+        lock.unlock();
+        drain();
+        lock.lock();
+      }
+    }
+
+    void write_all(const void* data, std::size_t length)
+    {
+      const char* p = static_cast<const char*>(data);
+      while (length > 0 && fd_ != -1)
+      {
+        ssize_t n = ::write(fd_, p, length);
+        if (n <= 0)
+          break;
+        p += n;
+        length -= static_cast<std::size_t>(n);
+      }
+    }
+
+    int fd_;
+    std::atomic<std::uint64_t> next_id_;
+    std::mutex strings_mutex_;
+    std::unordered_map<const char*, std::uint32_t> strings_;
+    std::uint32_t next_string_id_;
+    std::mutex rings_mutex_;
+    ring* first_ring_;
+    std::mutex flusher_mutex_;
+    std::condition_variable flusher_cv_;
+    bool stopped_;
+    std::thread flusher_;
+  };
+
+  static state& get_state()
+  {
+    static state s;
+    return s;
+  }
+
+  static thread_state& this_thread()
+  {
+    static thread_local thread_state t;
+    return t;
+  }
+
+  static location*& current_location()
+  {
+    static thread_local location* current = nullptr;
+    return current;
+  }
+
+  static completion*& current_completion()
+  {
+    static thread_local completion* current = nullptr;
+    return current;
+  }
+
+  static std::uint64_t current_id()
+  {
+    return current_completion() ? current_completion()->id_ : 0;
+  }
+
+  static std::uint64_t now()
+  {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count());
+  }
+
+  // The maximum length of a string in the output.
+  enum { max_string_length = 1024 };
+
+  static record make_record(record_type type, std::uint64_t time)
+  {
+    record r = record();
+    r.type = static_cast<std::uint16_t>(type);
+    r.time = time;
+    return r;
+  }
+
+  // Get the id of a string. A string is written to the output the first time
+  // it is seen. Subsequent lookups are usually satisfied by a per-thread
+  // cache of the string addresses.
+  static std::uint32_t intern(thread_state& t, const char* str)
+  {
+    if (!str)
+      return 0;
+
+    std::size_t slot = (reinterpret_cast<std::uintptr_t>(str) >> 3)
+      % thread_state::string_cache_size;
+    if (t.string_cache_[slot].str == str)
+      return t.string_cache_[slot].id;
+
+    state& s = get_state();
+    std::lock_guard<std::mutex> lock(s.strings_mutex_);
+    std::uint32_t& id = s.strings_[str];
+    if (id == 0)
+    {
+      id = s.next_string_id_++;
+      std::size_t length = std::strlen(str);
+      if (length > max_string_length)
+        length = max_string_length;
+
+      // Write the string and its continuation blocks in a single write.
+      string_data d[max_string_length / sizeof(record) + 1] = {};
+      d[0].type = string_record;
+      d[0].id = id;
+      d[0].length = static_cast<std::int32_t>(length);
+      std::memcpy(d[0].text, str, length);
+      std::size_t blocks = 1;
+      if (length > sizeof(d[0].text))
+        blocks += (length - sizeof(d[0].text) + sizeof(record) - 1)
+          / sizeof(record);
+      s.write_all(d, blocks * sizeof(record));
+    }
+
+    t.string_cache_[slot].str = str;
+    t.string_cache_[slot].id = id;
+    return id;
+  }
+};
+
+#endif // BINARY_TRACKING_HPP
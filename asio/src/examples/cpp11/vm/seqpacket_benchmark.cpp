@@ -0,0 +1,93 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <asio.hpp>
+
+#if defined(ASIO_HAS_VM_SOCKETS)
+
+using asio::vm::seqpacket_protocol;
+using asio::vm::cid;
+
+// Measures the rate at which messages can be received over a loopback VSOCK
+// connection, first with one receive() call per message and then with
+// receive_batch(). Requires the vsock_loopback kernel module.
+
+double run(asio::io_context& io_context, unsigned int port,
+    std::size_t messages, std::size_t length, std::size_t batch_size)
+{
+  seqpacket_protocol::acceptor acceptor(io_context,
+      seqpacket_protocol::endpoint(cid::local(), port));
+
+  std::thread sender(
+      [&]
+      {
+        seqpacket_protocol::socket s(io_context);
+        s.connect(seqpacket_protocol::endpoint(cid::local(), port));
+        std::vector<char> message(length);
+        for (std::size_t i = 0; i < messages; ++i)
+          s.send(asio::buffer(message), 0);
+      });
+
+  seqpacket_protocol::socket s(io_context);
+  acceptor.accept(s);
+
+  std::size_t received = 0;
+  auto start = std::chrono::steady_clock::now();
+  if (batch_size == 0)
+  {
+    std::vector<char> message(length);
+    while (received < messages)
+    {
+      asio::socket_base::message_flags flags = 0;
+      s.receive(asio::buffer(message), flags);
+      ++received;
+    }
+  }
+  else
+  {
+    asio::vm::message_batch batch(batch_size, length);
+    while (received < messages)
+      received += asio::vm::receive_batch(s, batch);
+  }
+  auto stop = std::chrono::steady_clock::now();
+
+  sender.join();
+  return received / std::chrono::duration<double>(stop - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    if (argc < 2 || argc > 5)
+    {
+      std::cerr << "Usage: seqpacket_benchmark <port> "
+        "[<messages> [<length> [<batch size>]]]\n";
+      return 1;
+    }
+
+    unsigned int port = std::atoi(argv[1]);
+    std::size_t messages = argc > 2 ? std::atoi(argv[2]) : 1000000;
+    std::size_t length = argc > 3 ? std::atoi(argv[3]) : 64;
+    std::size_t batch_size = argc > 4 ? std::atoi(argv[4]) : 64;
+
+    asio::io_context io_context;
+    std::cout << "receive:       "
+      << run(io_context, port, messages, length, 0) << " messages/s\n";
+    std::cout << "receive_batch: "
+      << run(io_context, port, messages, length, batch_size)
+      << " messages/s\n";
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << "\n";
+  }
+
+  return 0;
+}
+
+#else // defined(ASIO_HAS_VM_SOCKETS)
+# error VSOCK sockets not available on this platform.
+#endif // defined(ASIO_HAS_VM_SOCKETS)
@@ -0,0 +1,56 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <asio.hpp>
+
+#if defined(ASIO_HAS_VM_SOCKETS)
+
+using asio::vm::seqpacket_protocol;
+using asio::vm::cid;
+
+enum { max_length = 4096 };
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    if (argc != 2)
+    {
+      std::cerr << "Usage: seqpacket_client <port>\n";
+      return 1;
+    }
+
+    asio::io_context io_context;
+
+    seqpacket_protocol::socket s(io_context);
+    s.connect(seqpacket_protocol::endpoint(cid::local(), std::atoi(argv[1])));
+
+    for (;;)
+    {
+      std::cout << "Enter message: ";
+      char request[max_length];
+      if (!std::cin.getline(request, max_length))
+        break;
+
+      // The message boundary is preserved, so no length prefix is needed.
+      s.send(asio::buffer(request, std::strlen(request)), 0);
+
+      char reply[max_length];
+      asio::socket_base::message_flags flags = 0;
+      std::size_t reply_length = s.receive(asio::buffer(reply), flags);
+      std::cout << "Reply is: ";
+      std::cout.write(reply, reply_length);
+      std::cout << "\n";
+    }
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << "\n";
+  }
+
+  return 0;
+}
+
+#else // defined(ASIO_HAS_VM_SOCKETS)
+# error VSOCK sockets not available on this platform.
+#endif // defined(ASIO_HAS_VM_SOCKETS)
@@ -0,0 +1,104 @@
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <asio.hpp>
+
+#if defined(ASIO_HAS_VM_SOCKETS)
+
+using asio::vm::seqpacket_protocol;
+
+class session
+  : public std::enable_shared_from_this<session>
+{
+public:
+  session(seqpacket_protocol::socket socket)
+    : socket_(std::move(socket)),
+      batch_(max_messages, max_length)
+  {
+  }
+
+  void start()
+  {
+    do_receive();
+  }
+
+private:
+  void do_receive()
+  {
+    auto self(shared_from_this());
+    asio::vm::async_receive_batch(socket_, batch_,
+        [this, self](std::error_code ec, std::size_t messages)
+        {
+          if (!ec)
+          {
+            // Each message is echoed back as a message of its own.
+            for (std::size_t i = 0; i < messages; ++i)
+            {
+              socket_.send(asio::buffer(batch_[i]), 0, ec);
+              if (ec)
+                return;
+            }
+
+            do_receive();
+          }
+        });
+  }
+
+  enum { max_messages = 64, max_length = 4096 };
+  seqpacket_protocol::socket socket_;
+  asio::vm::message_batch batch_;
+};
+
+class server
+{
+public:
+  server(asio::io_context& io_context, unsigned int port)
+    : acceptor_(io_context, seqpacket_protocol::endpoint(port))
+  {
+    do_accept();
+  }
+
+private:
+  void do_accept()
+  {
+    acceptor_.async_accept(
+        [this](std::error_code ec, seqpacket_protocol::socket socket)
+        {
+          if (!ec)
+          {
+            std::make_shared<session>(std::move(socket))->start();
+          }
+
+          do_accept();
+        });
+  }
+
+  seqpacket_protocol::acceptor acceptor_;
+};
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    if (argc != 2)
+    {
+      std::cerr << "Usage: seqpacket_server <port>\n";
+      return 1;
+    }
+
+    asio::io_context io_context;
+    server s(io_context, std::atoi(argv[1]));
+    io_context.run();
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << "\n";
+  }
+
+  return 0;
+}
+
+#else // defined(ASIO_HAS_VM_SOCKETS)
+# error VSOCK sockets not available on this platform.
+#endif // defined(ASIO_HAS_VM_SOCKETS)
@@ -1,6 +1,9 @@
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <iostream>
+#include <vector>
 #include <asio.hpp>
 
 #if defined(ASIO_HAS_VM_SOCKETS)
@@ -10,21 +13,108 @@ using asio::vm::cid;
 
 enum { max_length = 1024 };
 
+// Send the given number of megabytes to a stream_server running with --bulk,
+// and report the throughput.
+void bulk_transfer(stream_protocol::socket& s, std::size_t megabytes,
+    bool zerocopy)
+{
+  std::vector<char> chunk(4 * 1024 * 1024, 'x');
+  std::size_t chunks = megabytes / 4 + (megabytes % 4 ? 1 : 0);
+  std::size_t sent = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  if (zerocopy)
+  {
+#if defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+    asio::vm::zerocopy_sender sender(s);
+    if (!sender.zerocopy_enabled())
+      std::cerr << "MSG_ZEROCOPY not supported, using ordinary sends\n";
+
+    // Each send completes once the kernel has finished with the chunk, so the
+    // chunk may safely be sent again.
+    std::size_t remaining = chunks;
+    std::function<void()> send_chunk =
+      [&]
+      {
+        sender.async_send(asio::buffer(chunk),
+            [&](std::error_code ec, std::size_t n)
+            {
+              sent += n;
+              if (!ec && --remaining > 0)
+                send_chunk();
+            });
+      };
+    send_chunk();
+    static_cast<asio::io_context&>(s.get_executor().context()).run();
+
+    if (sender.copied_sends())
+      std::cerr << sender.copied_sends() << " sends were copied\n";
+#else // defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+    std::cerr << "MSG_ZEROCOPY not available on this platform\n";
+    return;
+#endif // defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+  }
+  else
+  {
+    for (std::size_t i = 0; i < chunks; ++i)
+      sent += asio::write(s, asio::buffer(chunk));
+  }
+  s.shutdown(stream_protocol::socket::shutdown_send);
+
+  // Wait for the server to close the connection once it has received
+  // everything.
+  char c;
+  std::error_code ec;
+  s.read_some(asio::buffer(&c, 1), ec);
+  auto stop = std::chrono::steady_clock::now();
+
+  double seconds = std::chrono::duration<double>(stop - start).count();
+  std::cout << sent << " bytes in " << seconds << "s, "
+    << sent / seconds / 1e6 << " MB/s\n";
+}
+
 int main(int argc, char* argv[])
 {
   try
   {
-    if (argc != 2)
+    if (argc < 2)
     {
-      std::cerr << "Usage: stream_client <port>\n";
+      std::cerr << "Usage: stream_client <port> [--bulk <megabytes> "
+        "[--zerocopy] [--buffer-size <bytes>]]\n";
       return 1;
     }
 
+    std::size_t bulk_megabytes = 0;
+    bool zerocopy = false;
+    unsigned long long buffer_size = 0;
+    for (int i = 2; i < argc; ++i)
+    {
+      if (std::strcmp(argv[i], "--bulk") == 0 && i + 1 < argc)
+        bulk_megabytes = std::atoi(argv[++i]);
+      else if (std::strcmp(argv[i], "--zerocopy") == 0)
+        zerocopy = true;
+      else if (std::strcmp(argv[i], "--buffer-size") == 0 && i + 1 < argc)
+        buffer_size = std::strtoull(argv[++i], 0, 10);
+    }
+
     asio::io_context io_context;
 
     stream_protocol::socket s(io_context);
+    s.open(stream_protocol());
+    s.set_option(stream_protocol::connect_timeout(std::chrono::seconds(5)));
+    if (buffer_size)
+    {
+      s.set_option(stream_protocol::max_buffer_size(buffer_size));
+      s.set_option(stream_protocol::buffer_size(buffer_size));
+    }
     s.connect(stream_protocol::endpoint(cid::local(), atoi(argv[1])));
 
+    if (bulk_megabytes)
+    {
+      bulk_transfer(s, bulk_megabytes, zerocopy);
+      return 0;
+    }
+
     using namespace std; // For strlen.
     std::cout << "Enter message: ";
     char request[max_length];
@@ -49,4 +139,4 @@ int main(int argc, char* argv[])
 
 #else // defined(ASIO_HAS_VM_SOCKETS)
 # error VSOCK sockets not available on this platform.
-#endif // defined(ASIO_HAS_VM_SOCKETS)
\ No newline at end of file
+#endif // defined(ASIO_HAS_VM_SOCKETS)
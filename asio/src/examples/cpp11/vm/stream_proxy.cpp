@@ -0,0 +1,114 @@
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <asio.hpp>
+
+#if defined(ASIO_HAS_VM_SOCKETS)
+
+using asio::ip::tcp;
+using asio::vm::stream_protocol;
+
+// Relays a single guest connection to the TCP backend.
+class bridge
+  : public std::enable_shared_from_this<bridge>
+{
+public:
+  bridge(stream_protocol::socket guest, tcp::socket backend)
+    : guest_(std::move(guest)),
+      backend_(std::move(backend))
+  {
+  }
+
+  void start(const tcp::endpoint& backend_endpoint)
+  {
+    auto self(shared_from_this());
+    backend_.async_connect(backend_endpoint,
+        [this, self](std::error_code ec)
+        {
+          if (!ec)
+          {
+            asio::async_proxy(guest_, backend_,
+                [self](std::error_code ec, std::size_t up, std::size_t down)
+                {
+                  std::cout << up << " bytes up, " << down << " bytes down"
+                    << (ec ? " (" + ec.message() + ")" : "") << "\n";
+                });
+          }
+        });
+  }
+
+private:
+  stream_protocol::socket guest_;
+  tcp::socket backend_;
+};
+
+class server
+{
+public:
+  server(asio::io_context& io_context, unsigned int port,
+      const tcp::endpoint& backend_endpoint)
+    : io_context_(io_context),
+      acceptor_(io_context, stream_protocol::endpoint(port)),
+      backend_endpoint_(backend_endpoint)
+  {
+    do_accept();
+  }
+
+private:
+  void do_accept()
+  {
+    acceptor_.async_accept(
+        [this](std::error_code ec, stream_protocol::socket socket)
+        {
+          if (!ec)
+          {
+            std::make_shared<bridge>(std::move(socket),
+                tcp::socket(io_context_))->start(backend_endpoint_);
+          }
+
+          do_accept();
+        });
+  }
+
+  asio::io_context& io_context_;
+  stream_protocol::acceptor acceptor_;
+  tcp::endpoint backend_endpoint_;
+};
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    if (argc != 4)
+    {
+      std::cerr
+        << "Usage: stream_proxy <vsock_port> <backend_host> <backend_port>\n";
+      return 1;
+    }
+
+    // Data relayed with splice() may raise SIGPIPE if the backend goes away.
+    std::signal(SIGPIPE, SIG_IGN);
+
+    asio::io_context io_context;
+
+    tcp::resolver resolver(io_context);
+    tcp::endpoint backend_endpoint =
+      *resolver.resolve(argv[2], argv[3]).begin();
+
+    using namespace std; // For atoi.
+    server s(io_context, atoi(argv[1]), backend_endpoint);
+    io_context.run();
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << "\n";
+  }
+
+  return 0;
+}
+
+#else // defined(ASIO_HAS_VM_SOCKETS)
+# error VSOCK sockets not available on this platform.
+#endif // defined(ASIO_HAS_VM_SOCKETS)
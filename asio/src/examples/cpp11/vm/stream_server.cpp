@@ -1,8 +1,13 @@
+#include <chrono>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <array>
 #include <functional>
 #include <memory>
+#include <utility>
+#include <vector>
 #include <asio.hpp>
 
 #if defined(ASIO_HAS_VM_SOCKETS)
@@ -67,6 +72,48 @@ private:
 
 typedef std::shared_ptr<session> session_ptr;
 
+// A session that discards everything it receives and reports the throughput
+// once the client has finished sending. Used with stream_client --bulk.
+class bulk_session
+  : public std::enable_shared_from_this<bulk_session>
+{
+public:
+  bulk_session(stream_protocol::socket socket)
+    : socket_(std::move(socket)),
+      data_(4 * 1024 * 1024),
+      bytes_(0),
+      start_(std::chrono::steady_clock::now())
+  {
+  }
+
+  void start()
+  {
+    auto self(shared_from_this());
+    socket_.async_read_some(asio::buffer(data_),
+        [this, self](std::error_code ec, std::size_t n)
+        {
+          bytes_ += n;
+          if (!ec)
+          {
+            start();
+          }
+          else
+          {
+            double seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start_).count();
+            std::cout << bytes_ << " bytes in " << seconds << "s, "
+              << bytes_ / seconds / 1e6 << " MB/s\n";
+          }
+        });
+  }
+
+private:
+  stream_protocol::socket socket_;
+  std::vector<char> data_;
+  std::size_t bytes_;
+  std::chrono::steady_clock::time_point start_;
+};
+
 class server
 {
 public:
@@ -80,6 +127,14 @@ public:
           asio::placeholders::error));
   }
 
+  server(asio::io_context& io_context, unsigned int port,
+      unsigned long long buffer_size)
+    : io_context_(io_context),
+      acceptor_(io_context, stream_protocol::endpoint(port))
+  {
+    do_bulk_accept(buffer_size);
+  }
+
   void handle_accept(session_ptr new_session,
       const asio::error_code& error)
   {
@@ -95,6 +150,30 @@ public:
   }
 
 private:
+  void do_bulk_accept(unsigned long long buffer_size)
+  {
+    acceptor_.async_accept(
+        [this, buffer_size](std::error_code ec,
+          stream_protocol::socket socket)
+        {
+          if (!ec)
+          {
+            // The receiver's buffer size limits how much data the sender may
+            // have in flight.
+            if (buffer_size)
+            {
+              socket.set_option(
+                  stream_protocol::max_buffer_size(buffer_size), ec);
+              socket.set_option(
+                  stream_protocol::buffer_size(buffer_size), ec);
+            }
+            std::make_shared<bulk_session>(std::move(socket))->start();
+          }
+
+          do_bulk_accept(buffer_size);
+        });
+  }
+
   asio::io_context& io_context_;
   stream_protocol::acceptor acceptor_;
 };
@@ -103,17 +182,35 @@ int main(int argc, char* argv[])
 {
   try
   {
-    if (argc != 2)
+    if (argc < 2)
     {
-      std::cerr << "Usage: stream_server <port>\n";
+      std::cerr << "Usage: stream_server <port> "
+        "[--bulk [--buffer-size <bytes>]]\n";
       return 1;
     }
 
+    bool bulk = false;
+    unsigned long long buffer_size = 0;
+    for (int i = 2; i < argc; ++i)
+    {
+      if (std::strcmp(argv[i], "--bulk") == 0)
+        bulk = true;
+      else if (std::strcmp(argv[i], "--buffer-size") == 0 && i + 1 < argc)
+        buffer_size = std::strtoull(argv[++i], 0, 10);
+    }
+
     asio::io_context io_context;
-    std::remove(argv[1]);
     using namespace std; // For atoi.
-    server s(io_context, atoi(argv[1]));
-    io_context.run();
+    if (bulk)
+    {
+      server s(io_context, atoi(argv[1]), buffer_size);
+      io_context.run();
+    }
+    else
+    {
+      server s(io_context, atoi(argv[1]));
+      io_context.run();
+    }
   }
   catch (std::exception& e)
   {
@@ -0,0 +1,870 @@
+//
+// benchmark.cpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include "asio/experimental/channel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "harness.hpp"
+
+#if defined(BENCHMARK_ENABLE_SSL)
+# include "asio/ssl.hpp"
+#endif // defined(BENCHMARK_ENABLE_SSL)
+
+// Runs a fixed set of scenarios against the backend selected when the program
+// was compiled, and reports their throughput and latency. The same source is
+// built once per backend, so that the results of each build may be compared:
+//
+//   benchmark           the platform's default backend
+//   benchmark_select    compiled with ASIO_DISABLE_EPOLL et al.
+//   benchmark_io_uring  compiled with ASIO_HAS_IO_URING and ASIO_DISABLE_EPOLL
+//
+// All networking scenarios run over the loopback interface.
+
+using asio::ip::tcp;
+using asio::ip::udp;
+using benchmark::clock_type;
+using benchmark::options;
+using benchmark::result;
+using benchmark::scaled;
+using benchmark::stopwatch;
+
+namespace {
+
+void record_latency(result& r, clock_type::time_point start)
+{
+  r.latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        clock_type::now() - start));
+}
+
+//------------------------------------------------------------------------------
+// Handler scheduling.
+
+result post(const options& opts)
+{
+  std::size_t n = scaled(2000000, opts);
+  asio::io_context ioc;
+  std::size_t count = 0;
+
+  stopwatch sw;
+  for (std::size_t i = 0; i < n; ++i)
+    asio::post(ioc, [&count]{ ++count; });
+  ioc.run();
+
+  result r;
+  r.operations = count;
+  r.seconds = sw.seconds();
+  return r;
+}
+
+class chain_handler
+{
+public:
+  chain_handler(asio::io_context& ioc, std::size_t& remaining)
+    : io_context_(&ioc),
+      remaining_(&remaining)
+  {
+  }
+
+  void operator()()
+  {
+    if (--*remaining_ > 0)
+      asio::post(*io_context_, *this);
+  }
+
+private:
+  asio::io_context* io_context_;
+  std::size_t* remaining_;
+};
+
+result post_chain(const options& opts)
+{
+  std::size_t n = scaled(2000000, opts);
+  asio::io_context ioc;
+  std::size_t remaining = n;
+
+  stopwatch sw;
+  asio::post(ioc, chain_handler(ioc, remaining));
+  ioc.run();
+
+  result r;
+  r.operations = n;
+  r.seconds = sw.seconds();
+  return r;
+}
+
+result dispatch(const options& opts)
+{
+  std::size_t n = scaled(10000000, opts);
+  asio::io_context ioc;
+  std::size_t count = 0;
+
+  stopwatch sw;
+  asio::post(ioc,
+      [&]
+      {
+        // Inside a handler dispatch() runs the function immediately.
+        for (std::size_t i = 0; i < n; ++i)
+          asio::dispatch(ioc, [&count]{ ++count; });
+      });
+  ioc.run();
+
+  result r;
+  r.operations = count;
+  r.seconds = sw.seconds();
+  return r;
+}
+
+result post_multithreaded(const options& opts)
+{
+  std::size_t n = scaled(2000000, opts);
+  asio::io_context ioc;
+  std::atomic<std::size_t> count(0);
+
+  stopwatch sw;
+  {
+    auto work = asio::make_work_guard(ioc);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < opts.threads; ++i)
+      threads.emplace_back([&ioc]{ ioc.run(); });
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      asio::post(ioc,
+          [&count]{ count.fetch_add(1, std::memory_order_relaxed); });
+    }
+    work.reset();
+    for (std::size_t i = 0; i < threads.size(); ++i)
+      threads[i].join();
+  }
+
+  result r;
+  r.operations = count;
+  r.seconds = sw.seconds();
+  return r;
+}
+
+result strand_contention(const options& opts)
+{
+  std::size_t n = scaled(1000000, opts);
+  asio::io_context ioc;
+  auto strand = asio::make_strand(ioc);
+  std::size_t count = 0; // Protected by the strand.
+
+  stopwatch sw;
+  {
+    auto work = asio::make_work_guard(ioc);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < opts.threads; ++i)
+      threads.emplace_back([&ioc]{ ioc.run(); });
+
+    // Several producers post to the same strand concurrently.
+    std::vector<std::thread> producers;
+    for (std::size_t i = 0; i < opts.threads; ++i)
+    {
+      producers.emplace_back(
+          [&, i]
+          {
+            std::size_t begin = n * i / opts.threads;
+            std::size_t end = n * (i + 1) / opts.threads;
+            for (std::size_t j = begin; j < end; ++j)
+              asio::post(strand, [&count]{ ++count; });
+          });
+    }
+    for (std::size_t i = 0; i < producers.size(); ++i)
+      producers[i].join();
+
+    work.reset();
+    for (std::size_t i = 0; i < threads.size(); ++i)
+      threads[i].join();
+  }
+
+  result r;
+  r.operations = count;
+  r.seconds = sw.seconds();
+  return r;
+}
+
+//------------------------------------------------------------------------------
+// Fork-join CPU work.
+
+// Recursively split a range, posting the second half of each split back to
+// the pool, and sum the leaves. The same workload is run on thread_pool,
+// which shares one queue between its threads, and on work_stealing_pool.
+template <typename Executor>
+void fork_join_sum(const Executor& ex, const unsigned* first,
+    const unsigned* last, std::atomic<std::uint64_t>& total,
+    std::atomic<std::size_t>& tasks)
+{
+  tasks.fetch_add(1, std::memory_order_relaxed);
+
+  while (last - first > 256)
+  {
+    const unsigned* middle = first + (last - first) / 2;
+    asio::post(ex,
+        [ex, middle, last, &total, &tasks]
+        {
+          fork_join_sum(ex, middle, last, total, tasks);
+        });
+    last = middle;
+  }
+
+  std::uint64_t sum = 0;
+  for (; first != last; ++first)
+    sum += *first * *first;
+  total.fetch_add(sum, std::memory_order_relaxed);
+}
+
+template <typename Pool>
+result fork_join(const options& opts)
+{
+  std::size_t n = scaled(1 << 24, opts);
+  std::vector<unsigned> data(n);
+  for (std::size_t i = 0; i < n; ++i)
+    data[i] = static_cast<unsigned>(i & 0xFFFF);
+
+  std::atomic<std::uint64_t> total(0);
+  std::atomic<std::size_t> tasks(0);
+  std::size_t rounds = 8;
+
+  stopwatch sw;
+  {
+    Pool pool(opts.threads);
+    for (std::size_t i = 0; i < rounds; ++i)
+    {
+      asio::post(pool,
+          [&, ex = pool.get_executor()]
+          {
+            fork_join_sum(ex, data.data(), data.data() + n, total, tasks);
+          });
+    }
+    pool.join();
+  }
+
+  result r;
+  r.operations = tasks;
+  r.bytes = rounds * n * sizeof(unsigned);
+  r.seconds = sw.seconds();
+  return r;
+}
+
+//------------------------------------------------------------------------------
+// Timers.
+
+// Arms a timer and immediately cancels it, so that every iteration inserts
+// into and removes from the timer queue.
+class timer_churn_handler
+{
+public:
+  timer_churn_handler(asio::steady_timer& t, std::size_t& remaining)
+    : timer_(&t),
+      remaining_(&remaining)
+  {
+  }
+
+  void start()
+  {
+    timer_->expires_after(std::chrono::hours(1));
+    timer_->async_wait(*this);
+    timer_->cancel();
+  }
+
+  void operator()(const asio::error_code&)
+  {
+    if (--*remaining_ > 0)
+      start();
+  }
+
+private:
+  asio::steady_timer* timer_;
+  std::size_t* remaining_;
+};
+
+result timer_churn(const options& opts)
+{
+  std::size_t n = scaled(1000000, opts);
+  asio::io_context ioc;
+  asio::steady_timer t(ioc);
+  std::size_t remaining = n;
+
+  stopwatch sw;
+  timer_churn_handler(t, remaining).start();
+  ioc.run();
+
+  result r;
+  r.operations = n;
+  r.seconds = sw.seconds();
+  return r;
+}
+
+// Many timers expiring at random short intervals. The latency is the time
+// from each timer's expiry until its handler runs.
+result timer_expiry(const options& opts)
+{
+  std::size_t n = scaled(200000, opts);
+  const std::size_t num_timers = 1000;
+  asio::io_context ioc;
+  std::vector<std::unique_ptr<asio::steady_timer>> timers;
+  std::minstd_rand random;
+  std::uniform_int_distribution<int> delay(0, 100);
+  std::size_t remaining = n;
+  result r;
+
+  std::function<void(asio::steady_timer&)> start =
+    [&](asio::steady_timer& t)
+    {
+      t.expires_after(std::chrono::microseconds(delay(random)));
+      t.async_wait(
+          [&](const asio::error_code&)
+          {
+            r.latency.record(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  clock_type::now() - t.expiry()));
+            if (remaining > 0)
+            {
+              --remaining;
+              start(t);
+            }
+          });
+    };
+
+  stopwatch sw;
+  for (std::size_t i = 0; i < num_timers && remaining > 0; ++i, --remaining)
+  {
+    timers.emplace_back(new asio::steady_timer(ioc));
+    start(*timers.back());
+  }
+  ioc.run();
+
+  r.operations = r.latency.count();
+  r.seconds = sw.seconds();
+  return r;
+}
+
+//------------------------------------------------------------------------------
+// Networking.
+
+const std::size_t echo_message_size = 64;
+
+class tcp_echo_session
+  : public std::enable_shared_from_this<tcp_echo_session>
+{
+public:
+  explicit tcp_echo_session(tcp::socket socket)
+    : socket_(std::move(socket))
+  {
+  }
+
+  void start()
+  {
+    auto self = shared_from_this();
+    socket_.async_read_some(asio::buffer(data_),
+        [this, self](const asio::error_code& ec, std::size_t n)
+        {
+          if (!ec)
+          {
+            asio::async_write(socket_, asio::buffer(data_, n),
+                [this, self](const asio::error_code& ec, std::size_t)
+                {
+                  if (!ec)
+                    start();
+                });
+          }
+        });
+  }
+
+private:
+  tcp::socket socket_;
+  char data_[echo_message_size];
+};
+
+// Round trip latency of a small message over a single TCP connection. The
+// server runs on its own thread and io_context.
+result tcp_echo(const options& opts)
+{
+  std::size_t n = scaled(50000, opts);
+
+  asio::io_context server_ioc;
+  tcp::acceptor acceptor(server_ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  acceptor.async_accept(
+      [](const asio::error_code& ec, tcp::socket socket)
+      {
+        if (!ec)
+        {
+          socket.set_option(tcp::no_delay(true));
+          std::make_shared<tcp_echo_session>(std::move(socket))->start();
+        }
+      });
+  std::thread server_thread([&server_ioc]{ server_ioc.run(); });
+
+  asio::io_context ioc;
+  tcp::socket socket(ioc);
+  socket.connect(acceptor.local_endpoint());
+  socket.set_option(tcp::no_delay(true));
+
+  char message[echo_message_size] = {};
+  char reply[echo_message_size];
+  std::size_t remaining = n;
+  clock_type::time_point start;
+  result r;
+
+  std::function<void()> round_trip =
+    [&]
+    {
+      start = clock_type::now();
+      asio::async_write(socket, asio::buffer(message),
+          [&](const asio::error_code& ec, std::size_t)
+          {
+            if (ec)
+              return;
+            asio::async_read(socket, asio::buffer(reply),
+                [&](const asio::error_code& ec, std::size_t)
+                {
+                  if (ec)
+                    return;
+                  record_latency(r, start);
+                  if (--remaining > 0)
+                    round_trip();
+                });
+          });
+    };
+
+  stopwatch sw;
+  round_trip();
+  ioc.run();
+  r.seconds = sw.seconds();
+  r.operations = r.latency.count();
+
+  socket.close();
+  server_thread.join();
+  return r;
+}
+
+// Round trip latency of a small datagram.
+result udp_echo(const options& opts)
+{
+  std::size_t n = scaled(50000, opts);
+
+  asio::io_context server_ioc;
+  udp::socket server(server_ioc,
+      udp::endpoint(asio::ip::address_v4::loopback(), 0));
+  char server_data[echo_message_size];
+  udp::endpoint sender;
+  std::size_t server_remaining = n;
+
+  std::function<void()> serve =
+    [&]
+    {
+      server.async_receive_from(asio::buffer(server_data), sender,
+          [&](const asio::error_code& ec, std::size_t bytes)
+          {
+            if (ec)
+              return;
+            server.async_send_to(asio::buffer(server_data, bytes), sender,
+                [&](const asio::error_code& ec, std::size_t)
+                {
+                  if (!ec && --server_remaining > 0)
+                    serve();
+                });
+          });
+    };
+  serve();
+  std::thread server_thread([&server_ioc]{ server_ioc.run(); });
+
+  asio::io_context ioc;
+  udp::socket socket(ioc, udp::endpoint(asio::ip::address_v4::loopback(), 0));
+  socket.connect(server.local_endpoint());
+
+  char message[echo_message_size] = {};
+  char reply[echo_message_size];
+  std::size_t remaining = n;
+  clock_type::time_point start;
+  result r;
+
+  std::function<void()> round_trip =
+    [&]
+    {
+      start = clock_type::now();
+      socket.async_send(asio::buffer(message),
+          [&](const asio::error_code& ec, std::size_t)
+          {
+            if (ec)
+              return;
+            socket.async_receive(asio::buffer(reply),
+                [&](const asio::error_code& ec, std::size_t)
+                {
+                  if (ec)
+                    return;
+                  record_latency(r, start);
+                  if (--remaining > 0)
+                    round_trip();
+                });
+          });
+    };
+
+  stopwatch sw;
+  round_trip();
+  ioc.run();
+  r.seconds = sw.seconds();
+  r.operations = r.latency.count();
+
+  server_thread.join();
+  return r;
+}
+
+#if defined(BENCHMARK_ENABLE_SSL)
+
+// Generate a temporary self-signed certificate for the server.
+void use_temporary_certificate(asio::ssl::context& ctx)
+{
+  EVP_PKEY_CTX* pctx = ::EVP_PKEY_CTX_new_id(EVP_PKEY_EC, 0);
+  EVP_PKEY* pkey = 0;
+  ::EVP_PKEY_keygen_init(pctx);
+  ::EVP_PKEY_CTX_set_ec_paramgen_curve_nid(pctx, NID_X9_62_prime256v1);
+  ::EVP_PKEY_keygen(pctx, &pkey);
+  ::EVP_PKEY_CTX_free(pctx);
+
+  X509* cert = ::X509_new();
+  ::X509_set_version(cert, 2);
+  ::ASN1_INTEGER_set(::X509_get_serialNumber(cert), 1);
+  ::X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+  ::X509_gmtime_adj(X509_getm_notAfter(cert), 24 * 60 * 60);
+  ::X509_set_pubkey(cert, pkey);
+  X509_NAME* name = ::X509_get_subject_name(cert);
+  ::X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+      reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+  ::X509_set_issuer_name(cert, name);
+  ::X509_sign(cert, pkey, ::EVP_sha256());
+
+  ::SSL_CTX_use_certificate(ctx.native_handle(), cert);
+  ::SSL_CTX_use_PrivateKey(ctx.native_handle(), pkey);
+  ::X509_free(cert);
+  ::EVP_PKEY_free(pkey);
+}
+
+// Bulk transfer from server to client over TLS.
+result ssl_bulk(const options& opts)
+{
+  typedef asio::ssl::stream<tcp::socket> ssl_socket;
+  std::size_t total = scaled(512 * 1024 * 1024, opts);
+  const std::size_t chunk_size = 64 * 1024;
+
+  asio::ssl::context server_ctx(asio::ssl::context::tls_server);
+  use_temporary_certificate(server_ctx);
+  asio::ssl::context client_ctx(asio::ssl::context::tls_client);
+  client_ctx.set_verify_mode(asio::ssl::verify_none);
+
+  asio::io_context server_ioc;
+  tcp::acceptor acceptor(server_ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  std::vector<char> server_data(chunk_size);
+  ssl_socket server(server_ioc, server_ctx);
+  std::size_t sent = 0;
+
+  std::function<void()> send =
+    [&]
+    {
+      std::size_t n = std::min(chunk_size, total - sent);
+      asio::async_write(server, asio::buffer(server_data, n),
+          [&](const asio::error_code& ec, std::size_t n)
+          {
+            sent += n;
+            if (!ec && sent < total)
+              send();
+          });
+    };
+  acceptor.async_accept(server.lowest_layer(),
+      [&](const asio::error_code& ec)
+      {
+        if (!ec)
+        {
+          server.async_handshake(asio::ssl::stream_base::server,
+              [&](const asio::error_code& ec)
+              {
+                if (!ec)
+                  send();
+              });
+        }
+      });
+  std::thread server_thread([&server_ioc]{ server_ioc.run(); });
+
+  asio::io_context ioc;
+  ssl_socket client(ioc, client_ctx);
+  client.lowest_layer().connect(acceptor.local_endpoint());
+  client.handshake(asio::ssl::stream_base::client);
+
+  std::vector<char> client_data(chunk_size);
+  std::size_t received = 0;
+  result r;
+
+  std::function<void()> receive =
+    [&]
+    {
+      client.async_read_some(asio::buffer(client_data),
+          [&](const asio::error_code& ec, std::size_t n)
+          {
+            received += n;
+            ++r.operations;
+            if (!ec && received < total)
+              receive();
+          });
+    };
+
+  stopwatch sw;
+  receive();
+  ioc.run();
+  r.seconds = sw.seconds();
+  r.bytes = received;
+
+  server_thread.join();
+  return r;
+}
+
+#endif // defined(BENCHMARK_ENABLE_SSL)
+
+//------------------------------------------------------------------------------
+// Channels and coroutines.
+
+typedef asio::experimental::channel<void(asio::error_code, std::size_t)>
+  ping_channel;
+
+// Two actors exchange a value through a pair of unbuffered channels. Each
+// operation is one complete round trip.
+result channel_ping_pong(const options& opts)
+{
+  std::size_t n = scaled(500000, opts);
+  asio::io_context ioc;
+  ping_channel ping(ioc);
+  ping_channel pong(ioc);
+  result r;
+
+  std::function<void()> ponger =
+    [&]
+    {
+      ping.async_receive(
+          [&](const asio::error_code& ec, std::size_t value)
+          {
+            if (ec)
+              return;
+            pong.async_send(asio::error_code(), value,
+                [&](const asio::error_code& ec)
+                {
+                  if (!ec)
+                    ponger();
+                });
+          });
+    };
+
+  std::function<void(std::size_t)> pinger =
+    [&](std::size_t value)
+    {
+      ping.async_send(asio::error_code(), value,
+          [&, value](const asio::error_code& ec)
+          {
+            if (ec)
+              return;
+            pong.async_receive(
+                [&](const asio::error_code& ec, std::size_t value)
+                {
+                  if (ec)
+                    return;
+                  ++r.operations;
+                  if (value + 1 < n)
+                    pinger(value + 1);
+                  else
+                    ping.close();
+                });
+          });
+    };
+
+  stopwatch sw;
+  ponger();
+  pinger(0);
+  ioc.run();
+  r.seconds = sw.seconds();
+  return r;
+}
+
+#if defined(ASIO_HAS_CO_AWAIT)
+
+// A coroutine that yields to the io_context on each iteration. Compare with
+// post_chain for the overhead of the coroutine machinery.
+result coroutine_post(const options& opts)
+{
+  std::size_t n = scaled(2000000, opts);
+  asio::io_context ioc;
+  result r;
+
+  stopwatch sw;
+  asio::co_spawn(ioc,
+      [&]() -> asio::awaitable<void>
+      {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          co_await asio::post(ioc, asio::use_awaitable);
+          ++r.operations;
+        }
+      }, asio::detached);
+  ioc.run();
+  r.seconds = sw.seconds();
+  return r;
+}
+
+asio::awaitable<std::size_t> coroutine_increment(std::size_t value)
+{
+  co_return value + 1;
+}
+
+// A coroutine that calls another coroutine on each iteration, measuring the
+// cost of creating, resuming and destroying a coroutine frame.
+result coroutine_call(const options& opts)
+{
+  std::size_t n = scaled(5000000, opts);
+  asio::io_context ioc;
+  result r;
+
+  stopwatch sw;
+  asio::co_spawn(ioc,
+      [&]() -> asio::awaitable<void>
+      {
+        for (std::size_t i = 0; i < n; ++i)
+          r.operations = co_await coroutine_increment(
+              static_cast<std::size_t>(r.operations));
+      }, asio::detached);
+  ioc.run();
+  r.seconds = sw.seconds();
+  return r;
+}
+
+#endif // defined(ASIO_HAS_CO_AWAIT)
+
+const benchmark::scenario scenarios[] =
+{
+  { "post", "post many handlers, then run them", post },
+  { "post_chain", "each handler posts the next", post_chain },
+  { "dispatch", "dispatch from inside a handler", dispatch },
+  { "post_multithreaded", "post to an io_context run by several threads",
+    post_multithreaded },
+  { "strand_contention", "several threads post to one strand",
+    strand_contention },
+  { "fork_join_thread_pool", "recursive fork-join sum on a thread_pool",
+    fork_join<asio::thread_pool> },
+  { "fork_join_work_stealing",
+    "recursive fork-join sum on a work_stealing_pool",
+    fork_join<asio::work_stealing_pool> },
+  { "timer_churn", "arm and cancel a timer", timer_churn },
+  { "timer_expiry", "many timers expiring at short intervals",
+    timer_expiry },
+  { "tcp_echo", "round trip latency over a TCP connection", tcp_echo },
+  { "udp_echo", "round trip latency of a UDP datagram", udp_echo },
+#if defined(BENCHMARK_ENABLE_SSL)
+  { "ssl_bulk", "bulk transfer over TLS", ssl_bulk },
+#endif // defined(BENCHMARK_ENABLE_SSL)
+  { "channel_ping_pong", "round trip through a pair of channels",
+    channel_ping_pong },
+#if defined(ASIO_HAS_CO_AWAIT)
+  { "coroutine_post", "coroutine yielding via post", coroutine_post },
+  { "coroutine_call", "coroutine calling a coroutine", coroutine_call },
+#endif // defined(ASIO_HAS_CO_AWAIT)
+};
+
+void usage()
+{
+  std::fprintf(stderr,
+      "Usage: benchmark [--json <file>] [--scale <factor>] "
+      "[--threads <n>] [--list] [scenario ...]\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    options opts;
+    opts.scale = 1.0;
+    opts.threads = std::max(2u, std::min(4u,
+          std::thread::hardware_concurrency()));
+    const char* json_file = 0;
+    std::vector<std::string> selected;
+
+    for (int i = 1; i < argc; ++i)
+    {
+      if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+        json_file = argv[++i];
+      else if (std::strcmp(argv[i], "--scale") == 0 && i + 1 < argc)
+        opts.scale = std::atof(argv[++i]);
+      else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        opts.threads = std::max(1, std::atoi(argv[++i]));
+      else if (std::strcmp(argv[i], "--list") == 0)
+      {
+        for (const benchmark::scenario& s : scenarios)
+          std::printf("%-24s %s\n", s.name, s.description);
+        return 0;
+      }
+      else if (argv[i][0] == '-')
+      {
+        usage();
+        return 1;
+      }
+      else
+        selected.push_back(argv[i]);
+    }
+
+    // When the JSON is written to stdout, the summary goes to stderr.
+    bool json_to_stdout = json_file && std::strcmp(json_file, "-") == 0;
+    std::FILE* text_out = json_to_stdout ? stderr : stdout;
+    std::fprintf(text_out, "backend: %s\n", benchmark::backend_name());
+
+    std::vector<std::pair<const benchmark::scenario*, result> > results;
+    for (const benchmark::scenario& s : scenarios)
+    {
+      if (!selected.empty() && std::find(selected.begin(),
+            selected.end(), s.name) == selected.end())
+        continue;
+
+      result r = s.run(opts);
+      benchmark::write_text(text_out, s.name, r);
+      std::fflush(text_out);
+      results.push_back(std::make_pair(&s, r));
+    }
+
+    if (json_to_stdout)
+      benchmark::write_json(stdout, opts, results);
+    else if (json_file)
+    {
+      std::FILE* f = std::fopen(json_file, "w");
+      if (!f)
+      {
+        std::fprintf(stderr, "Cannot open %s\n", json_file);
+        return 1;
+      }
+      benchmark::write_json(f, opts, results);
+      std::fclose(f);
+    }
+  }
+  catch (std::exception& e)
+  {
+    std::fprintf(stderr, "Exception: %s\n", e.what());
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,183 @@
+//
+// harness.hpp
+// ~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BENCHMARK_HARNESS_HPP
+#define BENCHMARK_HARNESS_HPP
+
+#include "asio/detail/config.hpp"
+#include "asio/latency_histogram.hpp"
+#include "asio/version.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+namespace benchmark {
+
+typedef std::chrono::steady_clock clock_type;
+
+// The name of the reactor or proactor selected by the configuration macros.
+inline const char* backend_name()
+{
+#if defined(ASIO_HAS_IOCP)
+  return "iocp";
+#elif defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  return "io_uring";
+#elif defined(ASIO_HAS_EPOLL)
+  return "epoll";
+#elif defined(ASIO_HAS_KQUEUE)
+  return "kqueue";
+#elif defined(ASIO_HAS_DEV_POLL)
+  return "dev_poll";
+#else
+  return "select";
+#endif
+}
+
+// Options that apply to all scenarios.
+struct options
+{
+  // Multiplier applied to the number of iterations of each scenario.
+  double scale;
+
+  // The number of threads used by multithreaded scenarios.
+  std::size_t threads;
+};
+
+// Scale an iteration count, running at least one iteration.
+inline std::size_t scaled(std::size_t n, const options& opts)
+{
+  double s = static_cast<double>(n) * opts.scale;
+  return s < 1.0 ? 1 : static_cast<std::size_t>(s);
+}
+
+// The outcome of running one scenario.
+struct result
+{
+  result()
+    : operations(0),
+      bytes(0),
+      seconds(0)
+  {
+  }
+
+  // The number of operations performed.
+  std::uint64_t operations;
+
+  // The number of bytes transferred, for throughput scenarios.
+  std::uint64_t bytes;
+
+  // The elapsed wall clock time.
+  double seconds;
+
+  // The latency of individual operations, for latency scenarios.
+  asio::latency_histogram latency;
+};
+
+// Measures elapsed wall clock time.
+class stopwatch
+{
+public:
+  stopwatch()
+    : start_(clock_type::now())
+  {
+  }
+
+  double seconds() const
+  {
+    return std::chrono::duration<double>(clock_type::now() - start_).count();
+  }
+
+private:
+  clock_type::time_point start_;
+};
+
+// A scenario and the function that runs it.
+struct scenario
+{
+  const char* name;
+  const char* description;
+  result (*run)(const options&);
+};
+
+inline double per_second(std::uint64_t n, double seconds)
+{
+  return seconds > 0 ? static_cast<double>(n) / seconds : 0;
+}
+
+// Write a human readable summary of a result.
+inline void write_text(std::FILE* out, const char* name, const result& r)
+{
+  std::fprintf(out, "%-24s %10llu ops %9.3fs %14.0f ops/s",
+      name, static_cast<unsigned long long>(r.operations),
+      r.seconds, per_second(r.operations, r.seconds));
+  if (r.bytes)
+    std::fprintf(out, " %10.1f MB/s", per_second(r.bytes, r.seconds) / 1e6);
+  if (r.latency.count())
+  {
+    std::fprintf(out, "  p50 %lldns p99 %lldns p99.9 %lldns",
+        static_cast<long long>(r.latency.percentile(50).count()),
+        static_cast<long long>(r.latency.percentile(99).count()),
+        static_cast<long long>(r.latency.percentile(99.9).count()));
+  }
+  std::fprintf(out, "\n");
+}
+
+// Write the results of a run as a JSON document, for regression tracking.
+inline void write_json(std::FILE* out, const options& opts,
+    const std::vector<std::pair<const scenario*, result> >& results)
+{
+  std::fprintf(out, "{\n");
+  std::fprintf(out, "  \"asio_version\": %d,\n", ASIO_VERSION);
+  std::fprintf(out, "  \"backend\": \"%s\",\n", backend_name());
+  std::fprintf(out, "  \"scale\": %g,\n", opts.scale);
+  std::fprintf(out, "  \"threads\": %llu,\n",
+      static_cast<unsigned long long>(opts.threads));
+  std::fprintf(out, "  \"results\": [");
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    const result& r = results[i].second;
+    std::fprintf(out, "%s\n    {\n", i == 0 ? "" : ",");
+    std::fprintf(out, "      \"name\": \"%s\",\n", results[i].first->name);
+    std::fprintf(out, "      \"operations\": %llu,\n",
+        static_cast<unsigned long long>(r.operations));
+    std::fprintf(out, "      \"seconds\": %.9f,\n", r.seconds);
+    std::fprintf(out, "      \"operations_per_second\": %.3f",
+        per_second(r.operations, r.seconds));
+    if (r.bytes)
+    {
+      std::fprintf(out, ",\n      \"bytes\": %llu,\n",
+          static_cast<unsigned long long>(r.bytes));
+      std::fprintf(out, "      \"bytes_per_second\": %.3f",
+          per_second(r.bytes, r.seconds));
+    }
+    if (r.latency.count())
+    {
+      static const double percentiles[] = { 50, 90, 99, 99.9, 100 };
+      static const char* names[] = { "p50", "p90", "p99", "p99_9", "max" };
+      std::fprintf(out, ",\n      \"latency_ns\": {");
+      for (std::size_t j = 0; j < 5; ++j)
+      {
+        std::fprintf(out, "%s\"%s\": %lld", j == 0 ? " " : ", ", names[j],
+            static_cast<long long>(
+              r.latency.percentile(percentiles[j]).count()));
+      }
+      std::fprintf(out, " }");
+    }
+    std::fprintf(out, "\n    }");
+  }
+  std::fprintf(out, "\n  ]\n}\n");
+}
+
+} // namespace benchmark
+
+#endif // BENCHMARK_HARNESS_HPP
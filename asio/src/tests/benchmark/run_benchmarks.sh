@@ -0,0 +1,34 @@
+#!/bin/sh
+#
+# run_benchmarks.sh
+# ~~~~~~~~~~~~~~~~~
+#
+# Runs each backend build of the benchmark program found in the given
+# directory, and writes a JSON array of their results to stdout. A summary of
+# each run is written to stderr. Any further arguments are passed on to the
+# benchmark programs. For example:
+#
+#   sh run_benchmarks.sh . --scale 0.5 > results.json
+#
+# Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#
+
+dir=.
+if [ $# -gt 0 ]; then
+  dir=$1
+  shift
+fi
+
+separator=""
+echo "["
+for program in benchmark benchmark_select benchmark_io_uring; do
+  if [ -x "$dir/$program" ]; then
+    printf "%s" "$separator"
+    "$dir/$program" --json - "$@" || exit 1
+    separator=","
+  fi
+done
+echo "]"
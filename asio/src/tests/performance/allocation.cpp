@@ -0,0 +1,150 @@
+//
+// allocation.cpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+// Measures handler allocation throughput. In the "local" scenario handlers are
+// allocated and freed by the same thread. In the "remote" scenario handlers
+// bounce between two io_context objects, each run on its own thread, so every
+// handler is freed by a thread other than the one that allocated it.
+
+template <std::size_t Size>
+class local_handler
+{
+public:
+  local_handler(asio::io_context& ioc, std::size_t remaining)
+    : io_context_(&ioc),
+      remaining_(remaining)
+  {
+  }
+
+  void operator()()
+  {
+    if (--remaining_ > 0)
+      asio::post(*io_context_, *this);
+  }
+
+private:
+  asio::io_context* io_context_;
+  std::size_t remaining_;
+  char payload_[Size];
+};
+
+template <std::size_t Size>
+class remote_handler
+{
+public:
+  remote_handler(asio::io_context& here, asio::io_context& there,
+      std::size_t remaining, std::atomic<std::size_t>& live)
+    : here_(&here),
+      there_(&there),
+      remaining_(remaining),
+      live_(&live)
+  {
+  }
+
+  void operator()()
+  {
+    if (--remaining_ > 0)
+    {
+      std::swap(here_, there_);
+      asio::post(*here_, *this);
+    }
+    else if (--(*live_) == 0)
+    {
+      here_->stop();
+      there_->stop();
+    }
+  }
+
+private:
+  asio::io_context* here_;
+  asio::io_context* there_;
+  std::size_t remaining_;
+  std::atomic<std::size_t>* live_;
+  char payload_[Size];
+};
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+}
+
+template <std::size_t Size>
+void run_local(std::size_t chains, std::size_t iterations)
+{
+  asio::io_context ioc;
+  for (std::size_t i = 0; i < chains; ++i)
+    asio::post(ioc, local_handler<Size>(ioc, iterations));
+
+  std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+  ioc.run();
+  double elapsed = seconds_since(start);
+
+  std::printf("local   %5lu bytes: %12.0f handlers/sec\n",
+      static_cast<unsigned long>(Size), chains * iterations / elapsed);
+}
+
+template <std::size_t Size>
+void run_remote(std::size_t chains, std::size_t iterations)
+{
+  asio::io_context ioc1(1), ioc2(1);
+  asio::executor_work_guard<asio::io_context::executor_type>
+    work1(ioc1.get_executor()), work2(ioc2.get_executor());
+  std::atomic<std::size_t> live(chains);
+  for (std::size_t i = 0; i < chains; ++i)
+    asio::post(ioc1, remote_handler<Size>(ioc1, ioc2, iterations, live));
+
+  std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+  std::thread t([&]{ ioc2.run(); });
+  ioc1.run();
+  t.join();
+  double elapsed = seconds_since(start);
+
+  std::printf("remote  %5lu bytes: %12.0f handlers/sec\n",
+      static_cast<unsigned long>(Size), chains * iterations / elapsed);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    std::fprintf(stderr, "Usage: allocation <chains> <iterations>\n");
+    return 1;
+  }
+
+  std::size_t chains = std::atoi(argv[1]);
+  std::size_t iterations = std::atoi(argv[2]);
+
+  run_local<16>(chains, iterations);
+  run_local<256>(chains, iterations);
+  run_local<2048>(chains, iterations);
+  run_remote<16>(chains, iterations);
+  run_remote<256>(chains, iterations);
+  run_remote<2048>(chains, iterations);
+
+  asio::recycling_allocator_statistics stats =
+    asio::get_recycling_allocator_statistics();
+  std::printf("hits: %lu, misses: %lu, uncached: %lu, remote: %lu\n",
+      static_cast<unsigned long>(stats.hits),
+      static_cast<unsigned long>(stats.misses),
+      static_cast<unsigned long>(stats.uncached),
+      static_cast<unsigned long>(stats.remote_deallocations));
+
+  return 0;
+}
@@ -0,0 +1,118 @@
+//
+// coroutine_echo.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// Measures the request rate of a coroutine-based echo server, where each
+// request is handled by a chain of nested co_await calls. The clients and the
+// server share one io_context and communicate over the loopback interface.
+// Compile with ASIO_DISABLE_FRAME_ARENA to compare against frames allocated
+// from the thread's recycling cache.
+
+using asio::ip::tcp;
+using asio::awaitable;
+using asio::use_awaitable;
+
+awaitable<std::size_t> handle_request(char* data,
+    std::size_t length, int depth)
+{
+  if (depth == 0)
+    co_return length;
+
+  // Give each frame some local state so that frames are not trivially small.
+  char scratch[64];
+  scratch[0] = data[0];
+  std::size_t n = co_await handle_request(data, length, depth - 1);
+  data[0] = scratch[0];
+  co_return n;
+}
+
+awaitable<void> session(tcp::socket socket, int depth)
+{
+  try
+  {
+    char data[128];
+    for (;;)
+    {
+      std::size_t n = co_await socket.async_read_some(
+          asio::buffer(data), use_awaitable);
+      n = co_await handle_request(data, n, depth);
+      co_await asio::async_write(socket,
+          asio::buffer(data, n), use_awaitable);
+    }
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+awaitable<void> listener(tcp::acceptor& acceptor,
+    std::size_t sessions, int depth)
+{
+  for (std::size_t i = 0; i < sessions; ++i)
+  {
+    tcp::socket socket = co_await acceptor.async_accept(use_awaitable);
+    socket.set_option(tcp::no_delay(true));
+    asio::co_spawn(acceptor.get_executor(),
+        session(std::move(socket), depth), asio::detached);
+  }
+}
+
+awaitable<void> client(tcp::endpoint endpoint, std::size_t requests)
+{
+  tcp::socket socket(co_await asio::this_coro::executor);
+  co_await socket.async_connect(endpoint, use_awaitable);
+  socket.set_option(tcp::no_delay(true));
+
+  char data[64] = "";
+  for (std::size_t i = 0; i < requests; ++i)
+  {
+    co_await asio::async_write(socket, asio::buffer(data), use_awaitable);
+    co_await asio::async_read(socket, asio::buffer(data), use_awaitable);
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::fprintf(stderr,
+        "Usage: coroutine_echo <clients> <requests> <depth>\n");
+    return 1;
+  }
+
+  std::size_t clients = std::atoi(argv[1]);
+  std::size_t requests = std::atoi(argv[2]);
+  int depth = std::atoi(argv[3]);
+
+  asio::io_context ioc(1);
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+  asio::co_spawn(ioc, listener(acceptor, clients, depth), asio::detached);
+  for (std::size_t i = 0; i < clients; ++i)
+    asio::co_spawn(ioc, client(acceptor.local_endpoint(), requests),
+        asio::detached);
+
+  std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+  ioc.run();
+  double elapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  std::printf("%lu clients, depth %d: %12.0f requests/sec\n",
+      static_cast<unsigned long>(clients), depth,
+      clients * requests / elapsed);
+
+  return 0;
+}
@@ -0,0 +1,165 @@
+//
+// deferred_chain.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "../unit/archetypes/counting_allocator.hpp"
+
+// Compares a chain of asynchronous operations composed with deferred, as in
+// the examples in src/examples/cpp14/deferred, against the equivalent chain
+// written with nested completion handlers. Each chain waits on a timer twice
+// and then produces a value. The timer has already expired, so the cost is
+// dominated by the operations themselves rather than by waiting.
+//
+// Both chains are run with the default allocator and with an allocator that
+// counts allocations, to show the number of allocations made per chain.
+
+using asio::deferred;
+
+template <typename CompletionToken>
+auto async_wait_twice_deferred(asio::steady_timer& timer,
+    CompletionToken&& token)
+{
+  return timer.async_wait(
+      deferred(
+        [&](std::error_code)
+        {
+          return timer.async_wait(deferred);
+        }
+      )
+    )(
+      deferred(
+        [](std::error_code)
+        {
+          return deferred.values(42);
+        }
+      )
+    )(
+      std::forward<CompletionToken>(token)
+    );
+}
+
+template <typename Handler>
+void async_wait_twice_callback(asio::steady_timer& timer, Handler handler)
+{
+  auto allocator = asio::get_associated_allocator(handler);
+  timer.async_wait(
+      asio::bind_allocator(allocator,
+        [&timer, allocator, handler = std::move(handler)](
+          std::error_code) mutable
+        {
+          timer.async_wait(
+              asio::bind_allocator(allocator,
+                [handler = std::move(handler)](std::error_code) mutable
+                {
+                  std::move(handler)(42);
+                }
+              )
+            );
+        }
+      )
+    );
+}
+
+struct deferred_chain
+{
+  template <typename Handler>
+  void operator()(asio::steady_timer& timer, Handler&& handler) const
+  {
+    async_wait_twice_deferred(timer, std::forward<Handler>(handler));
+  }
+};
+
+struct callback_chain
+{
+  template <typename Handler>
+  void operator()(asio::steady_timer& timer, Handler&& handler) const
+  {
+    async_wait_twice_callback(timer, std::forward<Handler>(handler));
+  }
+};
+
+// Restarts the chain from its own completion handler until done.
+template <typename Chain, typename Allocator>
+class chain_handler
+{
+public:
+  typedef Allocator allocator_type;
+
+  chain_handler(asio::steady_timer& timer,
+      std::size_t remaining, const Allocator& allocator)
+    : timer_(&timer),
+      remaining_(remaining),
+      allocator_(allocator)
+  {
+  }
+
+  allocator_type get_allocator() const noexcept
+  {
+    return allocator_;
+  }
+
+  void operator()(int)
+  {
+    if (--remaining_ > 0)
+      Chain()(*timer_, std::move(*this));
+  }
+
+private:
+  asio::steady_timer* timer_;
+  std::size_t remaining_;
+  Allocator allocator_;
+};
+
+template <typename Chain, typename Allocator>
+double run(std::size_t chains, const Allocator& allocator)
+{
+  asio::io_context ioc(1);
+  asio::steady_timer timer(ioc, asio::steady_timer::time_point::min());
+  Chain()(timer, chain_handler<Chain, Allocator>(timer, chains, allocator));
+
+  std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+  ioc.run();
+  return std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename Chain>
+void run_chain(const char* name, std::size_t chains)
+{
+  double elapsed = run<Chain>(chains, std::allocator<void>());
+  std::printf("%-8s default: %12.0f chains/sec\n", name, chains / elapsed);
+
+  int allocations = 0;
+  int deallocations = 0;
+  elapsed = run<Chain>(chains,
+      archetypes::counting_allocator<void>(&allocations, &deallocations));
+  std::printf("%-8s counted: %12.0f chains/sec, %.2f allocations/chain\n",
+      name, chains / elapsed, static_cast<double>(allocations) / chains);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::fprintf(stderr, "Usage: deferred_chain <chains>\n");
+    return 1;
+  }
+
+  std::size_t chains = std::atoi(argv[1]);
+
+  run_chain<callback_chain>("callback", chains);
+  run_chain<deferred_chain>("deferred", chains);
+
+  return 0;
+}
@@ -0,0 +1,165 @@
+//
+// read_until.cpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// Measures the throughput of read_until when the delimiter is at the end of a
+// message of the given size. The message is read from memory in chunks, as it
+// would be from a socket, so that the delimiter search is resumed after each
+// read. The byte-at-a-time search that read_until used previously is measured
+// for comparison. Compile with ASIO_DISABLE_AVX2 or ASIO_DISABLE_SSE2 to
+// compare the different instruction sets.
+
+class memory_stream
+{
+public:
+  memory_stream(const std::string& data, std::size_t chunk_size)
+    : data_(data),
+      position_(0),
+      chunk_size_(chunk_size)
+  {
+  }
+
+  void rewind()
+  {
+    position_ = 0;
+  }
+
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    ec = asio::error_code();
+    std::size_t n = asio::buffer_copy(buffers,
+        asio::buffer(data_) + position_, chunk_size_);
+    if (n == 0)
+      ec = asio::error::eof;
+    position_ += n;
+    return n;
+  }
+
+private:
+  const std::string& data_;
+  std::size_t position_;
+  std::size_t chunk_size_;
+};
+
+// The search previously used by read_until, which inspects the data one byte
+// at a time through a buffers_iterator.
+std::size_t bytewise_read_until(memory_stream& s,
+    std::string& buffer, const std::string& delim)
+{
+  std::size_t search_position = 0;
+  for (;;)
+  {
+    typedef asio::buffers_iterator<asio::const_buffer> iterator;
+    asio::const_buffer data_buffer = asio::buffer(buffer);
+    iterator begin = iterator::begin(data_buffer);
+    iterator end = iterator::end(data_buffer);
+    iterator iter = std::search(begin + search_position,
+        end, delim.begin(), delim.end());
+    if (iter != end)
+      return iter - begin + delim.length();
+    search_position = buffer.size() < delim.length() - 1
+      ? 0 : buffer.size() - (delim.length() - 1);
+
+    asio::error_code ec;
+    std::size_t pos = buffer.size();
+    buffer.resize(pos + 65536);
+    buffer.resize(pos + s.read_some(asio::buffer(&buffer[pos], 65536), ec));
+    if (ec)
+      return 0;
+  }
+}
+
+std::size_t asio_read_until(memory_stream& s,
+    std::string& buffer, const std::string& delim)
+{
+  asio::error_code ec;
+  return asio::read_until(s, asio::dynamic_buffer(buffer), delim, ec);
+}
+
+template <typename ReadUntil>
+double run(ReadUntil read_until, const std::string& message,
+    const std::string& delim, std::size_t iterations)
+{
+  memory_stream s(message, 4096);
+  std::string buffer;
+  buffer.reserve(message.size() + 65536);
+
+  std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; ++i)
+  {
+    s.rewind();
+    buffer.clear();
+    if (read_until(s, buffer, delim) != message.size())
+    {
+      std::fprintf(stderr, "Delimiter not found\n");
+      std::exit(1);
+    }
+  }
+  return std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::fprintf(stderr, "Usage: read_until <megabytes>\n");
+    return 1;
+  }
+
+  double total = std::atof(argv[1]) * 1024 * 1024;
+
+  static const char* const delims[] = { "\r\n", "\r\n\r\n" };
+  static const char* const names[] = { "CRLF", "CRLFCRLF" };
+  static const std::size_t sizes[] = { 1024, 16384, 65536, 1048576 };
+
+  for (std::size_t d = 0; d < 2; ++d)
+  {
+    std::string delim(delims[d]);
+    for (std::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+      // Header-like text containing line breaks, but no delimiter until the
+      // end of the message.
+      std::string line = d == 0
+        ? "Header-Name: header value\n" : "Header-Name: header value\r\n";
+      std::string message;
+      while (message.size() < sizes[i])
+        message += line;
+      message.resize(sizes[i] - delim.size());
+      for (std::size_t j = message.size();
+          message[j - 1] == '\r' || message[j - 1] == '\n'; --j)
+        message[j - 1] = 'x';
+      message += delim;
+
+      std::size_t iterations = static_cast<std::size_t>(
+          std::max<double>(1, total / sizes[i]));
+      double bytewise = run(bytewise_read_until, message, delim, iterations);
+      double vectorised = run(asio_read_until, message, delim, iterations);
+
+      std::printf("%-8s %8lu bytes: bytewise %8.1f MB/s,"
+          " read_until %8.1f MB/s\n", names[d],
+          static_cast<unsigned long>(sizes[i]),
+          sizes[i] * iterations / bytewise / 1048576,
+          sizes[i] * iterations / vectorised / 1048576);
+    }
+  }
+
+  return 0;
+}
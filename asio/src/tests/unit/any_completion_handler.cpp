@@ -24,6 +24,7 @@
 #include "asio/bind_executor.hpp"
 #include "asio/bind_immediate_executor.hpp"
 #include "asio/error.hpp"
+#include "asio/post.hpp"
 #include "asio/thread_pool.hpp"
 
 namespace bindns = std;
@@ -250,6 +251,177 @@ void any_completion_handler_invocation_test()
   ASIO_CHECK(count == 2);
 }
 
+template <std::size_t Padding>
+class counting_handler
+{
+public:
+  explicit counting_handler(int* count)
+    : count_(count)
+  {
+  }
+
+  void operator()()
+  {
+    ++(*count_);
+  }
+
+private:
+  int* count_;
+  char padding_[Padding];
+};
+
+void any_completion_handler_inline_storage_test()
+{
+  int count = 0;
+  int alloc_count = 0;
+
+  asio::any_completion_handler<void()> h1 = counting_handler<1>(&count);
+
+  ASIO_CHECK(!!h1);
+
+  asio::any_completion_handler<void()> h2(std::move(h1));
+
+  ASIO_CHECK(!h1);
+  ASIO_CHECK(!!h2);
+
+  asio::any_completion_handler<void()> h3(
+      asio::bind_allocator(handler_allocator<char>(&alloc_count),
+        counting_handler<128>(&count)));
+
+  ASIO_CHECK(!!h3);
+  ASIO_CHECK(alloc_count == 1);
+
+  h2.swap(h3);
+
+  ASIO_CHECK(!!h2);
+  ASIO_CHECK(!!h3);
+  ASIO_CHECK(alloc_count == 1);
+
+  std::move(h2)();
+
+  ASIO_CHECK(!h2);
+  ASIO_CHECK(count == 1);
+
+  h1 = std::move(h3);
+
+  ASIO_CHECK(!!h1);
+  ASIO_CHECK(!h3);
+
+  std::move(h1)();
+
+  ASIO_CHECK(!h1);
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(alloc_count == 1);
+}
+
+class allocating_handler
+{
+public:
+  using allocator_type = handler_allocator<char>;
+
+  allocating_handler(int* count, int* alloc_count)
+    : count_(count),
+      alloc_count_(alloc_count)
+  {
+  }
+
+  allocator_type get_allocator() const noexcept
+  {
+    return allocator_type(alloc_count_);
+  }
+
+  void operator()()
+  {
+    ++(*count_);
+  }
+
+private:
+  int* count_;
+  int* alloc_count_;
+};
+
+void any_completion_handler_allocator_move_test()
+{
+  int count = 0;
+  int alloc_count = 0;
+
+  // A small handler with an associated allocator. Allocators obtained from
+  // the any_completion_handler must remain usable after it has been moved.
+  asio::any_completion_handler<void()> h1(
+      asio::bind_allocator(handler_allocator<char>(&alloc_count),
+        counting_handler<1>(&count)));
+
+  ASIO_CHECK(alloc_count == 1);
+
+  asio::any_completion_handler<void()>::allocator_type a1
+    = h1.get_allocator();
+
+  asio::any_completion_handler<void()> h2(std::move(h1));
+
+  std::allocator_traits<asio::any_completion_handler<void()>::allocator_type>
+    ::rebind_alloc<int> a2(a1);
+  int* p = a2.allocate(1);
+  *p = 42;
+  a2.deallocate(p, 1);
+
+  ASIO_CHECK(alloc_count == 2);
+
+  // Posting takes a copy of the associated allocator before moving the
+  // handler into the allocated storage.
+  asio::thread_pool pool(1);
+  asio::post(pool, std::move(h2));
+  pool.join();
+
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(alloc_count == 3);
+
+  // A small handler without an associated allocator.
+  asio::any_completion_handler<void()> h3 = counting_handler<1>(&count);
+  asio::any_completion_handler<void()>::allocator_type a3
+    = h3.get_allocator();
+
+  asio::any_completion_handler<void()> h4(std::move(h3));
+
+  std::allocator_traits<asio::any_completion_handler<void()>::allocator_type>
+    ::rebind_alloc<int> a4(a3);
+  p = a4.allocate(1);
+  *p = 42;
+  a4.deallocate(p, 1);
+
+  asio::thread_pool pool2(1);
+  asio::post(pool2, std::move(h4));
+  pool2.join();
+
+  ASIO_CHECK(count == 2);
+
+  // A small handler that provides its own allocator.
+  alloc_count = 0;
+  asio::any_completion_handler<void()> h5
+    = allocating_handler(&count, &alloc_count);
+
+  ASIO_CHECK(alloc_count == 1);
+
+  asio::any_completion_handler<void()>::allocator_type a5
+    = h5.get_allocator();
+
+  asio::any_completion_handler<void()> h6(std::move(h5));
+
+  std::allocator_traits<asio::any_completion_handler<void()>::allocator_type>
+    ::rebind_alloc<int> a6(a5);
+  p = a6.allocate(1);
+  *p = 42;
+  a6.deallocate(p, 1);
+
+  ASIO_CHECK(alloc_count == 2);
+
+  asio::thread_pool pool3(1);
+  asio::post(pool3, std::move(h6));
+  pool3.join();
+
+  ASIO_CHECK(count == 3);
+  ASIO_CHECK(alloc_count == 3);
+}
+
 ASIO_TEST_SUITE
 (
   "any_completion_handler",
@@ -257,4 +429,6 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(any_completion_handler_assignment_test)
   ASIO_TEST_CASE(any_completion_handler_associator_test)
   ASIO_TEST_CASE(any_completion_handler_invocation_test)
+  ASIO_TEST_CASE(any_completion_handler_inline_storage_test)
+  ASIO_TEST_CASE(any_completion_handler_allocator_move_test)
 )
@@ -0,0 +1,66 @@
+//
+// archetypes/counting_allocator.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ARCHETYPES_COUNTING_ALLOCATOR_HPP
+#define ARCHETYPES_COUNTING_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+namespace archetypes {
+
+template <typename T>
+class counting_allocator
+{
+public:
+  typedef T value_type;
+
+  counting_allocator(int* allocations, int* deallocations)
+    : allocations_(allocations),
+      deallocations_(deallocations)
+  {
+  }
+
+  template <typename U>
+  counting_allocator(const counting_allocator<U>& other)
+    : allocations_(other.allocations_),
+      deallocations_(other.deallocations_)
+  {
+  }
+
+  bool operator==(const counting_allocator& other) const
+  {
+    return allocations_ == other.allocations_;
+  }
+
+  bool operator!=(const counting_allocator& other) const
+  {
+    return allocations_ != other.allocations_;
+  }
+
+  T* allocate(std::size_t n)
+  {
+    ++(*allocations_);
+    return static_cast<T*>(::operator new(sizeof(T) * n));
+  }
+
+  void deallocate(T* p, std::size_t)
+  {
+    ++(*deallocations_);
+    ::operator delete(p);
+  }
+
+  int* allocations_;
+  int* deallocations_;
+};
+
+} // namespace archetypes
+
+#endif // ARCHETYPES_COUNTING_ALLOCATOR_HPP
@@ -23,7 +23,9 @@
 #include <stdexcept>
 #include "asio/any_completion_handler.hpp"
 #include "asio/bind_cancellation_slot.hpp"
+#include "asio/deferred.hpp"
 #include "asio/io_context.hpp"
+#include "asio/thread_pool.hpp"
 
 asio::awaitable<void> void_returning_coroutine()
 {
@@ -115,11 +117,64 @@ void test_co_spawn_immediate_cancel()
   ASIO_CHECK(result != nullptr);
 }
 
+asio::awaitable<int> nested_coroutine(int depth)
+{
+  if (depth == 0)
+    co_return 0;
+  co_return 1 + co_await nested_coroutine(depth - 1);
+}
+
+asio::awaitable<int> spawning_coroutine(asio::thread_pool& pool, int depth)
+{
+  // The child's frames are allocated while this coroutine's frame arena is
+  // active, but are resumed and released on a thread pool thread.
+  int result = 0;
+  for (int i = 0; i < 10; ++i)
+  {
+    result += co_await asio::co_spawn(pool,
+        nested_coroutine(depth), asio::deferred);
+    result += co_await nested_coroutine(depth);
+  }
+  co_return result;
+}
+
+void test_co_spawn_frame_arena()
+{
+  asio::io_context ctx;
+
+  // Deep enough that the frames span several arena chunks.
+  int result = 0;
+  asio::co_spawn(ctx, nested_coroutine(1000),
+      [&](std::exception_ptr, int i)
+      {
+        result = i;
+      });
+
+  ctx.run();
+
+  ASIO_CHECK(result == 1000);
+
+  asio::thread_pool pool(1);
+  result = 0;
+  asio::co_spawn(ctx, spawning_coroutine(pool, 50),
+      [&](std::exception_ptr, int i)
+      {
+        result = i;
+      });
+
+  ctx.restart();
+  ctx.run();
+  pool.join();
+
+  ASIO_CHECK(result == 1000);
+}
+
 ASIO_TEST_SUITE
 (
   "co_spawn",
   ASIO_TEST_CASE(test_co_spawn_with_any_completion_handler)
   ASIO_TEST_CASE(test_co_spawn_immediate_cancel)
+  ASIO_TEST_CASE(test_co_spawn_frame_arena)
 )
 
 #else // defined(ASIO_HAS_CO_AWAIT)
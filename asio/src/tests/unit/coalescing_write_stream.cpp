@@ -0,0 +1,416 @@
+//
+// coalescing_write_stream.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/coalescing_write_stream.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include "archetypes/async_result.hpp"
+#include "asio/bind_executor.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "asio/read.hpp"
+#include "asio/strand.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+typedef asio::coalescing_write_stream<
+    asio::ip::tcp::socket> stream_type;
+
+void write_some_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void read_some_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void test_compile()
+{
+  using namespace asio;
+
+  try
+  {
+    io_context ioc;
+    char mutable_char_buffer[128] = "";
+    const char const_char_buffer[128] = "";
+    std::vector<asio::const_buffer> const_buffers;
+    const_buffers.push_back(asio::buffer(const_char_buffer, 10));
+    const_buffers.push_back(asio::buffer(const_char_buffer + 10, 10));
+    archetypes::lazy_handler lazy;
+    asio::error_code ec;
+
+    stream_type stream1(ioc);
+
+    stream_type::executor_type ex = stream1.get_executor();
+    (void)ex;
+
+    stream_type::lowest_layer_type& lowest_layer = stream1.lowest_layer();
+    (void)lowest_layer;
+
+    stream_type::next_layer_type& next_layer = stream1.next_layer();
+    (void)next_layer;
+
+    stream1.close();
+    stream1.close(ec);
+
+    stream1.write_some(buffer(mutable_char_buffer));
+    stream1.write_some(buffer(const_char_buffer));
+    stream1.write_some(const_buffers);
+    stream1.write_some(buffer(mutable_char_buffer), ec);
+    stream1.write_some(const_buffers, ec);
+
+    stream1.async_write_some(buffer(mutable_char_buffer), &write_some_handler);
+    stream1.async_write_some(buffer(const_char_buffer), &write_some_handler);
+    stream1.async_write_some(const_buffers, &write_some_handler);
+    int i1 = stream1.async_write_some(buffer(const_char_buffer), lazy);
+    (void)i1;
+
+    stream1.read_some(buffer(mutable_char_buffer));
+    stream1.read_some(buffer(mutable_char_buffer), ec);
+
+    stream1.async_read_some(buffer(mutable_char_buffer), &read_some_handler);
+    int i2 = stream1.async_read_some(buffer(mutable_char_buffer), lazy);
+    (void)i2;
+
+    asio::async_write(stream1, buffer(const_char_buffer), &write_some_handler);
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+// A stream that records the writes made to it, and that completes each write
+// after writing at most max_length bytes.
+class recording_stream
+{
+public:
+  typedef asio::io_context::executor_type executor_type;
+  typedef recording_stream lowest_layer_type;
+
+  explicit recording_stream(asio::io_context& ioc)
+    : ioc_(ioc),
+      writes_(0),
+      max_buffers_(0),
+      max_length_(~std::size_t(0))
+  {
+  }
+
+  executor_type get_executor() noexcept
+  {
+    return ioc_.get_executor();
+  }
+
+  lowest_layer_type& lowest_layer()
+  {
+    return *this;
+  }
+
+  const lowest_layer_type& lowest_layer() const
+  {
+    return *this;
+  }
+
+  void close()
+  {
+  }
+
+  template <typename ConstBufferSequence, typename Handler>
+  void async_write_some(const ConstBufferSequence& buffers, Handler&& handler)
+  {
+    ++writes_;
+    asio::error_code ec = error_;
+    std::size_t count = 0;
+    std::size_t length = 0;
+    for (typename ConstBufferSequence::const_iterator
+        iter = buffers.begin(); iter != buffers.end(); ++iter, ++count)
+    {
+      asio::const_buffer b(*iter);
+      ASIO_CHECK(b.size() > 0);
+      std::size_t n = ec ? 0 : max_length_ - length;
+      n = n < b.size() ? n : b.size();
+      data_.append(static_cast<const char*>(b.data()), n);
+      length += n;
+    }
+    max_buffers_ = count > max_buffers_ ? count : max_buffers_;
+
+    asio::post(ioc_, asio::detail::bind_handler(
+          static_cast<Handler&&>(handler), ec, length));
+  }
+
+  asio::io_context& ioc_;
+  std::string data_;
+  std::size_t writes_;
+  std::size_t max_buffers_;
+  std::size_t max_length_;
+  asio::error_code error_;
+};
+
+typedef asio::coalescing_write_stream<recording_stream> recording_type;
+
+struct write_result
+{
+  write_result() : called(false), length(0) {}
+  bool called;
+  asio::error_code ec;
+  std::size_t length;
+};
+
+class write_result_handler
+{
+public:
+  write_result_handler(std::vector<write_result>& results, std::size_t index)
+    : results_(&results),
+      index_(index)
+  {
+  }
+
+  void operator()(const asio::error_code& ec, std::size_t length)
+  {
+    write_result& r = (*results_)[index_];
+    ASIO_CHECK(!r.called);
+
+    // Operations complete in the order in which they were started.
+    for (std::size_t i = 0; i < index_; ++i)
+      ASIO_CHECK((*results_)[i].called);
+
+    r.called = true;
+    r.ec = ec;
+    r.length = length;
+  }
+
+private:
+  std::vector<write_result>* results_;
+  std::size_t index_;
+};
+
+void test_coalesced_writes()
+{
+  asio::io_context ioc;
+  recording_type stream(ioc);
+
+  std::vector<std::string> messages;
+  for (int i = 0; i < 100; ++i)
+    messages.push_back(std::string(1 + i % 7, static_cast<char>('a' + i % 26)));
+
+  std::vector<write_result> results(messages.size());
+  std::string expected;
+  for (std::size_t i = 0; i < messages.size(); ++i)
+  {
+    stream.async_write_some(asio::buffer(messages[i]),
+        write_result_handler(results, i));
+    expected += messages[i];
+  }
+
+  // Nothing is written until the current handler returns.
+  ASIO_CHECK(stream.next_layer().writes_ == 0);
+
+  ioc.run();
+
+  ASIO_CHECK(stream.next_layer().data_ == expected);
+  ASIO_CHECK(stream.next_layer().writes_ ==
+      (messages.size() + asio::detail::coalesced_buffers::max_buffers - 1)
+        / asio::detail::coalesced_buffers::max_buffers);
+  ASIO_CHECK(stream.next_layer().max_buffers_ <=
+      static_cast<std::size_t>(asio::detail::coalesced_buffers::max_buffers));
+  for (std::size_t i = 0; i < messages.size(); ++i)
+  {
+    ASIO_CHECK(results[i].called);
+    ASIO_CHECK(!results[i].ec);
+    ASIO_CHECK(results[i].length == messages[i].size());
+  }
+}
+
+void test_partial_writes()
+{
+  asio::io_context ioc;
+  recording_type stream(ioc);
+  stream.next_layer().max_length_ = 7;
+
+  const char* const messages[] = { "hello", "", "big", "multi", "", "buffer" };
+  const std::size_t message_count = sizeof(messages) / sizeof(messages[0]);
+
+  std::vector<write_result> results(message_count + 1);
+  std::string expected;
+  for (std::size_t i = 0; i < message_count; ++i)
+  {
+    stream.async_write_some(asio::buffer(messages[i], std::strlen(messages[i])),
+        write_result_handler(results, i));
+    expected += messages[i];
+  }
+
+  // A sequence of several buffers is written as a whole.
+  std::vector<asio::const_buffer> buffers;
+  buffers.push_back(asio::buffer("abc", 3));
+  buffers.push_back(asio::const_buffer());
+  buffers.push_back(asio::buffer("defghij", 7));
+  stream.async_write_some(buffers, write_result_handler(results, message_count));
+  expected += "abcdefghij";
+
+  ioc.run();
+
+  ASIO_CHECK(stream.next_layer().data_ == expected);
+  for (std::size_t i = 0; i < message_count; ++i)
+  {
+    ASIO_CHECK(results[i].called);
+    ASIO_CHECK(!results[i].ec);
+    ASIO_CHECK(results[i].length == std::strlen(messages[i]));
+  }
+  ASIO_CHECK(results[message_count].called);
+  ASIO_CHECK(results[message_count].length == 10);
+
+  // A zero-length write completes without writing to the next layer.
+  std::size_t writes = stream.next_layer().writes_;
+  std::vector<write_result> empty_result(1);
+  stream.async_write_some(asio::const_buffer(),
+      write_result_handler(empty_result, 0));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(empty_result[0].called);
+  ASIO_CHECK(!empty_result[0].ec);
+  ASIO_CHECK(empty_result[0].length == 0);
+  ASIO_CHECK(stream.next_layer().writes_ == writes);
+}
+
+void test_writes_during_flush()
+{
+  asio::io_context ioc;
+  recording_type stream(ioc);
+
+  int completed = 0;
+  stream.async_write_some(asio::buffer("first", 5),
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        ASIO_CHECK(!ec);
+        ASIO_CHECK(n == 5);
+        ++completed;
+      });
+  ioc.poll_one();
+  ASIO_CHECK(stream.next_layer().writes_ == 1);
+
+  // Writes started while the first write is in progress are sent together.
+  for (int i = 0; i < 10; ++i)
+  {
+    stream.async_write_some(asio::buffer("more", 4),
+        [&](const asio::error_code& ec, std::size_t n)
+        {
+          ASIO_CHECK(!ec);
+          ASIO_CHECK(n == 4);
+          ++completed;
+        });
+  }
+
+  ioc.run();
+  ASIO_CHECK(completed == 11);
+  ASIO_CHECK(stream.next_layer().writes_ == 2);
+  ASIO_CHECK(stream.next_layer().data_
+      == "firstmoremoremoremoremoremoremoremoremoremore");
+}
+
+void test_write_error()
+{
+  asio::io_context ioc;
+  recording_type stream(ioc);
+  stream.next_layer().error_ = asio::error::broken_pipe;
+
+  std::vector<write_result> results(3);
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    stream.async_write_some(asio::buffer("data", 4),
+        write_result_handler(results, i));
+  }
+
+  ioc.run();
+
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    ASIO_CHECK(results[i].called);
+    ASIO_CHECK(results[i].ec == asio::error::broken_pipe);
+    ASIO_CHECK(results[i].length == 0);
+  }
+
+  // The stream may be used again after an error.
+  stream.next_layer().error_ = asio::error_code();
+  std::vector<write_result> result(1);
+  stream.async_write_some(asio::buffer("data", 4),
+      write_result_handler(result, 0));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(result[0].called);
+  ASIO_CHECK(!result[0].ec);
+  ASIO_CHECK(stream.next_layer().data_ == "data");
+}
+
+void test_socket_writes()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  asio::io_context ioc;
+  asio::coalescing_write_stream<asio::local::stream_protocol::socket>
+    stream(ioc);
+  asio::local::stream_protocol::socket peer(ioc);
+  asio::local::connect_pair(stream.next_layer(), peer);
+
+  asio::strand<asio::io_context::executor_type> strand(ioc.get_executor());
+
+  std::string expected;
+  std::vector<std::string> messages;
+  for (int i = 0; i < 200; ++i)
+  {
+    messages.push_back(std::string(1 + i % 13, static_cast<char>('A' + i % 26)));
+    expected += messages[i];
+  }
+
+  std::size_t completed = 0;
+  for (std::size_t i = 0; i < messages.size(); ++i)
+  {
+    asio::async_write(stream, asio::buffer(messages[i]),
+        asio::bind_executor(strand,
+          [&, i](const asio::error_code& ec, std::size_t n)
+          {
+            ASIO_CHECK(!ec);
+            ASIO_CHECK(n == messages[i].size());
+            ASIO_CHECK(completed++ == i);
+          }));
+  }
+
+  std::string received(expected.size(), '\0');
+  asio::async_read(peer, asio::buffer(&received[0], received.size()),
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        ASIO_CHECK(!ec);
+        ASIO_CHECK(n == expected.size());
+      });
+
+  ioc.run();
+
+  ASIO_CHECK(completed == messages.size());
+  ASIO_CHECK(received == expected);
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+ASIO_TEST_SUITE
+(
+  "coalescing_write_stream",
+  ASIO_COMPILE_TEST_CASE(test_compile)
+  ASIO_TEST_CASE(test_coalesced_writes)
+  ASIO_TEST_CASE(test_partial_writes)
+  ASIO_TEST_CASE(test_writes_during_flush)
+  ASIO_TEST_CASE(test_write_error)
+  ASIO_TEST_CASE(test_socket_writes)
+)
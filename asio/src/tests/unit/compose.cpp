@@ -17,6 +17,8 @@
 #include "asio/compose.hpp"
 
 #include <functional>
+#include "archetypes/counting_allocator.hpp"
+#include "asio/bind_allocator.hpp"
 #include "asio/bind_cancellation_slot.hpp"
 #include "asio/cancellation_signal.hpp"
 #include "asio/io_context.hpp"
@@ -517,6 +519,69 @@ void compose_total_cancellation_test()
 
 //------------------------------------------------------------------------------
 
+//------------------------------------------------------------------------------
+
+class impl_repeated_post
+{
+public:
+  impl_repeated_post(asio::io_context& ioc, int count)
+    : ioc_(ioc),
+      remaining_(count)
+  {
+  }
+
+  template <typename Self>
+  void operator()(Self& self)
+  {
+    if (remaining_-- > 0)
+      asio::post(ioc_, static_cast<Self&&>(self));
+    else
+      self.complete();
+  }
+
+private:
+  asio::io_context& ioc_;
+  int remaining_;
+};
+
+template <typename CompletionToken>
+auto async_repeated_post(asio::io_context& ioc, int count,
+    CompletionToken&& token)
+  -> decltype(
+    asio::async_compose<CompletionToken, void()>(
+      impl_repeated_post(ioc, count), token))
+{
+  return asio::async_compose<CompletionToken, void()>(
+      impl_repeated_post(ioc, count), token);
+}
+
+void compose_allocation_test()
+{
+  asio::io_context ioc;
+  int count = 0;
+  int allocations = 0;
+  int deallocations = 0;
+
+  async_repeated_post(ioc, 10,
+      asio::bind_allocator(
+        archetypes::counting_allocator<void>(&allocations, &deallocations),
+        compose_0_args_lvalue_handler{&count}));
+
+  ioc.run();
+
+  ASIO_CHECK(count == 1);
+#if !defined(ASIO_DISABLE_REUSABLE_OP_MEMORY)
+  // The memory used by the first intermediate operation is reused by all
+  // subsequent ones.
+  ASIO_CHECK(allocations == 1);
+#else // !defined(ASIO_DISABLE_REUSABLE_OP_MEMORY)
+  ASIO_CHECK(allocations == 10);
+#endif // !defined(ASIO_DISABLE_REUSABLE_OP_MEMORY)
+  ASIO_CHECK(deallocations == allocations);
+}
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "compose",
@@ -525,4 +590,5 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(compose_default_cancellation_test)
   ASIO_TEST_CASE(compose_partial_cancellation_test)
   ASIO_TEST_CASE(compose_total_cancellation_test)
+  ASIO_TEST_CASE(compose_allocation_test)
 )
@@ -16,10 +16,64 @@
 // Test that header file is self-contained.
 #include "asio/deferred.hpp"
 
+#include "archetypes/counting_allocator.hpp"
+#include "asio/bind_allocator.hpp"
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
 #include "unit_test.hpp"
 
+void deferred_sequence_allocation_test()
+{
+  asio::io_context ioc;
+  int stages = 0;
+  int result = 0;
+  int allocations = 0;
+  int deallocations = 0;
+
+  auto sequence = asio::post(ioc, asio::deferred)
+    | asio::deferred(
+        [&]()
+        {
+          ++stages;
+          return asio::post(ioc, asio::deferred);
+        })
+    | asio::deferred(
+        [&]()
+        {
+          ++stages;
+          return asio::post(ioc, asio::deferred);
+        })
+    | asio::deferred(
+        [&]()
+        {
+          ++stages;
+          return asio::deferred.values(42);
+        });
+
+  std::move(sequence)(
+      asio::bind_allocator(
+        archetypes::counting_allocator<void>(&allocations, &deallocations),
+        [&](int value)
+        {
+          result = value;
+        }));
+
+  ioc.run();
+
+  ASIO_CHECK(stages == 3);
+  ASIO_CHECK(result == 42);
+#if !defined(ASIO_DISABLE_REUSABLE_OP_MEMORY)
+  // The operation of every stage reuses the same memory.
+  ASIO_CHECK(allocations == 1);
+#else // !defined(ASIO_DISABLE_REUSABLE_OP_MEMORY)
+  ASIO_CHECK(allocations == 3);
+#endif // !defined(ASIO_DISABLE_REUSABLE_OP_MEMORY)
+  ASIO_CHECK(deallocations == allocations);
+}
+
 ASIO_TEST_SUITE
 (
   "experimental/deferred",
   ASIO_TEST_CASE(null_test)
+  ASIO_TEST_CASE(deferred_sequence_allocation_test)
 )
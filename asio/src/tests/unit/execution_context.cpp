@@ -16,10 +16,171 @@
 // Test that header file is self-contained.
 #include "asio/execution_context.hpp"
 
+#include <vector>
+#include "asio/detail/thread.hpp"
 #include "unit_test.hpp"
 
+class test_context : public asio::execution_context
+{
+public:
+  ~test_context()
+  {
+    shutdown();
+    destroy();
+  }
+
+  void restart_services()
+  {
+    shutdown();
+    destroy();
+  }
+};
+
+static int service_count = 0;
+
+template <int N>
+class numbered_service : public asio::execution_context::service
+{
+public:
+  typedef numbered_service key_type;
+
+  explicit numbered_service(asio::execution_context& ctx)
+    : asio::execution_context::service(ctx)
+  {
+    ++service_count;
+  }
+
+  ~numbered_service()
+  {
+    --service_count;
+  }
+
+  void shutdown()
+  {
+  }
+};
+
+class id_service : public asio::execution_context::service
+{
+public:
+  static asio::execution_context::id id;
+
+  explicit id_service(asio::execution_context& ctx)
+    : asio::execution_context::service(ctx),
+      // Services may be created from a service's constructor.
+      dependency_(asio::use_service<numbered_service<0> >(ctx))
+  {
+  }
+
+  void shutdown()
+  {
+  }
+
+  numbered_service<0>& dependency_;
+};
+
+asio::execution_context::id id_service::id;
+
+template <int N>
+void use_numbered_services(asio::execution_context& ctx,
+    std::vector<asio::execution_context::service*>& services)
+{
+  services.push_back(&asio::use_service<numbered_service<N> >(ctx));
+  use_numbered_services<N - 1>(ctx, services);
+}
+
+template <>
+void use_numbered_services<-1>(asio::execution_context&,
+    std::vector<asio::execution_context::service*>&)
+{
+}
+
+void service_lookup_test()
+{
+  service_count = 0;
+  {
+    test_context ctx;
+
+    ASIO_CHECK(!asio::has_service<numbered_service<0> >(ctx));
+    id_service& svc1 = asio::use_service<id_service>(ctx);
+    ASIO_CHECK(&asio::use_service<id_service>(ctx) == &svc1);
+    ASIO_CHECK(&svc1.dependency_
+        == &asio::use_service<numbered_service<0> >(ctx));
+    ASIO_CHECK(asio::has_service<numbered_service<0> >(ctx));
+    ASIO_CHECK(service_count == 1);
+
+    // Enough service types to outgrow the initial lookup table.
+    std::vector<asio::execution_context::service*> services1;
+    use_numbered_services<40>(ctx, services1);
+    ASIO_CHECK(service_count == 41);
+
+    std::vector<asio::execution_context::service*> services2;
+    use_numbered_services<40>(ctx, services2);
+    ASIO_CHECK(services1 == services2);
+    ASIO_CHECK(asio::has_service<numbered_service<40> >(ctx));
+
+    // Services are recreated after being destroyed.
+    ctx.restart_services();
+    ASIO_CHECK(service_count == 0);
+    ASIO_CHECK(!asio::has_service<numbered_service<40> >(ctx));
+    asio::use_service<numbered_service<40> >(ctx);
+    ASIO_CHECK(service_count == 1);
+    ASIO_CHECK(asio::has_service<numbered_service<40> >(ctx));
+  }
+  ASIO_CHECK(service_count == 0);
+}
+
+#if defined(ASIO_HAS_THREADS)
+
+struct concurrent_lookup
+{
+  asio::execution_context* ctx;
+  std::vector<asio::execution_context::service*>* services;
+
+  void operator()()
+  {
+    use_numbered_services<40>(*ctx, *services);
+  }
+};
+
+void concurrent_service_lookup_test()
+{
+  service_count = 0;
+  {
+    test_context ctx;
+
+    const int num_threads = 4;
+    std::vector<asio::execution_context::service*> services[num_threads];
+    asio::detail::thread* threads[num_threads];
+    for (int i = 0; i < num_threads; ++i)
+    {
+      concurrent_lookup f = { &ctx, &services[i] };
+      threads[i] = new asio::detail::thread(f);
+    }
+    for (int i = 0; i < num_threads; ++i)
+    {
+      threads[i]->join();
+      delete threads[i];
+    }
+
+    ASIO_CHECK(service_count == 41);
+    for (int i = 1; i < num_threads; ++i)
+      ASIO_CHECK(services[i] == services[0]);
+  }
+  ASIO_CHECK(service_count == 0);
+}
+
+#else // defined(ASIO_HAS_THREADS)
+
+void concurrent_service_lookup_test()
+{
+}
+
+#endif // defined(ASIO_HAS_THREADS)
+
 ASIO_TEST_SUITE
 (
   "execution_context",
-  ASIO_TEST_CASE(null_test)
+  ASIO_TEST_CASE(service_lookup_test)
+  ASIO_TEST_CASE(concurrent_service_lookup_test)
 )
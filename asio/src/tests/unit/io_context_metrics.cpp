@@ -0,0 +1,319 @@
+//
+// io_context_metrics.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/io_context_metrics.hpp"
+
+#include <atomic>
+#include <string>
+#include "asio/io_context.hpp"
+#include "asio/ip/udp.hpp"
+#include "asio/latency_histogram.hpp"
+#include "asio/post.hpp"
+#include "asio/steady_timer.hpp"
+#include "asio/thread.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_STD_THREAD)
+# include <thread>
+#endif // defined(ASIO_HAS_STD_THREAD)
+
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS) \
+  && (defined(ASIO_HAS_EPOLL) || defined(ASIO_HAS_IO_URING_AS_DEFAULT))
+# define ASIO_TEST_REACTOR_METRICS 1
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+       //   && (defined(ASIO_HAS_EPOLL)
+       //     || defined(ASIO_HAS_IO_URING_AS_DEFAULT))
+
+std::size_t total_pending_timers(const asio::io_context_metrics& m)
+{
+  std::size_t n = 0;
+  for (std::size_t i = 0; i < m.pending_timers.size(); ++i)
+    n += m.pending_timers[i];
+  return n;
+}
+
+void io_context_metrics_test()
+{
+  asio::io_context ioc;
+
+  asio::io_context_metrics m = ioc.metrics();
+  ASIO_CHECK(m.queue_depth == 0);
+  ASIO_CHECK(m.outstanding_work == 0);
+  ASIO_CHECK(m.threads == 0);
+  ASIO_CHECK(m.handlers_executed == 0);
+  ASIO_CHECK(m.handler_execution_time.count() == 0);
+  ASIO_CHECK(total_pending_timers(m) == 0);
+
+  int count = 0;
+  for (int i = 0; i < 5; ++i)
+    asio::post(ioc, [&]{ ++count; });
+
+  asio::steady_timer t1(ioc, asio::chrono::seconds(60));
+  t1.async_wait([&](const asio::error_code&){ ++count; });
+  asio::steady_timer t2(ioc, asio::chrono::seconds(60));
+  t2.async_wait([&](const asio::error_code&){ ++count; });
+
+  asio::ip::udp::socket s(ioc,
+      asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+  m = ioc.metrics();
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  ASIO_CHECK(m.queue_depth == 5);
+  ASIO_CHECK(m.outstanding_work == 7);
+#else // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  ASIO_CHECK(m.queue_depth == 0);
+  ASIO_CHECK(m.outstanding_work == 0);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+#if defined(ASIO_TEST_REACTOR_METRICS)
+  ASIO_CHECK(total_pending_timers(m) == 2);
+  ASIO_CHECK(m.registered_descriptors >= 1);
+#else // defined(ASIO_TEST_REACTOR_METRICS)
+  ASIO_CHECK(m.registered_descriptors == 0);
+#endif // defined(ASIO_TEST_REACTOR_METRICS)
+
+  std::size_t threads_in_handler = 0;
+  asio::post(ioc,
+      [&]
+      {
+        threads_in_handler = ioc.metrics().threads;
+        t1.cancel();
+        t2.cancel();
+      });
+
+  ioc.run();
+  ASIO_CHECK(count == 7);
+
+  m = ioc.metrics();
+  ASIO_CHECK(m.queue_depth == 0);
+  ASIO_CHECK(m.outstanding_work == 0);
+  ASIO_CHECK(m.threads == 0);
+  ASIO_CHECK(total_pending_timers(m) == 0);
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  ASIO_CHECK(threads_in_handler == 1);
+  ASIO_CHECK(m.handlers_executed == 8);
+  ASIO_CHECK(m.handler_execution_time.count() > 0);
+#else // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  ASIO_CHECK(threads_in_handler == 0);
+  ASIO_CHECK(m.handlers_executed == 0);
+  ASIO_CHECK(m.handler_execution_time.count() == 0);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+#if defined(ASIO_TEST_REACTOR_METRICS)
+  ASIO_CHECK(m.reactor_wakeups > 0);
+  ASIO_CHECK(m.reactor_events > 0);
+#else // defined(ASIO_TEST_REACTOR_METRICS)
+  ASIO_CHECK(m.reactor_wakeups == 0);
+  ASIO_CHECK(m.reactor_events == 0);
+#endif // defined(ASIO_TEST_REACTOR_METRICS)
+}
+
+void io_context_metrics_multiple_threads_test()
+{
+#if defined(ASIO_HAS_THREADS)
+  asio::io_context ioc;
+
+  std::atomic<int> count(0);
+  for (int i = 0; i < 100; ++i)
+    asio::post(ioc, [&]{ ++count; });
+
+  asio::thread t1([&]{ ioc.run(); });
+  asio::thread t2([&]{ ioc.run(); });
+  t1.join();
+  t2.join();
+  ASIO_CHECK(count == 100);
+
+  // Counters from threads that have stopped running are retained.
+  asio::io_context_metrics m = ioc.metrics();
+  ASIO_CHECK(m.threads == 0);
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  ASIO_CHECK(m.handlers_executed == 100);
+#else // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  ASIO_CHECK(m.handlers_executed == 0);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+#endif // defined(ASIO_HAS_THREADS)
+}
+
+void latency_histogram_test()
+{
+  using asio::latency_histogram;
+  using asio::chrono::nanoseconds;
+
+  // Buckets are contiguous and each duration maps to the bucket containing it.
+  for (std::size_t i = 0; i < latency_histogram::bucket_count; ++i)
+  {
+    nanoseconds lower = latency_histogram::bucket_lower_bound(i);
+    nanoseconds upper = latency_histogram::bucket_upper_bound(i);
+    ASIO_CHECK(lower < upper);
+    ASIO_CHECK(latency_histogram::bucket_index(lower) == i);
+    ASIO_CHECK(latency_histogram::bucket_index(upper - nanoseconds(1)) == i);
+    if (i + 1 < latency_histogram::bucket_count)
+      ASIO_CHECK(latency_histogram::bucket_lower_bound(i + 1) == upper);
+  }
+
+  ASIO_CHECK(latency_histogram::bucket_index(nanoseconds(-1)) == 0);
+  ASIO_CHECK(latency_histogram::bucket_index(asio::chrono::hours(24))
+      == latency_histogram::bucket_count - 1);
+
+  latency_histogram h;
+  ASIO_CHECK(h.count() == 0);
+  ASIO_CHECK(h.percentile(50).count() == 0);
+
+  for (int i = 1; i <= 100; ++i)
+    h.record(asio::chrono::microseconds(i));
+  ASIO_CHECK(h.count() == 100);
+
+  // The relative error of a percentile is bounded by the bucket width.
+  nanoseconds p50 = h.percentile(50);
+  ASIO_CHECK(p50 >= asio::chrono::microseconds(50));
+  ASIO_CHECK(p50 < asio::chrono::microseconds(50) * 17 / 16);
+  nanoseconds p100 = h.percentile(100);
+  ASIO_CHECK(p100 >= asio::chrono::microseconds(100));
+  ASIO_CHECK(p100 < asio::chrono::microseconds(100) * 17 / 16);
+  ASIO_CHECK(h.percentile(0) < asio::chrono::microseconds(2));
+
+  latency_histogram h2;
+  h2.record(asio::chrono::seconds(1), 10);
+  h2 += h;
+  ASIO_CHECK(h2.count() == 110);
+  ASIO_CHECK(h2.percentile(95) >= asio::chrono::seconds(1));
+}
+
+int slow_handler_line = 0;
+
+void post_slow_handler(asio::io_context& ioc)
+{
+  slow_handler_line = __LINE__ + 1;
+  ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "post_slow_handler"));
+
+  asio::post(ioc,
+      []
+      {
+#if defined(ASIO_HAS_STD_THREAD)
+        std::this_thread::sleep_for(asio::chrono::milliseconds(20));
+#endif // defined(ASIO_HAS_STD_THREAD)
+      });
+}
+
+void io_context_slow_handler_test()
+{
+  asio::io_context ioc;
+
+  int calls = 0;
+  asio::slow_handler_info info = asio::slow_handler_info();
+  ioc.set_slow_handler_callback(asio::chrono::milliseconds(10),
+      [&](const asio::slow_handler_info& i)
+      {
+        ++calls;
+        info = i;
+      });
+
+  for (int i = 0; i < 10; ++i)
+    asio::post(ioc, []{});
+  post_slow_handler(ioc);
+
+  ioc.run();
+
+  asio::io_context_metrics m = ioc.metrics();
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS) && defined(ASIO_HAS_STD_THREAD)
+  ASIO_CHECK(calls == 1);
+  ASIO_CHECK(info.execution_time >= asio::chrono::milliseconds(20));
+  ASIO_CHECK(info.queue_wait_time.count() > 0);
+# if !defined(ASIO_CUSTOM_HANDLER_TRACKING)
+  ASIO_CHECK(info.file_name != 0);
+  ASIO_CHECK(info.line == slow_handler_line);
+  ASIO_CHECK(info.function_name != 0
+      && std::string(info.function_name) == "post_slow_handler");
+# endif // !defined(ASIO_CUSTOM_HANDLER_TRACKING)
+  ASIO_CHECK(m.execution_histogram.count() == 11);
+  ASIO_CHECK(m.queue_wait_histogram.count() == 11);
+  ASIO_CHECK(m.execution_histogram.percentile(100)
+      >= asio::chrono::milliseconds(20));
+#elif !defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  ASIO_CHECK(calls == 0);
+  ASIO_CHECK(m.execution_histogram.count() == 0);
+  ASIO_CHECK(m.queue_wait_histogram.count() == 0);
+#endif // !defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
+  // Handlers completed by the reactor also record their queue wait time.
+  ioc.restart();
+  asio::steady_timer t(ioc, asio::chrono::milliseconds(1));
+  t.async_wait([](const asio::error_code&){});
+  ioc.run();
+
+  m = ioc.metrics();
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  ASIO_CHECK(m.queue_wait_histogram.count() == m.handlers_executed);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
+  // A handler that exits with an exception is not reported.
+  calls = 0;
+  ioc.set_slow_handler_callback(asio::chrono::nanoseconds(0),
+      [&](const asio::slow_handler_info&)
+      {
+        ++calls;
+        throw 1;
+      });
+  ioc.restart();
+  asio::post(ioc, []{ throw 2; });
+  int caught = 0;
+  try
+  {
+    ioc.run();
+  }
+  catch (int i)
+  {
+    caught = i;
+  }
+  ASIO_CHECK(calls == 0);
+  ASIO_CHECK(caught == 2);
+
+  // An exception thrown by the callback propagates from run().
+  ioc.restart();
+  asio::post(ioc, []{});
+  caught = 0;
+  try
+  {
+    ioc.run();
+  }
+  catch (int i)
+  {
+    caught = i;
+  }
+#if defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  ASIO_CHECK(calls == 1);
+  ASIO_CHECK(caught == 1);
+#else // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+  ASIO_CHECK(calls == 0);
+  ASIO_CHECK(caught == 0);
+#endif // defined(ASIO_ENABLE_IO_CONTEXT_METRICS)
+
+  // An empty callback disables the check.
+  calls = 0;
+  ioc.set_slow_handler_callback(asio::chrono::nanoseconds(0),
+      asio::slow_handler_callback());
+  ioc.restart();
+  asio::post(ioc, []{});
+  ioc.run();
+  ASIO_CHECK(calls == 0);
+}
+
+ASIO_TEST_SUITE
+(
+  "io_context_metrics",
+  ASIO_TEST_CASE(io_context_metrics_test)
+  ASIO_TEST_CASE(io_context_metrics_multiple_threads_test)
+  ASIO_TEST_CASE(latency_histogram_test)
+  ASIO_TEST_CASE(io_context_slow_handler_test)
+)
@@ -30,6 +30,10 @@
 #include "../archetypes/io_control_command.hpp"
 #include "../archetypes/settable_socket_option.hpp"
 
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+# include <fcntl.h>
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
 #if defined(ASIO_HAS_BOOST_ARRAY)
 # include <boost/array.hpp>
 #else // defined(ASIO_HAS_BOOST_ARRAY)
@@ -1020,6 +1024,78 @@ void test()
       == client_endpoint.port());
 }
 
+void check_fast_accepted(asio::ip::tcp::socket& client_side_socket,
+    asio::ip::tcp::socket& server_side_socket)
+{
+  ASIO_CHECK(server_side_socket.is_open());
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  int fd = server_side_socket.native_handle();
+  ASIO_CHECK((::fcntl(fd, F_GETFD, 0) & FD_CLOEXEC) != 0);
+#if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  ASIO_CHECK((::fcntl(fd, F_GETFL, 0) & O_NONBLOCK) == 0);
+  ASIO_CHECK(!server_side_socket.native_non_blocking());
+#else // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  ASIO_CHECK((::fcntl(fd, F_GETFL, 0) & O_NONBLOCK) != 0);
+  ASIO_CHECK(server_side_socket.native_non_blocking());
+#endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+  // Synchronous operations must still block on the accepted socket.
+  const char write_data[] = "fast accept";
+  char read_data[sizeof(write_data)] = "";
+  asio::write(client_side_socket,
+      asio::buffer(write_data, sizeof(write_data)));
+  std::size_t length = asio::read(server_side_socket,
+      asio::buffer(read_data, sizeof(read_data)));
+  ASIO_CHECK(length == sizeof(write_data));
+  ASIO_CHECK(memcmp(read_data, write_data, sizeof(write_data)) == 0);
+
+  client_side_socket.close();
+  server_side_socket.close();
+}
+
+void test_fast_accept()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  acceptor.set_option(socket_base::fast_accept(true));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+  check_fast_accepted(client_side_socket, server_side_socket);
+
+  acceptor.async_accept(server_side_socket, &handle_accept);
+  client_side_socket.async_connect(server_endpoint, &handle_connect);
+
+  ioc.restart();
+  ioc.run();
+
+  check_fast_accepted(client_side_socket, server_side_socket);
+
+  acceptor.async_accept(
+      [&](const asio::error_code& err, ip::tcp::socket s)
+      {
+        ASIO_CHECK(!err);
+        server_side_socket = std::move(s);
+      });
+  client_side_socket.async_connect(server_endpoint, &handle_connect);
+
+  ioc.restart();
+  ioc.run();
+
+  check_fast_accepted(client_side_socket, server_side_socket);
+}
+
 } // namespace ip_tcp_acceptor_runtime
 
 //------------------------------------------------------------------------------
@@ -1329,6 +1405,7 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(ip_tcp_socket_runtime::test)
   ASIO_COMPILE_TEST_CASE(ip_tcp_acceptor_compile::test)
   ASIO_TEST_CASE(ip_tcp_acceptor_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_acceptor_runtime::test_fast_accept)
   ASIO_COMPILE_TEST_CASE(ip_tcp_resolver_compile::test)
   ASIO_COMPILE_TEST_CASE(ip_tcp_resolver_entry_compile::test)
   ASIO_COMPILE_TEST_CASE(ip_tcp_resolver_entry_compile::test)
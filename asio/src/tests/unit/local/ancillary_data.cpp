@@ -0,0 +1,400 @@
+//
+// ancillary_data.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/local/ancillary_data.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "../unit_test.hpp"
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS) \
+  && !defined(ASIO_WINDOWS) \
+  && !defined(__CYGWIN__)
+# include <fcntl.h>
+# include <unistd.h>
+#endif
+
+//------------------------------------------------------------------------------
+
+// local_ancillary_data_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// local::ancillary_data and the associated free functions compile and link
+// correctly. Runtime failures are ignored.
+
+namespace local_ancillary_data_compile {
+
+void handler(const asio::error_code&, std::size_t)
+{
+}
+
+void test()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS) \
+  && !defined(ASIO_WINDOWS) \
+  && !defined(__CYGWIN__)
+  using namespace asio;
+  namespace local = asio::local;
+
+  try
+  {
+    io_context ioc;
+    char mutable_char_buffer[128] = "";
+    const char const_char_buffer[128] = "";
+    asio::error_code ec;
+
+    local::stream_protocol::socket socket1(ioc);
+    ip::tcp::socket socket2(ioc);
+
+    local::ancillary_data data;
+    local::ancillary_data data2(4);
+
+    std::size_t n = data.max_descriptors();
+    data.add_descriptor(0);
+    data.add_socket(socket2);
+    data.clear_send();
+    n = data.descriptor_count();
+    int fd = data.release_descriptor(0);
+    data.adopt(0, socket1);
+    data.adopt(0, socket2, ip::tcp::v4());
+    data.adopt(0, socket2, ip::tcp::v4(), ec);
+    bool b = data.truncated();
+    (void)fd;
+    (void)b;
+
+#if defined(SCM_CREDENTIALS)
+    local::credentials creds = local::credentials();
+    data.send_credentials(creds);
+    b = data.has_credentials();
+    creds = data.peer_credentials();
+#endif // defined(SCM_CREDENTIALS)
+
+#if defined(SO_PASSCRED)
+    socket1.set_option(local::stream_protocol::pass_credentials(true));
+#endif // defined(SO_PASSCRED)
+
+    n = local::send_with_ancillary(socket1,
+        buffer(const_char_buffer), data);
+    n = local::send_with_ancillary(socket1,
+        buffer(const_char_buffer), data, ec);
+    local::async_send_with_ancillary(socket1,
+        buffer(const_char_buffer), data, &handler);
+
+    n = local::receive_with_ancillary(socket1,
+        buffer(mutable_char_buffer), data);
+    n = local::receive_with_ancillary(socket1,
+        buffer(mutable_char_buffer), data, ec);
+    local::async_receive_with_ancillary(socket1,
+        buffer(mutable_char_buffer), data, &handler);
+    (void)n;
+  }
+  catch (std::exception&)
+  {
+  }
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+       //   && !defined(ASIO_WINDOWS)
+       //   && !defined(__CYGWIN__)
+}
+
+} // namespace local_ancillary_data_compile
+
+//------------------------------------------------------------------------------
+
+// local_ancillary_data_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of descriptor and
+// credential passing.
+
+namespace local_ancillary_data_runtime {
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS) \
+  && !defined(ASIO_WINDOWS) \
+  && !defined(__CYGWIN__)
+
+bool is_open_descriptor(int fd)
+{
+  return ::fcntl(fd, F_GETFD) != -1;
+}
+
+void test_async_socket_handoff()
+{
+  namespace local = asio::local;
+
+  asio::io_context ioc;
+  asio::io_context worker_ioc;
+
+  asio::ip::tcp::acceptor acceptor(ioc,
+      asio::ip::tcp::endpoint(asio::ip::tcp::v4(), 0));
+  asio::ip::tcp::endpoint endpoint = acceptor.local_endpoint();
+  endpoint.address(asio::ip::address_v4::loopback());
+  asio::ip::tcp::socket client(ioc);
+  client.connect(endpoint);
+  asio::ip::tcp::socket accepted(ioc);
+  acceptor.accept(accepted);
+
+  local::stream_protocol::socket sender(ioc), receiver(ioc);
+  local::connect_pair(sender, receiver);
+
+  local::ancillary_data send_data;
+  send_data.add_socket(accepted);
+
+  bool sent = false;
+  local::async_send_with_ancillary(sender, asio::buffer("H", 1), send_data,
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        ASIO_CHECK(!ec);
+        ASIO_CHECK(n == 1);
+        sent = true;
+      });
+
+  local::ancillary_data receive_data;
+  char tag = 0;
+  bool received = false;
+  local::async_receive_with_ancillary(receiver,
+      asio::buffer(&tag, 1), receive_data,
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        ASIO_CHECK(!ec);
+        ASIO_CHECK(n == 1);
+        received = true;
+      });
+
+  ASIO_CHECK(!sent);
+  ASIO_CHECK(!received);
+
+  ioc.run();
+
+  ASIO_CHECK(sent);
+  ASIO_CHECK(received);
+  ASIO_CHECK(tag == 'H');
+  ASIO_CHECK(send_data.descriptor_count() == 0);
+  ASIO_CHECK(receive_data.descriptor_count() == 1);
+  ASIO_CHECK(!receive_data.truncated());
+
+  // The sender's copy may be closed as soon as the message has been sent.
+  accepted.close();
+
+  asio::ip::tcp::socket adopted(worker_ioc);
+  receive_data.adopt(0, adopted, asio::ip::tcp::v4());
+  ASIO_CHECK(adopted.is_open());
+  ASIO_CHECK((::fcntl(adopted.native_handle(), F_GETFD) & FD_CLOEXEC) != 0);
+
+  asio::error_code ec;
+  receive_data.adopt(0, adopted, asio::ip::tcp::v4(), ec);
+  ASIO_CHECK(ec == asio::error::bad_descriptor);
+
+  const char message[] = "handed off";
+  char reply[sizeof(message)] = "";
+  asio::async_write(adopted, asio::buffer(message),
+      [&](const asio::error_code& ec, std::size_t)
+      {
+        ASIO_CHECK(!ec);
+      });
+  worker_ioc.run();
+
+  asio::read(client, asio::buffer(reply));
+  ASIO_CHECK(std::memcmp(reply, message, sizeof(message)) == 0);
+}
+
+void test_sync_descriptors()
+{
+  namespace local = asio::local;
+
+  asio::io_context ioc;
+  local::stream_protocol::socket sender(ioc), receiver(ioc);
+  local::connect_pair(sender, receiver);
+
+  local::stream_protocol::socket passed1(ioc), passed2(ioc);
+  local::connect_pair(passed1, passed2);
+
+  local::ancillary_data send_data(2);
+  send_data.add_socket(passed1);
+  send_data.add_socket(passed2);
+  bool threw = false;
+  try
+  {
+    send_data.add_descriptor(0);
+  }
+  catch (std::length_error&)
+  {
+    threw = true;
+  }
+  ASIO_CHECK(threw);
+
+  const char data[] = "two descriptors";
+  std::size_t n = local::send_with_ancillary(
+      sender, asio::buffer(data), send_data);
+  ASIO_CHECK(n == sizeof(data));
+
+  local::ancillary_data receive_data(2);
+  char buffer[sizeof(data)] = "";
+  n = local::receive_with_ancillary(
+      receiver, asio::buffer(buffer), receive_data);
+  ASIO_CHECK(n == sizeof(data));
+  ASIO_CHECK(std::memcmp(buffer, data, sizeof(data)) == 0);
+  ASIO_CHECK(receive_data.descriptor_count() == 2);
+
+  // A released descriptor is owned by the caller, and its slot is left empty.
+  int released = receive_data.release_descriptor(0);
+  ASIO_CHECK(is_open_descriptor(released));
+  ASIO_CHECK(receive_data.release_descriptor(0) == -1);
+  ASIO_CHECK(receive_data.descriptor_count() == 2);
+  ::close(released);
+
+  asio::error_code ec;
+  local::stream_protocol::socket adopted(ioc);
+  receive_data.adopt(0, adopted, local::stream_protocol(), ec);
+  ASIO_CHECK(ec == asio::error::bad_descriptor);
+  receive_data.adopt(1, adopted, local::stream_protocol(), ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(adopted.is_open());
+
+  // Descriptors not claimed from one message are closed by the next receive.
+  local::ancillary_data empty;
+  local::send_with_ancillary(sender, asio::buffer("x", 1), empty);
+  n = local::receive_with_ancillary(
+      receiver, asio::buffer(buffer), receive_data);
+  ASIO_CHECK(n == 1);
+  ASIO_CHECK(receive_data.descriptor_count() == 0);
+  ASIO_CHECK(receive_data.release_descriptor(0) == -1);
+}
+
+void test_truncated()
+{
+  namespace local = asio::local;
+
+  asio::io_context ioc;
+  local::stream_protocol::socket sender(ioc), receiver(ioc);
+  local::connect_pair(sender, receiver);
+
+  local::stream_protocol::socket passed(ioc);
+  passed.open();
+
+  local::ancillary_data send_data(32);
+  for (int i = 0; i < 32; ++i)
+    send_data.add_socket(passed);
+  local::send_with_ancillary(sender, asio::buffer("x", 1), send_data);
+
+  local::ancillary_data receive_data(1);
+  char c;
+  local::receive_with_ancillary(receiver, asio::buffer(&c, 1), receive_data);
+  ASIO_CHECK(receive_data.truncated());
+  ASIO_CHECK(receive_data.descriptor_count() < 32);
+}
+
+void test_credentials()
+{
+#if defined(SCM_CREDENTIALS) && defined(SO_PASSCRED)
+  namespace local = asio::local;
+
+  asio::io_context ioc;
+  local::stream_protocol::socket sender(ioc), receiver(ioc);
+  local::connect_pair(sender, receiver);
+  receiver.set_option(local::stream_protocol::pass_credentials(true));
+
+  local::ancillary_data send_data;
+  local::credentials creds;
+  creds.pid = ::getpid();
+  creds.uid = ::getuid();
+  creds.gid = ::getgid();
+  send_data.send_credentials(creds);
+
+  local::async_send_with_ancillary(sender, asio::buffer("c", 1), send_data,
+      [](const asio::error_code& ec, std::size_t n)
+      {
+        ASIO_CHECK(!ec);
+        ASIO_CHECK(n == 1);
+      });
+
+  local::ancillary_data receive_data;
+  char c = 0;
+  local::async_receive_with_ancillary(receiver,
+      asio::buffer(&c, 1), receive_data,
+      [](const asio::error_code& ec, std::size_t n)
+      {
+        ASIO_CHECK(!ec);
+        ASIO_CHECK(n == 1);
+      });
+
+  ioc.run();
+
+  ASIO_CHECK(c == 'c');
+  ASIO_CHECK(receive_data.has_credentials());
+  ASIO_CHECK(receive_data.peer_credentials().pid == ::getpid());
+  ASIO_CHECK(receive_data.peer_credentials().uid == ::getuid());
+  ASIO_CHECK(receive_data.peer_credentials().gid == ::getgid());
+#endif // defined(SCM_CREDENTIALS) && defined(SO_PASSCRED)
+}
+
+void test_eof()
+{
+  namespace local = asio::local;
+
+  asio::io_context ioc;
+  local::stream_protocol::socket sender(ioc), receiver(ioc);
+  local::connect_pair(sender, receiver);
+  sender.close();
+
+  local::ancillary_data receive_data;
+  char c;
+  asio::error_code result;
+  local::async_receive_with_ancillary(receiver,
+      asio::buffer(&c, 1), receive_data,
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        result = ec;
+        ASIO_CHECK(n == 0);
+      });
+
+  ioc.run();
+
+  ASIO_CHECK(result == asio::error::eof);
+}
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+       //   && !defined(ASIO_WINDOWS)
+       //   && !defined(__CYGWIN__)
+
+void test()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS) \
+  && !defined(ASIO_WINDOWS) \
+  && !defined(__CYGWIN__)
+  test_async_socket_handoff();
+  test_sync_descriptors();
+  test_truncated();
+  test_credentials();
+  test_eof();
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+       //   && !defined(ASIO_WINDOWS)
+       //   && !defined(__CYGWIN__)
+}
+
+} // namespace local_ancillary_data_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "local/ancillary_data",
+  ASIO_COMPILE_TEST_CASE(local_ancillary_data_compile::test)
+  ASIO_TEST_CASE(local_ancillary_data_runtime::test)
+)
@@ -16,10 +16,20 @@
 // Test that header file is self-contained.
 #include "asio/posix/stream_descriptor.hpp"
 
+#include <cstring>
+#include "asio/executor_work_guard.hpp"
 #include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/write.hpp"
 #include "../archetypes/async_result.hpp"
 #include "../unit_test.hpp"
 
+#if defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+# include <fcntl.h>
+# include <unistd.h>
+# include "asio/detail/thread.hpp"
+#endif // defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+
 //------------------------------------------------------------------------------
 
 // posix_stream_descriptor_compile test
@@ -183,8 +193,194 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// posix_stream_descriptor_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the
+// posix::stream_descriptor class, in particular that operations waiting for
+// readiness are notified whether the descriptor's reactor registration is
+// made before or while the reactor is waiting.
+
+namespace posix_stream_descriptor_runtime {
+
+#if defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+
+void make_pipe(asio::io_context& ioc,
+    asio::posix::stream_descriptor& read_end,
+    asio::posix::stream_descriptor& write_end)
+{
+  int fds[2];
+  ASIO_CHECK(::pipe(fds) == 0);
+  read_end = asio::posix::stream_descriptor(ioc, fds[0]);
+  write_end = asio::posix::stream_descriptor(ioc, fds[1]);
+}
+
+void test_deferred_registration()
+{
+  using namespace asio;
+  namespace posix = asio::posix;
+
+  io_context ioc;
+  posix::stream_descriptor read_end(ioc), write_end(ioc);
+  make_pipe(ioc, read_end, write_end);
+
+  // The read must wait, and the write is performed by a handler that runs
+  // before the reactor next waits.
+  const char write_data[] = "deferred";
+  char read_data[sizeof(write_data)] = "";
+  std::size_t bytes_read = 0;
+  read_end.async_read_some(buffer(read_data),
+      [&](const asio::error_code& err, std::size_t n)
+      {
+        ASIO_CHECK(!err);
+        bytes_read = n;
+      });
+  post(ioc,
+      [&]()
+      {
+        asio::write(write_end, buffer(write_data));
+      });
+
+  ioc.run();
+
+  ASIO_CHECK(bytes_read == sizeof(write_data));
+  ASIO_CHECK(memcmp(read_data, write_data, sizeof(write_data)) == 0);
+
+  // A wait on a descriptor that is already readable must complete, even
+  // though the edge for that data has already been consumed.
+  asio::write(write_end, buffer(write_data));
+  bool waited = false;
+  read_end.async_wait(posix::descriptor_base::wait_read,
+      [&](const asio::error_code& err)
+      {
+        ASIO_CHECK(!err);
+        waited = true;
+      });
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(waited);
+
+  // Both read and write interest are requested before the reactor runs.
+  posix::stream_descriptor read_end2(ioc), write_end2(ioc);
+  make_pipe(ioc, read_end2, write_end2);
+  waited = false;
+  read_end2.async_wait(posix::descriptor_base::wait_read,
+      [&](const asio::error_code& err)
+      {
+        ASIO_CHECK(!err);
+        waited = true;
+      });
+  bool write_waited = false;
+  write_end2.async_wait(posix::descriptor_base::wait_write,
+      [&](const asio::error_code& err)
+      {
+        ASIO_CHECK(!err);
+        write_waited = true;
+        asio::write(write_end2, buffer(write_data));
+      });
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(waited);
+  ASIO_CHECK(write_waited);
+
+  // Descriptors closed before the reactor runs are never registered.
+  posix::stream_descriptor read_end3(ioc), write_end3(ioc);
+  make_pipe(ioc, read_end3, write_end3);
+  asio::error_code read_ec;
+  read_end3.async_read_some(buffer(read_data),
+      [&](const asio::error_code& err, std::size_t)
+      {
+        read_ec = err;
+      });
+  read_end3.close();
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(read_ec == asio::error::operation_aborted);
+}
+
+void test_registration_while_waiting()
+{
+  using namespace asio;
+  namespace posix = asio::posix;
+
+  io_context ioc;
+  posix::stream_descriptor read_end(ioc), write_end(ioc);
+  make_pipe(ioc, read_end, write_end);
+
+  executor_work_guard<io_context::executor_type> work(ioc.get_executor());
+  asio::detail::thread t(
+      [&]()
+      {
+        ioc.run();
+      });
+
+  // Give the reactor time to block, so that the read is registered directly.
+  ::usleep(50000);
+
+  const char write_data[] = "waiting";
+  char read_data[sizeof(write_data)] = "";
+  std::size_t bytes_read = 0;
+  read_end.async_read_some(buffer(read_data),
+      [&](const asio::error_code& err, std::size_t n)
+      {
+        ASIO_CHECK(!err);
+        bytes_read = n;
+        work.reset();
+      });
+  asio::write(write_end, buffer(write_data));
+
+  t.join();
+
+  ASIO_CHECK(bytes_read == sizeof(write_data));
+}
+
+void test_unsupported_descriptor()
+{
+  using namespace asio;
+  namespace posix = asio::posix;
+
+  io_context ioc;
+  int fd = ::open("/dev/null", O_RDONLY);
+  ASIO_CHECK(fd != -1);
+  posix::stream_descriptor null_descriptor(ioc, fd);
+
+  asio::error_code wait_ec;
+  null_descriptor.async_wait(posix::descriptor_base::wait_read,
+      [&](const asio::error_code& err)
+      {
+        wait_ec = err;
+      });
+
+  ioc.run();
+
+  // Readiness of /dev/null is either reported immediately, or the reactor
+  // is unable to monitor it.
+  ASIO_CHECK(!wait_ec || wait_ec == asio::error::operation_not_supported);
+}
+
+#endif // defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+
+void test()
+{
+#if defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+  test_deferred_registration();
+  test_registration_while_waiting();
+  test_unsupported_descriptor();
+#endif // defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+}
+
+} // namespace posix_stream_descriptor_runtime
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "posix/stream_descriptor",
   ASIO_COMPILE_TEST_CASE(posix_stream_descriptor_compile::test)
+  ASIO_TEST_CASE(posix_stream_descriptor_runtime::test)
 )
@@ -0,0 +1,279 @@
+//
+// proxy.cpp
+// ~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/proxy.hpp"
+
+#include <string>
+#include <vector>
+#include "asio/bind_cancellation_slot.hpp"
+#include "asio/cancellation_signal.hpp"
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+void proxy_handler(const asio::error_code&, std::size_t, std::size_t)
+{
+}
+
+void test_compile()
+{
+  using namespace asio;
+
+  try
+  {
+    io_context ioc;
+
+    ip::tcp::socket socket1(ioc);
+    ip::tcp::socket socket2(ioc);
+
+    async_proxy(socket1, socket2, &proxy_handler);
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+    local::stream_protocol::socket socket3(ioc);
+
+    async_proxy(socket3, socket1, &proxy_handler);
+    async_proxy(socket1, socket3, &proxy_handler);
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+void connect_tcp_pair(asio::ip::tcp::acceptor& acceptor,
+    asio::ip::tcp::socket& client, asio::ip::tcp::socket& server)
+{
+  asio::ip::tcp::endpoint endpoint = acceptor.local_endpoint();
+  endpoint.address(asio::ip::address_v4::loopback());
+  client.connect(endpoint);
+  acceptor.accept(server);
+}
+
+struct proxy_result
+{
+  proxy_result()
+    : called(false),
+      a_to_b(0),
+      b_to_a(0)
+  {
+  }
+
+  void operator()(const asio::error_code& e, std::size_t n1, std::size_t n2)
+  {
+    called = true;
+    ec = e;
+    a_to_b = n1;
+    b_to_a = n2;
+  }
+
+  bool called;
+  asio::error_code ec;
+  std::size_t a_to_b;
+  std::size_t b_to_a;
+};
+
+struct proxy_result_handler
+{
+  proxy_result* result;
+
+  void operator()(const asio::error_code& e, std::size_t n1, std::size_t n2)
+  {
+    (*result)(e, n1, n2);
+  }
+};
+
+std::string make_data(std::size_t length)
+{
+  std::string data(length, '\0');
+  for (std::size_t i = 0; i < length; ++i)
+    data[i] = static_cast<char>('A' + (i * 7 + i / 251) % 26);
+  return data;
+}
+
+// Sends request_data from peer_a and response_data from peer_b, with each
+// peer shutting down its sending side once done, and checks that both arrive
+// intact on the far side of a proxy between a and b.
+template <typename PeerA, typename A, typename B, typename PeerB>
+void run_relay(asio::io_context& ioc, PeerA& peer_a, A& a,
+    B& b, PeerB& peer_b, const std::string& request_data,
+    const std::string& response_data)
+{
+  proxy_result result;
+  proxy_result_handler handler = { &result };
+  asio::async_proxy(a, b, handler);
+
+  std::string request;
+  std::string response;
+
+  asio::async_write(peer_a, asio::buffer(request_data),
+      [&](const asio::error_code& ec, std::size_t)
+      {
+        ASIO_CHECK(!ec);
+        peer_a.shutdown(asio::socket_base::shutdown_send);
+      });
+
+  asio::async_read(peer_b, asio::dynamic_buffer(request),
+      [&](const asio::error_code& ec, std::size_t)
+      {
+        // The request direction is half-closed while the response direction
+        // remains open.
+        ASIO_CHECK(ec == asio::error::eof);
+        asio::async_write(peer_b, asio::buffer(response_data),
+            [&](const asio::error_code& ec, std::size_t)
+            {
+              ASIO_CHECK(!ec);
+              peer_b.shutdown(asio::socket_base::shutdown_send);
+            });
+      });
+
+  asio::async_read(peer_a, asio::dynamic_buffer(response),
+      [&](const asio::error_code& ec, std::size_t)
+      {
+        ASIO_CHECK(ec == asio::error::eof);
+      });
+
+  ioc.run();
+
+  ASIO_CHECK(result.called);
+  ASIO_CHECK(!result.ec);
+  ASIO_CHECK(result.a_to_b == request_data.size());
+  ASIO_CHECK(result.b_to_a == response_data.size());
+  ASIO_CHECK(request == request_data);
+  ASIO_CHECK(response == response_data);
+}
+
+void test_tcp_relay()
+{
+  asio::io_context ioc;
+  asio::ip::tcp::acceptor acceptor(ioc,
+      asio::ip::tcp::endpoint(asio::ip::tcp::v4(), 0));
+
+  asio::ip::tcp::socket peer_a(ioc), a(ioc), b(ioc), peer_b(ioc);
+  connect_tcp_pair(acceptor, peer_a, a);
+  connect_tcp_pair(acceptor, b, peer_b);
+
+  run_relay(ioc, peer_a, a, b, peer_b,
+      make_data(4 * 1024 * 1024 + 17), make_data(100000));
+}
+
+void test_empty_relay()
+{
+  asio::io_context ioc;
+  asio::ip::tcp::acceptor acceptor(ioc,
+      asio::ip::tcp::endpoint(asio::ip::tcp::v4(), 0));
+
+  asio::ip::tcp::socket peer_a(ioc), a(ioc), b(ioc), peer_b(ioc);
+  connect_tcp_pair(acceptor, peer_a, a);
+  connect_tcp_pair(acceptor, b, peer_b);
+
+  run_relay(ioc, peer_a, a, b, peer_b, std::string(), std::string());
+}
+
+void test_mixed_relay()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  asio::io_context ioc;
+  asio::ip::tcp::acceptor acceptor(ioc,
+      asio::ip::tcp::endpoint(asio::ip::tcp::v4(), 0));
+
+  asio::local::stream_protocol::socket peer_a(ioc), a(ioc);
+  asio::local::connect_pair(peer_a, a);
+
+  asio::ip::tcp::socket b(ioc), peer_b(ioc);
+  connect_tcp_pair(acceptor, b, peer_b);
+
+  run_relay(ioc, peer_a, a, b, peer_b,
+      make_data(1024 * 1024 + 3), make_data(300000));
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+void test_cancellation()
+{
+  asio::io_context ioc;
+  asio::ip::tcp::acceptor acceptor(ioc,
+      asio::ip::tcp::endpoint(asio::ip::tcp::v4(), 0));
+
+  asio::ip::tcp::socket peer_a(ioc), a(ioc), b(ioc), peer_b(ioc);
+  connect_tcp_pair(acceptor, peer_a, a);
+  connect_tcp_pair(acceptor, b, peer_b);
+
+  const std::string data = make_data(1000);
+  asio::write(peer_a, asio::buffer(data));
+
+  asio::cancellation_signal signal;
+  proxy_result result;
+  proxy_result_handler handler = { &result };
+  asio::async_proxy(a, b,
+      asio::bind_cancellation_slot(signal.slot(), handler));
+
+  std::string received(data.size(), '\0');
+  asio::async_read(peer_b, asio::buffer(&received[0], received.size()),
+      [&](const asio::error_code& ec, std::size_t)
+      {
+        ASIO_CHECK(!ec);
+        signal.emit(asio::cancellation_type::terminal);
+      });
+
+  ioc.run();
+
+  ASIO_CHECK(result.called);
+  ASIO_CHECK(result.ec == asio::error::operation_aborted);
+  ASIO_CHECK(result.a_to_b == data.size());
+  ASIO_CHECK(result.b_to_a == 0);
+  ASIO_CHECK(received == data);
+}
+
+void test_error_stops_other_direction()
+{
+  asio::io_context ioc;
+  asio::ip::tcp::acceptor acceptor(ioc,
+      asio::ip::tcp::endpoint(asio::ip::tcp::v4(), 0));
+
+  asio::ip::tcp::socket peer_a(ioc), a(ioc), b(ioc), peer_b(ioc);
+  connect_tcp_pair(acceptor, peer_a, a);
+  connect_tcp_pair(acceptor, b, peer_b);
+
+  proxy_result result;
+  proxy_result_handler handler = { &result };
+  asio::async_proxy(a, b, handler);
+
+  // Reset the connection to a. The direction from b to a is idle, and would
+  // otherwise wait for peer_b indefinitely.
+  peer_a.set_option(asio::socket_base::linger(true, 0));
+  peer_a.close();
+
+  ioc.run();
+
+  ASIO_CHECK(result.called);
+  ASIO_CHECK(result.ec == asio::error::connection_reset);
+  ASIO_CHECK(result.a_to_b == 0);
+  ASIO_CHECK(result.b_to_a == 0);
+}
+
+ASIO_TEST_SUITE
+(
+  "proxy",
+  ASIO_COMPILE_TEST_CASE(test_compile)
+  ASIO_TEST_CASE(test_tcp_relay)
+  ASIO_TEST_CASE(test_empty_relay)
+  ASIO_TEST_CASE(test_mixed_relay)
+  ASIO_TEST_CASE(test_cancellation)
+  ASIO_TEST_CASE(test_error_stops_other_direction)
+)
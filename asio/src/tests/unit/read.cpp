@@ -21,6 +21,8 @@
 #include <functional>
 #include <vector>
 #include "archetypes/async_result.hpp"
+#include "archetypes/counting_allocator.hpp"
+#include "asio/bind_allocator.hpp"
 #include "asio/io_context.hpp"
 #include "asio/post.hpp"
 #include "asio/streambuf.hpp"
@@ -4897,6 +4899,61 @@ void test_4_arg_streambuf_async_read()
 #endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
 }
 
+void test_async_read_allocation()
+{
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  asio::io_context ioc;
+  test_stream s(ioc);
+  char read_buf[sizeof(read_data)];
+  asio::mutable_buffer buffers
+    = asio::buffer(read_buf, sizeof(read_buf));
+
+  s.reset(read_data, sizeof(read_data));
+  s.next_read_length(1);
+  memset(read_buf, 0, sizeof(read_buf));
+  bool called = false;
+  int allocations = 0;
+  int deallocations = 0;
+  asio::async_read(s, buffers,
+      asio::bind_allocator(
+        archetypes::counting_allocator<void>(&allocations, &deallocations),
+        bindns::bind(async_read_handler,
+          _1, _2, sizeof(read_data), &called)));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(s.check_buffers(buffers, sizeof(read_data)));
+#if !defined(ASIO_DISABLE_REUSABLE_OP_MEMORY)
+  // Every partial read reuses the memory of the first.
+  ASIO_CHECK(allocations == 1);
+#endif // !defined(ASIO_DISABLE_REUSABLE_OP_MEMORY)
+  ASIO_CHECK(deallocations == allocations);
+
+  std::string data;
+  s.reset(read_data, sizeof(read_data));
+  s.next_read_length(10);
+  called = false;
+  allocations = 0;
+  deallocations = 0;
+  asio::async_read(s, asio::dynamic_buffer(data, sizeof(read_data)),
+      asio::bind_allocator(
+        archetypes::counting_allocator<void>(&allocations, &deallocations),
+        bindns::bind(async_read_handler,
+          _1, _2, sizeof(read_data), &called)));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(data.size() == sizeof(read_data));
+  ASIO_CHECK(s.check_buffers(asio::buffer(data), sizeof(read_data)));
+#if !defined(ASIO_DISABLE_REUSABLE_OP_MEMORY)
+  ASIO_CHECK(allocations == 1);
+#endif // !defined(ASIO_DISABLE_REUSABLE_OP_MEMORY)
+  ASIO_CHECK(deallocations == allocations);
+}
+
 ASIO_TEST_SUITE
 (
   "read",
@@ -4930,4 +4987,5 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(test_4_arg_std_array_buffers_async_read)
   ASIO_TEST_CASE(test_4_arg_dynamic_string_async_read)
   ASIO_TEST_CASE(test_4_arg_streambuf_async_read)
+  ASIO_TEST_CASE(test_async_read_allocation)
 )
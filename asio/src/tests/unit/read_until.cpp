@@ -18,6 +18,8 @@
 
 #include <cstring>
 #include <functional>
+#include <string>
+#include <vector>
 #include "archetypes/async_result.hpp"
 #include "asio/io_context.hpp"
 #include "asio/post.hpp"
@@ -96,6 +98,79 @@ private:
   size_t next_read_length_;
 };
 
+// A dynamic buffer that presents its contents as a sequence of small buffers,
+// so that delimiters straddle the boundaries between buffers.
+class segmented_dynamic_buffer
+{
+public:
+  typedef std::vector<asio::const_buffer> const_buffers_type;
+  typedef std::vector<asio::mutable_buffer> mutable_buffers_type;
+
+  segmented_dynamic_buffer(std::string& data, std::size_t segment_size)
+    : data_(&data),
+      segment_size_(segment_size)
+  {
+  }
+
+  std::size_t size() const
+  {
+    return data_->size();
+  }
+
+  std::size_t max_size() const
+  {
+    return data_->max_size();
+  }
+
+  std::size_t capacity() const
+  {
+    return data_->capacity();
+  }
+
+  const_buffers_type data(std::size_t pos, std::size_t n) const
+  {
+    const_buffers_type buffers;
+    for (std::size_t end = pos + (std::min)(n, size() - pos);
+        pos < end; pos += segment_size_)
+    {
+      buffers.push_back(asio::buffer(data_->data() + pos,
+            (std::min)(segment_size_, end - pos)));
+    }
+    return buffers;
+  }
+
+  mutable_buffers_type data(std::size_t pos, std::size_t n)
+  {
+    mutable_buffers_type buffers;
+    for (std::size_t end = pos + (std::min)(n, size() - pos);
+        pos < end; pos += segment_size_)
+    {
+      buffers.push_back(asio::buffer(&(*data_)[0] + pos,
+            (std::min)(segment_size_, end - pos)));
+    }
+    return buffers;
+  }
+
+  void grow(std::size_t n)
+  {
+    data_->resize(data_->size() + n);
+  }
+
+  void shrink(std::size_t n)
+  {
+    data_->resize(data_->size() - (std::min)(n, size()));
+  }
+
+  void consume(std::size_t n)
+  {
+    data_->erase(0, n);
+  }
+
+private:
+  std::string* data_;
+  std::size_t segment_size_;
+};
+
 static const char read_data[]
   = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
 
@@ -1611,6 +1686,96 @@ void test_streambuf_async_read_until_match_condition()
 #endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
 }
 
+void test_segmented_read_until_string()
+{
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  asio::io_context ioc;
+  test_stream s(ioc);
+  asio::error_code ec;
+
+  // Place each delimiter at every offset in a message that is long enough for
+  // the vectorised search to be used, and read it back using a range of read
+  // lengths and buffer segment sizes.
+  static const char* const delims[] = { "\n", "\r\n", "\r\n\r\n", "XYZ" };
+  static const std::size_t segment_sizes[] = { 1, 2, 3, 7, 64, 4096 };
+  static const std::size_t read_lengths[] = { 1, 5, 100, 512 };
+
+  for (std::size_t d = 0; d < sizeof(delims) / sizeof(delims[0]); ++d)
+  {
+    std::string delim(delims[d]);
+    for (std::size_t offset = 0; offset < 80; ++offset)
+    {
+      // The message contains near misses before the delimiter.
+      std::string message(100, 'a');
+      for (std::size_t i = 0; i + 1 < delim.size() && i < offset; ++i)
+        message[offset - 1 - i] = delim[delim.size() - 2 - i];
+      message.replace(offset, delim.size(), delim);
+
+      for (std::size_t i = 0;
+          i < sizeof(segment_sizes) / sizeof(segment_sizes[0]); ++i)
+      {
+        for (std::size_t j = 0;
+            j < sizeof(read_lengths) / sizeof(read_lengths[0]); ++j)
+        {
+          std::string data;
+          s.reset(message.data(), message.size());
+          s.next_read_length(read_lengths[j]);
+          std::size_t length = asio::read_until(s,
+              segmented_dynamic_buffer(data, segment_sizes[i]),
+              delim, ec);
+          ASIO_CHECK(!ec);
+          ASIO_CHECK(length == message.find(delim) + delim.size());
+
+          if (delim.size() == 1)
+          {
+            data.clear();
+            s.reset(message.data(), message.size());
+            s.next_read_length(read_lengths[j]);
+            length = asio::read_until(s,
+                segmented_dynamic_buffer(data, segment_sizes[i]),
+                delim[0], ec);
+            ASIO_CHECK(!ec);
+            ASIO_CHECK(length == message.find(delim) + delim.size());
+          }
+        }
+      }
+    }
+  }
+
+  std::string message(300, 'a');
+  message.replace(250, 4, "\r\n\r\n");
+  std::string data;
+  s.reset(message.data(), message.size());
+  s.next_read_length(7);
+  std::size_t length = 0;
+  bool called = false;
+  asio::async_read_until(s, segmented_dynamic_buffer(data, 3), "\r\n\r\n",
+      bindns::bind(async_read_handler, _1, &ec,
+        _2, &length, &called));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(length == 254);
+
+  data.clear();
+  s.reset(message.data(), message.size());
+  s.next_read_length(7);
+  length = 0;
+  called = false;
+  asio::async_read_until(s, segmented_dynamic_buffer(data, 3), '\n',
+      bindns::bind(async_read_handler, _1, &ec,
+        _2, &length, &called));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(length == 252);
+}
+
 ASIO_TEST_SUITE
 (
   "read_until",
@@ -1626,4 +1791,5 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(test_streambuf_async_read_until_string)
   ASIO_TEST_CASE(test_dynamic_string_async_read_until_match_condition)
   ASIO_TEST_CASE(test_streambuf_async_read_until_match_condition)
+  ASIO_TEST_CASE(test_segmented_read_until_string)
 )
@@ -19,6 +19,9 @@
 #include "unit_test.hpp"
 #include <vector>
 #include "asio/detail/type_traits.hpp"
+#include "asio/post.hpp"
+#include "asio/thread_pool.hpp"
+#include "asio/use_future.hpp"
 
 void recycling_allocator_test()
 {
@@ -73,8 +76,53 @@ void recycling_allocator_test()
   ASIO_CHECK(v.size() == 42);
 }
 
+char* allocate_block()
+{
+  return asio::recycling_allocator<char>().allocate(3000);
+}
+
+char* reallocate_block()
+{
+  asio::recycling_allocator<char> a;
+  char* p = a.allocate(3000);
+  a.deallocate(p, 3000);
+  char* q = a.allocate(3000);
+  ASIO_CHECK(p == q);
+  return q;
+}
+
+void recycling_allocator_cross_thread_test()
+{
+  asio::thread_pool pool(1);
+  asio::recycling_allocator<char> a;
+
+  char* p1 = asio::post(pool, asio::use_future(&reallocate_block)).get();
+  ASIO_CHECK(p1 != 0);
+
+  // Deallocating on this thread returns the block to the pool thread's cache.
+  a.deallocate(p1, 3000);
+
+  char* p2 = asio::post(pool, asio::use_future(&allocate_block)).get();
+  ASIO_CHECK(p1 == p2);
+
+  a.deallocate(p2, 3000);
+
+  char* p3 = asio::post(pool, asio::use_future(&allocate_block)).get();
+  ASIO_CHECK(p3 != 0);
+
+  pool.join();
+
+  // The owning cache has gone, so the block is released immediately.
+  a.deallocate(p3, 3000);
+
+  char* p4 = a.allocate(1 << 20);
+  ASIO_CHECK(p4 != 0);
+  a.deallocate(p4, 1 << 20);
+}
+
 ASIO_TEST_SUITE
 (
   "recycling_allocator",
   ASIO_TEST_CASE(recycling_allocator_test)
+  ASIO_TEST_CASE(recycling_allocator_cross_thread_test)
 )
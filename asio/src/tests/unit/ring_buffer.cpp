@@ -0,0 +1,205 @@
+//
+// ring_buffer.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ring_buffer.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "asio/io_context.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "asio/read_until.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_RING_BUFFER)
+
+void ring_buffer_v2_test()
+{
+  asio::ring_buffer rb(1);
+  std::size_t capacity = rb.capacity();
+  ASIO_CHECK(capacity > 0);
+  ASIO_CHECK(rb.size() == 0);
+
+  asio::dynamic_ring_buffer db = asio::dynamic_buffer(rb);
+  ASIO_CHECK(db.size() == 0);
+  ASIO_CHECK(db.max_size() == capacity);
+  ASIO_CHECK(db.capacity() == capacity);
+
+  // Move the start of the data close to the end of the underlying memory.
+  db.grow(capacity - 10);
+  db.consume(capacity - 10);
+  ASIO_CHECK(db.size() == 0);
+
+  // Data that wraps around the end of the underlying memory is contiguous.
+  std::string expected;
+  for (int i = 0; i < 25; ++i)
+  {
+    std::size_t pos = db.size();
+    db.grow(4);
+    asio::mutable_buffer b = db.data(pos, 4);
+    ASIO_CHECK(b.size() == 4);
+    std::memcpy(b.data(), "abcd", 4);
+    expected += "abcd";
+    ASIO_CHECK(db.size() == pos + 4);
+  }
+
+  const asio::dynamic_ring_buffer& cdb = db;
+  asio::const_buffer data = cdb.data(0, db.size());
+  ASIO_CHECK(data.size() == 100);
+  ASIO_CHECK(std::string(static_cast<const char*>(data.data()), 100)
+      == expected);
+
+  // The ring buffer itself presents the same contiguous data.
+  ASIO_CHECK(rb.size() == 100);
+  ASIO_CHECK(rb.data().data() == data.data());
+
+  // Copies of the dynamic buffer share the ring buffer's state.
+  asio::dynamic_ring_buffer db2(db);
+  db2.consume(50);
+  ASIO_CHECK(db.size() == 50);
+  db2.shrink(10);
+  ASIO_CHECK(db.size() == 40);
+
+  // The maximum size is limited by the capacity of the ring buffer.
+  bool threw = false;
+  try
+  {
+    db.grow(capacity - 39);
+  }
+  catch (std::length_error&)
+  {
+    threw = true;
+  }
+  ASIO_CHECK(threw);
+  db.grow(capacity - 40);
+  ASIO_CHECK(db.size() == capacity);
+  ASIO_CHECK(db.data(0, capacity).size() == capacity);
+
+  db.consume(capacity + 1);
+  ASIO_CHECK(db.size() == 0);
+
+  // An explicit maximum size is honoured.
+  asio::dynamic_ring_buffer db3 = asio::dynamic_buffer(rb, 16);
+  ASIO_CHECK(db3.max_size() == 16);
+  threw = false;
+  try
+  {
+    db3.grow(17);
+  }
+  catch (std::length_error&)
+  {
+    threw = true;
+  }
+  ASIO_CHECK(threw);
+}
+
+void ring_buffer_v1_test()
+{
+#if !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+  asio::ring_buffer rb(4096);
+  std::size_t capacity = rb.capacity();
+  asio::dynamic_ring_buffer db = asio::dynamic_buffer(rb);
+
+  asio::mutable_buffer b = db.prepare(capacity - 2);
+  ASIO_CHECK(b.size() == capacity - 2);
+  db.commit(capacity - 2);
+  ASIO_CHECK(db.size() == capacity - 2);
+  db.consume(capacity - 3);
+  ASIO_CHECK(db.size() == 1);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    b = db.prepare(10);
+    ASIO_CHECK(b.size() == 10);
+    std::memcpy(b.data(), "abcd", 4);
+    db.commit(4);
+    ASIO_CHECK(db.size() == 5);
+    db.consume(4);
+    ASIO_CHECK(db.size() == 1);
+  }
+
+  asio::const_buffer data = db.data();
+  ASIO_CHECK(data.size() == 1);
+  ASIO_CHECK(*static_cast<const char*>(data.data()) == 'd');
+  ASIO_CHECK(rb.size() == 1);
+
+  db.consume(1);
+  ASIO_CHECK(db.size() == 0);
+#endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
+}
+
+void ring_buffer_read_until_test()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  asio::io_context ioc;
+  asio::local::stream_protocol::socket s1(ioc), s2(ioc);
+  asio::local::connect_pair(s1, s2);
+
+  asio::ring_buffer rb(4096);
+  std::size_t capacity = rb.capacity();
+  std::string line(capacity / 3 - 2, 'x');
+  line += "\r\n";
+
+  // Read enough lines that the data wraps around the underlying memory.
+  std::size_t total = 0;
+  for (int i = 0; i < 10; ++i)
+  {
+    asio::write(s1, asio::buffer(line));
+    std::size_t n = asio::read_until(s2, asio::dynamic_buffer(rb), "\r\n");
+    ASIO_CHECK(n == line.size());
+    ASIO_CHECK(rb.data().size() == n);
+    ASIO_CHECK(std::memcmp(rb.data().data(), line.data(), n) == 0);
+    asio::dynamic_buffer(rb).consume(n);
+    total += n;
+  }
+  ASIO_CHECK(total > capacity);
+
+  asio::write(s1, asio::buffer(line));
+  std::size_t length = 0;
+  asio::async_read_until(s2, asio::dynamic_buffer(rb), "\r\n",
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        ASIO_CHECK(!ec);
+        length = n;
+      });
+  ioc.run();
+  ASIO_CHECK(length == line.size());
+
+  // A line that does not fit in the buffer is not found.
+  std::string long_line(capacity + 1, 'x');
+  asio::dynamic_buffer(rb).consume(length);
+  asio::write(s1, asio::buffer(long_line));
+  asio::error_code ec;
+  length = asio::read_until(s2, asio::dynamic_buffer(rb), "\r\n", ec);
+  ASIO_CHECK(ec == asio::error::not_found);
+  ASIO_CHECK(length == 0);
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+#endif // defined(ASIO_HAS_RING_BUFFER)
+
+ASIO_TEST_SUITE
+(
+  "ring_buffer",
+#if defined(ASIO_HAS_RING_BUFFER)
+  ASIO_TEST_CASE(ring_buffer_v2_test)
+  ASIO_TEST_CASE(ring_buffer_v1_test)
+  ASIO_TEST_CASE(ring_buffer_read_until_test)
+#endif // defined(ASIO_HAS_RING_BUFFER)
+  ASIO_TEST_CASE(null_test)
+)
@@ -16,10 +16,17 @@
 // Test that header file is self-contained.
 #include "asio/signal_set.hpp"
 
+#include <signal.h>
 #include "archetypes/async_result.hpp"
 #include "asio/io_context.hpp"
 #include "unit_test.hpp"
 
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+# include <sys/types.h>
+# include <sys/wait.h>
+# include <unistd.h>
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
 //------------------------------------------------------------------------------
 
 // signal_set_compile test
@@ -91,8 +98,140 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// signal_set_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the signal_set class,
+// using signals raised by the test program itself.
+
+namespace signal_set_runtime {
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+void record_signal(const asio::error_code& ec,
+    int signal_number, asio::error_code* out_ec, int* out_signal_number)
+{
+  *out_ec = ec;
+  *out_signal_number = signal_number;
+}
+
+void test_multiple_sets()
+{
+  asio::io_context ioc;
+  asio::signal_set set1(ioc, SIGUSR1);
+  asio::signal_set set2(ioc, SIGUSR1, SIGUSR2);
+
+  asio::error_code ec1, ec2;
+  int signal1 = 0, signal2 = 0;
+  set1.async_wait(
+      [&](const asio::error_code& ec, int n)
+      {
+        record_signal(ec, n, &ec1, &signal1);
+      });
+  set2.async_wait(
+      [&](const asio::error_code& ec, int n)
+      {
+        record_signal(ec, n, &ec2, &signal2);
+      });
+
+  ::raise(SIGUSR1);
+  ioc.run();
+
+  ASIO_CHECK(!ec1);
+  ASIO_CHECK(signal1 == SIGUSR1);
+  ASIO_CHECK(!ec2);
+  ASIO_CHECK(signal2 == SIGUSR1);
+
+  // A signal that occurs with no waiting handler is queued.
+  set1.remove(SIGUSR1);
+  ::raise(SIGUSR2);
+
+  set2.async_wait(
+      [&](const asio::error_code& ec, int n)
+      {
+        record_signal(ec, n, &ec2, &signal2);
+      });
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(!ec2);
+  ASIO_CHECK(signal2 == SIGUSR2);
+
+  // Cancelled waits complete with operation_aborted.
+  set2.async_wait(
+      [&](const asio::error_code& ec, int n)
+      {
+        record_signal(ec, n, &ec2, &signal2);
+      });
+  set2.cancel();
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(ec2 == asio::error::operation_aborted);
+}
+
+void test_child_exit()
+{
+  asio::io_context ioc;
+  asio::signal_set set(ioc, SIGCHLD);
+
+  pid_t child = ::fork();
+  if (child == 0)
+    ::_exit(0);
+  ASIO_CHECK(child > 0);
+
+  asio::error_code result_ec;
+  int result_signal = 0;
+  set.async_wait(
+      [&](const asio::error_code& ec, int n)
+      {
+        record_signal(ec, n, &result_ec, &result_signal);
+      });
+
+  ioc.run();
+
+  ASIO_CHECK(!result_ec);
+  ASIO_CHECK(result_signal == SIGCHLD);
+
+  int status = 0;
+  ASIO_CHECK(::waitpid(child, &status, 0) == child);
+}
+
+void test_invalid_signal()
+{
+  asio::io_context ioc;
+  asio::signal_set set(ioc);
+
+  asio::error_code ec;
+  set.add(SIGKILL, ec);
+  ASIO_CHECK(!!ec);
+
+  set.add(-1, ec);
+  ASIO_CHECK(ec == asio::error::invalid_argument);
+
+#if defined(ASIO_HAS_SIGNALFD)
+  set.add(SIGUSR1, asio::signal_set::flags::restart, ec);
+  ASIO_CHECK(ec == asio::error::operation_not_supported);
+#endif // defined(ASIO_HAS_SIGNALFD)
+}
+
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+void test()
+{
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  test_multiple_sets();
+  test_child_exit();
+  test_invalid_signal();
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+}
+
+} // namespace signal_set_runtime
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "signal_set",
   ASIO_COMPILE_TEST_CASE(signal_set_compile::test)
+  ASIO_TEST_CASE(signal_set_runtime::test)
 )
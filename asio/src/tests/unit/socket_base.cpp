@@ -177,6 +177,17 @@ void test()
     (void)static_cast<bool>(!enable_connection_aborted1);
     (void)static_cast<bool>(enable_connection_aborted1.value());
 
+    // fast_accept class.
+
+    socket_base::fast_accept fast_accept1(true);
+    sock.set_option(fast_accept1);
+    socket_base::fast_accept fast_accept2;
+    sock.get_option(fast_accept2);
+    fast_accept1 = true;
+    (void)static_cast<bool>(fast_accept1);
+    (void)static_cast<bool>(!fast_accept1);
+    (void)static_cast<bool>(fast_accept1.value());
+
     // bytes_readable class.
 
     socket_base::bytes_readable bytes_readable;
@@ -631,6 +642,36 @@ void test()
   ASIO_CHECK(!static_cast<bool>(enable_connection_aborted4));
   ASIO_CHECK(!enable_connection_aborted4);
 
+  // fast_accept class.
+
+  socket_base::fast_accept fast_accept1(true);
+  ASIO_CHECK(fast_accept1.value());
+  ASIO_CHECK(static_cast<bool>(fast_accept1));
+  ASIO_CHECK(!!fast_accept1);
+  tcp_acceptor.set_option(fast_accept1, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::fast_accept fast_accept2;
+  tcp_acceptor.get_option(fast_accept2, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(fast_accept2.value());
+  ASIO_CHECK(static_cast<bool>(fast_accept2));
+  ASIO_CHECK(!!fast_accept2);
+
+  socket_base::fast_accept fast_accept3(false);
+  ASIO_CHECK(!fast_accept3.value());
+  ASIO_CHECK(!static_cast<bool>(fast_accept3));
+  ASIO_CHECK(!fast_accept3);
+  tcp_acceptor.set_option(fast_accept3, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::fast_accept fast_accept4;
+  tcp_acceptor.get_option(fast_accept4, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(!fast_accept4.value());
+  ASIO_CHECK(!static_cast<bool>(fast_accept4));
+  ASIO_CHECK(!fast_accept4);
+
   // bytes_readable class.
 
   socket_base::bytes_readable bytes_readable;
@@ -488,6 +488,135 @@ void system_timer_op_cancel_test()
   ASIO_CHECK(ioc.stopped());
 }
 
+void record_completion(asio::system_timer::time_point* completed,
+    const asio::error_code& ec)
+{
+  ASIO_CHECK(!ec);
+  *completed = now();
+}
+
+void system_timer_slack_test()
+{
+  using asio::chrono::milliseconds;
+
+  asio::io_context ioc;
+
+  asio::system_timer t1(ioc);
+  ASIO_CHECK(t1.slack() == asio::system_timer::duration());
+
+  t1.slack(milliseconds(100));
+  ASIO_CHECK(t1.slack() == milliseconds(100));
+
+  asio::system_timer t2(ioc);
+  t2.slack(milliseconds(100));
+  asio::system_timer t3(ioc);
+  t3.slack(milliseconds(100));
+
+  // Choose expiry times that fall within a single slack interval, measured
+  // from the clock's epoch. All three waits are scheduled for the end of the
+  // interval, and none may complete before its own expiry time.
+  asio::system_timer::duration slack = milliseconds(100);
+  asio::system_timer::duration since_epoch = now().time_since_epoch();
+  asio::system_timer::time_point end_of_interval(
+      since_epoch - since_epoch % slack + 2 * slack);
+
+  t1.expires_at(end_of_interval - milliseconds(30));
+  t2.expires_at(end_of_interval - milliseconds(20));
+  t3.expires_at(end_of_interval - milliseconds(10));
+
+  asio::system_timer::time_point completed1, completed2, completed3;
+  t1.async_wait(bindns::bind(record_completion,
+        &completed1, bindns::placeholders::_1));
+  t2.async_wait(bindns::bind(record_completion,
+        &completed2, bindns::placeholders::_1));
+  t3.async_wait(bindns::bind(record_completion,
+        &completed3, bindns::placeholders::_1));
+
+  ioc.run();
+
+  ASIO_CHECK(completed1 >= end_of_interval);
+  ASIO_CHECK(completed2 >= end_of_interval);
+  ASIO_CHECK(completed3 >= end_of_interval);
+
+  // The slack does not alter the expiry time reported by the timer.
+  ASIO_CHECK(t1.expiry() == end_of_interval - milliseconds(30));
+
+  // An expiry time already on an interval boundary is not delayed.
+  t1.expires_at(end_of_interval + slack);
+  t1.async_wait(bindns::bind(record_completion,
+        &completed1, bindns::placeholders::_1));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(completed1 >= end_of_interval + slack);
+  ASIO_CHECK(completed1 < end_of_interval + 2 * slack);
+
+  // The slack is transferred by a move.
+  asio::system_timer t4(std::move(t1));
+  ASIO_CHECK(t4.slack() == milliseconds(100));
+}
+
+void system_timer_refresh_test()
+{
+  using asio::chrono::milliseconds;
+
+  asio::io_context ioc;
+
+  // Refreshing a timer with no pending waits only sets the expiry time.
+  asio::system_timer t1(ioc);
+  asio::system_timer::time_point start = now();
+  t1.refresh_expires_at(start + milliseconds(50));
+  ASIO_CHECK(t1.expiry() == start + milliseconds(50));
+
+  // Extending the expiry of a pending wait delays its completion, and the
+  // wait still completes successfully.
+  asio::system_timer::time_point completed1;
+  t1.async_wait(bindns::bind(record_completion,
+        &completed1, bindns::placeholders::_1));
+  t1.refresh_expires_at(start + milliseconds(100));
+  t1.refresh_expires_after(milliseconds(150));
+  asio::system_timer::time_point expiry1 = t1.expiry();
+
+  // Bringing the expiry of a pending wait forward makes it complete earlier.
+  asio::system_timer t2(ioc);
+  t2.expires_at(start + milliseconds(400));
+  asio::system_timer::time_point completed2;
+  t2.async_wait(bindns::bind(record_completion,
+        &completed2, bindns::placeholders::_1));
+  t2.refresh_expires_at(start + milliseconds(300));
+  t2.refresh_expires_at(start + milliseconds(20));
+
+  ioc.run();
+
+  ASIO_CHECK(completed1 >= expiry1);
+  ASIO_CHECK(completed2 >= start + milliseconds(20));
+  ASIO_CHECK(completed2 < completed1);
+
+  // A refresh after an earlier one has moved the timer keeps applying.
+  asio::system_timer::time_point completed3;
+  start = now();
+  t1.expires_at(start + milliseconds(20));
+  t1.async_wait(bindns::bind(record_completion,
+        &completed3, bindns::placeholders::_1));
+  t1.refresh_expires_at(start + milliseconds(40));
+
+  asio::system_timer t3(ioc);
+  t3.expires_at(start + milliseconds(30));
+  t3.async_wait(
+      [&](const asio::error_code& ec)
+      {
+        ASIO_CHECK(!ec);
+        ASIO_CHECK(completed3 == asio::system_timer::time_point());
+        t1.refresh_expires_at(start + milliseconds(100));
+      });
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(completed3 >= start + milliseconds(100));
+}
+
 ASIO_TEST_SUITE
 (
   "system_timer",
@@ -497,4 +626,6 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(system_timer_thread_test)
   ASIO_TEST_CASE(system_timer_move_test)
   ASIO_TEST_CASE(system_timer_op_cancel_test)
+  ASIO_TEST_CASE(system_timer_slack_test)
+  ASIO_TEST_CASE(system_timer_refresh_test)
 )
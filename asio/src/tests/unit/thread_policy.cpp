@@ -0,0 +1,187 @@
+//
+// thread_policy.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/thread_policy.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/post.hpp"
+#include "asio/system_error.hpp"
+#include "asio/thread_pool.hpp"
+#include "unit_test.hpp"
+
+#if defined(__linux__)
+# include <pthread.h>
+# include <sched.h>
+#endif // defined(__linux__)
+
+#if defined(__linux__)
+
+std::string current_thread_name()
+{
+  char name[16] = "";
+  pthread_getname_np(pthread_self(), name, sizeof(name));
+  return name;
+}
+
+// Get the CPUs on which the calling thread is allowed to run.
+std::vector<int> current_thread_cpus()
+{
+  std::vector<int> cpus;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    if (CPU_ISSET(cpu, &set))
+      cpus.push_back(cpu);
+  return cpus;
+}
+
+#endif // defined(__linux__)
+
+void thread_policy_accessors_test()
+{
+  asio::thread_policy policy;
+  ASIO_CHECK(policy.name_prefix().empty());
+  ASIO_CHECK(policy.cpus().empty());
+  ASIO_CHECK(policy.assignment() == asio::thread_policy::shared);
+  ASIO_CHECK(policy.numa_node() == -1);
+
+  std::vector<int> cpus;
+  cpus.push_back(1);
+  cpus.push_back(3);
+  policy.set_name_prefix("worker-")
+    .set_cpus(cpus, asio::thread_policy::one_per_thread)
+    .set_numa_node(0);
+  ASIO_CHECK(policy.name_prefix() == "worker-");
+  ASIO_CHECK(policy.cpus() == cpus);
+  ASIO_CHECK(policy.assignment() == asio::thread_policy::one_per_thread);
+  ASIO_CHECK(policy.numa_node() == 0);
+
+  // An empty policy leaves the thread unchanged.
+  asio::error_code ec;
+  asio::thread_policy().apply(0, ec);
+  ASIO_CHECK(!ec);
+}
+
+void thread_policy_thread_pool_test()
+{
+#if defined(__linux__)
+  int cpu = current_thread_cpus().back();
+
+  asio::thread_policy policy;
+  policy.set_name_prefix("pool-")
+    .set_cpus(std::vector<int>(1, cpu), asio::thread_policy::one_per_thread);
+
+  asio::thread_pool pool(2, policy);
+
+  std::string names[2];
+  std::vector<int> cpus[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    asio::post(pool,
+        [&names, &cpus, i]
+        {
+          names[i] = current_thread_name();
+          cpus[i] = current_thread_cpus();
+        });
+  }
+  pool.join();
+
+  for (int i = 0; i < 2; ++i)
+  {
+    ASIO_CHECK(names[i] == "pool-0" || names[i] == "pool-1");
+    ASIO_CHECK(cpus[i] == std::vector<int>(1, cpu));
+  }
+#endif // defined(__linux__)
+}
+
+void thread_policy_bind_test()
+{
+#if defined(__linux__)
+  asio::io_context io_context;
+
+  asio::thread_policy policy;
+  policy.set_name_prefix("io-");
+
+  std::string name;
+  asio::post(io_context, [&name]{ name = current_thread_name(); });
+
+  std::thread t(policy.bind(7, [&io_context]{ io_context.run(); }));
+  t.join();
+
+  ASIO_CHECK(name == "io-7");
+
+  // Long prefixes are truncated so that the number is kept.
+  policy.set_name_prefix("a-very-long-thread-name-");
+  std::thread t2(policy.bind(12, [&name]{ name = current_thread_name(); }));
+  t2.join();
+
+  ASIO_CHECK(name == "a-very-long-t12");
+#endif // defined(__linux__)
+}
+
+void thread_policy_error_test()
+{
+#if defined(__linux__)
+  asio::thread_policy policy;
+  policy.set_cpus(std::vector<int>(1, -1)).set_name_prefix("bad-");
+
+  std::string name;
+  asio::error_code ec;
+  std::thread t(
+      [&]
+      {
+        policy.apply(3, ec);
+        name = current_thread_name();
+      });
+  t.join();
+
+  // The remaining settings are applied after a failure.
+  ASIO_CHECK(ec == asio::error::invalid_argument);
+  ASIO_CHECK(name == "bad-3");
+
+# if !defined(ASIO_NO_EXCEPTIONS)
+  bool caught = false;
+  std::thread t2(
+      [&]
+      {
+        try
+        {
+          policy.apply(0);
+        }
+        catch (const asio::system_error& e)
+        {
+          caught = (e.code() == asio::error::invalid_argument);
+        }
+      });
+  t2.join();
+
+  ASIO_CHECK(caught);
+# endif // !defined(ASIO_NO_EXCEPTIONS)
+#endif // defined(__linux__)
+}
+
+ASIO_TEST_SUITE
+(
+  "thread_policy",
+  ASIO_TEST_CASE(thread_policy_accessors_test)
+  ASIO_TEST_CASE(thread_policy_thread_pool_test)
+  ASIO_TEST_CASE(thread_policy_bind_test)
+  ASIO_TEST_CASE(thread_policy_error_test)
+)
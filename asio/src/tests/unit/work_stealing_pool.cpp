@@ -0,0 +1,262 @@
+//
+// work_stealing_pool.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/work_stealing_pool.hpp"
+
+#include <atomic>
+#include <functional>
+#include "asio/defer.hpp"
+#include "asio/deferred.hpp"
+#include "asio/dispatch.hpp"
+#include "asio/experimental/parallel_group.hpp"
+#include "asio/post.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_CO_AWAIT)
+# include "asio/co_spawn.hpp"
+# include "asio/use_awaitable.hpp"
+#endif // defined(ASIO_HAS_CO_AWAIT)
+
+using namespace asio;
+namespace bindns = std;
+
+void increment(int* count)
+{
+  ++(*count);
+}
+
+void decrement_to_zero(work_stealing_pool* pool, int* count)
+{
+  if (*count > 0)
+  {
+    --(*count);
+
+    int before_value = *count;
+    asio::post(*pool, bindns::bind(decrement_to_zero, pool, count));
+
+    // Handler execution cannot nest, so count value should remain unchanged.
+    ASIO_CHECK(*count == before_value);
+  }
+}
+
+void nested_decrement_to_zero(work_stealing_pool* pool, int* count)
+{
+  if (*count > 0)
+  {
+    --(*count);
+
+    asio::dispatch(*pool,
+        bindns::bind(nested_decrement_to_zero, pool, count));
+
+    // Handler execution is nested, so count value should now be zero.
+    ASIO_CHECK(*count == 0);
+  }
+}
+
+void work_stealing_pool_test()
+{
+  work_stealing_pool pool(1);
+
+  int count1 = 0;
+  asio::post(pool, bindns::bind(increment, &count1));
+
+  int count2 = 10;
+  asio::post(pool, bindns::bind(decrement_to_zero, &pool, &count2));
+
+  int count3 = 10;
+  asio::post(pool, bindns::bind(nested_decrement_to_zero, &pool, &count3));
+
+  pool.wait();
+
+  ASIO_CHECK(count1 == 1);
+  ASIO_CHECK(count2 == 0);
+  ASIO_CHECK(count3 == 0);
+}
+
+void fork_join(work_stealing_pool* pool, int depth,
+    std::atomic<int>* leaves)
+{
+  if (depth == 0)
+  {
+    ++(*leaves);
+    return;
+  }
+
+  asio::post(*pool, bindns::bind(fork_join, pool, depth - 1, leaves));
+  asio::defer(*pool, bindns::bind(fork_join, pool, depth - 1, leaves));
+}
+
+void work_stealing_pool_fork_join_test()
+{
+  work_stealing_pool pool(4);
+
+  std::atomic<int> leaves(0);
+  asio::post(pool, bindns::bind(fork_join, &pool, 14, &leaves));
+
+  // Functions posted from outside the pool go to the shared queue.
+  std::atomic<int> outside(0);
+  for (int i = 0; i < 1000; ++i)
+    asio::post(pool, [&outside]{ ++outside; });
+
+  pool.wait();
+
+  ASIO_CHECK(leaves == (1 << 14));
+  ASIO_CHECK(outside == 1000);
+}
+
+void work_stealing_pool_executor_query_test()
+{
+  work_stealing_pool pool(1);
+
+  ASIO_CHECK(
+      &asio::query(pool.executor(),
+        asio::execution::context)
+      == &pool);
+
+  ASIO_CHECK(
+      asio::query(pool.executor(),
+        asio::execution::blocking)
+      == asio::execution::blocking.possibly);
+
+  ASIO_CHECK(
+      asio::query(pool.executor(),
+        asio::execution::outstanding_work)
+      == asio::execution::outstanding_work.untracked);
+
+  ASIO_CHECK(
+      asio::query(pool.executor(),
+        asio::execution::relationship)
+      == asio::execution::relationship.fork);
+
+  ASIO_CHECK(
+      asio::query(pool.executor(),
+        asio::execution::mapping)
+      == asio::execution::mapping.thread);
+
+  ASIO_CHECK(
+      asio::query(pool.executor(),
+        asio::execution::allocator)
+      == std::allocator<void>());
+
+  ASIO_CHECK(
+      asio::query(pool.executor(),
+        asio::execution::occupancy)
+      == 1);
+}
+
+void work_stealing_pool_executor_execute_test()
+{
+  int count = 0;
+  work_stealing_pool pool(1);
+
+  pool.executor().execute(bindns::bind(increment, &count));
+
+  asio::require(pool.executor(),
+      asio::execution::blocking.always
+    ).execute(bindns::bind(increment, &count));
+
+  asio::require(pool.executor(),
+      asio::execution::blocking.never,
+      asio::execution::outstanding_work.tracked
+    ).execute(bindns::bind(increment, &count));
+
+  asio::require(pool.executor(),
+      asio::execution::blocking.never,
+      asio::execution::outstanding_work.untracked,
+      asio::execution::relationship.continuation
+    ).execute(bindns::bind(increment, &count));
+
+  asio::prefer(
+      asio::require(pool.executor(),
+        asio::execution::blocking.never,
+        asio::execution::relationship.continuation),
+      asio::execution::allocator(std::allocator<void>())
+    ).execute(bindns::bind(increment, &count));
+
+  pool.wait();
+
+  ASIO_CHECK(count == 5);
+}
+
+void work_stealing_pool_parallel_group_test()
+{
+  work_stealing_pool pool(2);
+  bool completed = false;
+  bool in_pool = false;
+
+  asio::experimental::make_parallel_group(
+      asio::post(pool, asio::deferred),
+      asio::post(pool, asio::deferred)
+    ).async_wait(asio::experimental::wait_for_all(),
+      [&](std::array<std::size_t, 2>)
+      {
+        completed = true;
+        in_pool = pool.get_executor().running_in_this_thread();
+      });
+
+  pool.wait();
+
+  ASIO_CHECK(completed);
+  ASIO_CHECK(in_pool);
+}
+
+#if defined(ASIO_HAS_CO_AWAIT)
+
+asio::awaitable<int> sum_to(int n)
+{
+  int total = 0;
+  for (int i = 1; i <= n; ++i)
+  {
+    co_await asio::post(asio::use_awaitable);
+    total += i;
+  }
+  co_return total;
+}
+
+void work_stealing_pool_co_spawn_test()
+{
+  work_stealing_pool pool(2);
+  int result = 0;
+
+  asio::co_spawn(pool, sum_to(100),
+      [&](std::exception_ptr, int value)
+      {
+        result = value;
+      });
+
+  pool.wait();
+
+  ASIO_CHECK(result == 5050);
+}
+
+#else // defined(ASIO_HAS_CO_AWAIT)
+
+void work_stealing_pool_co_spawn_test()
+{
+}
+
+#endif // defined(ASIO_HAS_CO_AWAIT)
+
+ASIO_TEST_SUITE
+(
+  "work_stealing_pool",
+  ASIO_TEST_CASE(work_stealing_pool_test)
+  ASIO_TEST_CASE(work_stealing_pool_fork_join_test)
+  ASIO_TEST_CASE(work_stealing_pool_executor_query_test)
+  ASIO_TEST_CASE(work_stealing_pool_executor_execute_test)
+  ASIO_TEST_CASE(work_stealing_pool_parallel_group_test)
+  ASIO_TEST_CASE(work_stealing_pool_co_spawn_test)
+)
@@ -21,8 +21,13 @@
 #include <functional>
 #include <vector>
 #include "archetypes/async_result.hpp"
+#include "archetypes/counting_allocator.hpp"
+#include "asio/bind_allocator.hpp"
 #include "asio/io_context.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
 #include "asio/post.hpp"
+#include "asio/read.hpp"
 #include "asio/streambuf.hpp"
 #include "unit_test.hpp"
 
@@ -4794,6 +4799,100 @@ void test_4_arg_streambuf_async_write()
 #endif // !defined(ASIO_NO_DYNAMIC_BUFFER_V1)
 }
 
+void test_async_write_allocation()
+{
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  asio::io_context ioc;
+  test_stream s(ioc);
+  asio::const_buffer buffers
+    = asio::buffer(write_data, sizeof(write_data));
+
+  s.reset();
+  s.next_write_length(1);
+  bool called = false;
+  int allocations = 0;
+  int deallocations = 0;
+  asio::async_write(s, buffers,
+      asio::bind_allocator(
+        archetypes::counting_allocator<void>(&allocations, &deallocations),
+        bindns::bind(async_write_handler,
+          _1, _2, sizeof(write_data), &called)));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(s.check_buffers(buffers, sizeof(write_data)));
+#if !defined(ASIO_DISABLE_REUSABLE_OP_MEMORY)
+  // Every partial write reuses the memory of the first.
+  ASIO_CHECK(allocations == 1);
+#endif // !defined(ASIO_DISABLE_REUSABLE_OP_MEMORY)
+  ASIO_CHECK(deallocations == allocations);
+}
+
+void test_long_buffer_sequence_async_write()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  asio::io_context ioc;
+  asio::local::stream_protocol::socket s1(ioc), s2(ioc);
+  asio::local::connect_pair(s1, s2);
+
+  // Split the data into many small buffers.
+  std::vector<char> data(7 * 1200);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = write_data[i % (sizeof(write_data) - 1)];
+  std::vector<asio::const_buffer> buffers;
+  for (size_t i = 0; i < data.size(); i += 7)
+    buffers.push_back(asio::buffer(&data[i], 7));
+
+  // A single operation writes as many buffers as the platform allows.
+  size_t max_buffers = asio::detail::buffer_sequence_adapter_base::max_buffers;
+  size_t expected = 7 * (buffers.size() < max_buffers
+      ? buffers.size() : max_buffers);
+  size_t length = 0;
+  int allocations = 0;
+  int deallocations = 0;
+  s1.async_write_some(buffers,
+      asio::bind_allocator(
+        archetypes::counting_allocator<void>(&allocations, &deallocations),
+        [&](const asio::error_code& ec, size_t n)
+        {
+          ASIO_CHECK(!ec);
+          length = n;
+        }));
+  ioc.run();
+  ASIO_CHECK(length == expected);
+  ASIO_CHECK(allocations > 0);
+  ASIO_CHECK(deallocations == allocations);
+
+  std::vector<char> received(length);
+  asio::read(s2, asio::buffer(received));
+  ASIO_CHECK(memcmp(received.data(), data.data(), length) == 0);
+
+  // The composed operation writes all of the buffers.
+  bool called = false;
+  asio::async_write(s1, buffers,
+      [&](const asio::error_code& ec, size_t n)
+      {
+        ASIO_CHECK(!ec);
+        ASIO_CHECK(n == 7 * buffers.size());
+        called = true;
+      });
+  received.resize(7 * buffers.size());
+  asio::async_read(s2, asio::buffer(received),
+      [&](const asio::error_code& ec, size_t n)
+      {
+        ASIO_CHECK(!ec);
+        ASIO_CHECK(n == 7 * buffers.size());
+      });
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(received == data);
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
 ASIO_TEST_SUITE
 (
   "write",
@@ -4829,4 +4928,6 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(test_4_arg_vector_buffers_async_write)
   ASIO_TEST_CASE(test_4_arg_dynamic_string_async_write)
   ASIO_TEST_CASE(test_4_arg_streambuf_async_write)
+  ASIO_TEST_CASE(test_async_write_allocation)
+  ASIO_TEST_CASE(test_long_buffer_sequence_async_write)
 )
@@ -0,0 +1,308 @@
+#!/usr/bin/perl -w
+#
+# handlerbin.pl
+# ~~~~~~~~~~~~~
+# A tool for post-processing the binary handler tracking output generated by
+# Asio-based programs that are compiled with the binary_tracking.hpp custom
+# tracking header. By default, the output is converted to the text format
+# written by the built-in handler tracking, so that it may be processed by
+# handlerviz.pl, handlertree.pl and handlerlive.pl. For example:
+#
+#   perl handlerbin.pl handler_tracking.bin | perl handlerviz.pl | dot -Tpng
+#
+# When the -l option is given, a report of handler latency histograms is
+# printed instead.
+#
+# Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#
+
+use strict;
+
+# Record types.
+my $header_record = 0;
+my $string_record = 1;
+my $location_record = 2;
+my $creation_record = 3;
+my $completion_record = 4;
+my $invocation_begin_record = 5;
+my $invocation_end_record = 6;
+my $operation_record = 7;
+my $reactor_operation_record = 11;
+my $lost_records_record = 12;
+
+# Record flags.
+my $invoked_flag = 1;
+my $error_code_flag = 2;
+my $bytes_transferred_flag = 4;
+my $signal_number_flag = 8;
+my $string_arg_flag = 16;
+my $innermost_flag = 32;
+
+my $record_size = 64;
+my $latency_report = 0;
+my %strings = ();
+my @records = ();
+my $lost_records = 0;
+
+#-------------------------------------------------------------------------------
+# Read the records from the input, building the string table as we go.
+
+sub read_records($)
+{
+  my ($file) = @_;
+
+  my $input;
+  if ($file eq "-")
+  {
+    $input = \*STDIN;
+  }
+  else
+  {
+    open($input, "<", $file) or die("Cannot open $file: $!\n");
+  }
+  binmode($input);
+
+  my $data;
+  while (read($input, $data, $record_size) == $record_size)
+  {
+    my ($type, $flags, $length, $id, $text) = unpack("S<S<l<Q<a48", $data);
+    if ($type == $header_record)
+    {
+      die("Unsupported record size $length\n") if $length != $record_size;
+    }
+    elsif ($type == $string_record)
+    {
+      my $remaining = $length > 48 ? $length - 48 : 0;
+      my $blocks = int(($remaining + $record_size - 1) / $record_size);
+      my $more = "";
+      read($input, $more, $blocks * $record_size) if $blocks > 0;
+      $strings{$id} = substr($text . $more, 0, $length);
+    }
+    else
+    {
+      my @r = unpack("S<S<l<Q<Q<Q<Q<Q<L<L<L<l<", $data);
+      push(@r, scalar(@records));
+      push(@records, \@r);
+    }
+  }
+
+  close($input) unless $file eq "-";
+
+  # Records from different threads are interleaved in the file. Sort them by
+  # time, keeping the file order of records with the same time.
+  @records = sort { $a->[3] <=> $b->[3] or $a->[12] <=> $b->[12] } @records;
+}
+
+sub string($)
+{
+  my ($id) = @_;
+  return "" if $id == 0;
+  return defined($strings{$id}) ? $strings{$id} : "?";
+}
+
+sub timestamp($)
+{
+  my ($time) = @_;
+  return sprintf("%d.%06d", int($time / 1000000000),
+      int(($time % 1000000000) / 1000));
+}
+
+sub error_code($)
+{
+  my ($r) = @_;
+  return sprintf("ec=%s:%d", string($r->[8]), $r->[2]);
+}
+
+#-------------------------------------------------------------------------------
+# Write the records in the text format used by the built-in handler tracking.
+
+sub print_text()
+{
+  for my $r (@records)
+  {
+    my ($type, $flags, $value, $time, $id, $parent, $object, $arg,
+        $str1, $str2, $str3, $value2) = @$r;
+    my $prefix = "\@asio|" . timestamp($time) . "|";
+
+    if ($type == $location_record)
+    {
+      my $func = string($str2);
+      print($prefix . "$parent^$id|"
+          . (($flags & $innermost_flag) ? "in " : "called from ")
+          . ($func ne "" ? "'$func' " : "")
+          . "(" . string($str1) . ":$value)\n");
+    }
+    elsif ($type == $creation_record)
+    {
+      printf("%s%d*%d|%s\@0x%x.%s\n", $prefix, $parent, $id,
+          string($str1), $object, string($str2));
+    }
+    elsif ($type == $completion_record)
+    {
+      print($prefix . (($flags & $invoked_flag) ? "!" : "~") . "$id|\n");
+    }
+    elsif ($type == $invocation_begin_record)
+    {
+      my $args = "";
+      if ($flags & $error_code_flag)
+      {
+        $args = error_code($r);
+        $args .= ",bytes_transferred=$arg" if $flags & $bytes_transferred_flag;
+        $args .= ",signal_number=$value2" if $flags & $signal_number_flag;
+        $args .= "," . string($str3) if $flags & $string_arg_flag;
+      }
+      print($prefix . ">$id|$args\n");
+    }
+    elsif ($type == $invocation_end_record)
+    {
+      print($prefix . "<$id|\n");
+    }
+    elsif ($type == $operation_record)
+    {
+      printf("%s%d|%s\@0x%x.%s\n", $prefix, $parent,
+          string($str1), $object, string($str2));
+    }
+    elsif ($type == $reactor_operation_record)
+    {
+      my $args = string($str2) . "," . error_code($r);
+      $args .= ",bytes_transferred=$arg" if $flags & $bytes_transferred_flag;
+      print($prefix . ".$id|$args\n");
+    }
+    elsif ($type == $lost_records_record)
+    {
+      $lost_records += $arg;
+    }
+  }
+}
+
+#-------------------------------------------------------------------------------
+# Print histograms of the time from the creation of each handler to the start
+# of its invocation, and from the start of its invocation to its completion.
+
+sub format_duration($)
+{
+  my ($ns) = @_;
+  return sprintf("%dns", $ns) if $ns < 1000;
+  return sprintf("%.1fus", $ns / 1000) if $ns < 1000000;
+  return sprintf("%.1fms", $ns / 1000000) if $ns < 1000000000;
+  return sprintf("%.1fs", $ns / 1000000000);
+}
+
+sub print_histogram($@)
+{
+  my ($title, @samples) = @_;
+
+  print("$title\n");
+  if (@samples == 0)
+  {
+    print("  no samples\n\n");
+    return;
+  }
+
+  @samples = sort { $a <=> $b } @samples;
+  my $count = scalar(@samples);
+  my $percentile = sub { $samples[int(($count - 1) * $_[0] / 100)] };
+  printf("  count %d, min %s, p50 %s, p90 %s, p99 %s, max %s\n",
+      $count, format_duration($samples[0]),
+      format_duration($percentile->(50)), format_duration($percentile->(90)),
+      format_duration($percentile->(99)), format_duration($samples[-1]));
+
+  # Use buckets whose bounds are powers of two nanoseconds.
+  my %buckets = ();
+  for my $ns (@samples)
+  {
+    my $bucket = 0;
+    $bucket++ while (2 ** ($bucket + 1)) <= $ns;
+    $buckets{$bucket}++;
+  }
+
+  my $largest = 0;
+  for my $n (values(%buckets))
+  {
+    $largest = $n if $n > $largest;
+  }
+
+  for my $bucket (sort { $a <=> $b } keys(%buckets))
+  {
+    my $n = $buckets{$bucket};
+    printf("  %9s - %-9s %8d %s\n", format_duration(2 ** $bucket),
+        format_duration(2 ** ($bucket + 1)), $n,
+        "#" x int(($n * 50 + $largest - 1) / $largest));
+  }
+  print("\n");
+}
+
+sub print_latency_report()
+{
+  my %created = ();
+  my %invoked = ();
+  my @queued = ();
+  my @executed = ();
+
+  for my $r (@records)
+  {
+    my ($type, $flags, $value, $time, $id) = @$r;
+
+    if ($type == $creation_record)
+    {
+      $created{$id} = $time;
+    }
+    elsif ($type == $invocation_begin_record)
+    {
+      push(@queued, $time - $created{$id}) if defined($created{$id});
+      delete($created{$id});
+      $invoked{$id} = $time;
+    }
+    elsif ($type == $invocation_end_record
+        || ($type == $completion_record && ($flags & $invoked_flag)))
+    {
+      push(@executed, $time - $invoked{$id}) if defined($invoked{$id});
+      delete($invoked{$id});
+    }
+    elsif ($type == $completion_record)
+    {
+      delete($created{$id});
+    }
+    elsif ($type == $lost_records_record)
+    {
+      $lost_records += $r->[7];
+    }
+  }
+
+  print_histogram("Creation to invocation:", @queued);
+  print_histogram("Invocation to completion:", @executed);
+}
+
+#-------------------------------------------------------------------------------
+
+while (@ARGV && $ARGV[0] =~ /^-./)
+{
+  my $option = shift(@ARGV);
+  if ($option eq "-l")
+  {
+    $latency_report = 1;
+  }
+  else
+  {
+    die("Usage: handlerbin.pl [-l] [file]\n");
+  }
+}
+
+read_records(@ARGV ? $ARGV[0] : "-");
+
+if ($latency_report)
+{
+  print_latency_report();
+}
+else
+{
+  print_text();
+}
+
+if ($lost_records > 0)
+{
+  print(STDERR "handlerbin.pl: $lost_records records were lost\n");
+}